@@ -10,3 +10,19 @@ target_include_directories(make_ipf PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
 add_executable(convert_orientations ${EbsdLibProj_SOURCE_DIR}/Source/Apps/ConvertOrientations.cpp)
 target_link_libraries(convert_orientations PUBLIC EbsdLib)
 target_include_directories(convert_orientations PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
+
+add_executable(laueops_benchmark ${EbsdLibProj_SOURCE_DIR}/Source/Apps/laueops_benchmark.cpp)
+target_link_libraries(laueops_benchmark PUBLIC EbsdLib)
+target_include_directories(laueops_benchmark PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
+
+add_executable(orientation_conversion_benchmark ${EbsdLibProj_SOURCE_DIR}/Source/Apps/orientation_conversion_benchmark.cpp)
+target_link_libraries(orientation_conversion_benchmark PUBLIC EbsdLib)
+target_include_directories(orientation_conversion_benchmark PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
+
+add_executable(feature_statistics_benchmark ${EbsdLibProj_SOURCE_DIR}/Source/Apps/feature_statistics_benchmark.cpp)
+target_link_libraries(feature_statistics_benchmark PUBLIC EbsdLib)
+target_include_directories(feature_statistics_benchmark PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
+
+add_executable(segmentation_benchmark ${EbsdLibProj_SOURCE_DIR}/Source/Apps/segmentation_benchmark.cpp)
+target_link_libraries(segmentation_benchmark PUBLIC EbsdLib)
+target_include_directories(segmentation_benchmark PUBLIC ${EbsdLibProj_SOURCE_DIR}/Source)
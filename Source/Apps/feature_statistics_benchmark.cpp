@@ -0,0 +1,152 @@
+/**
+ * This program times FeatureOrientationStatistics against the per point loop over LaueOps::getNearestQuat() and
+ * LaueOps::calculateMisorientation() that callers had to write before the engine existed, on a synthetic cubic
+ * orientation map where every feature is a contiguous run of points scattered by a few degrees about its center.
+ * getNearestQuat() only accepts symmetric equivalents with w >= 0, so the loop sometimes picks the wrong operator for
+ * features whose mean is near w = 0, and its checksum is larger than the one of the engine.
+ *
+ * Usage: feature_statistics_benchmark [number of points] [number of features]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/LaueOps/FeatureOrientationStatistics.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// -----------------------------------------------------------------------------
+double SecondsSince(const Clock::time_point& start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// -----------------------------------------------------------------------------
+void CreateFeatureMap(size_t numPoints, size_t numFeatures, EbsdLib::FloatArrayType& quats, EbsdLib::Int32ArrayType& featureIds)
+{
+  std::mt19937_64 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<QuatD> centers(numFeatures);
+  for(size_t f = 0; f < numFeatures; f++)
+  {
+    OrientationD eu(EbsdLib::Constants::k_2PiD * distribution(generator), EbsdLib::Constants::k_PiD * distribution(generator), EbsdLib::Constants::k_2PiD * distribution(generator));
+    centers[f] = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+  }
+
+  // Small rotations of up to ~3 degrees about a random axis
+  std::uniform_real_distribution<double> noise(-0.025, 0.025);
+  float* q = quats.getPointer(0);
+  int32_t* ids = featureIds.getPointer(0);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    auto feature = static_cast<int32_t>(i * numFeatures / numPoints);
+    double x = noise(generator);
+    double y = noise(generator);
+    double z = noise(generator);
+    double w = std::sqrt(1.0 - x * x - y * y - z * z);
+    QuatD member = centers[feature] * QuatD(x, y, z, w);
+    q[i * 4] = static_cast<float>(member.x());
+    q[i * 4 + 1] = static_cast<float>(member.y());
+    q[i * 4 + 2] = static_cast<float>(member.z());
+    q[i * 4 + 3] = static_cast<float>(member.w());
+    ids[i] = feature;
+  }
+}
+
+// -----------------------------------------------------------------------------
+double SerialFeatureStatistics(const LaueOps& ops, const EbsdLib::FloatArrayType& quats, const EbsdLib::Int32ArrayType& featureIds, size_t numFeatures)
+{
+  const size_t numPoints = quats.getNumberOfTuples();
+  const float* q = quats.getPointer(0);
+  const int32_t* ids = featureIds.getPointer(0);
+
+  // Running sums of the members moved next to the first member of each feature
+  std::vector<QuatD> refs(numFeatures, QuatD(0.0, 0.0, 0.0, 0.0));
+  std::vector<QuatD> sums(numFeatures, QuatD(0.0, 0.0, 0.0, 0.0));
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    QuatD quat(q[i * 4], q[i * 4 + 1], q[i * 4 + 2], q[i * 4 + 3]);
+    QuatD& ref = refs[ids[i]];
+    if(ref.w() == 0.0 && ref.x() == 0.0 && ref.y() == 0.0 && ref.z() == 0.0)
+    {
+      ref = quat;
+    }
+    // getNearestQuat() returns w >= 0, members on the other hemisphere than the reference have to be negated
+    QuatD nearest = ops.getNearestQuat(ref, quat);
+    if(nearest.x() * ref.x() + nearest.y() * ref.y() + nearest.z() * ref.z() + nearest.w() * ref.w() < 0.0)
+    {
+      nearest.negate();
+    }
+    sums[ids[i]] += nearest;
+  }
+  std::vector<QuatD> means(numFeatures);
+  for(size_t f = 0; f < numFeatures; f++)
+  {
+    double norm = std::sqrt(sums[f].x() * sums[f].x() + sums[f].y() * sums[f].y() + sums[f].z() * sums[f].z() + sums[f].w() * sums[f].w());
+    means[f] = norm > 0.0 ? QuatD(sums[f].x() / norm, sums[f].y() / norm, sums[f].z() / norm, sums[f].w() / norm) : QuatD(0.0, 0.0, 0.0, 1.0);
+  }
+
+  double checksum = 0.0;
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    QuatD quat(q[i * 4], q[i * 4 + 1], q[i * 4 + 2], q[i * 4 + 3]);
+    checksum += ops.calculateMisorientation(means[ids[i]], quat)[3];
+  }
+  return checksum;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numPoints = 100000000;
+  size_t numFeatures = 1000000;
+  if(argc > 1)
+  {
+    numPoints = static_cast<size_t>(std::stoull(argv[1]));
+  }
+  if(argc > 2)
+  {
+    numFeatures = static_cast<size_t>(std::stoull(argv[2]));
+  }
+
+  std::cout << "Generating " << numPoints << " points in " << numFeatures << " features..." << std::endl;
+  EbsdLib::FloatArrayType::Pointer quats = EbsdLib::FloatArrayType::CreateArray(numPoints, {4}, "Quats", true);
+  EbsdLib::Int32ArrayType::Pointer featureIds = EbsdLib::Int32ArrayType::CreateArray(numPoints, "FeatureIds", true);
+  EbsdLib::Int32ArrayType::Pointer phases = EbsdLib::Int32ArrayType::CreateArray(numPoints, "Phases", true);
+  phases->initializeWithValue(1);
+  CreateFeatureMap(numPoints, numFeatures, *quats, *featureIds);
+
+  CubicOps ops;
+  Clock::time_point start = Clock::now();
+  double checksum = SerialFeatureStatistics(ops, *quats, *featureIds, numFeatures);
+  double serialTime = SecondsSince(start);
+
+  FeatureOrientationStatistics::Pointer stats = FeatureOrientationStatistics::New({EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Cubic_High});
+  start = Clock::now();
+  stats->compute(quats.get(), featureIds.get(), phases.get(), numFeatures);
+  double engineTime = SecondsSince(start);
+
+  double engineChecksum = 0.0;
+  for(float angle : *stats->getPointMisorientations())
+  {
+    engineChecksum += angle;
+  }
+  std::cout << "Feature statistics (" << numPoints << " points, " << numFeatures << " features)" << std::endl;
+  std::cout << "  getNearestQuat + calculateMisorientation loop: " << serialTime << " s  (checksum " << checksum << ")" << std::endl;
+  std::cout << "  FeatureOrientationStatistics:                  " << engineTime << " s  (checksum " << engineChecksum << ", " << (serialTime / engineTime) << "x)" << std::endl;
+
+  return 0;
+}
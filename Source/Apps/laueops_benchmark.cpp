@@ -0,0 +1,158 @@
+/**
+ * This program times the bulk LaueOps entry points against their single point counterparts, and the double
+ * and single precision modes of the batch misorientation and IPF color kernels, on a large
+ * synthetic orientation map.
+ *
+ * Usage: laueops_benchmark [number of points]
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "EbsdLib/Core/EbsdArrayView.hpp"
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/LaueOps/HexagonalOps.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Math/EbsdMatrixMath.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// -----------------------------------------------------------------------------
+EbsdLib::FloatArrayType::Pointer CreateRandomQuats(size_t numPoints)
+{
+  std::mt19937_64 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  EbsdLib::FloatArrayType::Pointer quats = EbsdLib::FloatArrayType::CreateArray(numPoints, {4}, "Quats", true);
+  float* ptr = quats->getPointer(0);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    OrientationD eu(EbsdLib::Constants::k_2PiD * distribution(generator), EbsdLib::Constants::k_PiD * distribution(generator), EbsdLib::Constants::k_2PiD * distribution(generator));
+    QuatD q = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+    ptr[i * 4] = static_cast<float>(q.x());
+    ptr[i * 4 + 1] = static_cast<float>(q.y());
+    ptr[i * 4 + 2] = static_cast<float>(q.z());
+    ptr[i * 4 + 3] = static_cast<float>(q.w());
+  }
+  return quats;
+}
+
+// -----------------------------------------------------------------------------
+double SecondsSince(const Clock::time_point& start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// -----------------------------------------------------------------------------
+void BenchmarkSchmidFactorMap(const LaueOps& ops, EbsdLib::FloatArrayType::Pointer& quats)
+{
+  const size_t numPoints = quats->getNumberOfTuples();
+  const double load[3] = {0.0, 0.0, 1.0};
+  EbsdLib::FloatArrayType::Pointer schmids = EbsdLib::FloatArrayType::CreateArray(numPoints, "Schmids", true);
+  EbsdLib::Int32ArrayType::Pointer slipSystems = EbsdLib::Int32ArrayType::CreateArray(numPoints, "SlipSystems", true);
+  EbsdLib::FloatArrayType::Pointer angleComps = EbsdLib::FloatArrayType::CreateArray(numPoints, {2}, "AngleComps", true);
+
+  // Single point loop, the way callers had to do it before the bulk entry point existed
+  Clock::time_point start = Clock::now();
+  const float* q = quats->getPointer(0);
+  double g[3][3];
+  double crystalLoad[3];
+  double comps[2];
+  double schmidFactor = 0.0;
+  int slipSystem = 0;
+  double checksum = 0.0;
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    QuatD quat(q[i * 4], q[i * 4 + 1], q[i * 4 + 2], q[i * 4 + 3]);
+    OrientationTransformation::qu2om<QuatD, OrientationD>(quat).toGMatrix(g);
+    EbsdMatrixMath::Multiply3x3with3x1(g, load, crystalLoad);
+    ops.getSchmidFactorAndSS(crystalLoad, schmidFactor, comps, slipSystem);
+    checksum += schmidFactor;
+  }
+  double serialTime = SecondsSince(start);
+
+  start = Clock::now();
+  ops.generateSchmidFactorMap(quats.get(), load, schmids.get(), slipSystems.get(), angleComps.get());
+  double bulkTime = SecondsSince(start);
+
+  std::cout << ops.getNameOfClass() << " Schmid factor map (" << numPoints << " points, checksum " << checksum << ")" << std::endl;
+  std::cout << "  getSchmidFactorAndSS loop:  " << serialTime << " s" << std::endl;
+  std::cout << "  generateSchmidFactorMap:    " << bulkTime << " s  (" << (serialTime / bulkTime) << "x)" << std::endl;
+}
+
+// -----------------------------------------------------------------------------
+void BenchmarkPrecision(const LaueOps& ops, EbsdLib::FloatArrayType::Pointer& quats)
+{
+  const size_t numPoints = quats->getNumberOfTuples();
+  const std::array<EbsdLib::ComputePrecision, 2> precisions = {EbsdLib::ComputePrecision::Double, EbsdLib::ComputePrecision::Single};
+  const std::array<const char*, 2> names = {"Double", "Single"};
+
+  // Neighboring points make up the misorientation pairs
+  EbsdLib::FloatArrayType::Pointer neighbors = EbsdLib::FloatArrayType::CreateArray(numPoints, {4}, "Neighbors", true);
+  float* ptr = neighbors->getPointer(0);
+  const float* q = quats->getPointer(0);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    size_t neighbor = (i + 1) % numPoints;
+    for(size_t c = 0; c < 4; c++)
+    {
+      ptr[i * 4 + c] = q[neighbor * 4 + c];
+    }
+  }
+  EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(numPoints, {3}, "Eulers", true);
+  float* eu = eulers->getPointer(0);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    OrientationF euler = OrientationTransformation::qu2eu<QuatF, OrientationF>(QuatF(q[i * 4], q[i * 4 + 1], q[i * 4 + 2], q[i * 4 + 3]));
+    eu[i * 3] = euler[0];
+    eu[i * 3 + 1] = euler[1];
+    eu[i * 3 + 2] = euler[2];
+  }
+
+  EbsdLib::FloatArrayType::Pointer axisAngles = EbsdLib::FloatArrayType::CreateArray(numPoints, {4}, "AxisAngles", true);
+  EbsdLib::UInt8ArrayType::Pointer colors = EbsdLib::UInt8ArrayType::CreateArray(numPoints, {3}, "Colors", true);
+  const double refDir[3] = {0.0, 0.0, 1.0};
+  std::cout << ops.getNameOfClass() << " batch precision (" << numPoints << " points)" << std::endl;
+  for(size_t p = 0; p < precisions.size(); p++)
+  {
+    Clock::time_point start = Clock::now();
+    ops.calculateMisorientations(quats.get(), neighbors.get(), axisAngles.get(), precisions[p]);
+    double misoTime = SecondsSince(start);
+    start = Clock::now();
+    ops.generateIPFColors(EbsdArrayView<const float>::FromArray(*eulers), refDir, false, colors.get(), precisions[p]);
+    double ipfTime = SecondsSince(start);
+    std::cout << "  " << names[p] << " calculateMisorientations: " << misoTime << " s  generateIPFColors: " << ipfTime << " s" << std::endl;
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numPoints = 10000000;
+  if(argc > 1)
+  {
+    numPoints = static_cast<size_t>(std::stoull(argv[1]));
+  }
+
+  std::cout << "Generating " << numPoints << " random orientations..." << std::endl;
+  EbsdLib::FloatArrayType::Pointer quats = CreateRandomQuats(numPoints);
+
+  CubicOps cubicOps;
+  BenchmarkSchmidFactorMap(cubicOps, quats);
+  BenchmarkPrecision(cubicOps, quats);
+  HexagonalOps hexOps;
+  BenchmarkPrecision(hexOps, quats);
+
+  return 0;
+}
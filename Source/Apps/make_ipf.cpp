@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <iostream>
@@ -6,11 +7,13 @@
 #include <utility>
 #include <vector>
 
+#include "EbsdLib/Core/EbsdArrayView.hpp"
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/IO/EbsdReader.h"
 #include "EbsdLib/IO/TSL/AngPhase.h"
 #include "EbsdLib/IO/TSL/AngReader.h"
 #include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/PhasePartition.h"
 #include "EbsdLib/Math/EbsdMatrixMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
 #include "EbsdLib/Utilities/TiffWriter.h"
@@ -25,7 +28,7 @@ using FloatVec3Type = std::array<float, 3>;
 class GenerateIPFColorsImpl
 {
 public:
-  GenerateIPFColorsImpl(FloatVec3Type& referenceDir, const std::vector<float>& eulers, int32_t* phases, std::vector<AngPhase::Pointer>& crystalStructures, bool* goodVoxels, uint8_t* colors)
+  GenerateIPFColorsImpl(FloatVec3Type& referenceDir, const EbsdArrayView<const float>& eulers, int32_t* phases, std::vector<AngPhase::Pointer>& crystalStructures, bool* goodVoxels, uint8_t* colors)
   : m_ReferenceDir(referenceDir)
   , m_CellEulerAngles(eulers)
   , m_CellPhases(phases)
@@ -39,64 +42,34 @@ public:
 
   void run() const
   {
-    std::vector<LaueOps::Pointer> ops = LaueOps::GetAllOrientationOps();
     double refDir[3] = {m_ReferenceDir[0], m_ReferenceDir[1], m_ReferenceDir[2]};
-    double dEuler[3] = {0.0, 0.0, 0.0};
-    EbsdLib::Rgb argb = 0x00000000;
-    int32_t phase = 0;
-    bool calcIPF = false;
-    size_t index = 0;
     int32_t numPhases = static_cast<int32_t>(m_PhaseInfos.size());
 
-    std::vector<size_t> laueOpsIndex(m_PhaseInfos.size());
+    std::vector<uint32_t> laueOpsIndex(m_PhaseInfos.size());
     for(size_t i = 0; i < laueOpsIndex.size(); i++)
     {
       laueOpsIndex[i] = m_PhaseInfos[i]->determineLaueGroup();
     }
 
-    size_t totalPoints = m_CellEulerAngles.size() / 3;
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      phase = m_CellPhases[i];
-      index = i * 3;
-      m_CellIPFColors[index] = 0;
-      m_CellIPFColors[index + 1] = 0;
-      m_CellIPFColors[index + 2] = 0;
-      dEuler[0] = m_CellEulerAngles[index];
-      dEuler[1] = m_CellEulerAngles[index + 1];
-      dEuler[2] = m_CellEulerAngles[index + 2];
-
-      // Make sure we are using a valid Euler Angles with valid crystal symmetry
-      calcIPF = true;
-      if(nullptr != m_GoodVoxels)
-      {
-        calcIPF = m_GoodVoxels[i];
-      }
-      // Sanity check the phase data to make sure we do not walk off the end of the array
-      if(phase >= numPhases)
-      {
-        // m_Filter->incrementPhaseWarningCount();
-        std::cout << "phase > number of phases" << std::endl;
-      }
-
-      size_t currentLaueOpsIndex = laueOpsIndex[phase];
-
-      if(phase < numPhases && calcIPF && currentLaueOpsIndex < EbsdLib::CrystalStructure::LaueGroupEnd)
-      {
-        argb = ops[currentLaueOpsIndex]->generateIPFColor(dEuler, refDir, false);
-        m_CellIPFColors[index] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
-        m_CellIPFColors[index + 1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
-        m_CellIPFColors[index + 2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
+    size_t totalPoints = m_CellEulerAngles.getNumberOfTuples();
+    std::fill(m_CellIPFColors, m_CellIPFColors + totalPoints * 3, static_cast<uint8_t>(0));
 
-        //  std::cout << (int32_t)(m_CellIPFColors[index]) << "\t" << (int32_t)(m_CellIPFColors[index + 1]) << (int32_t)(m_CellIPFColors[index + 2]) << m_CellEulerAngles[index] << "\t"
-        //            << m_CellEulerAngles[index + 1] << "\t" << m_CellEulerAngles[index + 2] << std::endl;
-      }
+    // Sort the points by phase once so each phase is colored by a single batch call on a contiguous block. Points
+    // with a phase that would walk off the end of the phase array are left black.
+    PhasePartition::Pointer partition = PhasePartition::New(m_CellPhases, totalPoints, static_cast<size_t>(numPhases), m_GoodVoxels);
+    if(std::any_of(m_CellPhases, m_CellPhases + totalPoints, [numPhases](int32_t phase) { return phase >= numPhases; }))
+    {
+      // m_Filter->incrementPhaseWarningCount();
+      std::cout << "phase > number of phases" << std::endl;
     }
+
+    EbsdLib::UInt8ArrayType::Pointer colors = EbsdLib::UInt8ArrayType::WrapPointer(m_CellIPFColors, totalPoints, {3}, "IPFColors", false);
+    partition->generateIPFColors(laueOpsIndex, m_CellEulerAngles, refDir, false, colors.get());
   }
 
 private:
   FloatVec3Type m_ReferenceDir;
-  const std::vector<float>& m_CellEulerAngles;
+  EbsdArrayView<const float> m_CellEulerAngles;
   int32_t* m_CellPhases;
   std::vector<AngPhase::Pointer> m_PhaseInfos;
 
@@ -158,15 +131,8 @@ public:
     float* phiPtr = reader.getPhiPointer(false);
     float* phi2Ptr = reader.getPhi2Pointer(false);
 
-    // We need to interleave the phi1, PHI, phi2 data into a single 3 component array
-    std::vector<float> eulers(3 * totalPoints);
-
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      eulers[i * 3] = phi1Ptr[i];
-      eulers[i * 3 + 1] = phiPtr[i];
-      eulers[i * 3 + 2] = phi2Ptr[i];
-    }
+    // Use the phi1, PHI, phi2 arrays from the reader directly as a single 3 component input
+    EbsdArrayView<const float> eulers = EbsdArrayView<const float>::FromComponents({phi1Ptr, phiPtr, phi2Ptr}, totalPoints);
 
     int32_t* phaseData = reader.getPhaseDataPointer(false);
     for(size_t i = 0; i < totalPoints; i++)
@@ -0,0 +1,168 @@
+/**
+ * This program times every one of the 49 orientation representation conversions through the Orientation container
+ * based functions in OrientationTransformation against the fused, stack based kernels in
+ * FusedOrientationTransformation.hpp and prints the throughput of each pair as a 7x7 matrix.
+ *
+ * Usage: orientation_conversion_benchmark [number of points]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/FusedOrientationTransformation.hpp"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationRepresentation.h"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+using RepType = OrientationRepresentation::Type;
+
+constexpr size_t k_NumRepresentations = 7;
+const char* k_ShortNames[k_NumRepresentations] = {"eu", "om", "qu", "ax", "ro", "ho", "cu"};
+
+struct Timing
+{
+  double orientation = 0.0;
+  double fused = 0.0;
+};
+
+// -----------------------------------------------------------------------------
+double SecondsSince(const Clock::time_point& start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// -----------------------------------------------------------------------------
+std::vector<double> CreateRandomEulers(size_t numPoints)
+{
+  std::mt19937_64 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<double> eulers(numPoints * 3);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    eulers[i * 3] = EbsdLib::Constants::k_2PiD * distribution(generator);
+    eulers[i * 3 + 1] = EbsdLib::Constants::k_PiD * distribution(generator);
+    eulers[i * 3 + 2] = EbsdLib::Constants::k_2PiD * distribution(generator);
+  }
+  return eulers;
+}
+
+// -----------------------------------------------------------------------------
+template <RepType From, RepType To>
+Timing BenchmarkPair(const std::vector<std::vector<double>>& inputs, double& checksum)
+{
+  namespace Fused = OrientationTransformation::Fused;
+  const std::vector<double>& input = inputs[static_cast<size_t>(From)];
+  const size_t inStride = Fused::NumComponents(From);
+  const size_t outStride = Fused::NumComponents(To);
+  const size_t numPoints = input.size() / inStride;
+  std::vector<double> output(numPoints * outStride);
+  std::vector<double> values(input);
+  Timing timing;
+
+  // One Orientation allocation per hop, the way OrientationConverter worked before the fused kernels
+  using InputType = std::conditional_t<From == RepType::Quaternion, QuatD, OrientationD>;
+  using OutputType = std::conditional_t<To == RepType::Quaternion, QuatD, OrientationD>;
+  Clock::time_point start = Clock::now();
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    double* ptr = values.data() + i * inStride;
+    InputType in;
+    if constexpr(From == RepType::Quaternion)
+    {
+      in = QuatD(ptr[0], ptr[1], ptr[2], ptr[3]);
+    }
+    else
+    {
+      in = OrientationD(ptr, inStride);
+    }
+    OutputType out = Fused::Conversion<From, To>::template Apply<InputType, OutputType>(in);
+    for(size_t c = 0; c < outStride; c++)
+    {
+      output[i * outStride + c] = out[c];
+    }
+  }
+  timing.orientation = SecondsSince(start);
+  checksum += output[0];
+
+  start = Clock::now();
+  Fused::ConvertRange<From, To, double>(input.data(), inStride, output.data(), outStride, 0, numPoints);
+  timing.fused = SecondsSince(start);
+  checksum += output[0];
+
+  return timing;
+}
+
+// -----------------------------------------------------------------------------
+template <size_t... Indices>
+std::vector<Timing> BenchmarkAllPairs(const std::vector<std::vector<double>>& inputs, double& checksum, std::index_sequence<Indices...> /*unused*/)
+{
+  return {BenchmarkPair<static_cast<RepType>(Indices / k_NumRepresentations), static_cast<RepType>(Indices % k_NumRepresentations)>(inputs, checksum)...};
+}
+
+// -----------------------------------------------------------------------------
+template <typename Functor>
+void PrintMatrix(const std::string& title, const std::vector<Timing>& timings, Functor value)
+{
+  std::cout << title << std::endl;
+  std::cout << "  from\\to";
+  for(const char* name : k_ShortNames)
+  {
+    std::cout << std::setw(10) << name;
+  }
+  std::cout << std::endl;
+  for(size_t from = 0; from < k_NumRepresentations; from++)
+  {
+    std::cout << std::setw(9) << k_ShortNames[from];
+    for(size_t to = 0; to < k_NumRepresentations; to++)
+    {
+      std::cout << std::setw(10) << std::fixed << std::setprecision(2) << value(timings[from * k_NumRepresentations + to]);
+    }
+    std::cout << std::endl;
+  }
+  std::cout << std::endl;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t numPoints = 1000000;
+  if(argc > 1)
+  {
+    numPoints = static_cast<size_t>(std::stoull(argv[1]));
+  }
+
+  std::cout << "Generating " << numPoints << " random orientations in each representation..." << std::endl;
+  std::vector<double> eulers = CreateRandomEulers(numPoints);
+  std::vector<std::vector<double>> inputs(k_NumRepresentations);
+  for(size_t rep = 0; rep < k_NumRepresentations; rep++)
+  {
+    const auto type = static_cast<RepType>(rep);
+    const size_t stride = OrientationTransformation::Fused::NumComponents(type);
+    inputs[rep].resize(numPoints * stride);
+    OrientationTransformation::Fused::GetConversionKernel<double>(RepType::Euler, type)(eulers.data(), 3, inputs[rep].data(), stride, 0, numPoints);
+  }
+
+  double checksum = 0.0;
+  std::vector<Timing> timings = BenchmarkAllPairs(inputs, checksum, std::make_index_sequence<k_NumRepresentations * k_NumRepresentations>());
+  std::cout << "(checksum " << checksum << ")" << std::endl << std::endl;
+
+  const double millions = static_cast<double>(numPoints) / 1.0E6;
+  PrintMatrix("Orientation<double> path [M orientations/s]", timings, [millions](const Timing& t) { return millions / t.orientation; });
+  PrintMatrix("Fused kernels [M orientations/s]", timings, [millions](const Timing& t) { return millions / t.fused; });
+  PrintMatrix("Speedup [x]", timings, [](const Timing& t) { return t.orientation / t.fused; });
+
+  return 0;
+}
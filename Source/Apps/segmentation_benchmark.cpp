@@ -0,0 +1,194 @@
+/**
+ * This program times MisorientationSegmentation against the serial flood fill over LaueOps::calculateMisorientation()
+ * that callers had to write before the engine existed, on a synthetic cubic volume made of blocks of points scattered
+ * by about a degree about the orientation of their block. Both number the features in the order of their lowest point
+ * index, so their feature counts and checksums match.
+ *
+ * Usage: segmentation_benchmark [points along X] [points along Y] [points along Z]
+ */
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/LaueOps/MisorientationSegmentation.h"
+#include "EbsdLib/Math/EbsdLibMath.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+constexpr size_t k_BlockSize = 16;
+
+// -----------------------------------------------------------------------------
+double SecondsSince(const Clock::time_point& start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// -----------------------------------------------------------------------------
+void CreateBlockMap(const size_t dims[3], EbsdLib::FloatArrayType& quats)
+{
+  std::mt19937_64 generator(42);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+  std::vector<QuatD> centers(1024);
+  for(QuatD& center : centers)
+  {
+    OrientationD eu(EbsdLib::Constants::k_2PiD * distribution(generator), EbsdLib::Constants::k_PiD * distribution(generator), EbsdLib::Constants::k_2PiD * distribution(generator));
+    center = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+  }
+
+  // Small rotations of up to ~1 degree about a random axis
+  std::uniform_real_distribution<double> noise(-0.005, 0.005);
+  float* q = quats.getPointer(0);
+  for(size_t z = 0; z < dims[2]; z++)
+  {
+    for(size_t y = 0; y < dims[1]; y++)
+    {
+      for(size_t x = 0; x < dims[0]; x++)
+      {
+        const size_t index = (z * dims[1] + y) * dims[0] + x;
+        const size_t block = ((x / k_BlockSize) + (y / k_BlockSize) * 31 + (z / k_BlockSize) * 97) % centers.size();
+        double nx = noise(generator);
+        double ny = noise(generator);
+        double nz = noise(generator);
+        double nw = std::sqrt(1.0 - nx * nx - ny * ny - nz * nz);
+        QuatD member = centers[block] * QuatD(nx, ny, nz, nw);
+        q[index * 4] = static_cast<float>(member.x());
+        q[index * 4 + 1] = static_cast<float>(member.y());
+        q[index * 4 + 2] = static_cast<float>(member.z());
+        q[index * 4 + 3] = static_cast<float>(member.w());
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t SerialFloodFill(const LaueOps& ops, const EbsdLib::FloatArrayType& quats, const size_t dims[3], double tolerance, EbsdLib::Int32ArrayType& featureIds)
+{
+  const size_t numPoints = dims[0] * dims[1] * dims[2];
+  const float* q = quats.getPointer(0);
+  int32_t* ids = featureIds.getPointer(0);
+  std::fill(ids, ids + numPoints, 0);
+  std::vector<size_t> stack;
+  int32_t numFeatures = 0;
+  for(size_t seed = 0; seed < numPoints; seed++)
+  {
+    if(ids[seed] != 0)
+    {
+      continue;
+    }
+    ids[seed] = ++numFeatures;
+    stack.push_back(seed);
+    while(!stack.empty())
+    {
+      const size_t index = stack.back();
+      stack.pop_back();
+      QuatD quat(q[index * 4], q[index * 4 + 1], q[index * 4 + 2], q[index * 4 + 3]);
+      const size_t x = index % dims[0];
+      const size_t y = (index / dims[0]) % dims[1];
+      const size_t z = index / (dims[0] * dims[1]);
+      std::array<size_t, 6> neighbors = {};
+      size_t numNeighbors = 0;
+      if(x > 0)
+      {
+        neighbors[numNeighbors++] = index - 1;
+      }
+      if(x + 1 < dims[0])
+      {
+        neighbors[numNeighbors++] = index + 1;
+      }
+      if(y > 0)
+      {
+        neighbors[numNeighbors++] = index - dims[0];
+      }
+      if(y + 1 < dims[1])
+      {
+        neighbors[numNeighbors++] = index + dims[0];
+      }
+      if(z > 0)
+      {
+        neighbors[numNeighbors++] = index - dims[0] * dims[1];
+      }
+      if(z + 1 < dims[2])
+      {
+        neighbors[numNeighbors++] = index + dims[0] * dims[1];
+      }
+      for(size_t n = 0; n < numNeighbors; n++)
+      {
+        const size_t neighbor = neighbors[n];
+        if(ids[neighbor] != 0)
+        {
+          continue;
+        }
+        QuatD other(q[neighbor * 4], q[neighbor * 4 + 1], q[neighbor * 4 + 2], q[neighbor * 4 + 3]);
+        if(ops.calculateMisorientation(quat, other)[3] <= tolerance)
+        {
+          ids[neighbor] = ids[index];
+          stack.push_back(neighbor);
+        }
+      }
+    }
+  }
+  return static_cast<size_t>(numFeatures) + 1;
+}
+
+// -----------------------------------------------------------------------------
+double Checksum(const EbsdLib::Int32ArrayType& featureIds)
+{
+  double checksum = 0.0;
+  for(int32_t id : featureIds)
+  {
+    checksum += id;
+  }
+  return checksum;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  size_t dims[3] = {400, 400, 400};
+  for(int i = 1; i < argc && i < 4; i++)
+  {
+    dims[i - 1] = static_cast<size_t>(std::stoull(argv[i]));
+  }
+  const size_t numPoints = dims[0] * dims[1] * dims[2];
+  const double tolerance = 5.0 * EbsdLib::Constants::k_PiOver180D;
+
+  std::cout << "Generating " << dims[0] << "x" << dims[1] << "x" << dims[2] << " points..." << std::endl;
+  EbsdLib::FloatArrayType::Pointer quats = EbsdLib::FloatArrayType::CreateArray(numPoints, {4}, "Quats", true);
+  EbsdLib::Int32ArrayType::Pointer phases = EbsdLib::Int32ArrayType::CreateArray(numPoints, "Phases", true);
+  EbsdLib::Int32ArrayType::Pointer featureIds = EbsdLib::Int32ArrayType::CreateArray(numPoints, "FeatureIds", true);
+  phases->initializeWithValue(1);
+  CreateBlockMap(dims, *quats);
+
+  CubicOps ops;
+  Clock::time_point start = Clock::now();
+  size_t numFeatures = SerialFloodFill(ops, *quats, dims, tolerance, *featureIds);
+  double serialTime = SecondsSince(start);
+  double checksum = Checksum(*featureIds);
+
+  MisorientationSegmentation::Pointer engine = MisorientationSegmentation::New({EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Cubic_High});
+  engine->setTolerance(tolerance);
+  start = Clock::now();
+  size_t engineFeatures = engine->compute(quats.get(), phases.get(), dims, featureIds.get());
+  double engineTime = SecondsSince(start);
+
+  std::cout << "Misorientation segmentation (" << numPoints << " points)" << std::endl;
+  std::cout << "  calculateMisorientation flood fill: " << serialTime << " s  (" << numFeatures << " features, checksum " << checksum << ")" << std::endl;
+  std::cout << "  MisorientationSegmentation:         " << engineTime << " s  (" << engineFeatures << " features, checksum " << Checksum(*featureIds) << ", " << (serialTime / engineTime)
+            << "x)" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,296 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ArrayAllocator.h"
+
+#include <atomic>
+#include <cstdlib>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+using namespace EbsdLib;
+
+namespace
+{
+const size_t k_CacheLineSize = 64;
+const size_t k_PageSize = 4096;
+const size_t k_HugePageSize = 2ULL * 1024ULL * 1024ULL;
+
+/**
+ * @brief Rounds value up to the next multiple of alignment, which must be a power of 2
+ */
+inline size_t RoundUp(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief Holds the process wide default allocator. GetDefault() runs on every EbsdDataArray construction, including
+ * inside parallel loops, so it never takes a lock: the allocator is read with std::atomic_load, and only after the
+ * hasAllocator flag shows that one was ever installed.
+ */
+struct DefaultAllocatorHolder
+{
+  std::atomic<bool> hasAllocator = {false};
+  ArrayAllocator::Pointer allocator;
+};
+
+DefaultAllocatorHolder& GetDefaultAllocatorHolder()
+{
+  static DefaultAllocatorHolder holder;
+  return holder;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+ArrayAllocator::ArrayAllocator() = default;
+
+// -----------------------------------------------------------------------------
+ArrayAllocator::~ArrayAllocator() = default;
+
+// -----------------------------------------------------------------------------
+ArrayAllocator::Pointer ArrayAllocator::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::string ArrayAllocator::getNameOfClass() const
+{
+  return ClassName();
+}
+
+// -----------------------------------------------------------------------------
+std::string ArrayAllocator::ClassName()
+{
+  return std::string("ArrayAllocator");
+}
+
+// -----------------------------------------------------------------------------
+void ArrayAllocator::SetDefault(const Pointer& allocator)
+{
+  DefaultAllocatorHolder& holder = GetDefaultAllocatorHolder();
+  std::atomic_store(&holder.allocator, allocator);
+  if(nullptr != allocator)
+  {
+    holder.hasAllocator.store(true, std::memory_order_release);
+  }
+}
+
+// -----------------------------------------------------------------------------
+ArrayAllocator::Pointer ArrayAllocator::GetDefault()
+{
+  DefaultAllocatorHolder& holder = GetDefaultAllocatorHolder();
+  if(!holder.hasAllocator.load(std::memory_order_acquire))
+  {
+    return nullptr;
+  }
+  return std::atomic_load(&holder.allocator);
+}
+
+// -----------------------------------------------------------------------------
+PooledArrayAllocator::PooledArrayAllocator(size_t maxCachedBytes, bool useHugePages)
+: m_MaxCachedBytes(maxCachedBytes)
+, m_UseHugePages(useHugePages)
+{
+}
+
+// -----------------------------------------------------------------------------
+PooledArrayAllocator::~PooledArrayAllocator()
+{
+  releaseCachedMemory();
+}
+
+// -----------------------------------------------------------------------------
+PooledArrayAllocator::Pointer PooledArrayAllocator::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::string PooledArrayAllocator::getNameOfClass() const
+{
+  return ClassName();
+}
+
+// -----------------------------------------------------------------------------
+std::string PooledArrayAllocator::ClassName()
+{
+  return std::string("PooledArrayAllocator");
+}
+
+// -----------------------------------------------------------------------------
+PooledArrayAllocator::Pointer PooledArrayAllocator::New(size_t maxCachedBytes, bool useHugePages)
+{
+  Pointer sharedPtr(new PooledArrayAllocator(maxCachedBytes, useHugePages));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+size_t PooledArrayAllocator::blockSize(size_t numBytes) const
+{
+  if(numBytes == 0)
+  {
+    numBytes = 1;
+  }
+  if(m_UseHugePages && numBytes >= k_HugePageSize)
+  {
+    return RoundUp(numBytes, k_HugePageSize);
+  }
+  if(numBytes >= k_PageSize)
+  {
+    return RoundUp(numBytes, k_PageSize);
+  }
+  return RoundUp(numBytes, k_CacheLineSize);
+}
+
+// -----------------------------------------------------------------------------
+void* PooledArrayAllocator::systemAllocate(size_t blockBytes) const
+{
+  const bool hugePage = m_UseHugePages && blockBytes >= k_HugePageSize;
+  const size_t alignment = hugePage ? k_HugePageSize : k_CacheLineSize;
+  void* ptr = nullptr;
+#if defined(_MSC_VER)
+  ptr = _aligned_malloc(blockBytes, alignment);
+#else
+  if(posix_memalign(&ptr, alignment, blockBytes) != 0)
+  {
+    ptr = nullptr;
+  }
+#endif
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if(nullptr != ptr && hugePage)
+  {
+    // This is only a hint, the kernel is free to ignore it
+    madvise(ptr, blockBytes, MADV_HUGEPAGE);
+  }
+#endif
+  return ptr;
+}
+
+// -----------------------------------------------------------------------------
+void PooledArrayAllocator::systemDeallocate(void* ptr, size_t /* blockBytes */) const
+{
+#if defined(_MSC_VER)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void* PooledArrayAllocator::allocate(size_t numBytes)
+{
+  const size_t blockBytes = blockSize(numBytes);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto iter = m_FreeBlocks.find(blockBytes);
+    if(iter != m_FreeBlocks.end() && !iter->second.empty())
+    {
+      void* ptr = iter->second.back();
+      iter->second.pop_back();
+      m_CachedBytes -= blockBytes;
+      m_ReuseCount++;
+      return ptr;
+    }
+    m_SystemAllocationCount++;
+  }
+  return systemAllocate(blockBytes);
+}
+
+// -----------------------------------------------------------------------------
+void PooledArrayAllocator::deallocate(void* ptr, size_t numBytes)
+{
+  if(nullptr == ptr)
+  {
+    return;
+  }
+  const size_t blockBytes = blockSize(numBytes);
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if(m_CachedBytes + blockBytes <= m_MaxCachedBytes)
+    {
+      m_FreeBlocks[blockBytes].push_back(ptr);
+      m_CachedBytes += blockBytes;
+      return;
+    }
+  }
+  systemDeallocate(ptr, blockBytes);
+}
+
+// -----------------------------------------------------------------------------
+void PooledArrayAllocator::releaseCachedMemory()
+{
+  std::map<size_t, std::vector<void*>> freeBlocks;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    freeBlocks.swap(m_FreeBlocks);
+    m_CachedBytes = 0;
+  }
+  for(const auto& entry : freeBlocks)
+  {
+    for(void* ptr : entry.second)
+    {
+      systemDeallocate(ptr, entry.first);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t PooledArrayAllocator::getCachedBytes() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_CachedBytes;
+}
+
+// -----------------------------------------------------------------------------
+size_t PooledArrayAllocator::getReuseCount() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_ReuseCount;
+}
+
+// -----------------------------------------------------------------------------
+size_t PooledArrayAllocator::getSystemAllocationCount() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_SystemAllocationCount;
+}
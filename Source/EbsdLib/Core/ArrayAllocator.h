@@ -0,0 +1,206 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+
+namespace EbsdLib
+{
+
+/**
+ * @class ArrayAllocator ArrayAllocator.h EbsdLib/Core/ArrayAllocator.h
+ * @brief The ArrayAllocator class is the interface EbsdDataArray uses to obtain and release the memory for its
+ * internal buffer. EbsdDataArray falls back to new[]/delete[] when no allocator has been set.
+ *
+ * A process wide default can be installed with SetDefault(). Every EbsdDataArray that is constructed afterwards
+ * (including the temporary arrays created inside the pole figure and IPF code) will then use it.
+ */
+class EbsdLib_EXPORT ArrayAllocator
+{
+public:
+  using Self = ArrayAllocator;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  /**
+   * @brief Returns the name of the class for ArrayAllocator
+   */
+  virtual std::string getNameOfClass() const;
+  /**
+   * @brief Returns the name of the class for ArrayAllocator
+   */
+  static std::string ClassName();
+
+  virtual ~ArrayAllocator();
+
+  /**
+   * @brief Allocates a block of memory. The contents of the block are NOT initialized.
+   * @param numBytes The size of the block in bytes
+   * @return Pointer to the block or nullptr if the memory could not be allocated
+   */
+  virtual void* allocate(size_t numBytes) = 0;
+
+  /**
+   * @brief Returns a block of memory that was obtained from allocate()
+   * @param ptr The block to release
+   * @param numBytes The size that was passed to allocate() for this block
+   */
+  virtual void deallocate(void* ptr, size_t numBytes) = 0;
+
+  /**
+   * @brief Sets the allocator that newly constructed EbsdDataArray instances will use. Pass nullptr to go back to
+   * new[]/delete[].
+   * @param allocator
+   */
+  static void SetDefault(const Pointer& allocator);
+
+  /**
+   * @brief Returns the allocator that newly constructed EbsdDataArray instances will use. Can be nullptr.
+   */
+  static Pointer GetDefault();
+
+protected:
+  ArrayAllocator();
+
+public:
+  ArrayAllocator(const ArrayAllocator&) = delete;            // Copy Constructor Not Implemented
+  ArrayAllocator(ArrayAllocator&&) = delete;                 // Move Constructor Not Implemented
+  ArrayAllocator& operator=(const ArrayAllocator&) = delete; // Copy Assignment Not Implemented
+  ArrayAllocator& operator=(ArrayAllocator&&) = delete;      // Move Assignment Not Implemented
+};
+
+/**
+ * @class PooledArrayAllocator ArrayAllocator.h EbsdLib/Core/ArrayAllocator.h
+ * @brief The PooledArrayAllocator class keeps released blocks in free lists keyed by their (rounded) size and hands
+ * them back out on the next request of the same size. Code that repeatedly creates and discards same sized arrays,
+ * such as pole figure generation, then reuses memory whose pages are already mapped instead of paying for fresh
+ * page faults on every call.
+ *
+ * Blocks are 64 byte aligned. When huge pages are requested, blocks of at least 2 MiB are aligned to 2 MiB and, on
+ * Linux, marked as eligible for transparent huge pages. The allocator is thread safe.
+ */
+class EbsdLib_EXPORT PooledArrayAllocator : public ArrayAllocator
+{
+public:
+  using Self = PooledArrayAllocator;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  /**
+   * @brief Returns the name of the class for PooledArrayAllocator
+   */
+  std::string getNameOfClass() const override;
+  /**
+   * @brief Returns the name of the class for PooledArrayAllocator
+   */
+  static std::string ClassName();
+
+  /**
+   * @brief Creates a new pool
+   * @param maxCachedBytes The maximum number of bytes the pool keeps in its free lists. Blocks released beyond that
+   * are returned to the system.
+   * @param useHugePages Back large blocks with huge pages where the platform supports it
+   */
+  static Pointer New(size_t maxCachedBytes = k_DefaultMaxCachedBytes, bool useHugePages = false);
+
+  ~PooledArrayAllocator() override;
+
+  static const size_t k_DefaultMaxCachedBytes = 512ULL * 1024ULL * 1024ULL;
+
+  void* allocate(size_t numBytes) override;
+  void deallocate(void* ptr, size_t numBytes) override;
+
+  /**
+   * @brief Returns every cached block to the system. Blocks that are currently in use are not affected.
+   */
+  void releaseCachedMemory();
+
+  /**
+   * @brief Returns the number of bytes currently held in the free lists
+   */
+  size_t getCachedBytes() const;
+
+  /**
+   * @brief Returns the number of allocations that were satisfied from the free lists
+   */
+  size_t getReuseCount() const;
+
+  /**
+   * @brief Returns the number of allocations that had to go to the system
+   */
+  size_t getSystemAllocationCount() const;
+
+protected:
+  PooledArrayAllocator(size_t maxCachedBytes, bool useHugePages);
+
+  /**
+   * @brief Returns the size of the block that is actually allocated for a request of numBytes
+   */
+  size_t blockSize(size_t numBytes) const;
+
+  void* systemAllocate(size_t blockBytes) const;
+  void systemDeallocate(void* ptr, size_t blockBytes) const;
+
+private:
+  size_t m_MaxCachedBytes = k_DefaultMaxCachedBytes;
+  bool m_UseHugePages = false;
+  mutable std::mutex m_Mutex;
+  std::map<size_t, std::vector<void*>> m_FreeBlocks;
+  size_t m_CachedBytes = 0;
+  size_t m_ReuseCount = 0;
+  size_t m_SystemAllocationCount = 0;
+
+public:
+  PooledArrayAllocator(const PooledArrayAllocator&) = delete;            // Copy Constructor Not Implemented
+  PooledArrayAllocator(PooledArrayAllocator&&) = delete;                 // Move Constructor Not Implemented
+  PooledArrayAllocator& operator=(const PooledArrayAllocator&) = delete; // Copy Assignment Not Implemented
+  PooledArrayAllocator& operator=(PooledArrayAllocator&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace EbsdLib
@@ -0,0 +1,327 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @class EbsdArrayView EbsdArrayView.hpp EbsdLib/Core/EbsdArrayView.hpp
+ * @brief A lightweight, non-owning view over tuples of data that lives somewhere else. Value (tuple, component) of
+ * the view is found at
+ * @code
+ *   data[tuple * tupleStride + component * componentStride]
+ * @endcode
+ * which covers a regular interleaved EbsdDataArray, a range of its tuples, a subset of its components (e.g. the 3
+ * Euler angles out of a wider row) and column major data. A view can also be "planar", where each component has its
+ * own base pointer, so that separate per column arrays (the way the EBSD readers store their data) can be used as a
+ * single multi-component input without interleaving them first.
+ *
+ * Views are cheap to copy and pass by value. The caller is responsible for keeping the viewed memory alive.
+ */
+template <typename T>
+class EbsdArrayView
+{
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using NonConstType = std::remove_const_t<T>;
+
+  /**
+   * @brief The maximum number of components of a planar view
+   */
+  static const size_t k_MaxPlanarComponents = 9;
+
+  EbsdArrayView() = default;
+  ~EbsdArrayView() = default;
+
+  EbsdArrayView(const EbsdArrayView&) = default;
+  EbsdArrayView(EbsdArrayView&&) noexcept = default;
+  EbsdArrayView& operator=(const EbsdArrayView&) = default;
+  EbsdArrayView& operator=(EbsdArrayView&&) noexcept = default;
+
+  /**
+   * @brief Creates a view over densely packed, interleaved tuples
+   * @param data Pointer to the first value
+   * @param numTuples The number of tuples
+   * @param numComponents The number of components in each tuple
+   */
+  EbsdArrayView(T* data, size_t numTuples, size_t numComponents)
+  : EbsdArrayView(data, numTuples, numComponents, numComponents, 1)
+  {
+  }
+
+  /**
+   * @brief Creates a strided view
+   * @param data Pointer to component 0 of tuple 0
+   * @param numTuples The number of tuples
+   * @param numComponents The number of components in each tuple
+   * @param tupleStride The distance, in values, between consecutive tuples
+   * @param componentStride The distance, in values, between consecutive components of a tuple
+   */
+  EbsdArrayView(T* data, size_t numTuples, size_t numComponents, size_t tupleStride, size_t componentStride)
+  : m_Data(data)
+  , m_NumTuples(numTuples)
+  , m_NumComponents(numComponents)
+  , m_TupleStride(tupleStride)
+  , m_ComponentStride(componentStride)
+  {
+  }
+
+  /**
+   * @brief Allows a view of T to be used where a view of const T is expected
+   */
+  template <typename U, class = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+  EbsdArrayView(const EbsdArrayView<U>& other)
+  : m_Data(other.m_Data)
+  , m_NumTuples(other.m_NumTuples)
+  , m_NumComponents(other.m_NumComponents)
+  , m_TupleStride(other.m_TupleStride)
+  , m_ComponentStride(other.m_ComponentStride)
+  , m_Planar(other.m_Planar)
+  {
+    for(size_t c = 0; c < k_MaxPlanarComponents; c++)
+    {
+      m_Planes[c] = other.m_Planes[c];
+    }
+  }
+
+  /**
+   * @brief Creates a view over every tuple of an EbsdDataArray (or any array type with the same tuple interface)
+   */
+  template <class ArrayType>
+  static EbsdArrayView FromArray(ArrayType& array)
+  {
+    return EbsdArrayView(array.getPointer(0), array.getNumberOfTuples(), static_cast<size_t>(array.getNumberOfComponents()));
+  }
+
+  /**
+   * @brief Creates a planar view where each component is stored in its own array
+   * @param components The base pointer of each component
+   * @param numTuples The number of tuples
+   * @param tupleStride The distance, in values, between consecutive tuples within each component array
+   */
+  static EbsdArrayView FromComponents(std::initializer_list<T*> components, size_t numTuples, size_t tupleStride = 1)
+  {
+    if(components.size() == 0 || components.size() > k_MaxPlanarComponents)
+    {
+      throw std::out_of_range("EbsdArrayView::FromComponents supports between 1 and 9 components");
+    }
+    EbsdArrayView view;
+    view.m_Planar = true;
+    view.m_NumTuples = numTuples;
+    view.m_NumComponents = components.size();
+    view.m_TupleStride = tupleStride;
+    view.m_ComponentStride = 0;
+    size_t c = 0;
+    for(T* ptr : components)
+    {
+      view.m_Planes[c++] = ptr;
+    }
+    view.m_Data = view.m_Planes[0];
+    return view;
+  }
+
+  size_t getNumberOfTuples() const
+  {
+    return m_NumTuples;
+  }
+
+  size_t getNumberOfComponents() const
+  {
+    return m_NumComponents;
+  }
+
+  size_t getTupleStride() const
+  {
+    return m_TupleStride;
+  }
+
+  size_t getComponentStride() const
+  {
+    return m_ComponentStride;
+  }
+
+  bool empty() const
+  {
+    return m_NumTuples == 0;
+  }
+
+  bool isPlanar() const
+  {
+    return m_Planar;
+  }
+
+  /**
+   * @brief Returns true if the components of each tuple are adjacent in memory, which means getTuplePointer() can
+   * be used.
+   */
+  bool isComponentContiguous() const
+  {
+    return !m_Planar && (m_ComponentStride == 1 || m_NumComponents == 1);
+  }
+
+  /**
+   * @brief Returns true if the view covers a densely packed, interleaved block of memory
+   */
+  bool isContiguous() const
+  {
+    return isComponentContiguous() && (m_TupleStride == m_NumComponents || m_NumTuples <= 1);
+  }
+
+  /**
+   * @brief Returns the pointer to component 0 of tuple 0. For planar views this is the first component array.
+   */
+  T* data() const
+  {
+    return m_Data;
+  }
+
+  /**
+   * @brief Returns the pointer to the first component of a tuple. Only valid if isComponentContiguous() is true.
+   */
+  T* getTuplePointer(size_t tuple) const
+  {
+    return m_Data + tuple * m_TupleStride;
+  }
+
+  T& operator()(size_t tuple, size_t component) const
+  {
+    if(m_Planar)
+    {
+      return m_Planes[component][tuple * m_TupleStride];
+    }
+    return m_Data[tuple * m_TupleStride + component * m_ComponentStride];
+  }
+
+  /**
+   * @brief Copies the components of a tuple into out, converting them to type U
+   */
+  template <typename U>
+  void getTuple(size_t tuple, U* out) const
+  {
+    for(size_t c = 0; c < m_NumComponents; c++)
+    {
+      out[c] = static_cast<U>((*this)(tuple, c));
+    }
+  }
+
+  /**
+   * @brief Copies the values in values into the components of a tuple
+   */
+  template <typename U>
+  void setTuple(size_t tuple, const U* values) const
+  {
+    for(size_t c = 0; c < m_NumComponents; c++)
+    {
+      (*this)(tuple, c) = static_cast<NonConstType>(values[c]);
+    }
+  }
+
+  /**
+   * @brief Returns a view of numTuples tuples starting at startTuple
+   */
+  EbsdArrayView subView(size_t startTuple, size_t numTuples) const
+  {
+    if(startTuple > m_NumTuples || numTuples > m_NumTuples - startTuple)
+    {
+      throw std::out_of_range("EbsdArrayView::subView range is outside of the view");
+    }
+    EbsdArrayView view(*this);
+    view.m_NumTuples = numTuples;
+    if(m_Planar)
+    {
+      for(size_t c = 0; c < m_NumComponents; c++)
+      {
+        view.m_Planes[c] = m_Planes[c] + startTuple * m_TupleStride;
+      }
+      view.m_Data = view.m_Planes[0];
+    }
+    else
+    {
+      view.m_Data = m_Data + startTuple * m_TupleStride;
+    }
+    return view;
+  }
+
+  /**
+   * @brief Returns a view of numComponents components starting at firstComponent of every tuple
+   */
+  EbsdArrayView componentView(size_t firstComponent, size_t numComponents) const
+  {
+    if(firstComponent > m_NumComponents || numComponents > m_NumComponents - firstComponent)
+    {
+      throw std::out_of_range("EbsdArrayView::componentView range is outside of the view");
+    }
+    EbsdArrayView view(*this);
+    view.m_NumComponents = numComponents;
+    if(m_Planar)
+    {
+      for(size_t c = 0; c < k_MaxPlanarComponents; c++)
+      {
+        view.m_Planes[c] = (c < numComponents) ? m_Planes[firstComponent + c] : nullptr;
+      }
+      view.m_Data = view.m_Planes[0];
+    }
+    else
+    {
+      view.m_Data = m_Data + firstComponent * m_ComponentStride;
+    }
+    return view;
+  }
+
+private:
+  template <typename U>
+  friend class EbsdArrayView;
+
+  T* m_Data = nullptr;
+  size_t m_NumTuples = 0;
+  size_t m_NumComponents = 0;
+  size_t m_TupleStride = 0;
+  size_t m_ComponentStride = 1;
+  bool m_Planar = false;
+  std::array<T*, k_MaxPlanarComponents> m_Planes = {};
+};
+
+namespace EbsdLib
+{
+using FloatArrayView = EbsdArrayView<float>;
+using ConstFloatArrayView = EbsdArrayView<const float>;
+using DoubleArrayView = EbsdArrayView<double>;
+using ConstDoubleArrayView = EbsdArrayView<const double>;
+} // namespace EbsdLib
@@ -35,12 +35,14 @@
 
 #include "EbsdDataArray.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
 #include <string>
+#include <utility>
 
 #ifndef __has_builtin
 #define __has_builtin(x) 0
@@ -69,8 +71,117 @@
 
 #include "EbsdLib/Core/EbsdMacros.h"
 
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 namespace
 {
+// The number of tuples that are compacted together by eraseTuplesByMask when running in parallel. This bounds the
+// size of the scratch buffer.
+constexpr size_t k_CompactionWindowTuples = 1048576;
+// The number of tuples each task counts and gathers within a compaction window
+constexpr size_t k_CompactionBlockTuples = 16384;
+
+/**
+ * @brief Counts the tuples of each block of a compaction window that are not flagged for removal
+ */
+class CountSurvivingTuplesImpl
+{
+public:
+  CountSurvivingTuplesImpl(const std::vector<bool>& eraseMask, size_t windowStart, size_t windowEnd, size_t* blockCounts)
+  : m_EraseMask(eraseMask)
+  , m_WindowStart(windowStart)
+  , m_WindowEnd(windowEnd)
+  , m_BlockCounts(blockCounts)
+  {
+  }
+
+  void generate(size_t startBlock, size_t endBlock) const
+  {
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      size_t start = m_WindowStart + block * k_CompactionBlockTuples;
+      size_t end = std::min(start + k_CompactionBlockTuples, m_WindowEnd);
+      size_t count = 0;
+      for(size_t i = start; i < end; i++)
+      {
+        count += m_EraseMask[i] ? 0 : 1;
+      }
+      m_BlockCounts[block] = count;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<bool>& m_EraseMask;
+  size_t m_WindowStart = 0;
+  size_t m_WindowEnd = 0;
+  size_t* m_BlockCounts = nullptr;
+};
+
+/**
+ * @brief Copies the surviving tuples of each block of a compaction window to the offset given by the prefix sum of
+ * the block counts
+ */
+template <typename T>
+class GatherSurvivingTuplesImpl
+{
+public:
+  GatherSurvivingTuplesImpl(const T* source, T* destination, size_t numComponents, const std::vector<bool>& eraseMask, size_t windowStart, size_t windowEnd, const size_t* blockOffsets)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_NumComponents(numComponents)
+  , m_EraseMask(eraseMask)
+  , m_WindowStart(windowStart)
+  , m_WindowEnd(windowEnd)
+  , m_BlockOffsets(blockOffsets)
+  {
+  }
+
+  void generate(size_t startBlock, size_t endBlock) const
+  {
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      size_t start = m_WindowStart + block * k_CompactionBlockTuples;
+      size_t end = std::min(start + k_CompactionBlockTuples, m_WindowEnd);
+      T* dest = m_Destination + m_BlockOffsets[block] * m_NumComponents;
+      for(size_t i = start; i < end; i++)
+      {
+        if(!m_EraseMask[i])
+        {
+          std::copy(m_Source + i * m_NumComponents, m_Source + (i + 1) * m_NumComponents, dest);
+          dest += m_NumComponents;
+        }
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const T* m_Source = nullptr;
+  T* m_Destination = nullptr;
+  size_t m_NumComponents = 0;
+  const std::vector<bool>& m_EraseMask;
+  size_t m_WindowStart = 0;
+  size_t m_WindowEnd = 0;
+  const size_t* m_BlockOffsets = nullptr;
+};
+
 // Can be replaced with std::bit_cast in C++ 20
 
 template <class To, class From, class = std::enable_if_t<(sizeof(To) == sizeof(From)) && std::is_trivially_copyable<From>::value && std::is_trivial<To>::value>>
@@ -216,6 +327,56 @@ EbsdDataArray<T>::~EbsdDataArray()
   clear();
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+EbsdDataArray<T>::EbsdDataArray(EbsdDataArray&& other) noexcept
+: m_Name(std::move(other.m_Name))
+, m_Array(std::exchange(other.m_Array, nullptr))
+, m_Size(std::exchange(other.m_Size, 0))
+, m_MaxId(std::exchange(other.m_MaxId, 0))
+, m_NumTuples(std::exchange(other.m_NumTuples, 0))
+, m_NumComponents(other.m_NumComponents)
+, m_InitValue(other.m_InitValue)
+, m_CompDims(std::move(other.m_CompDims))
+, m_IsAllocated(std::exchange(other.m_IsAllocated, false))
+, m_OwnsData(std::exchange(other.m_OwnsData, true))
+, m_InitializeOnAllocate(other.m_InitializeOnAllocate)
+, m_Allocator(other.m_Allocator)
+, m_BufferAllocator(std::move(other.m_BufferAllocator))
+, m_BufferSize(std::exchange(other.m_BufferSize, 0))
+{
+  other.m_BufferAllocator = nullptr;
+  other.m_CompDims = {other.m_NumComponents};
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+EbsdDataArray<T>& EbsdDataArray<T>::operator=(EbsdDataArray&& other) noexcept
+{
+  if(this == &other)
+  {
+    return *this;
+  }
+  clear();
+  m_Name = std::move(other.m_Name);
+  m_Array = std::exchange(other.m_Array, nullptr);
+  m_Size = std::exchange(other.m_Size, 0);
+  m_MaxId = std::exchange(other.m_MaxId, 0);
+  m_NumTuples = std::exchange(other.m_NumTuples, 0);
+  m_NumComponents = other.m_NumComponents;
+  m_InitValue = other.m_InitValue;
+  m_CompDims = std::move(other.m_CompDims);
+  m_IsAllocated = std::exchange(other.m_IsAllocated, false);
+  m_OwnsData = std::exchange(other.m_OwnsData, true);
+  m_InitializeOnAllocate = other.m_InitializeOnAllocate;
+  m_Allocator = other.m_Allocator;
+  m_BufferAllocator = std::move(other.m_BufferAllocator);
+  m_BufferSize = std::exchange(other.m_BufferSize, 0);
+  other.m_BufferAllocator = nullptr;
+  other.m_CompDims = {other.m_NumComponents};
+  return *this;
+}
+
 template <typename T>
 typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(size_t numTuples, const std::string& name, bool allocate)
 {
@@ -225,7 +386,8 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(size_t numTuple
   }
   comp_dims_type cDims = {1};
   auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, cDims, static_cast<T>(0), allocate);
-  if(allocate)
+  // The constructor has already allocated the memory unless that failed
+  if(allocate && !d->isAllocated())
   {
     if(d->allocate() < 0)
     {
@@ -247,7 +409,8 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(size_t numTuple
   comp_dims_type cDims(static_cast<size_t>(rank));
   std::copy(dims, dims + rank, cDims.begin());
   auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, cDims, static_cast<T>(0), allocate);
-  if(allocate)
+  // The constructor has already allocated the memory unless that failed
+  if(allocate && !d->isAllocated())
   {
     if(d->allocate() < 0)
     {
@@ -267,7 +430,8 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(size_t numTuple
     return nullptr;
   }
   auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), allocate);
-  if(allocate)
+  // The constructor has already allocated the memory unless that failed
+  if(allocate && !d->isAllocated())
   {
     if(d->allocate() < 0)
     {
@@ -290,7 +454,8 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(const comp_dims
   size_t numTuples = std::accumulate(tupleDims.cbegin(), tupleDims.cend(), static_cast<size_t>(1), std::multiplies<>());
 
   auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), allocate);
-  if(allocate)
+  // The constructor has already allocated the memory unless that failed
+  if(allocate && !d->isAllocated())
   {
     if(d->allocate() < 0)
     {
@@ -301,6 +466,24 @@ typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateArray(const comp_dims
   return d;
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::CreateUninitializedArray(size_t numTuples, const comp_dims_type& compDims, const std::string& name)
+{
+  if(name.empty())
+  {
+    return nullptr;
+  }
+  auto d = std::make_shared<EbsdDataArray<T>>(numTuples, name, compDims, static_cast<T>(0), false);
+  d->setInitializeOnAllocate(false);
+  if(d->allocate() < 0)
+  {
+    // Could not allocate enough memory, reset the pointer to null and return
+    return nullptr;
+  }
+  return d;
+}
+
 template <typename T>
 typename EbsdDataArray<T>::Pointer EbsdDataArray<T>::createNewArray(size_t numTuples, int rank, const size_t* compDims, const std::string& name, bool allocate) const
 {
@@ -607,6 +790,34 @@ void EbsdDataArray<T>::setInitValue(T initValue)
   m_InitValue = initValue;
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::setAllocator(const EbsdLib::ArrayAllocator::Pointer& allocator)
+{
+  m_Allocator = allocator;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+EbsdLib::ArrayAllocator::Pointer EbsdDataArray<T>::getAllocator() const
+{
+  return m_Allocator;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::setInitializeOnAllocate(bool value)
+{
+  m_InitializeOnAllocate = value;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool EbsdDataArray<T>::getInitializeOnAllocate() const
+{
+  return m_InitializeOnAllocate;
+}
+
 // -----------------------------------------------------------------------------
 template <typename T>
 void EbsdDataArray<T>::takeOwnership()
@@ -639,14 +850,13 @@ int32_t EbsdDataArray<T>::allocate()
   }
 
   size_t newSize = m_Size;
-  m_Array = new(std::nothrow) T[newSize]();
-  if(!m_Array)
+  T* newArray = allocateBuffer(newSize, m_InitializeOnAllocate);
+  if(nullptr == newArray)
   {
     std::cout << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
     return -1;
   }
-  m_Size = newSize;
-  m_IsAllocated = true;
+  adoptBuffer(newArray, newSize);
 
   return 1;
 }
@@ -701,16 +911,9 @@ int32_t EbsdDataArray<T>::eraseTuples(const comp_dims_type& idxs)
     }
   }
 
-  // Calculate the new size of the array to copy into
-  size_t newSize = (getNumberOfTuples() - idxs.size()) * m_NumComponents;
-
-  // Create a new m_Array to copy into
-  T* newArray = new T[newSize]();
-
-#ifndef NDEBUG
-  // Splat AB across the array so we know if we are copying the values or not
-  std::memset(newArray, 0xAB, newSize * sizeof(T));
-#endif
+  // The surviving tuples are moved towards the front of the current m_Array. Every destination is at or before
+  // its source so the copies never overwrite values that still need to be moved.
+  size_t newNumTuples = getNumberOfTuples() - idxs.size();
 
   size_t j = 0;
   size_t k = 0;
@@ -733,14 +936,8 @@ int32_t EbsdDataArray<T>::eraseTuples(const comp_dims_type& idxs)
   {
     auto srcBegin = begin() + (j * m_NumComponents);
     auto srcEnd = srcBegin + (getNumberOfTuples() - idxs.size()) * m_NumComponents;
-    std::copy(srcBegin, srcEnd, newArray);
-    // We are done copying - delete the current m_Array
-    deallocate();
-    m_Size = newSize;
-    m_Array = newArray;
-    m_OwnsData = true;
-    m_MaxId = newSize - 1;
-    m_IsAllocated = true;
+    std::copy(srcBegin, srcEnd, begin());
+    truncateTuples(newNumTuples);
     return 0;
   }
 
@@ -771,22 +968,91 @@ int32_t EbsdDataArray<T>::eraseTuples(const comp_dims_type& idxs)
   {
     auto srcBegin = begin() + srcIdx[i];
     auto srcEnd = srcBegin + copyElements[i];
-    auto dstBegin = newArray + destIdx[i];
+    auto dstBegin = begin() + destIdx[i];
     std::copy(srcBegin, srcEnd, dstBegin);
   }
+  truncateTuples(newNumTuples);
 
-  // We are done copying - delete the current m_Array
-  deallocate();
+  return err;
+}
 
-  // Allocation was successful.  Save it.
-  m_Size = newSize;
-  m_Array = newArray;
-  // This object has now allocated its memory and owns it.
-  m_OwnsData = true;
-  m_IsAllocated = true;
-  m_MaxId = newSize - 1;
+// -----------------------------------------------------------------------------
+template <typename T>
+int32_t EbsdDataArray<T>::eraseTuplesByMask(const std::vector<bool>& eraseMask)
+{
+  const size_t numTuples = getNumberOfTuples();
+  if(eraseMask.size() != numTuples)
+  {
+    return -100;
+  }
+  if(numTuples == 0)
+  {
+    return 0;
+  }
 
-  return err;
+  // Nothing moves until the first removed tuple
+  size_t firstErased = 0;
+  while(firstErased < numTuples && !eraseMask[firstErased])
+  {
+    firstErased++;
+  }
+  if(firstErased == numTuples)
+  {
+    return 0;
+  }
+
+  size_t numKept = firstErased;
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  if(numTuples - firstErased > k_CompactionBlockTuples)
+  {
+    // Each window is gathered into a scratch buffer and then copied down to the end of the already compacted tuples.
+    // Everything that copy overwrites has already been read so the windows can be processed one after another.
+    const size_t windowSize = std::min(k_CompactionWindowTuples, numTuples - firstErased);
+    std::unique_ptr<T[]> scratch(new T[windowSize * m_NumComponents]);
+    std::vector<size_t> blockOffsets((windowSize + k_CompactionBlockTuples - 1) / k_CompactionBlockTuples);
+    for(size_t windowStart = firstErased; windowStart < numTuples; windowStart += windowSize)
+    {
+      size_t windowEnd = std::min(windowStart + windowSize, numTuples);
+      size_t numBlocks = (windowEnd - windowStart + k_CompactionBlockTuples - 1) / k_CompactionBlockTuples;
+
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), CountSurvivingTuplesImpl(eraseMask, windowStart, windowEnd, blockOffsets.data()), tbb::auto_partitioner());
+      size_t windowKept = 0;
+      for(size_t block = 0; block < numBlocks; block++)
+      {
+        size_t count = blockOffsets[block];
+        blockOffsets[block] = windowKept;
+        windowKept += count;
+      }
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks),
+                        GatherSurvivingTuplesImpl<T>(m_Array, scratch.get(), m_NumComponents, eraseMask, windowStart, windowEnd, blockOffsets.data()), tbb::auto_partitioner());
+
+      std::copy(scratch.get(), scratch.get() + windowKept * m_NumComponents, m_Array + numKept * m_NumComponents);
+      numKept += windowKept;
+    }
+  }
+  else
+#endif
+  {
+    for(size_t i = firstErased + 1; i < numTuples; i++)
+    {
+      if(!eraseMask[i])
+      {
+        std::copy(m_Array + i * m_NumComponents, m_Array + (i + 1) * m_NumComponents, m_Array + numKept * m_NumComponents);
+        numKept++;
+      }
+    }
+  }
+
+  if(numKept == 0)
+  {
+    resizeTuples(0);
+  }
+  else
+  {
+    truncateTuples(numKept);
+  }
+  return 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -1387,6 +1653,8 @@ void EbsdDataArray<T>::clear()
     deallocate();
   }
   m_Array = nullptr;
+  m_BufferAllocator = nullptr;
+  m_BufferSize = 0;
   m_Size = 0;
   m_OwnsData = true;
   m_MaxId = 0;
@@ -1442,12 +1710,76 @@ void EbsdDataArray<T>::deallocate()
       }
 #endif
 
-  delete[](m_Array);
+  if(nullptr != m_BufferAllocator)
+  {
+    m_BufferAllocator->deallocate(m_Array, m_BufferSize * sizeof(T));
+  }
+  else
+  {
+    delete[](m_Array);
+  }
 
   m_Array = nullptr;
+  m_BufferAllocator = nullptr;
+  m_BufferSize = 0;
   m_IsAllocated = false;
 }
 
+// -----------------------------------------------------------------------------
+template <typename T>
+T* EbsdDataArray<T>::allocateBuffer(size_t numElements, bool initialize) const
+{
+  if(nullptr == m_Allocator)
+  {
+    return initialize ? new(std::nothrow) T[numElements]() : new(std::nothrow) T[numElements];
+  }
+  T* buffer = static_cast<T*>(m_Allocator->allocate(numElements * sizeof(T)));
+  if(nullptr != buffer && initialize)
+  {
+    std::fill_n(buffer, numElements, static_cast<T>(0));
+  }
+  return buffer;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::truncateTuples(size_t numTuples)
+{
+  m_NumTuples = numTuples;
+  m_Size = numTuples * m_NumComponents;
+  m_MaxId = (m_Size > 0) ? m_Size - 1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::adoptBuffer(T* buffer, size_t numElements)
+{
+  m_Array = buffer;
+  m_BufferAllocator = m_Allocator;
+  m_BufferSize = numElements;
+  m_Size = numElements;
+  m_MaxId = (numElements > 0) ? numElements - 1 : 0;
+  // This object has now allocated its memory and owns it.
+  m_OwnsData = true;
+  m_IsAllocated = true;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void EbsdDataArray<T>::detachFromAllocator()
+{
+  if(nullptr == m_Array || nullptr == m_BufferAllocator || !m_OwnsData)
+  {
+    return;
+  }
+  T* newArray = new T[m_Size];
+  std::copy(m_Array, m_Array + m_Size, newArray);
+  m_BufferAllocator->deallocate(m_Array, m_BufferSize * sizeof(T));
+  m_Array = newArray;
+  m_BufferAllocator = nullptr;
+  m_BufferSize = m_Size;
+}
+
 // -----------------------------------------------------------------------------
 template <typename T>
 int32_t EbsdDataArray<T>::resizeTotalElements(size_t size)
@@ -1489,7 +1821,8 @@ T* EbsdDataArray<T>::resizeAndExtend(size_t size)
     return m_Array;
   }
 
-  newArray = new(std::nothrow) T[newSize]();
+  // The old values are copied over and any new values are initialized below
+  newArray = allocateBuffer(newSize, false);
   if(!newArray)
   {
     std::cout << "Unable to allocate " << newSize << " elements of size " << sizeof(T) << " bytes. ";
@@ -1512,17 +1845,10 @@ T* EbsdDataArray<T>::resizeAndExtend(size_t size)
   }
 
   // Allocation was successful.  Save it.
-  m_Size = newSize;
-  m_Array = newArray;
-
-  // This object has now allocated its memory and owns it.
-  m_OwnsData = true;
-
-  m_MaxId = newSize - 1;
-  m_IsAllocated = true;
+  adoptBuffer(newArray, newSize);
 
   // Initialize the new tuples if newSize is larger than old size
-  if(newSize > oldSize)
+  if(newSize > oldSize && m_InitializeOnAllocate)
   {
     initializeWithValue(m_InitValue, oldSize);
   }
@@ -42,6 +42,7 @@
 #include <string>
 #include <vector>
 
+#include "EbsdLib/Core/ArrayAllocator.h"
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/EbsdLib.h"
 
@@ -78,9 +79,19 @@ public:
   int32_t getClassVersion() const;
 
   EbsdDataArray(const EbsdDataArray&) = default;           // Copy Constructor default Implemented
-  EbsdDataArray(EbsdDataArray&&) = delete;                 // Move Constructor Not Implemented
   EbsdDataArray& operator=(const EbsdDataArray&) = delete; // Copy Assignment Not Implemented
-  EbsdDataArray& operator=(EbsdDataArray&&) = delete;      // Move Assignment Not Implemented
+
+  /**
+   * @brief Move Constructor. The new array takes over the memory (and its allocator) of other, which is left as an
+   * empty, unallocated array. No element data is copied.
+   */
+  EbsdDataArray(EbsdDataArray&& other) noexcept;
+
+  /**
+   * @brief Move Assignment. Any memory currently held by this array is released before the contents of other are
+   * taken over. other is left as an empty, unallocated array.
+   */
+  EbsdDataArray& operator=(EbsdDataArray&& other) noexcept;
 
   //========================================= STL INTERFACE COMPATIBILITY =================================
   using comp_dims_type = std::vector<size_t>;
@@ -168,6 +179,17 @@ public:
    */
   static Pointer CreateArray(const comp_dims_type& tupleDims, const comp_dims_type& compDims, const std::string& name, bool allocate);
 
+  /**
+   * @brief Static constructor for arrays whose every value is going to be overwritten by the caller. The memory is
+   * allocated but NOT initialized, which saves zeroing (and touching) every page up front. Tuples added by later
+   * resizes are not initialized either.
+   * @param numTuples The number of tuples in the array.
+   * @param compDims The actual dimensions of the attribute on each Tuple
+   * @param name The name of the array
+   * @return Std::Shared_Ptr wrapping an instance of EbsdDataArrayTemplate<T>
+   */
+  static Pointer CreateUninitializedArray(size_t numTuples, const comp_dims_type& compDims, const std::string& name);
+
   //========================================= Instance Constructing EbsdDataArray Objects =================================
   /**
    * @brief createNewArray Creates a new EbsdDataArray object using the same POD type as the existing instance
@@ -236,6 +258,8 @@ public:
   template <typename DataArrayType>
   std::shared_ptr<DataArrayType> moveToDataArrayType()
   {
+    // The receiving class frees the memory itself so it can not come from an ArrayAllocator
+    detachFromAllocator();
     std::shared_ptr<DataArrayType> output = DataArrayType::WrapPointer(data(), getNumberOfTuples(), getComponentDimensions(), getName().c_str(), true);
     releaseOwnership();
     return output;
@@ -324,6 +348,31 @@ public:
     return m_InitValue;
   }
 
+  /**
+   * @brief Sets the allocator used for every allocation of the internal array from now on. The current contents
+   * stay where they are until the next allocation. Pass nullptr to use new[]/delete[]. Newly constructed arrays start
+   * out with EbsdLib::ArrayAllocator::GetDefault().
+   * @param allocator
+   */
+  void setAllocator(const EbsdLib::ArrayAllocator::Pointer& allocator);
+
+  /**
+   * @brief Returns the allocator used for allocations of the internal array. Can be nullptr.
+   */
+  EbsdLib::ArrayAllocator::Pointer getAllocator() const;
+
+  /**
+   * @brief Sets whether newly allocated memory is filled with the init value. Turning this off is only safe when
+   * every value is written before it is read.
+   * @param value
+   */
+  void setInitializeOnAllocate(bool value);
+
+  /**
+   * @brief Returns whether newly allocated memory is filled with the init value.
+   */
+  bool getInitializeOnAllocate() const;
+
   /**
    * @brief Makes this class responsible for freeing the memory
    */
@@ -332,7 +381,8 @@ public:
   /**
    * @brief This class will NOT free the memory associated with the internal pointer.
    * This can be useful if the user wishes to keep the data around after this
-   * class goes out of scope.
+   * class goes out of scope. If the memory came from an ArrayAllocator it must be
+   * returned to that allocator.
    */
   void releaseOwnership();
 
@@ -356,12 +406,26 @@ public:
    * @brief Removes Tuples from the m_Array. If the size of the vector is Zero nothing is done. If the size of the
    * vector is greater than or Equal to the number of Tuples then the m_Array is Resized to Zero. If there are
    * indices that are larger than the size of the original (before erasing operations) then an error code (-100) is
-   * returned from the program.
+   * returned from the program. The indices must be sorted in increasing order. The remaining tuples are compacted in
+   * place and the memory of the removed tuples stays with the array until it is resized or cleared.
    * @param idxs The indices to remove
    * @return error code.
    */
   int32_t eraseTuples(const comp_dims_type& idxs);
 
+  /**
+   * @brief Removes every tuple whose flag in eraseMask is true. The remaining tuples keep their order and are
+   * compacted in place so, unlike a reallocation, the peak memory use does not grow. The memory of the removed
+   * tuples stays with the array until it is resized or cleared.
+   *
+   * When parallel algorithms are enabled large arrays are compacted one bounded window of tuples at a time: the
+   * surviving tuples of each block are counted in parallel, a prefix sum of the counts gives each block its output
+   * offset, and the blocks are then gathered in parallel.
+   * @param eraseMask One flag per tuple, true for the tuples to remove
+   * @return error code. -100 if eraseMask does not have one flag per tuple
+   */
+  int32_t eraseTuplesByMask(const std::vector<bool>& eraseMask);
+
   /**
    * @brief
    * @param currentPos
@@ -1191,6 +1255,35 @@ protected:
    */
   T* resizeAndExtend(size_t size);
 
+  /**
+   * @brief Allocates a new buffer for numElements values using the current allocator. The buffer is not adopted
+   * by this instance, call adoptBuffer() for that.
+   * @param numElements
+   * @param initialize Fill the buffer with zeros
+   * @return The buffer or nullptr if the memory could not be allocated
+   */
+  T* allocateBuffer(size_t numElements, bool initialize) const;
+
+  /**
+   * @brief Makes a buffer returned by allocateBuffer() the internal array. Any existing array must already have
+   * been released.
+   * @param buffer
+   * @param numElements
+   */
+  void adoptBuffer(T* buffer, size_t numElements);
+
+  /**
+   * @brief Moves the contents of the internal array into a new[] allocated buffer if the current one came from an
+   * ArrayAllocator.
+   */
+  void detachFromAllocator();
+
+  /**
+   * @brief Shrinks the array to its first numTuples tuples without reallocating the memory
+   * @param numTuples
+   */
+  void truncateTuples(size_t numTuples);
+
 private:
   std::string m_Name = {};
   T* m_Array = nullptr;
@@ -1202,6 +1295,10 @@ private:
   comp_dims_type m_CompDims = {1};
   bool m_IsAllocated = false;
   bool m_OwnsData = true;
+  bool m_InitializeOnAllocate = true;
+  EbsdLib::ArrayAllocator::Pointer m_Allocator = EbsdLib::ArrayAllocator::GetDefault();
+  EbsdLib::ArrayAllocator::Pointer m_BufferAllocator = nullptr;
+  size_t m_BufferSize = 0;
 };
 
 // -----------------------------------------------------------------------------
@@ -61,6 +61,33 @@ enum InfoStringFormat
   UnknownFormat
 };
 
+/**
+ * @brief Floating point type that the batch orientation kernels compute in. Double gives results identical to the
+ * single orientation API. Single keeps float input data in float from end to end. This halves the memory traffic and
+ * the register footprint of each orientation, and it stays within the error bounds in SinglePrecisionBounds.
+ */
+enum class ComputePrecision : int32_t
+{
+  Double = 0,
+  Single = 1
+};
+
+/**
+ * @brief Maximum errors of ComputePrecision::Single relative to ComputePrecision::Double for inputs that are already
+ * float. The unit tests validate these bounds.
+ */
+namespace SinglePrecisionBounds
+{
+// Absolute error of any output component of a conversion from eu, qu, ax, ho or cu. Rodrigues vectors are unbounded near
+// 180 degrees, and orientation matrices rounded to float are not orthonormal enough to be used as input.
+inline constexpr double k_OrientationTransform = 2.0E-3;
+// Misorientation angle in radians
+inline constexpr double k_MisorientationAngle = 1.0E-5;
+// IPF color channel levels out of 255, and the fraction of points allowed to exceed that because they sit on an edge of the unit triangle
+inline constexpr int32_t k_IPFColorChannel = 2;
+inline constexpr double k_IPFColorOutlierFraction = 1.0E-3;
+} // namespace SinglePrecisionBounds
+
 namespace StringConstants
 {
 inline const std::string Statistics("Statistics");
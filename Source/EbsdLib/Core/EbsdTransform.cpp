@@ -35,6 +35,92 @@
 
 #include "EbsdTransform.h"
 
+#include <cmath>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "EbsdLib/Core/FusedOrientationTransformation.hpp"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/EbsdMatrixMath.h"
+
+namespace Detail
+{
+/**
+ * @brief The TransformEulerAnglesImpl class rotates the reference frame of a range of Euler angles with a
+ * precomputed rotation matrix, gathering the input through an optional index map
+ */
+class TransformEulerAnglesImpl
+{
+public:
+  TransformEulerAnglesImpl(const float* inPhi1, const float* inPhi, const float* inPhi2, float* outPhi1, float* outPhi, float* outPhi2, double rotation[3][3], bool degrees, const size_t* sourceIndex)
+  : m_InPhi1(inPhi1)
+  , m_InPhi(inPhi)
+  , m_InPhi2(inPhi2)
+  , m_OutPhi1(outPhi1)
+  , m_OutPhi(outPhi)
+  , m_OutPhi2(outPhi2)
+  , m_Degrees(degrees)
+  , m_SourceIndex(sourceIndex)
+  {
+    for(size_t r = 0; r < 3; r++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        m_Rotation[r][c] = rotation[r][c];
+      }
+    }
+  }
+  virtual ~TransformEulerAnglesImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    namespace Fused = OrientationTransformation::Fused;
+    const double toRadians = m_Degrees ? EbsdLib::Constants::k_DegToRadD : 1.0;
+    const double fromRadians = m_Degrees ? EbsdLib::Constants::k_RadToDegD : 1.0;
+    double eu[3];
+    double g[3][3];
+    double gNew[3][3];
+    for(size_t i = start; i < end; i++)
+    {
+      const size_t source = (m_SourceIndex == nullptr) ? i : m_SourceIndex[i];
+      eu[0] = m_InPhi1[source] * toRadians;
+      eu[1] = m_InPhi[source] * toRadians;
+      eu[2] = m_InPhi2[source] * toRadians;
+      Fused::Convert<Fused::RepType::Euler, Fused::RepType::OrientationMatrix>(eu, &g[0][0]);
+      EbsdMatrixMath::Multiply3x3with3x3(g, m_Rotation, gNew);
+      Fused::Convert<Fused::RepType::OrientationMatrix, Fused::RepType::Euler>(&gNew[0][0], eu);
+      m_OutPhi1[i] = static_cast<float>(eu[0] * fromRadians);
+      m_OutPhi[i] = static_cast<float>(eu[1] * fromRadians);
+      m_OutPhi2[i] = static_cast<float>(eu[2] * fromRadians);
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_InPhi1;
+  const float* m_InPhi;
+  const float* m_InPhi2;
+  float* m_OutPhi1;
+  float* m_OutPhi;
+  float* m_OutPhi2;
+  // Not const so it can be handed to EbsdMatrixMath
+  mutable double m_Rotation[3][3];
+  bool m_Degrees;
+  const size_t* m_SourceIndex;
+};
+} // namespace Detail
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -75,6 +161,110 @@ EbsdLib::EbsdToSampleCoordinateMapping EbsdTransform::IdentifyStandardTransforma
   return EbsdLib::UnknownCoordinateMapping;
 }
 
+// -----------------------------------------------------------------------------
+bool EbsdTransform::SampleTransformationPermutation(float angle, const std::array<float, 3>& axis, size_t xDim, size_t yDim, std::vector<size_t>& sourceIndex, bool& flipsZ)
+{
+  sourceIndex.clear();
+  flipsZ = false;
+  const float turns = std::fmod(std::fabs(angle), 360.0f);
+  if(turns < 1.0E-3f || turns > 360.0f - 1.0E-3f)
+  {
+    return true;
+  }
+  if(std::fabs(turns - 180.0f) > 1.0E-3f)
+  {
+    return false;
+  }
+
+  // Find the principal axis the rotation is about
+  const float length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+  int principalAxis = -1;
+  for(int a = 0; a < 3; a++)
+  {
+    if(length > 0.0f && std::fabs(std::fabs(axis[a]) / length - 1.0f) < 1.0E-4f)
+    {
+      principalAxis = a;
+    }
+  }
+  if(principalAxis < 0)
+  {
+    return false;
+  }
+
+  // A 180 degree rotation negates the two coordinates that are not on the axis. Each flip is its own inverse so the
+  // forward map is also the source map.
+  const bool flipX = (principalAxis != 0);
+  const bool flipY = (principalAxis != 1);
+  flipsZ = (principalAxis != 2);
+  sourceIndex.resize(xDim * yDim);
+  for(size_t y = 0; y < yDim; y++)
+  {
+    const size_t sourceY = flipY ? (yDim - 1 - y) : y;
+    for(size_t x = 0; x < xDim; x++)
+    {
+      const size_t sourceX = flipX ? (xDim - 1 - x) : x;
+      sourceIndex[y * xDim + x] = sourceY * xDim + sourceX;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool EbsdTransform::SlicePlacementIndex(float angle, const std::array<float, 3>& axis, size_t xSlice, size_t ySlice, size_t xVolume, size_t yVolume, std::vector<size_t>& destIndex, bool& flipsZ)
+{
+  destIndex.clear();
+  std::vector<size_t> volumeIndex;
+  if(xSlice > xVolume || ySlice > yVolume || !SampleTransformationPermutation(angle, axis, xVolume, yVolume, volumeIndex, flipsZ))
+  {
+    return false;
+  }
+
+  // Each flip is its own inverse, so the source map of the volume plane is also its destination map
+  const size_t xStart = (xVolume - xSlice) / 2;
+  const size_t yStart = (yVolume - ySlice) / 2;
+  destIndex.resize(xSlice * ySlice);
+  for(size_t y = 0; y < ySlice; y++)
+  {
+    for(size_t x = 0; x < xSlice; x++)
+    {
+      const size_t placed = (y + yStart) * xVolume + (x + xStart);
+      destIndex[y * xSlice + x] = volumeIndex.empty() ? placed : volumeIndex[placed];
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void EbsdTransform::TransformEulerAngles(const float* inPhi1, const float* inPhi, const float* inPhi2, float* outPhi1, float* outPhi, float* outPhi2, size_t numPoints, float angle,
+                                         const std::array<float, 3>& axis, bool degrees, const size_t* sourceIndex)
+{
+  if(numPoints == 0)
+  {
+    return;
+  }
+  double rotation[3][3];
+  OrientationD axisAngle(axis[0], axis[1], axis[2], angle * EbsdLib::Constants::k_DegToRadD);
+  double length = std::sqrt(axisAngle[0] * axisAngle[0] + axisAngle[1] * axisAngle[1] + axisAngle[2] * axisAngle[2]);
+  if(length > 0.0)
+  {
+    axisAngle[0] /= length;
+    axisAngle[1] /= length;
+    axisAngle[2] /= length;
+  }
+  else
+  {
+    axisAngle = OrientationD(0.0, 0.0, 1.0, 0.0);
+  }
+  OrientationTransformation::ax2om<OrientationD, OrientationD>(axisAngle).toGMatrix(rotation);
+
+  Detail::TransformEulerAnglesImpl impl(inPhi1, inPhi, inPhi2, outPhi1, outPhi, outPhi2, rotation, degrees, sourceIndex);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, numPoints);
+#endif
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -36,6 +36,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
@@ -76,6 +77,58 @@ public:
    */
   static EbsdLib::EbsdToSampleCoordinateMapping IdentifyStandardTransformation(const std::array<float, 4>& sampleTransformation, const std::array<float, 4>& eulerTransformation);
 
+  /**
+   * @brief SampleTransformationPermutation Builds the index map that applies a sample transformation to a single
+   * xDim x yDim slice. Only no rotation and 180 degree rotations about the X, Y or Z axis are supported. These are
+   * the flips used by the standard TSL and HKL transformations, and they only reorder the points.
+   * @param angle The rotation angle in degrees
+   * @param axis The rotation axis
+   * @param xDim The number of columns of the slice
+   * @param yDim The number of rows of the slice
+   * @param sourceIndex [output] Point i of the transformed slice takes its values from point sourceIndex[i]. Left
+   * empty when the transformation does not move any point.
+   * @param flipsZ [output] True if the rotation also reverses the stacking direction of a volume
+   * @return false if the transformation is not one of the supported flips
+   */
+  static bool SampleTransformationPermutation(float angle, const std::array<float, 3>& axis, size_t xDim, size_t yDim, std::vector<size_t>& sourceIndex, bool& flipsZ);
+
+  /**
+   * @brief SlicePlacementIndex Builds the index map that places a slice in the plane of a volume and applies a sample
+   * transformation to the whole volume. The slice is centered in the plane the way the h5ebsd volume readers center
+   * slices that are smaller than the volume, then the flip is done on the volume grid. Slices of different sizes
+   * therefore stay registered with each other, exactly as if the flip were applied to the assembled volume.
+   * @param angle The rotation angle in degrees
+   * @param axis The rotation axis
+   * @param xSlice The number of columns of the slice
+   * @param ySlice The number of rows of the slice
+   * @param xVolume The number of columns of the volume, at least xSlice
+   * @param yVolume The number of rows of the volume, at least ySlice
+   * @param destIndex [output] Point i of the slice goes to point destIndex[i] of the volume plane
+   * @param flipsZ [output] True if the rotation also reverses the stacking direction of the volume
+   * @return false if the transformation is not one of the flips supported by SampleTransformationPermutation() or
+   * the slice is larger than the volume
+   */
+  static bool SlicePlacementIndex(float angle, const std::array<float, 3>& axis, size_t xSlice, size_t ySlice, size_t xVolume, size_t yVolume, std::vector<size_t>& destIndex, bool& flipsZ);
+
+  /**
+   * @brief TransformEulerAngles Rotates the reference frame of a set of Euler angles in one pass. The orientation
+   * matrix of every point is post multiplied by the rotation matrix of (axis, angle), which is computed once. An
+   * optional index map is applied in the same pass.
+   * @param inPhi1 Input phi1 values
+   * @param inPhi Input Phi values
+   * @param inPhi2 Input phi2 values
+   * @param outPhi1 Output phi1 values. May be the same as inPhi1 when sourceIndex is nullptr.
+   * @param outPhi Output Phi values. May be the same as inPhi when sourceIndex is nullptr.
+   * @param outPhi2 Output phi2 values. May be the same as inPhi2 when sourceIndex is nullptr.
+   * @param numPoints The number of output points
+   * @param angle The rotation angle in degrees
+   * @param axis The rotation axis
+   * @param degrees True if the Euler angles are stored in degrees (HKL) instead of radians (TSL)
+   * @param sourceIndex Optional. Output point i is computed from input point sourceIndex[i].
+   */
+  static void TransformEulerAngles(const float* inPhi1, const float* inPhi, const float* inPhi2, float* outPhi1, float* outPhi, float* outPhi2, size_t numPoints, float angle,
+                                   const std::array<float, 3>& axis, bool degrees, const size_t* sourceIndex = nullptr);
+
 public:
   EbsdTransform(const EbsdTransform&) = delete;            // Copy Constructor Not Implemented
   EbsdTransform(EbsdTransform&&) = delete;                 // Move Constructor Not Implemented
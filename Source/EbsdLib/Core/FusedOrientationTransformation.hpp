@@ -0,0 +1,326 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "EbsdLib/Core/OrientationRepresentation.h"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+
+namespace OrientationTransformation
+{
+/**
+ * @class LocalOrientation FusedOrientationTransformation.hpp EbsdLib/Core/FusedOrientationTransformation.hpp
+ * @brief Fixed capacity storage for a single orientation of up to 9 values. It satisfies the container interface
+ * that the conversion functions in OrientationTransformation use for their InputType and OutputType. When it is used
+ * for both, every intermediate representation of a multi step conversion (e.g. eu2cu = eu2ax -> ax2ho -> ho2cu) lives
+ * on the stack instead of in a freshly allocated Orientation, and the compiler is free to inline the whole chain into
+ * a single kernel that keeps the intermediates in registers.
+ */
+template <typename T>
+class LocalOrientation
+{
+public:
+  using value_type = T;
+  using size_type = size_t;
+
+  static const size_t k_Capacity = 9;
+
+  LocalOrientation() = default;
+
+  explicit LocalOrientation(size_t size, T init = static_cast<T>(0))
+  : m_Size(size)
+  {
+    for(size_t i = 0; i < m_Size; i++)
+    {
+      m_Values[i] = init;
+    }
+  }
+
+  /**
+   * @brief Copies size values from ptr
+   */
+  LocalOrientation(const T* ptr, size_t size)
+  : m_Size(size)
+  {
+    for(size_t i = 0; i < m_Size; i++)
+    {
+      m_Values[i] = ptr[i];
+    }
+  }
+
+  size_t size() const
+  {
+    return m_Size;
+  }
+
+  T& operator[](size_t index)
+  {
+    return m_Values[index];
+  }
+
+  const T& operator[](size_t index) const
+  {
+    return m_Values[index];
+  }
+
+  T* data()
+  {
+    return m_Values.data();
+  }
+
+  const T* data() const
+  {
+    return m_Values.data();
+  }
+
+  /**
+   * @brief Quaternion component access for orientations holding a quaternion in Vector-Scalar (x, y, z, w) order
+   */
+  T x() const
+  {
+    return m_Values[0];
+  }
+
+  T y() const
+  {
+    return m_Values[1];
+  }
+
+  T z() const
+  {
+    return m_Values[2];
+  }
+
+  T w() const
+  {
+    return m_Values[3];
+  }
+
+  /**
+   * @brief Copies the values into ptr
+   */
+  void copyInto(T* ptr) const
+  {
+    for(size_t i = 0; i < m_Size; i++)
+    {
+      ptr[i] = m_Values[i];
+    }
+  }
+
+private:
+  std::array<T, k_Capacity> m_Values;
+  size_t m_Size = 0;
+};
+
+namespace Fused
+{
+using RepType = OrientationRepresentation::Type;
+
+/**
+ * @brief Returns the number of values that make up a single orientation of the given representation
+ */
+constexpr size_t NumComponents(RepType type)
+{
+  switch(type)
+  {
+  case RepType::Euler:
+    return 3;
+  case RepType::OrientationMatrix:
+    return 9;
+  case RepType::Quaternion:
+    return 4;
+  case RepType::AxisAngle:
+    return 4;
+  case RepType::Rodrigues:
+    return 4;
+  case RepType::Homochoric:
+    return 3;
+  case RepType::Cubochoric:
+    return 3;
+  case RepType::Unknown:
+    return 0;
+  }
+  return 0;
+}
+
+/**
+ * @brief Maps a (From, To) pair of representations onto the OrientationTransformation function that converts
+ * between them. Converting a representation to itself is a copy, which requires InputType and OutputType to match.
+ */
+template <RepType From, RepType To>
+struct Conversion
+{
+  template <typename InputType, typename OutputType>
+  static OutputType Apply(const InputType& input)
+  {
+    static_assert(From == To, "No conversion function is registered for this pair of representations");
+    return input;
+  }
+};
+
+#define EBSD_FUSED_CONVERSION(FROM, TO, CONVERSION_METHOD)                                                                                                                                             \
+  template <>                                                                                                                                                                                          \
+  struct Conversion<RepType::FROM, RepType::TO>                                                                                                                                                        \
+  {                                                                                                                                                                                                    \
+    template <typename InputType, typename OutputType>                                                                                                                                                 \
+    static OutputType Apply(const InputType& input)                                                                                                                                                    \
+    {                                                                                                                                                                                                  \
+      return OrientationTransformation::CONVERSION_METHOD<InputType, OutputType>(input);                                                                                                              \
+    }                                                                                                                                                                                                  \
+  };
+
+EBSD_FUSED_CONVERSION(Euler, OrientationMatrix, eu2om)
+EBSD_FUSED_CONVERSION(Euler, Quaternion, eu2qu)
+EBSD_FUSED_CONVERSION(Euler, AxisAngle, eu2ax)
+EBSD_FUSED_CONVERSION(Euler, Rodrigues, eu2ro)
+EBSD_FUSED_CONVERSION(Euler, Homochoric, eu2ho)
+EBSD_FUSED_CONVERSION(Euler, Cubochoric, eu2cu)
+
+EBSD_FUSED_CONVERSION(OrientationMatrix, Euler, om2eu)
+EBSD_FUSED_CONVERSION(OrientationMatrix, Quaternion, om2qu)
+EBSD_FUSED_CONVERSION(OrientationMatrix, AxisAngle, om2ax)
+EBSD_FUSED_CONVERSION(OrientationMatrix, Rodrigues, om2ro)
+EBSD_FUSED_CONVERSION(OrientationMatrix, Homochoric, om2ho)
+EBSD_FUSED_CONVERSION(OrientationMatrix, Cubochoric, om2cu)
+
+EBSD_FUSED_CONVERSION(Quaternion, Euler, qu2eu)
+EBSD_FUSED_CONVERSION(Quaternion, OrientationMatrix, qu2om)
+EBSD_FUSED_CONVERSION(Quaternion, AxisAngle, qu2ax)
+EBSD_FUSED_CONVERSION(Quaternion, Rodrigues, qu2ro)
+EBSD_FUSED_CONVERSION(Quaternion, Homochoric, qu2ho)
+EBSD_FUSED_CONVERSION(Quaternion, Cubochoric, qu2cu)
+
+EBSD_FUSED_CONVERSION(AxisAngle, Euler, ax2eu)
+EBSD_FUSED_CONVERSION(AxisAngle, OrientationMatrix, ax2om)
+EBSD_FUSED_CONVERSION(AxisAngle, Quaternion, ax2qu)
+EBSD_FUSED_CONVERSION(AxisAngle, Rodrigues, ax2ro)
+EBSD_FUSED_CONVERSION(AxisAngle, Homochoric, ax2ho)
+EBSD_FUSED_CONVERSION(AxisAngle, Cubochoric, ax2cu)
+
+EBSD_FUSED_CONVERSION(Rodrigues, Euler, ro2eu)
+EBSD_FUSED_CONVERSION(Rodrigues, OrientationMatrix, ro2om)
+EBSD_FUSED_CONVERSION(Rodrigues, Quaternion, ro2qu)
+EBSD_FUSED_CONVERSION(Rodrigues, AxisAngle, ro2ax)
+EBSD_FUSED_CONVERSION(Rodrigues, Homochoric, ro2ho)
+EBSD_FUSED_CONVERSION(Rodrigues, Cubochoric, ro2cu)
+
+EBSD_FUSED_CONVERSION(Homochoric, Euler, ho2eu)
+EBSD_FUSED_CONVERSION(Homochoric, OrientationMatrix, ho2om)
+EBSD_FUSED_CONVERSION(Homochoric, Quaternion, ho2qu)
+EBSD_FUSED_CONVERSION(Homochoric, AxisAngle, ho2ax)
+EBSD_FUSED_CONVERSION(Homochoric, Rodrigues, ho2ro)
+EBSD_FUSED_CONVERSION(Homochoric, Cubochoric, ho2cu)
+
+EBSD_FUSED_CONVERSION(Cubochoric, Euler, cu2eu)
+EBSD_FUSED_CONVERSION(Cubochoric, OrientationMatrix, cu2om)
+EBSD_FUSED_CONVERSION(Cubochoric, Quaternion, cu2qu)
+EBSD_FUSED_CONVERSION(Cubochoric, AxisAngle, cu2ax)
+EBSD_FUSED_CONVERSION(Cubochoric, Rodrigues, cu2ro)
+EBSD_FUSED_CONVERSION(Cubochoric, Homochoric, cu2ho)
+
+#undef EBSD_FUSED_CONVERSION
+
+/**
+ * @brief Converts a single orientation. All intermediate representations are kept on the stack.
+ * Quaternions are read and written in Vector-Scalar (x, y, z, w) order.
+ * @param input Pointer to the NumComponents(From) input values
+ * @param output Pointer to the NumComponents(To) output values. May not overlap the input.
+ */
+template <RepType From, RepType To, typename T>
+inline void Convert(const T* input, T* output)
+{
+  using LocalType = LocalOrientation<T>;
+  LocalType in(input, NumComponents(From));
+  Conversion<From, To>::template Apply<LocalType, LocalType>(in).copyInto(output);
+}
+
+/**
+ * @brief Converts the orientations [start, end) of a strided input array into a strided output array
+ * @param input Pointer to the first input orientation
+ * @param inStride Distance in values between consecutive input orientations
+ * @param output Pointer to the first output orientation
+ * @param outStride Distance in values between consecutive output orientations
+ * @param start The first orientation to convert
+ * @param end One past the last orientation to convert
+ */
+template <RepType From, RepType To, typename T>
+void ConvertRange(const T* input, size_t inStride, T* output, size_t outStride, size_t start, size_t end)
+{
+  for(size_t i = start; i < end; i++)
+  {
+    Convert<From, To, T>(input + i * inStride, output + i * outStride);
+  }
+}
+
+/**
+ * @brief Signature of the conversion kernels returned by GetConversionKernel()
+ */
+template <typename T>
+using ConversionKernel = void (*)(const T* input, size_t inStride, T* output, size_t outStride, size_t start, size_t end);
+
+namespace Detail
+{
+constexpr size_t k_NumRepresentations = 7;
+
+template <typename T, size_t... Indices>
+constexpr std::array<ConversionKernel<T>, sizeof...(Indices)> MakeKernelTable(std::index_sequence<Indices...> /*unused*/)
+{
+  return {{&ConvertRange<static_cast<RepType>(Indices / k_NumRepresentations), static_cast<RepType>(Indices % k_NumRepresentations), T>...}};
+}
+} // namespace Detail
+
+/**
+ * @brief Returns the fused conversion kernel for a pair of representations that are only known at run time,
+ * or nullptr if either representation is Unknown. The table of all 49 kernels is generated at compile time.
+ */
+template <typename T>
+ConversionKernel<T> GetConversionKernel(RepType from, RepType to)
+{
+  static const std::array<ConversionKernel<T>, Detail::k_NumRepresentations * Detail::k_NumRepresentations> k_Kernels =
+      Detail::MakeKernelTable<T>(std::make_index_sequence<Detail::k_NumRepresentations * Detail::k_NumRepresentations>());
+  const auto fromIndex = static_cast<size_t>(from);
+  const auto toIndex = static_cast<size_t>(to);
+  if(fromIndex >= Detail::k_NumRepresentations || toIndex >= Detail::k_NumRepresentations)
+  {
+    return nullptr;
+  }
+  return k_Kernels[fromIndex * Detail::k_NumRepresentations + toIndex];
+}
+
+} // namespace Fused
+} // namespace OrientationTransformation
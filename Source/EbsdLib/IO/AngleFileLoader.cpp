@@ -35,18 +35,232 @@
 
 #include "AngleFileLoader.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <vector>
 
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "EbsdLib/Core/EbsdArrayView.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationRepresentation.h"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/OrientationMath/OrientationConverter.hpp"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 
+namespace
+{
+constexpr size_t k_NumComponents = 5;
+
+// -----------------------------------------------------------------------------
+inline bool IsSeparator(char c, char delimiter)
+{
+  return c == delimiter || c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Parses the first count values of the line [begin, end). Runs of separators are skipped so empty fields
+ * never produce a value, which is how the tokenizer used by earlier versions of this class behaved.
+ * @return false if the line has fewer than count values or one of them is not a number
+ */
+bool ParseValues(const char* begin, const char* end, char delimiter, float* values, size_t count)
+{
+  const char* ptr = begin;
+  for(size_t v = 0; v < count; v++)
+  {
+    while(ptr < end && IsSeparator(*ptr, delimiter))
+    {
+      ptr++;
+    }
+    if(ptr == end)
+    {
+      return false;
+    }
+    if(*ptr == '+')
+    {
+      ptr++;
+    }
+#if defined(__cpp_lib_to_chars)
+    std::from_chars_result result = std::from_chars(ptr, end, values[v]);
+    if(result.ec != std::errc())
+    {
+      return false;
+    }
+    ptr = result.ptr;
+#else
+    // The read buffer is NUL terminated so strtof can not run off the end of it
+    char* next = nullptr;
+    values[v] = std::strtof(ptr, &next);
+    if(next == ptr || next > end)
+    {
+      return false;
+    }
+    ptr = next;
+#endif
+    if(ptr < end && !IsSeparator(*ptr, delimiter))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+namespace Detail
+{
+/**
+ * @brief The ParseAngleLinesImpl class parses a range of lines of one read block into consecutive angle tuples
+ */
+class ParseAngleLinesImpl
+{
+public:
+  ParseAngleLinesImpl(const char* buffer, const std::vector<size_t>& lineStarts, const std::vector<size_t>& lineEnds, float* angles, uint32_t representation, char delimiter,
+                      std::atomic<size_t>& firstBadLine)
+  : m_Buffer(buffer)
+  , m_LineStarts(lineStarts)
+  , m_LineEnds(lineEnds)
+  , m_Angles(angles)
+  , m_Representation(representation)
+  , m_Delimiter(delimiter)
+  , m_FirstBadLine(firstBadLine)
+  {
+  }
+  virtual ~ParseAngleLinesImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    std::array<float, 6> values = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    const size_t numValues = (m_Representation == AngleFileLoader::QuaternionAngles) ? 6 : 5;
+    for(size_t i = start; i < end; i++)
+    {
+      float* tuple = m_Angles + i * k_NumComponents;
+      const char* lineBegin = m_Buffer + m_LineStarts[i];
+      const char* lineEnd = m_Buffer + m_LineEnds[i];
+      const char* first = lineBegin;
+      while(first < lineEnd && IsSeparator(*first, m_Delimiter))
+      {
+        first++;
+      }
+      // Comment and blank lines still use up their tuple
+      if(first == lineEnd || *lineBegin == '#')
+      {
+        std::fill(tuple, tuple + k_NumComponents, 0.0f);
+        continue;
+      }
+      if(!ParseValues(first, lineEnd, m_Delimiter, values.data(), numValues))
+      {
+        setBadLine(i);
+        std::fill(tuple, tuple + k_NumComponents, 0.0f);
+        continue;
+      }
+
+      if(m_Representation == AngleFileLoader::EulerAngles)
+      {
+        std::copy(values.begin(), values.begin() + k_NumComponents, tuple);
+        continue;
+      }
+      OrientationF euler(3);
+      if(m_Representation == AngleFileLoader::QuaternionAngles)
+      {
+        QuatF quat(values[0], values[1], values[2], values[3]);
+        euler = OrientationTransformation::qu2eu<QuatF, OrientationF>(quat);
+        tuple[3] = values[4];
+        tuple[4] = values[5];
+      }
+      else
+      {
+        Orientation<float> rod(4, 0.0);
+        rod[0] = values[0];
+        rod[1] = values[1];
+        rod[2] = values[2];
+        euler = OrientationTransformation::ro2eu<OrientationF, OrientationF>(rod);
+        tuple[3] = values[3];
+        tuple[4] = values[4];
+      }
+      tuple[0] = euler[0];
+      tuple[1] = euler[1];
+      tuple[2] = euler[2];
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const char* m_Buffer;
+  const std::vector<size_t>& m_LineStarts;
+  const std::vector<size_t>& m_LineEnds;
+  float* m_Angles;
+  uint32_t m_Representation;
+  char m_Delimiter;
+  std::atomic<size_t>& m_FirstBadLine;
+
+  void setBadLine(size_t line) const
+  {
+    size_t current = m_FirstBadLine.load();
+    while(line < current && !m_FirstBadLine.compare_exchange_weak(current, line))
+    {
+    }
+  }
+};
+
+/**
+ * @brief The ScaleAnglesImpl class multiplies the three Euler angles of a range of tuples by a constant factor
+ */
+class ScaleAnglesImpl
+{
+public:
+  ScaleAnglesImpl(float* angles, float factor)
+  : m_Angles(angles)
+  , m_Factor(factor)
+  {
+  }
+  virtual ~ScaleAnglesImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    float* angles = m_Angles;
+    const float factor = m_Factor;
+    for(size_t i = start; i < end; i++)
+    {
+      float* tuple = angles + i * k_NumComponents;
+      tuple[0] *= factor;
+      tuple[1] *= factor;
+      tuple[2] *= factor;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  float* m_Angles;
+  float m_Factor;
+};
+} // namespace Detail
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -105,7 +319,7 @@ EbsdLib::FloatArrayType::Pointer AngleFileLoader::loadData()
   std::string buf;
 
   // Open the file and read the first line
-  std::ifstream reader(getInputFile(), std::ios_base::in);
+  std::ifstream reader(getInputFile(), std::ios_base::in | std::ios_base::binary);
   if(!reader.is_open())
   {
     std::string msg = std::string("Angle file could not be opened: ") + getInputFile();
@@ -114,10 +328,12 @@ EbsdLib::FloatArrayType::Pointer AngleFileLoader::loadData()
     return angles;
   }
 
+  size_t headerLines = 1;
   std::getline(reader, buf);
-  while(buf[0] == '#')
+  while(!buf.empty() && buf[0] == '#')
   {
     std::getline(reader, buf);
+    headerLines++;
   }
   buf = EbsdStringUtils::trimmed(buf); // Remove leading and trailing whitespace
 
@@ -132,7 +348,9 @@ EbsdLib::FloatArrayType::Pointer AngleFileLoader::loadData()
     return angles;
   }
 
-  if(tokens[0] != "Angle Count")
+  std::string countToken = EbsdStringUtils::trimmed(tokens[1]);
+  std::from_chars_result countResult = std::from_chars(countToken.data(), countToken.data() + countToken.size(), numOrients);
+  if(tokens[0] != "Angle Count" || countResult.ec != std::errc() || numOrients < 0)
   {
     std::stringstream msg;
     msg << "Proper Header was not detected. The file should have a single header line of 'Angle Count:XXXX'";
@@ -140,94 +358,134 @@ EbsdLib::FloatArrayType::Pointer AngleFileLoader::loadData()
     setErrorMessage(msg.str());
     return angles;
   }
-  numOrients = std::stoi(tokens[1]);
 
   // Allocate enough for the angles
-  std::vector<size_t> dims(1, 5);
-  angles = EbsdLib::FloatArrayType::CreateArray(numOrients, dims, "EulerAngles_From_File", true);
-
-  for(int i = 0; i < numOrients; i++)
+  const size_t numTuples = static_cast<size_t>(numOrients);
+  std::vector<size_t> dims(1, k_NumComponents);
+  angles = EbsdLib::FloatArrayType::CreateArray(numTuples, dims, "EulerAngles_From_File", true);
+  float* anglesPtr = angles->getPointer(0);
+
+  // Any whitespace separates values. A tab delimiter is therefore the same as a space.
+  const char delimiter = m_Delimiter.empty() ? ' ' : m_Delimiter[0];
+
+  // Read the body of the file in large blocks. The complete lines of each block are found with memchr and then
+  // parsed in parallel. A partial line at the end of a block is carried over to the front of the next block.
+  std::vector<char> buffer;
+  std::vector<size_t> lineStarts;
+  std::vector<size_t> lineEnds;
+  size_t carry = 0;
+  size_t tupleIndex = 0;
+  bool endOfFile = false;
+  const size_t blockSize = std::max(m_ReadBlockSize, static_cast<size_t>(1));
+  while(tupleIndex < numTuples && !endOfFile)
   {
-    float weight = 0.0f;
-    float sigma = 1.0f;
-    std::getline(reader, buf);
-    // Skip any lines that start with a '#' character
-    if(buf[0] == '#')
+    buffer.resize(carry + blockSize + 1);
+    reader.read(buffer.data() + carry, static_cast<std::streamsize>(blockSize));
+    const size_t bytesRead = static_cast<size_t>(reader.gcount());
+    endOfFile = (bytesRead < blockSize);
+    const size_t length = carry + bytesRead;
+    buffer[length] = '\0';
+
+    lineStarts.clear();
+    lineEnds.clear();
+    const char* data = buffer.data();
+    size_t offset = 0;
+    while(offset < length && tupleIndex + lineStarts.size() < numTuples)
     {
-      continue;
+      const char* newline = static_cast<const char*>(std::memchr(data + offset, '\n', length - offset));
+      if(nullptr == newline)
+      {
+        if(endOfFile)
+        {
+          lineStarts.push_back(offset);
+          lineEnds.push_back(length);
+          offset = length;
+        }
+        break;
+      }
+      const size_t newlineOffset = static_cast<size_t>(newline - data);
+      lineStarts.push_back(offset);
+      lineEnds.push_back(newlineOffset);
+      offset = newlineOffset + 1;
     }
-    buf = EbsdStringUtils::trimmed(buf); // Remove leading and trailing whitespace
 
-    // Remove multiple Delimiters if wanted by the user.
-    if(m_IgnoreMultipleDelimiters)
+    const size_t numLines = lineStarts.size();
+    std::atomic<size_t> firstBadLine(std::numeric_limits<size_t>::max());
+    Detail::ParseAngleLinesImpl impl(data, lineStarts, lineEnds, anglesPtr + tupleIndex * k_NumComponents, m_AngleRepresentation, delimiter, firstBadLine);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numLines), impl, tbb::auto_partitioner());
+#else
+    impl.generate(0, numLines);
+#endif
+    if(firstBadLine.load() != std::numeric_limits<size_t>::max())
     {
-      buf = EbsdStringUtils::simplified(buf); // Remove leading and trailing whitespace
+      std::stringstream msg;
+      msg << "Line " << (headerLines + tupleIndex + firstBadLine.load() + 1) << " of the angle file could not be parsed as the selected angle representation";
+      setErrorCode(-103);
+      setErrorMessage(msg.str());
+      return EbsdLib::FloatArrayType::NullPointer();
     }
-    std::string delimiter = getDelimiter();
-    if(delimiter == "\t")
-    {
-      setDelimiter(" ");
-    }
-    tokens = EbsdStringUtils::split(buf, (*(getDelimiter().c_str())));
+    tupleIndex += numLines;
 
-    OrientationF euler(3);
-    if(m_AngleRepresentation == EulerAngles)
-    {
-      euler[0] = std::stof(tokens[0]);
-      euler[1] = std::stof(tokens[1]);
-      euler[2] = std::stof(tokens[2]);
-      weight = std::stof(tokens[3]);
-      sigma = std::stof(tokens[4]);
-    }
-    else if(m_AngleRepresentation == QuaternionAngles)
-    {
-      QuatF quat(4);
+    carry = length - offset;
+    std::memmove(buffer.data(), buffer.data() + offset, carry);
+  }
 
-      quat.x() = std::stof(tokens[0]);
-      quat.y() = std::stof(tokens[1]);
-      quat.z() = std::stof(tokens[2]);
-      quat.w() = std::stof(tokens[3]);
+  if(tupleIndex < numTuples)
+  {
+    std::stringstream msg;
+    msg << "The angle file ended after " << tupleIndex << " of the " << numTuples << " angles given in the header";
+    setErrorCode(-104);
+    setErrorMessage(msg.str());
+    return EbsdLib::FloatArrayType::NullPointer();
+  }
 
-      euler = OrientationTransformation::qu2eu<QuatF, OrientationF>(quat);
-      weight = std::stof(tokens[4]);
-      sigma = std::stof(tokens[5]);
-    }
-    else if(m_AngleRepresentation == RodriguezAngles)
-    {
-      Orientation<float> rod(4, 0.0);
-      rod[0] = std::stof(tokens[0]);
-      rod[1] = std::stof(tokens[1]);
-      rod[2] = std::stof(tokens[2]);
-      euler = OrientationTransformation::ro2eu<OrientationF, OrientationF>(rod);
-      weight = std::stof(tokens[3]);
-      sigma = std::stof(tokens[4]);
-    }
+  float factor = 1.0f;
+  // Values in File are in Radians and the user wants them in Degrees
+  if(!m_FileAnglesInDegrees && m_OutputAnglesInDegrees)
+  {
+    factor = EbsdLib::Constants::k_RadToDegF;
+  }
+  // Values are in Degrees but user wants them in Radians
+  else if(m_FileAnglesInDegrees && !m_OutputAnglesInDegrees)
+  {
+    factor = EbsdLib::Constants::k_DegToRadF;
+  }
+  if(factor != 1.0f)
+  {
+    Detail::ScaleAnglesImpl scale(anglesPtr, factor);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTuples), scale, tbb::auto_partitioner());
+#else
+    scale.generate(0, numTuples);
+#endif
+  }
 
-    // Values in File are in Radians and the user wants them in Degrees
-    if(!m_FileAnglesInDegrees && m_OutputAnglesInDegrees)
-    {
-      euler[0] = euler[0] * EbsdLib::Constants::k_RadToDegF;
-      euler[1] = euler[1] * EbsdLib::Constants::k_RadToDegF;
-      euler[2] = euler[2] * EbsdLib::Constants::k_RadToDegF;
-    }
-    // Values are in Degrees but user wants them in Radians
-    else if(m_FileAnglesInDegrees && !m_OutputAnglesInDegrees)
-    {
-      euler[0] = euler[0] * EbsdLib::Constants::k_DegToRadF;
-      euler[1] = euler[1] * EbsdLib::Constants::k_DegToRadF;
-      euler[2] = euler[2] * EbsdLib::Constants::k_DegToRadF;
-    }
+  setErrorCode(0);
+  setErrorMessage("");
+  return angles;
+}
 
-    // Store the values into our array
-    angles->setComponent(i, 0, euler[0]);
-    angles->setComponent(i, 1, euler[1]);
-    angles->setComponent(i, 2, euler[2]);
-    angles->setComponent(i, 3, weight);
-    angles->setComponent(i, 4, sigma);
-    //   std::cout << "reading line: " << i ;
+// -----------------------------------------------------------------------------
+EbsdLib::FloatArrayType::Pointer AngleFileLoader::loadQuaternions()
+{
+  const bool outputAnglesInDegrees = m_OutputAnglesInDegrees;
+  m_OutputAnglesInDegrees = false;
+  EbsdLib::FloatArrayType::Pointer angles = loadData();
+  m_OutputAnglesInDegrees = outputAnglesInDegrees;
+  if(nullptr == angles)
+  {
+    return angles;
   }
 
-  return angles;
+  // Convert the Euler angles in place, skipping the weight and sigma columns
+  using ConverterType = OrientationConverter<EbsdLib::FloatArrayType, float>;
+  ConverterType::Pointer converter = EulerConverter<EbsdLib::FloatArrayType, float>::New();
+  converter->setInputView(EbsdArrayView<float>(angles->getPointer(0), angles->getNumberOfTuples(), 3, k_NumComponents, 1));
+  converter->convertRepresentationTo(OrientationRepresentation::Type::Quaternion);
+  EbsdLib::FloatArrayType::Pointer quats = converter->getOutputData();
+  quats->setName("Quaternions_From_File");
+  return quats;
 }
 
 // -----------------------------------------------------------------------------
@@ -350,3 +608,15 @@ bool AngleFileLoader::getIgnoreMultipleDelimiters() const
 {
   return m_IgnoreMultipleDelimiters;
 }
+
+// -----------------------------------------------------------------------------
+void AngleFileLoader::setReadBlockSize(size_t value)
+{
+  m_ReadBlockSize = value;
+}
+
+// -----------------------------------------------------------------------------
+size_t AngleFileLoader::getReadBlockSize() const
+{
+  return m_ReadBlockSize;
+}
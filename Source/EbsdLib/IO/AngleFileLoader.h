@@ -158,17 +158,50 @@ public:
 
   /**
    * @brief Setter property for IgnoreMultipleDelimiters
+   * @deprecated The value is stored but no longer used. Runs of delimiters and whitespace between values are always
+   * skipped, so empty fields never produce a value. This is the behavior earlier versions had for every setting,
+   * because their tokenizer dropped empty tokens as well.
    */
-  void setIgnoreMultipleDelimiters(bool value);
+  [[deprecated("Runs of delimiters are always skipped")]] void setIgnoreMultipleDelimiters(bool value);
 
   /**
    * @brief Getter property for IgnoreMultipleDelimiters
+   * @deprecated See setIgnoreMultipleDelimiters()
    * @return Value of IgnoreMultipleDelimiters
    */
-  bool getIgnoreMultipleDelimiters() const;
+  [[deprecated("Runs of delimiters are always skipped")]] bool getIgnoreMultipleDelimiters() const;
 
+  /**
+   * @brief Setter property for ReadBlockSize. Lines longer than a block are still read whole.
+   */
+  void setReadBlockSize(size_t value);
+
+  /**
+   * @brief Getter property for ReadBlockSize
+   * @return Value of ReadBlockSize
+   */
+  size_t getReadBlockSize() const;
+
+  /**
+   * @brief Reads the file into a 5 component array of (phi1, Phi, phi2, weight, sigma) tuples. The body of the file
+   * is read in large blocks whose lines are parsed in parallel. Comment ('#') and blank lines keep their tuple which
+   * is left as zeros.
+   * @return The angles or a NullPointer if the file could not be read. Check getErrorCode() for the reason.
+   */
   EbsdLib::FloatArrayType::Pointer loadData();
 
+  /**
+   * @brief Reads the file and converts the Euler angles into a 4 component (x, y, z, w) quaternion array. The
+   * OutputAnglesInDegrees property is ignored and the weight and sigma columns are not returned.
+   * @return The quaternions or a NullPointer if the file could not be read
+   */
+  EbsdLib::FloatArrayType::Pointer loadQuaternions();
+
+  /**
+   * @brief The default number of bytes that are read from the file and parsed at a time
+   */
+  static constexpr size_t k_DefaultReadBlockSize = 32 * 1024 * 1024;
+
 protected:
   AngleFileLoader();
 
@@ -187,4 +220,5 @@ private:
   uint32_t m_AngleRepresentation = {};
   std::string m_Delimiter = {};
   bool m_IgnoreMultipleDelimiters = {};
+  size_t m_ReadBlockSize = k_DefaultReadBlockSize;
 };
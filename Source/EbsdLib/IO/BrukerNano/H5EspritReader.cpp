@@ -830,6 +830,53 @@ void* H5EspritReader::getPointerByName(const std::string& featureName)
   return nullptr;
 }
 
+// -----------------------------------------------------------------------------
+void* H5EspritReader::releasePointerByName(const std::string& featureName)
+{
+  if(featureName == EbsdLib::H5Esprit::MAD)
+  {
+    return releaseArrayData(m_MAD, m_MADCleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::NIndexedBands)
+  {
+    return releaseArrayData(m_NIndexedBands, m_NIndexedBandsCleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::PHI)
+  {
+    return releaseArrayData(m_PHI, m_PHICleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::Phase)
+  {
+    return releaseArrayData(m_Phase, m_PhaseCleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::RadonBandCount)
+  {
+    return releaseArrayData(m_RadonBandCount, m_RadonBandCountCleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::RadonQuality)
+  {
+    return releaseArrayData(m_RadonQuality, m_RadonQualityCleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::XBEAM)
+  {
+    return releaseArrayData(m_XBEAM, m_XBEAMCleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::YBEAM)
+  {
+    return releaseArrayData(m_YBEAM, m_YBEAMCleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::phi1)
+  {
+    return releaseArrayData(m_phi1, m_phi1Cleanup);
+  }
+  if(featureName == EbsdLib::H5Esprit::phi2)
+  {
+    return releaseArrayData(m_phi2, m_phi2Cleanup);
+  }
+  // The pattern data is not a per point column and stays with the reader
+  return nullptr;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
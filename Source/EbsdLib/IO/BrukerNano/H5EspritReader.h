@@ -158,6 +158,12 @@ public:
    */
   void* getPointerByName(const std::string& featureName) override;
 
+  /**
+   * @brief Hands the memory of a data column over to the caller. See EbsdReader::releasePointerByName()
+   * @param featureName The name of the feature.
+   */
+  void* releasePointerByName(const std::string& featureName) override;
+
   /**
    * @brief Returns an enumeration value that depicts the numerical
    * primitive type that the data is stored as (Int, Float, etc).
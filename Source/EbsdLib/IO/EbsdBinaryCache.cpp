@@ -0,0 +1,270 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "EbsdBinaryCache.h"
+
+#include <fstream>
+#include <system_error>
+
+namespace
+{
+const char k_Magic[8] = {'E', 'B', 'S', 'D', 'C', 'A', 'C', 'H'};
+const uint32_t k_Version = 1;
+
+/**
+ * @brief Identifies the source file contents by size and modification time
+ */
+struct SourceStamp
+{
+  uint64_t size = 0;
+  int64_t modified = 0;
+};
+
+// -----------------------------------------------------------------------------
+bool GetSourceStamp(const std::string& sourceFile, SourceStamp& stamp)
+{
+  std::error_code error;
+  fs::path sourcePath(sourceFile);
+  stamp.size = static_cast<uint64_t>(fs::file_size(sourcePath, error));
+  if(error)
+  {
+    return false;
+  }
+  stamp.modified = static_cast<int64_t>(fs::last_write_time(sourcePath, error).time_since_epoch().count());
+  return !error;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void WriteValue(std::ofstream& out, const T& value)
+{
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// -----------------------------------------------------------------------------
+void WriteString(std::ofstream& out, const std::string& value)
+{
+  WriteValue(out, static_cast<uint32_t>(value.size()));
+  out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+bool ReadValue(std::ifstream& in, T& value)
+{
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(in);
+}
+
+// -----------------------------------------------------------------------------
+bool ReadString(std::ifstream& in, std::string& value)
+{
+  uint32_t length = 0;
+  if(!ReadValue(in, length) || length > 4096)
+  {
+    return false;
+  }
+  value.resize(length);
+  in.read(&value[0], static_cast<std::streamsize>(length));
+  return static_cast<bool>(in);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+std::string EbsdBinaryCache::CacheFilePath(const std::string& sourceFile)
+{
+  return sourceFile + ".ebsdcache";
+}
+
+// -----------------------------------------------------------------------------
+size_t EbsdBinaryCache::SizeOfType(EbsdLib::NumericTypes::Type type)
+{
+  switch(type)
+  {
+  case EbsdLib::NumericTypes::Type::Int8:
+  case EbsdLib::NumericTypes::Type::UInt8:
+  case EbsdLib::NumericTypes::Type::Bool:
+    return 1;
+  case EbsdLib::NumericTypes::Type::Int16:
+  case EbsdLib::NumericTypes::Type::UInt16:
+    return 2;
+  case EbsdLib::NumericTypes::Type::Int32:
+  case EbsdLib::NumericTypes::Type::UInt32:
+  case EbsdLib::NumericTypes::Type::Float:
+    return 4;
+  case EbsdLib::NumericTypes::Type::Int64:
+  case EbsdLib::NumericTypes::Type::UInt64:
+  case EbsdLib::NumericTypes::Type::Double:
+    return 8;
+  case EbsdLib::NumericTypes::Type::SizeT:
+    return sizeof(size_t);
+  case EbsdLib::NumericTypes::Type::UnknownNumType:
+    return 0;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+bool EbsdBinaryCache::Write(const std::string& sourceFile, const std::string& readerName, size_t numElements, int32_t numFeatures, const std::vector<Column>& columns)
+{
+  SourceStamp stamp;
+  if(!GetSourceStamp(sourceFile, stamp))
+  {
+    return false;
+  }
+
+  // Write to a temporary file first so that an interrupted write never leaves a cache that looks valid
+  const std::string cacheFile = CacheFilePath(sourceFile);
+  const std::string tempFile = cacheFile + ".tmp";
+  {
+    std::ofstream out(tempFile, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if(!out.is_open())
+    {
+      return false;
+    }
+    out.write(k_Magic, sizeof(k_Magic));
+    WriteValue(out, k_Version);
+    WriteString(out, readerName);
+    WriteValue(out, stamp.size);
+    WriteValue(out, stamp.modified);
+    WriteValue(out, static_cast<uint64_t>(numElements));
+    WriteValue(out, numFeatures);
+    WriteValue(out, static_cast<uint32_t>(columns.size()));
+    for(const auto& column : columns)
+    {
+      WriteString(out, column.name);
+      WriteValue(out, static_cast<int32_t>(column.type));
+      out.write(static_cast<const char*>(column.data), static_cast<std::streamsize>(numElements * SizeOfType(column.type)));
+    }
+    if(!out)
+    {
+      out.close();
+      std::error_code error;
+      fs::remove(tempFile, error);
+      return false;
+    }
+  }
+  std::error_code error;
+  fs::rename(tempFile, cacheFile, error);
+  return !error;
+}
+
+// -----------------------------------------------------------------------------
+bool EbsdBinaryCache::Read(const std::string& sourceFile, const std::string& readerName, size_t numElements, int32_t& numFeatures, const std::vector<Destination>& destinations)
+{
+  SourceStamp stamp;
+  if(!GetSourceStamp(sourceFile, stamp))
+  {
+    return false;
+  }
+  std::ifstream in(CacheFilePath(sourceFile), std::ios_base::in | std::ios_base::binary);
+  if(!in.is_open())
+  {
+    return false;
+  }
+
+  char magic[sizeof(k_Magic)] = {0};
+  in.read(magic, sizeof(magic));
+  uint32_t version = 0;
+  std::string cachedReaderName;
+  SourceStamp cachedStamp;
+  uint64_t cachedNumElements = 0;
+  int32_t cachedNumFeatures = 0;
+  uint32_t numColumns = 0;
+  if(!in || std::string(magic, sizeof(magic)) != std::string(k_Magic, sizeof(k_Magic)) || !ReadValue(in, version) || version != k_Version || !ReadString(in, cachedReaderName) ||
+     !ReadValue(in, cachedStamp.size) || !ReadValue(in, cachedStamp.modified) || !ReadValue(in, cachedNumElements) || !ReadValue(in, cachedNumFeatures) || !ReadValue(in, numColumns))
+  {
+    return false;
+  }
+  if(cachedReaderName != readerName || cachedStamp.size != stamp.size || cachedStamp.modified != stamp.modified || cachedNumElements != numElements)
+  {
+    return false;
+  }
+
+  if(numColumns != destinations.size())
+  {
+    return false;
+  }
+
+  // Match every cached column to an expected one before anything is copied, so that a cache that is missing a column
+  // or holds one of the wrong type leaves the reader's arrays untouched
+  const std::streamoff headerEnd = in.tellg();
+  in.seekg(0, std::ios_base::end);
+  const std::streamoff fileSize = in.tellg();
+  in.seekg(headerEnd);
+  std::vector<size_t> order(numColumns, 0);
+  std::vector<std::streamoff> offsets(numColumns, 0);
+  std::vector<bool> matched(destinations.size(), false);
+  for(uint32_t c = 0; c < numColumns; c++)
+  {
+    std::string name;
+    int32_t type = 0;
+    if(!ReadString(in, name) || !ReadValue(in, type))
+    {
+      return false;
+    }
+    const auto columnType = static_cast<EbsdLib::NumericTypes::Type>(type);
+    size_t index = 0;
+    while(index < destinations.size() && destinations[index].name != name)
+    {
+      index++;
+    }
+    const size_t numBytes = numElements * SizeOfType(columnType);
+    if(index == destinations.size() || matched[index] || destinations[index].type != columnType || destinations[index].data == nullptr || numBytes == 0)
+    {
+      return false;
+    }
+    matched[index] = true;
+    order[c] = index;
+    offsets[c] = in.tellg();
+    in.seekg(static_cast<std::streamoff>(numBytes), std::ios_base::cur);
+    if(!in || offsets[c] + static_cast<std::streamoff>(numBytes) > fileSize)
+    {
+      return false;
+    }
+  }
+
+  for(uint32_t c = 0; c < numColumns; c++)
+  {
+    const Destination& destination = destinations[order[c]];
+    in.seekg(offsets[c]);
+    in.read(static_cast<char*>(destination.data), static_cast<std::streamsize>(numElements * SizeOfType(destination.type)));
+    if(!in)
+    {
+      return false;
+    }
+  }
+  numFeatures = cachedNumFeatures;
+  return true;
+}
@@ -0,0 +1,107 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class EbsdBinaryCache EbsdBinaryCache.h EbsdLib/IO/EbsdBinaryCache.h
+ * @brief The EbsdBinaryCache class stores the parsed data columns of a text EBSD file (.ang, .ctf) in a binary
+ * sidecar file next to it. Later reads of the same file can then skip tokenizing the text. The cache records the size
+ * and modification time of the source file, and is only used while both still match. Each column is stored as raw
+ * values so reading it back is a single bulk read straight into the reader's arrays.
+ */
+class EbsdLib_EXPORT EbsdBinaryCache
+{
+public:
+  /**
+   * @brief A single column of per point data
+   */
+  struct Column
+  {
+    std::string name;
+    EbsdLib::NumericTypes::Type type = EbsdLib::NumericTypes::Type::UnknownNumType;
+    const void* data = nullptr;
+  };
+
+  /**
+   * @brief A column the reader expects from the cache and the array it is copied into
+   */
+  struct Destination
+  {
+    std::string name;
+    EbsdLib::NumericTypes::Type type = EbsdLib::NumericTypes::Type::UnknownNumType;
+    void* data = nullptr;
+  };
+
+  /**
+   * @brief Returns the path of the cache file for a source file
+   */
+  static std::string CacheFilePath(const std::string& sourceFile);
+
+  /**
+   * @brief Writes the cache file for a source file
+   * @param sourceFile The text file the data was parsed from
+   * @param readerName The name of the reader class, so that the cache is only reused by the same kind of reader
+   * @param numElements The number of values in each column
+   * @param numFeatures The number of data columns the reader found in the file
+   * @param columns The columns to store
+   * @return true if the cache was written
+   */
+  static bool Write(const std::string& sourceFile, const std::string& readerName, size_t numElements, int32_t numFeatures, const std::vector<Column>& columns);
+
+  /**
+   * @brief Reads the cache file for a source file if it is still valid
+   * @param sourceFile The text file the data was parsed from
+   * @param readerName The name of the reader class
+   * @param numElements The number of values each column must have
+   * @param numFeatures [output] The number of data columns the reader found in the file
+   * @param destinations Every column the reader expects and where it is copied to
+   * @return true if the cache holds exactly the expected columns with matching types and all of them were read. On
+   * false the destinations are left untouched and the source file has to be parsed.
+   */
+  static bool Read(const std::string& sourceFile, const std::string& readerName, size_t numElements, int32_t& numFeatures, const std::vector<Destination>& destinations);
+
+  /**
+   * @brief Returns the size in bytes of a single value of a numeric type
+   */
+  static size_t SizeOfType(EbsdLib::NumericTypes::Type type);
+};
@@ -0,0 +1,494 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "EbsdHeaderScanner.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "EbsdLib/IO/HKL/CtfConstants.h"
+#include "EbsdLib/IO/HKL/CtfPhase.h"
+#include "EbsdLib/IO/TSL/AngConstants.h"
+#include "EbsdLib/IO/TSL/AngPhase.h"
+
+namespace
+{
+/**
+ * @brief Walks the complete lines of a buffer. A line is complete once its newline has been read, or when the buffer
+ * holds the rest of the file.
+ */
+class LineCursor
+{
+public:
+  LineCursor(const char* buffer, size_t length, bool endOfFile)
+  : m_Buffer(buffer)
+  , m_Length(length)
+  , m_EndOfFile(endOfFile)
+  {
+  }
+
+  bool next(std::string_view& line)
+  {
+    m_LineStart = m_Offset;
+    if(m_Offset >= m_Length)
+    {
+      return false;
+    }
+    const char* start = m_Buffer + m_Offset;
+    const char* newline = static_cast<const char*>(std::memchr(start, '\n', m_Length - m_Offset));
+    size_t lineLength = 0;
+    if(newline != nullptr)
+    {
+      lineLength = static_cast<size_t>(newline - start);
+      m_Offset += lineLength + 1;
+    }
+    else if(m_EndOfFile)
+    {
+      lineLength = m_Length - m_Offset;
+      m_Offset = m_Length;
+    }
+    else
+    {
+      return false;
+    }
+    if(lineLength > 0 && start[lineLength - 1] == '\r')
+    {
+      lineLength--;
+    }
+    line = std::string_view(start, lineLength);
+    return true;
+  }
+
+  /**
+   * @brief Returns the offset of the line that was returned last
+   */
+  size_t lineStart() const
+  {
+    return m_LineStart;
+  }
+
+  size_t offset() const
+  {
+    return m_Offset;
+  }
+
+private:
+  const char* m_Buffer;
+  size_t m_Length;
+  bool m_EndOfFile;
+  size_t m_Offset = 0;
+  size_t m_LineStart = 0;
+};
+
+// -----------------------------------------------------------------------------
+std::string_view Trimmed(std::string_view text)
+{
+  while(!text.empty() && std::isspace(static_cast<unsigned char>(text.front())) != 0)
+  {
+    text.remove_prefix(1);
+  }
+  while(!text.empty() && std::isspace(static_cast<unsigned char>(text.back())) != 0)
+  {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+// -----------------------------------------------------------------------------
+std::string_view NextWord(std::string_view& text)
+{
+  text = Trimmed(text);
+  size_t end = 0;
+  while(end < text.size() && std::isspace(static_cast<unsigned char>(text[end])) == 0)
+  {
+    end++;
+  }
+  std::string_view word = text.substr(0, end);
+  text.remove_prefix(end);
+  return word;
+}
+
+// -----------------------------------------------------------------------------
+std::string_view NextField(std::string_view& text, char delimiter)
+{
+  size_t end = text.find(delimiter);
+  std::string_view field = text.substr(0, end);
+  text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+  return Trimmed(field);
+}
+
+// -----------------------------------------------------------------------------
+int32_t ParseInt(std::string_view text)
+{
+  text = Trimmed(text);
+  int32_t value = 0;
+  std::from_chars(text.data(), text.data() + text.size(), value);
+  return value;
+}
+
+// -----------------------------------------------------------------------------
+float ParseFloat(std::string_view text)
+{
+  // Copy into a small buffer so strtof sees a terminated string. HKL files written with European settings use ','
+  // as the decimal separator.
+  text = Trimmed(text);
+  char value[64] = {0};
+  const size_t length = std::min(text.size(), sizeof(value) - 1);
+  for(size_t i = 0; i < length; i++)
+  {
+    value[i] = (text[i] == ',') ? '.' : text[i];
+  }
+  return std::strtof(value, nullptr);
+}
+
+// -----------------------------------------------------------------------------
+void StorePhase(EbsdHeaderScanner::HeaderInfo& info, int32_t phase, uint32_t crystalStructure)
+{
+  if(phase >= 0 && static_cast<size_t>(phase) < EbsdHeaderScanner::k_MaxPhases)
+  {
+    info.crystalStructures[phase] = crystalStructure;
+  }
+}
+
+// -----------------------------------------------------------------------------
+EbsdHeaderScanner::HeaderInfo ScanFileWithBuffer(const std::string& filePath, std::vector<char>& buffer)
+{
+  EbsdHeaderScanner::HeaderInfo info;
+  info.fileType = EbsdHeaderScanner::GetFileType(filePath);
+  if(info.fileType == EbsdHeaderScanner::FileType::Unknown)
+  {
+    info.errorCode = -101;
+    return info;
+  }
+  std::FILE* file = std::fopen(filePath.c_str(), "rb");
+  if(file == nullptr)
+  {
+    info.errorCode = -100;
+    return info;
+  }
+
+  // A single read is enough for nearly every header. Files with long notes sections are read further until the
+  // header ends or gets unreasonably long.
+  size_t length = 0;
+  bool endOfFile = false;
+  size_t readSize = EbsdHeaderScanner::k_DefaultReadSize;
+  while(true)
+  {
+    if(buffer.size() < length + readSize)
+    {
+      buffer.resize(length + readSize);
+    }
+    const size_t numRead = std::fread(buffer.data() + length, 1, readSize, file);
+    length += numRead;
+    endOfFile = (numRead < readSize);
+
+    if(info.fileType == EbsdHeaderScanner::FileType::Ang)
+    {
+      info = EbsdHeaderScanner::ScanAngHeader(buffer.data(), length, endOfFile);
+    }
+    else
+    {
+      info = EbsdHeaderScanner::ScanCtfHeader(buffer.data(), length, endOfFile);
+    }
+    if(info.errorCode != -102 || endOfFile || length >= EbsdHeaderScanner::k_MaxHeaderSize)
+    {
+      break;
+    }
+    readSize = length;
+  }
+  std::fclose(file);
+  return info;
+}
+} // namespace
+
+namespace Detail
+{
+/**
+ * @brief The ScanFilesImpl class scans the headers of a range of files, reusing one read buffer for the whole range
+ */
+class ScanFilesImpl
+{
+public:
+  ScanFilesImpl(const std::vector<std::string>& filePaths, std::vector<EbsdHeaderScanner::HeaderInfo>& headers)
+  : m_FilePaths(filePaths)
+  , m_Headers(headers)
+  {
+  }
+  virtual ~ScanFilesImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    std::vector<char> buffer(EbsdHeaderScanner::k_DefaultReadSize);
+    for(size_t i = start; i < end; i++)
+    {
+      m_Headers[i] = ScanFileWithBuffer(m_FilePaths[i], buffer);
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<std::string>& m_FilePaths;
+  std::vector<EbsdHeaderScanner::HeaderInfo>& m_Headers;
+};
+} // namespace Detail
+
+// -----------------------------------------------------------------------------
+EbsdHeaderScanner::FileType EbsdHeaderScanner::GetFileType(const std::string& filePath)
+{
+  const size_t dot = filePath.find_last_of('.');
+  if(dot == std::string::npos || filePath.size() - dot != 4)
+  {
+    return FileType::Unknown;
+  }
+  std::string extension = filePath.substr(dot + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  if(extension == "ang")
+  {
+    return FileType::Ang;
+  }
+  if(extension == "ctf")
+  {
+    return FileType::Ctf;
+  }
+  return FileType::Unknown;
+}
+
+// -----------------------------------------------------------------------------
+EbsdHeaderScanner::HeaderInfo EbsdHeaderScanner::ScanFile(const std::string& filePath)
+{
+  std::vector<char> buffer(k_DefaultReadSize);
+  return ScanFileWithBuffer(filePath, buffer);
+}
+
+// -----------------------------------------------------------------------------
+std::vector<EbsdHeaderScanner::HeaderInfo> EbsdHeaderScanner::ScanFiles(const std::vector<std::string>& filePaths)
+{
+  std::vector<HeaderInfo> headers(filePaths.size());
+  Detail::ScanFilesImpl impl(filePaths, headers);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, filePaths.size()), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, filePaths.size());
+#endif
+  return headers;
+}
+
+// -----------------------------------------------------------------------------
+EbsdHeaderScanner::HeaderInfo EbsdHeaderScanner::ScanAngHeader(const char* buffer, size_t length, bool endOfFile)
+{
+  HeaderInfo info;
+  info.fileType = FileType::Ang;
+  info.errorCode = -102;
+
+  LineCursor cursor(buffer, length, endOfFile);
+  std::string_view line;
+  bool insideNotes = false;
+  bool insideColumnNotes = false;
+  while(cursor.next(line))
+  {
+    if(line.empty() || line[0] != '#')
+    {
+      info.headerSize = cursor.lineStart();
+      info.errorCode = 0;
+      break;
+    }
+    std::string_view text = line.substr(1);
+    std::string_view key = NextWord(text);
+    if(!key.empty() && key.back() == ':')
+    {
+      key.remove_suffix(1);
+    }
+    std::string_view value = NextWord(text);
+
+    // Version 7 files have free text notes sections
+    if(key == "NOTES" || key == "COLUMN_NOTES")
+    {
+      if(value == "Start" || value == "End")
+      {
+        (key == "NOTES" ? insideNotes : insideColumnNotes) = (value == "Start");
+      }
+      continue;
+    }
+    if(insideNotes || insideColumnNotes)
+    {
+      continue;
+    }
+
+    if(key == EbsdLib::Ang::Phase)
+    {
+      info.numPhases++;
+    }
+    else if(key == EbsdLib::Ang::Symmetry && info.numPhases > 0)
+    {
+      StorePhase(info, info.numPhases - 1, AngPhase::DetermineLaueGroup(static_cast<uint32_t>(ParseInt(value))));
+    }
+    else if(key == EbsdLib::Ang::Grid)
+    {
+      if(value.find(EbsdLib::Ang::SquareGrid) == 0)
+      {
+        info.gridType = GridType::Square;
+      }
+      else if(value.find(EbsdLib::Ang::HexGrid) == 0)
+      {
+        info.gridType = GridType::Hex;
+      }
+    }
+    else if(key == EbsdLib::Ang::XStep)
+    {
+      info.xStep = ParseFloat(value);
+    }
+    else if(key == EbsdLib::Ang::YStep)
+    {
+      info.yStep = ParseFloat(value);
+    }
+    else if(key == EbsdLib::Ang::NColsOdd)
+    {
+      info.xCells = ParseInt(value);
+    }
+    else if(key == EbsdLib::Ang::NColsEven)
+    {
+      info.xCellsEven = ParseInt(value);
+    }
+    else if(key == EbsdLib::Ang::NRows)
+    {
+      info.yCells = ParseInt(value);
+    }
+  }
+  if(info.errorCode == -102 && endOfFile && cursor.offset() >= length)
+  {
+    // A file that is nothing but a header
+    info.headerSize = length;
+    info.errorCode = 0;
+  }
+
+  // The same point count AngReader computes before it reads the data
+  const uint64_t numRows = static_cast<uint64_t>(std::max(info.yCells, 0));
+  const uint64_t numOddCols = static_cast<uint64_t>(std::max(info.xCells, 0));
+  const uint64_t numEvenCols = static_cast<uint64_t>(std::max(info.xCellsEven, 0));
+  if(info.gridType == GridType::Square)
+  {
+    info.numberOfPoints = numRows * (numOddCols > 0 ? numOddCols : numEvenCols);
+  }
+  else if(info.gridType == GridType::Hex)
+  {
+    info.numberOfPoints = ((numRows + 1) / 2) * numOddCols + (numRows / 2) * numEvenCols;
+  }
+  return info;
+}
+
+// -----------------------------------------------------------------------------
+EbsdHeaderScanner::HeaderInfo EbsdHeaderScanner::ScanCtfHeader(const char* buffer, size_t length, bool endOfFile)
+{
+  HeaderInfo info;
+  info.fileType = FileType::Ctf;
+  info.gridType = GridType::Square;
+  info.errorCode = -102;
+
+  LineCursor cursor(buffer, length, endOfFile);
+  std::string_view line;
+  while(info.errorCode == -102 && cursor.next(line))
+  {
+    std::string_view text = line;
+    std::string_view key = NextField(text, '\t');
+    if(key == EbsdLib::Ctf::XCells)
+    {
+      info.xCells = ParseInt(text);
+    }
+    else if(key == EbsdLib::Ctf::YCells)
+    {
+      info.yCells = ParseInt(text);
+    }
+    else if(key == EbsdLib::Ctf::ZCells)
+    {
+      info.zCells = ParseInt(text);
+    }
+    else if(key == EbsdLib::Ctf::XStep)
+    {
+      info.xStep = ParseFloat(text);
+    }
+    else if(key == EbsdLib::Ctf::YStep)
+    {
+      info.yStep = ParseFloat(text);
+    }
+    else if(key == EbsdLib::Ctf::ZStep)
+    {
+      info.zStep = ParseFloat(text);
+    }
+    else if(key == EbsdLib::Ctf::NumPhases)
+    {
+      // One line per phase follows, then the line with the column names
+      info.numPhases = std::max(ParseInt(text), 0);
+      int32_t phase = 0;
+      for(; phase < info.numPhases && cursor.next(line); phase++)
+      {
+        std::string_view fields = line;
+        NextField(fields, '\t'); // Lattice constants
+        NextField(fields, '\t'); // Lattice angles
+        NextField(fields, '\t'); // Phase name
+        const auto laueGroup = static_cast<EbsdLib::Ctf::LaueGroupTable>(ParseInt(NextField(fields, '\t')));
+        StorePhase(info, phase, CtfPhase::DetermineLaueGroup(laueGroup));
+      }
+      if(phase == info.numPhases && cursor.next(line))
+      {
+        info.headerSize = cursor.offset();
+        info.errorCode = 0;
+      }
+      else
+      {
+        break;
+      }
+    }
+  }
+
+  info.xCellsEven = info.xCells;
+  info.numberOfPoints = static_cast<uint64_t>(std::max(info.xCells, 0)) * static_cast<uint64_t>(std::max(info.yCells, 0)) * static_cast<uint64_t>(std::max(info.zCells, 1));
+  return info;
+}
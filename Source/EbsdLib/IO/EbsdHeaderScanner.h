@@ -0,0 +1,142 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class EbsdHeaderScanner EbsdHeaderScanner.h EbsdLib/IO/EbsdHeaderScanner.h
+ * @brief The EbsdHeaderScanner class extracts the scan geometry and phase symmetries from the headers of many .ang and
+ * .ctf files. Each file is opened with a single read of its first few KB and the header is parsed in place, without
+ * building header entry or phase objects. File lists are scanned in parallel. Use AngReader or CtfReader to get the
+ * complete header of a single file.
+ */
+class EbsdLib_EXPORT EbsdHeaderScanner
+{
+public:
+  /**
+   * @brief The maximum number of phases whose crystal structure is stored in a HeaderInfo
+   */
+  static constexpr size_t k_MaxPhases = 16;
+
+  /**
+   * @brief The number of bytes read from each file before the header is parsed
+   */
+  static constexpr size_t k_DefaultReadSize = 8192;
+
+  /**
+   * @brief Headers longer than this (for example .ang files with very long notes) are reported as incomplete
+   */
+  static constexpr size_t k_MaxHeaderSize = 1048576;
+
+  enum class FileType : uint8_t
+  {
+    Unknown = 0,
+    Ang = 1,
+    Ctf = 2
+  };
+
+  enum class GridType : uint8_t
+  {
+    Unknown = 0,
+    Square = 1,
+    Hex = 2
+  };
+
+  /**
+   * @brief The header values of a single file
+   */
+  struct HeaderInfo
+  {
+    int32_t errorCode = 0;
+    FileType fileType = FileType::Unknown;
+    GridType gridType = GridType::Unknown;
+    int32_t xCells = 0; ///< NCOLS_ODD for .ang files
+    int32_t xCellsEven = 0; ///< NCOLS_EVEN for .ang files, equal to xCells for .ctf files
+    int32_t yCells = 0;
+    int32_t zCells = 1;
+    float xStep = 0.0f;
+    float yStep = 0.0f;
+    float zStep = 0.0f;
+    uint64_t numberOfPoints = 0; ///< The number of data points the header describes
+    uint64_t headerSize = 0; ///< The number of bytes before the first data line
+    int32_t numPhases = 0;
+    std::array<uint32_t, k_MaxPhases> crystalStructures = {}; ///< The first k_MaxPhases phases, in file order
+  };
+
+  /**
+   * @brief Scans the header of a single file. The file type comes from the file extension.
+   * @param filePath The .ang or .ctf file
+   * @return The header values. errorCode is -100 if the file could not be opened, -101 for an unsupported extension and
+   * -102 if the end of the header was not found.
+   */
+  static HeaderInfo ScanFile(const std::string& filePath);
+
+  /**
+   * @brief Scans the headers of many files in parallel
+   * @param filePaths The .ang or .ctf files
+   * @return One HeaderInfo per file, in the same order as filePaths
+   */
+  static std::vector<HeaderInfo> ScanFiles(const std::vector<std::string>& filePaths);
+
+  /**
+   * @brief Parses an .ang header that is already in memory
+   * @param buffer The start of the file
+   * @param length The number of valid bytes in buffer
+   * @param endOfFile Whether buffer holds the whole file
+   * @return The header values. errorCode is -102 if buffer ends before the header does.
+   */
+  static HeaderInfo ScanAngHeader(const char* buffer, size_t length, bool endOfFile);
+
+  /**
+   * @brief Parses a .ctf header that is already in memory
+   * @param buffer The start of the file
+   * @param length The number of valid bytes in buffer
+   * @param endOfFile Whether buffer holds the whole file
+   * @return The header values. errorCode is -102 if buffer ends before the header does.
+   */
+  static HeaderInfo ScanCtfHeader(const char* buffer, size_t length, bool endOfFile);
+
+  /**
+   * @brief Returns the file type for a file path based on its extension
+   */
+  static FileType GetFileType(const std::string& filePath);
+};
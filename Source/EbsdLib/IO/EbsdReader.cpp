@@ -35,6 +35,27 @@
 
 #include "EbsdReader.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+
+#include "EbsdLib/Core/EbsdTransform.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+template <typename T>
+void PermuteArray(void* ptr, const std::vector<size_t>& sourceIndex)
+{
+  T* data = static_cast<T*>(ptr);
+  std::vector<T> source(data, data + sourceIndex.size());
+  for(size_t i = 0; i < sourceIndex.size(); i++)
+  {
+    data[i] = source[sourceIndex[i]];
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -42,7 +63,11 @@ EbsdReader::EbsdReader()
 : m_ErrorCode(0)
 , m_UserZDir(EbsdLib::RefFrameZDir::LowtoHigh)
 , m_SampleTransformationAngle(0.0f)
+, m_SampleTransformationAxis({0.0f, 0.0f, 1.0f})
 , m_EulerTransformationAngle(0.0f)
+, m_EulerTransformationAxis({0.0f, 0.0f, 1.0f})
+, m_ApplyTransformations(false)
+, m_UseBinaryCache(false)
 , m_NumFeatures(0)
 , m_ManageMemory(true)
 , m_HeaderIsComplete(false)
@@ -58,6 +83,120 @@ EbsdReader::EbsdReader()
 // -----------------------------------------------------------------------------
 EbsdReader::~EbsdReader() = default;
 
+// -----------------------------------------------------------------------------
+void* EbsdReader::releasePointerByName(const std::string& /* featureName */)
+{
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+int EbsdReader::applyTransformations(const std::array<std::string, 3>& eulerNames, const std::vector<std::string>& arrayNames, bool degrees)
+{
+  const size_t numElements = getNumberOfElements();
+  const size_t xDim = static_cast<size_t>(std::max(getXDimension(), 0));
+  const size_t yDim = static_cast<size_t>(std::max(getYDimension(), 0));
+  const size_t sliceSize = xDim * yDim;
+  if(numElements == 0)
+  {
+    return 0;
+  }
+  if(sliceSize == 0 || numElements % sliceSize != 0)
+  {
+    std::stringstream ss;
+    ss << "The number of points (" << numElements << ") is not a whole number of " << xDim << " x " << yDim << " slices so the Sample transformation can not be applied.";
+    setErrorCode(-1200);
+    setErrorMessage(ss.str());
+    return -1200;
+  }
+
+  std::vector<size_t> sliceIndex;
+  bool flipsZ = false;
+  if(!EbsdTransform::SampleTransformationPermutation(m_SampleTransformationAngle, m_SampleTransformationAxis, xDim, yDim, sliceIndex, flipsZ))
+  {
+    std::stringstream ss;
+    ss << "Only 180 degree Sample transformations about the X, Y or Z axis can be applied while reading. The requested transformation was " << m_SampleTransformationAngle << " degrees about <"
+       << m_SampleTransformationAxis[0] << ", " << m_SampleTransformationAxis[1] << ", " << m_SampleTransformationAxis[2] << ">.";
+    setErrorCode(-1201);
+    setErrorMessage(ss.str());
+    return -1201;
+  }
+
+  // Extend the slice map to every slice, reversing the slice order if the flip also reverses Z
+  const size_t numSlices = numElements / sliceSize;
+  std::vector<size_t> sourceIndex;
+  if(!sliceIndex.empty() || (flipsZ && numSlices > 1))
+  {
+    sourceIndex.resize(numElements);
+    for(size_t z = 0; z < numSlices; z++)
+    {
+      const size_t sourceZ = flipsZ ? (numSlices - 1 - z) : z;
+      for(size_t i = 0; i < sliceSize; i++)
+      {
+        sourceIndex[z * sliceSize + i] = sourceZ * sliceSize + (sliceIndex.empty() ? i : sliceIndex[i]);
+      }
+    }
+  }
+
+  // The Euler angles are rotated and reordered in the same pass
+  auto* phi1 = static_cast<float*>(getPointerByName(eulerNames[0]));
+  auto* phi = static_cast<float*>(getPointerByName(eulerNames[1]));
+  auto* phi2 = static_cast<float*>(getPointerByName(eulerNames[2]));
+  if(phi1 != nullptr && phi != nullptr && phi2 != nullptr)
+  {
+    if(sourceIndex.empty())
+    {
+      EbsdTransform::TransformEulerAngles(phi1, phi, phi2, phi1, phi, phi2, numElements, m_EulerTransformationAngle, m_EulerTransformationAxis, degrees);
+    }
+    else
+    {
+      std::vector<float> source(phi1, phi1 + numElements);
+      source.insert(source.end(), phi, phi + numElements);
+      source.insert(source.end(), phi2, phi2 + numElements);
+      EbsdTransform::TransformEulerAngles(source.data(), source.data() + numElements, source.data() + 2 * numElements, phi1, phi, phi2, numElements, m_EulerTransformationAngle,
+                                          m_EulerTransformationAxis, degrees, sourceIndex.data());
+    }
+  }
+
+  if(sourceIndex.empty())
+  {
+    return 0;
+  }
+  for(const auto& name : arrayNames)
+  {
+    void* ptr = getPointerByName(name);
+    if(ptr == nullptr)
+    {
+      continue;
+    }
+    switch(getPointerType(name))
+    {
+    case EbsdLib::NumericTypes::Type::Int8:
+    case EbsdLib::NumericTypes::Type::UInt8:
+    case EbsdLib::NumericTypes::Type::Bool:
+      PermuteArray<uint8_t>(ptr, sourceIndex);
+      break;
+    case EbsdLib::NumericTypes::Type::Int16:
+    case EbsdLib::NumericTypes::Type::UInt16:
+      PermuteArray<uint16_t>(ptr, sourceIndex);
+      break;
+    case EbsdLib::NumericTypes::Type::Int32:
+    case EbsdLib::NumericTypes::Type::UInt32:
+    case EbsdLib::NumericTypes::Type::Float:
+      PermuteArray<uint32_t>(ptr, sourceIndex);
+      break;
+    case EbsdLib::NumericTypes::Type::Int64:
+    case EbsdLib::NumericTypes::Type::UInt64:
+    case EbsdLib::NumericTypes::Type::Double:
+    case EbsdLib::NumericTypes::Type::SizeT:
+      PermuteArray<uint64_t>(ptr, sourceIndex);
+      break;
+    case EbsdLib::NumericTypes::Type::UnknownNumType:
+      break;
+    }
+  }
+  return 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -35,8 +35,10 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
@@ -98,6 +100,19 @@ public:
   EBSD_INSTANCE_PROPERTY(float, EulerTransformationAngle)
   EBSD_INSTANCE_PROPERTY(TransformationType, EulerTransformationAxis)
 
+  /**
+   * @brief When true, readFile() applies the Sample and Euler transformations to the data once it is parsed. The
+   * Euler angles are rotated with a single precomputed rotation and the supported 180 degree sample flips are
+   * applied by reordering the points. The X and Y position arrays are left as they are since they describe the grid.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, ApplyTransformations)
+
+  /**
+   * @brief When true, readFile() reuses the parsed data from a binary sidecar file next to the data file
+   * (see EbsdBinaryCache) as long as the data file is unchanged, and writes that sidecar file after parsing otherwise.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, UseBinaryCache)
+
   /** @brief Sets the file name of the ebsd file to be read */
   /**
    * @brief Setter property for FileName
@@ -177,6 +192,15 @@ public:
    */
   virtual EbsdLib::NumericTypes::Type getPointerType(const std::string& featureName) = 0;
 
+  /**
+   * @brief Hands the memory of a data column over to the caller, who frees it with delete[] as an array of the type
+   * given by getPointerType(). The reader forgets the column, so getPointerByName() returns nullptr for it until the
+   * next read allocates a new one. The default implementation does not release anything.
+   * @param featureName The name of the feature.
+   * @return The released memory or nullptr if the column was not read or the reader does not own its memory
+   */
+  virtual void* releasePointerByName(const std::string& featureName);
+
   /**
    * @brief freePointerByName
    * @param featureName
@@ -224,6 +248,25 @@ public:
     }
   }
 
+  /**
+   * @brief Hands memory that was allocated with allocateArray() over to the caller and sets the pointer passed in to
+   * nullptr. Nothing is released if the reader does not own the memory.
+   * @param ptr The pointer to be released.
+   * @param cleanup The Cleanup flag of the pointer property
+   * @return The released memory or nullptr
+   */
+  template <typename T>
+  void* releaseArrayData(T*& ptr, bool cleanup)
+  {
+    if(ptr == nullptr || !cleanup || !this->m_ManageMemory)
+    {
+      return nullptr;
+    }
+    void* released = static_cast<void*>(ptr);
+    ptr = nullptr;
+    return released;
+  }
+
 #ifdef EbsdLib_ENABLE_HDF5
 
   /**
@@ -285,6 +328,16 @@ public:
 protected:
   std::map<std::string, EbsdHeaderEntry::Pointer> m_HeaderMap;
 
+  /**
+   * @brief Applies the Sample and Euler transformations to the parsed data in a single pass over each array. Volume
+   * data is handled as getNumberOfElements() / (X Dimension * Y Dimension) slices.
+   * @param eulerNames The names of the phi1, Phi and phi2 arrays
+   * @param arrayNames The names of the other per point arrays that move with the sample transformation
+   * @param degrees True if the Euler angles are stored in degrees instead of radians
+   * @return 0 on success or a negative error code, which is also set on the reader
+   */
+  int applyTransformations(const std::array<std::string, 3>& eulerNames, const std::vector<std::string>& arrayNames, bool degrees);
+
 public:
   EbsdReader(const EbsdReader&) = delete;            // Copy Constructor Not Implemented
   EbsdReader(EbsdReader&&) = delete;                 // Move Constructor Not Implemented
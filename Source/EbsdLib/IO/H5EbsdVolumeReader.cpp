@@ -43,6 +43,7 @@ H5EbsdVolumeReader::H5EbsdVolumeReader()
 : m_Cancel(false)
 , m_SliceStart(0)
 , m_SliceEnd(0)
+, m_ApplyTransformations(false)
 , m_ManageMemory(true)
 , m_NumberOfElements(0)
 , m_ReadAllArrays(true)
@@ -91,6 +91,12 @@ public:
    */
   EBSD_INSTANCE_PROPERTY(int, SliceEnd)
 
+  /**
+   * @brief When true, loadData() applies the Sample and Euler transformations stored in the file while it copies each
+   * slice into the volume. The supported sample transformations are the 180 degree flips about the X, Y or Z axis.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, ApplyTransformations)
+
   /**
    * @brief This method does the actual loading of the OIM data from the data
    * source (files, streams, etc) into the data structures. Subclasses need to
@@ -130,8 +130,14 @@ void CtfPhase::printSelf(std::ostream& stream)
 // -----------------------------------------------------------------------------
 unsigned int CtfPhase::determineLaueGroup()
 {
-  EbsdLib::Ctf::LaueGroupTable symmetry = getLaueGroup();
+  return DetermineLaueGroup(getLaueGroup());
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+unsigned int CtfPhase::DetermineLaueGroup(EbsdLib::Ctf::LaueGroupTable symmetry)
+{
   switch(symmetry)
   {
   case EbsdLib::Ctf::LG_Triclinic:
@@ -136,6 +136,12 @@ public:
    */
   unsigned int determineLaueGroup();
 
+  /**
+   * @brief Returns the type of crystal structure for an HKL Laue group value
+   * @param symmetry The Laue group column of a phase line
+   */
+  static unsigned int DetermineLaueGroup(EbsdLib::Ctf::LaueGroupTable symmetry);
+
   std::string getMaterialName();
 
 protected:
@@ -42,6 +42,7 @@
 
 #include "CtfPhase.h"
 #include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/IO/EbsdBinaryCache.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 
@@ -164,6 +165,19 @@ void* CtfReader::getPointerByName(const std::string& featureName)
   return ptr;
 }
 
+// -----------------------------------------------------------------------------
+void* CtfReader::releasePointerByName(const std::string& featureName)
+{
+  auto iter = m_NamePointerMap.find(featureName);
+  if(iter == m_NamePointerMap.end() || !iter->second->getManageMemory())
+  {
+    return nullptr;
+  }
+  void* ptr = iter->second->getVoidPointer();
+  iter->second->setVoidPointer(nullptr);
+  return ptr;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -459,6 +473,18 @@ int CtfReader::readFile()
   }
 
   err = readData(in);
+  if(err >= 0 && getApplyTransformations())
+  {
+    std::vector<std::string> arrayNames;
+    for(const auto& name : getColumnNames())
+    {
+      if(name != EbsdLib::Ctf::X && name != EbsdLib::Ctf::Y && name != EbsdLib::Ctf::Z && name != EbsdLib::Ctf::Euler1 && name != EbsdLib::Ctf::Euler2 && name != EbsdLib::Ctf::Euler3)
+      {
+        arrayNames.push_back(name);
+      }
+    }
+    err = applyTransformations({EbsdLib::Ctf::Euler1, EbsdLib::Ctf::Euler2, EbsdLib::Ctf::Euler3}, arrayNames, true);
+  }
 
   return err;
 }
@@ -582,10 +608,25 @@ int CtfReader::readData(std::ifstream& in)
     }
   }
 
+  // An unchanged file that was parsed before is loaded from its binary cache instead of being tokenized again. Reads
+  // of a single slice always parse the text.
+  const bool useBinaryCache = getUseBinaryCache() && m_SingleSliceRead < 0;
+  bool loadedFromCache = false;
+  if(useBinaryCache)
+  {
+    int32_t numFeatures = getNumFeatures();
+    std::vector<EbsdBinaryCache::Destination> destinations;
+    for(const auto& entry : m_NamePointerMap)
+    {
+      destinations.push_back({entry.first, getPointerType(entry.first), entry.second->getVoidPointer()});
+    }
+    loadedFromCache = EbsdBinaryCache::Read(getFileName(), getNameOfClass(), totalScanPoints, numFeatures, destinations);
+  }
+
   // Now start reading the data line by line
   int err = 0;
   size_t counter = 0;
-  for(int slice = zStart; slice < zEnd; ++slice)
+  for(int slice = zStart; slice < zEnd && !loadedFromCache; ++slice)
   {
     for(size_t row = 0; row < yCells; ++row)
     {
@@ -631,6 +672,16 @@ int CtfReader::readData(std::ifstream& in)
     setErrorCode(-105);
     return -105;
   }
+
+  if(useBinaryCache && !loadedFromCache)
+  {
+    std::vector<EbsdBinaryCache::Column> columns;
+    for(const auto& entry : m_NamePointerMap)
+    {
+      columns.push_back({entry.first, getPointerType(entry.first), entry.second->getVoidPointer()});
+    }
+    EbsdBinaryCache::Write(getFileName(), getNameOfClass(), totalScanPoints, getNumFeatures(), columns);
+  }
   return 0;
 }
 
@@ -127,6 +127,12 @@ public:
    * @param featureName The name of the feature to return the pointer to.
    */
   void* getPointerByName(const std::string& featureName) override;
+
+  /**
+   * @brief Hands the memory of a data column over to the caller. See EbsdReader::releasePointerByName()
+   * @param featureName The name of the feature.
+   */
+  void* releasePointerByName(const std::string& featureName) override;
   //  void setPointerByName(const std::string& name, void* p);
 
   /**
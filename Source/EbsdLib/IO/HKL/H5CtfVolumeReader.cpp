@@ -36,11 +36,13 @@
 #include "H5CtfVolumeReader.h"
 
 #include <cmath>
+#include <vector>
 
 #include "H5Support/H5Lite.h"
 #include "H5Support/H5Utilities.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/EbsdTransform.h"
 #include "EbsdLib/IO/HKL/H5CtfReader.h"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
 
@@ -312,6 +314,26 @@ int H5CtfVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoint
     xstartspot = static_cast<int>((xpointstemp - xpointsslice) / 2);
     ystartspot = static_cast<int>((ypointstemp - ypointsslice) / 2);
 
+    // The Euler angles of the slice are rotated in place. The sample flip is done on the volume grid, so the data of
+    // the slice goes where a flip of the assembled volume would put it. The X/Y positions are not moved.
+    std::vector<size_t> destIndex;
+    bool flipsZ = false;
+    if(getApplyTransformations())
+    {
+      if(!EbsdTransform::SlicePlacementIndex(getSampleTransformationAngle(), getSampleTransformationAxis(), static_cast<size_t>(xpointsslice), static_cast<size_t>(ypointsslice),
+                                             static_cast<size_t>(xpointstemp), static_cast<size_t>(ypointstemp), destIndex, flipsZ))
+      {
+        setErrorCode(-77001);
+        setErrorMessage("Only 180 degree Sample transformations about the X, Y or Z axis of slices no larger than the volume can be applied while loading the data");
+        return getErrorCode();
+      }
+      if(nullptr != euler1Ptr && nullptr != euler2Ptr && nullptr != euler3Ptr)
+      {
+        EbsdTransform::TransformEulerAngles(euler1Ptr, euler2Ptr, euler3Ptr, euler1Ptr, euler2Ptr, euler3Ptr, static_cast<size_t>(xpointsslice * ypointsslice), getEulerTransformationAngle(),
+                                            getEulerTransformationAxis(), true);
+      }
+    }
+
     // If no stacking order preference was passed, read it from the file and use that value
     if(ZDir == EbsdLib::RefFrameZDir::UnknownRefFrameZDirection)
     {
@@ -326,23 +348,30 @@ int H5CtfVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoint
       zval = static_cast<int>((zpoints - 1) - slice);
     }
 
+    if(flipsZ)
+    {
+      zval = static_cast<int>((zpoints - 1) - zval);
+    }
+
     // Copy the data from the current storage into the Storage Location
     for(int64_t j = 0; j < ypointsslice; j++)
     {
       for(int64_t i = 0; i < xpointsslice; i++)
       {
-        index = static_cast<int32_t>((zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot));
+        const int64_t placed = ((j + ystartspot) * xpointstemp) + (i + xstartspot);
+        const auto positionIndex = static_cast<int32_t>((zval * xpointstemp * ypointstemp) + placed);
+        index = static_cast<int32_t>((zval * xpointstemp * ypointstemp) + (destIndex.empty() ? placed : static_cast<int64_t>(destIndex[readerIndex])));
         if(nullptr != phasePtr)
         {
           m_Phase[index] = phasePtr[readerIndex];
         }
         if(nullptr != xPtr)
         {
-          m_X[index] = xPtr[readerIndex];
+          m_X[positionIndex] = xPtr[readerIndex];
         }
         if(nullptr != yPtr)
         {
-          m_Y[index] = yPtr[readerIndex];
+          m_Y[positionIndex] = yPtr[readerIndex];
         }
         if(nullptr != bandPtr)
         {
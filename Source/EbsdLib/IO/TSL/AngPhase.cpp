@@ -288,7 +288,14 @@ void AngPhase::printSelf(std::stringstream& stream)
 // -----------------------------------------------------------------------------
 unsigned int AngPhase::determineLaueGroup()
 {
-  uint32_t symmetry = getSymmetry();
+  return DetermineLaueGroup(getSymmetry());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+unsigned int AngPhase::DetermineLaueGroup(uint32_t symmetry)
+{
   unsigned int crystal_structure = EbsdLib::CrystalStructure::UnknownCrystalStructure;
 
   switch(symmetry)
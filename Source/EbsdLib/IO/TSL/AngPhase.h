@@ -217,6 +217,12 @@ public:
    */
   unsigned int determineLaueGroup();
 
+  /**
+   * @brief Returns the type of crystal structure for a TSL symmetry value
+   * @param symmetry The value of the 'Symmetry' header entry
+   */
+  static unsigned int DetermineLaueGroup(uint32_t symmetry);
+
 private:
   std::string m_MaterialName = {};
   std::string m_Formula = {};
@@ -36,14 +36,105 @@
 #include "AngReader.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <sstream>
+#include <type_traits>
+#include <vector>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
 
 #include "AngConstants.h"
+#include "AngFields.h"
 
 #include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/IO/EbsdBinaryCache.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 
+namespace Detail
+{
+/**
+ * @brief The HexToSquareGridImpl class finds, for every point of a square grid, the index of the nearest point of a
+ * hexagonal grid. The hexagonal rows are described by their Y value, the X value of their first point and their
+ * position in the parsed arrays, so both the odd/even row offset and the row spacing come from the data itself.
+ */
+class HexToSquareGridImpl
+{
+public:
+  HexToSquareGridImpl(const std::vector<float>& rowY, const std::vector<float>& rowX, const std::vector<size_t>& rowStart, const std::vector<size_t>& rowSize, float hexStep, float xOrigin,
+                      float yOrigin, float squareStep, size_t numSquareCols, size_t* sourceIndex)
+  : m_RowY(rowY)
+  , m_RowX(rowX)
+  , m_RowStart(rowStart)
+  , m_RowSize(rowSize)
+  , m_HexStep(hexStep)
+  , m_XOrigin(xOrigin)
+  , m_YOrigin(yOrigin)
+  , m_SquareStep(squareStep)
+  , m_NumSquareCols(numSquareCols)
+  , m_SourceIndex(sourceIndex)
+  {
+  }
+  virtual ~HexToSquareGridImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t numRows = m_RowY.size();
+    for(size_t i = start; i < end; i++)
+    {
+      const float x = m_XOrigin + static_cast<float>(i % m_NumSquareCols) * m_SquareStep;
+      const float y = m_YOrigin + static_cast<float>(i / m_NumSquareCols) * m_SquareStep;
+
+      // The nearest hexagonal point is always in one of the two rows that bracket y
+      size_t upper = static_cast<size_t>(std::upper_bound(m_RowY.begin(), m_RowY.end(), y) - m_RowY.begin());
+      size_t firstRow = (upper == 0) ? 0 : upper - 1;
+      size_t lastRow = std::min(upper, numRows - 1);
+
+      float bestDistance = std::numeric_limits<float>::max();
+      size_t best = 0;
+      for(size_t row = firstRow; row <= lastRow; row++)
+      {
+        float col = std::round((x - m_RowX[row]) / m_HexStep);
+        col = std::min(std::max(col, 0.0f), static_cast<float>(m_RowSize[row] - 1));
+        const float dx = x - (m_RowX[row] + col * m_HexStep);
+        const float dy = y - m_RowY[row];
+        const float distance = dx * dx + dy * dy;
+        if(distance < bestDistance)
+        {
+          bestDistance = distance;
+          best = m_RowStart[row] + static_cast<size_t>(col);
+        }
+      }
+      m_SourceIndex[i] = best;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<float>& m_RowY;
+  const std::vector<float>& m_RowX;
+  const std::vector<size_t>& m_RowStart;
+  const std::vector<size_t>& m_RowSize;
+  float m_HexStep;
+  float m_XOrigin;
+  float m_YOrigin;
+  float m_SquareStep;
+  size_t m_NumSquareCols;
+  size_t* m_SourceIndex;
+};
+} // namespace Detail
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -64,6 +155,8 @@ AngReader::AngReader()
   setNumFeatures(10);
 
   m_ReadHexGrid = false;
+  m_ConvertHexGridToSquareGrid = false;
+  m_SquareGridStep = 0.0f;
 
   // Initialize the map of header key to header value
   m_HeaderMap[EbsdLib::Ang::TEMPIXPerUM] = AngHeaderEntry<float>::NewEbsdHeaderEntry(EbsdLib::Ang::TEMPIXPerUM);
@@ -200,6 +293,52 @@ void* AngReader::getPointerByName(const std::string& featureName)
   return nullptr;
 }
 
+// -----------------------------------------------------------------------------
+void* AngReader::releasePointerByName(const std::string& featureName)
+{
+  if(featureName == EbsdLib::Ang::Phi1)
+  {
+    return releaseArrayData(m_Phi1, m_Phi1Cleanup);
+  }
+  if(featureName == EbsdLib::Ang::Phi)
+  {
+    return releaseArrayData(m_Phi, m_PhiCleanup);
+  }
+  if(featureName == EbsdLib::Ang::Phi2)
+  {
+    return releaseArrayData(m_Phi2, m_Phi2Cleanup);
+  }
+  if(featureName == EbsdLib::Ang::ImageQuality)
+  {
+    return releaseArrayData(m_Iq, m_IqCleanup);
+  }
+  if(featureName == EbsdLib::Ang::ConfidenceIndex)
+  {
+    return releaseArrayData(m_Ci, m_CiCleanup);
+  }
+  if(featureName == EbsdLib::Ang::PhaseData)
+  {
+    return releaseArrayData(m_PhaseData, m_PhaseDataCleanup);
+  }
+  if(featureName == EbsdLib::Ang::XPosition)
+  {
+    return releaseArrayData(m_X, m_XCleanup);
+  }
+  if(featureName == EbsdLib::Ang::YPosition)
+  {
+    return releaseArrayData(m_Y, m_YCleanup);
+  }
+  if(featureName == EbsdLib::Ang::SEMSignal)
+  {
+    return releaseArrayData(m_SEMSignal, m_SEMSignalCleanup);
+  }
+  if(featureName == EbsdLib::Ang::Fit)
+  {
+    return releaseArrayData(m_Fit, m_FitCleanup);
+  }
+  return nullptr;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -343,6 +482,11 @@ int AngReader::readFile()
   }
   // We need to pass in the buffer because it has the first line of data
   readData(in, buf);
+  if(getErrorCode() >= 0 && getApplyTransformations())
+  {
+    applyTransformations({EbsdLib::Ang::Phi1, EbsdLib::Ang::Phi, EbsdLib::Ang::Phi2},
+                         {EbsdLib::Ang::ImageQuality, EbsdLib::Ang::ConfidenceIndex, EbsdLib::Ang::PhaseData, EbsdLib::Ang::SEMSignal, EbsdLib::Ang::Fit}, false);
+  }
 
   return getErrorCode();
 }
@@ -384,13 +528,13 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
       totalDataPoints = 0;
     }
   }
-  else if(grid.find(EbsdLib::Ang::HexGrid) == 0 && !m_ReadHexGrid)
+  else if(grid.find(EbsdLib::Ang::HexGrid) == 0 && !m_ReadHexGrid && !m_ConvertHexGridToSquareGrid)
   {
     setErrorCode(-400);
-    setErrorMessage("Ang Files with Hex Grids Are NOT currently supported - Try converting them to Square Grid with the Hex2Sqr Converter filter.");
+    setErrorMessage("Ang Files with Hex Grids Are NOT read by default - Enable ConvertHexGridToSquareGrid on the reader to resample them onto a Square Grid.");
     return;
   }
-  else if(grid.find(EbsdLib::Ang::HexGrid) == 0 && m_ReadHexGrid)
+  else if(grid.find(EbsdLib::Ang::HexGrid) == 0)
   {
     bool evenRow = false;
     totalDataPoints = 0;
@@ -449,6 +593,27 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
     return;
   }
 
+  // An unchanged file that was parsed before is loaded from its binary cache instead of being tokenized again
+  bool loadedFromCache = false;
+  if(getUseBinaryCache())
+  {
+    int32_t numFeatures = getNumFeatures();
+    std::vector<EbsdBinaryCache::Destination> destinations;
+    for(const auto& name : AngFields().getFieldNames())
+    {
+      void* ptr = getPointerByName(name);
+      if(ptr != nullptr)
+      {
+        destinations.push_back({name, getPointerType(name), ptr});
+      }
+    }
+    loadedFromCache = EbsdBinaryCache::Read(getFileName(), "AngReader", totalDataPoints, numFeatures, destinations);
+    if(loadedFromCache)
+    {
+      setNumFeatures(numFeatures);
+    }
+  }
+
   size_t counter = 1; // Because we are on the first line now.
 
   bool onEvenRow = false;
@@ -460,7 +625,7 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
   int nxEven = 0;
   // int nRows = 0;
 
-  for(size_t i = 0; i < totalDataPoints; ++i)
+  for(size_t i = 0; i < totalDataPoints && !loadedFromCache; ++i)
   {
     if(i > 0)
     {
@@ -534,9 +699,125 @@ void AngReader::readData(std::ifstream& in, std::string& buf)
        << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
     setErrorMessage(ss.str());
     setErrorCode(-600);
+    return;
+  }
+
+  if(getUseBinaryCache() && !loadedFromCache)
+  {
+    std::vector<EbsdBinaryCache::Column> columns;
+    for(const auto& name : AngFields().getFieldNames())
+    {
+      void* ptr = getPointerByName(name);
+      if(ptr != nullptr)
+      {
+        columns.push_back({name, getPointerType(name), ptr});
+      }
+    }
+    EbsdBinaryCache::Write(getFileName(), "AngReader", totalDataPoints, getNumFeatures(), columns);
+  }
+
+  if(grid.find(EbsdLib::Ang::HexGrid) == 0 && m_ConvertHexGridToSquareGrid)
+  {
+    convertHexGridToSquareGrid();
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AngReader::convertHexGridToSquareGrid()
+{
+  // Describe each hexagonal row. Rows alternate between the odd and even column counts starting with an odd row.
+  const size_t totalDataPoints = getNumberOfElements();
+  const size_t numOddCols = static_cast<size_t>(std::max(getNumOddCols(), 0));
+  const size_t numEvenCols = static_cast<size_t>(std::max(getNumEvenCols(), 0));
+  std::vector<float> rowY;
+  std::vector<float> rowX;
+  std::vector<size_t> rowStart;
+  std::vector<size_t> rowSize;
+  size_t start = 0;
+  for(int row = 0; row < getNumRows(); row++)
+  {
+    size_t count = (row % 2 == 0) ? numOddCols : numEvenCols;
+    if(count == 0 || start + count > totalDataPoints)
+    {
+      break;
+    }
+    rowY.push_back(m_Y[start]);
+    rowX.push_back(m_X[start]);
+    rowStart.push_back(start);
+    rowSize.push_back(count);
+    start += count;
+  }
+  if(rowY.empty() || !std::is_sorted(rowY.begin(), rowY.end()))
+  {
+    setErrorCode(-410);
+    setErrorMessage("The rows of the Hex Grid could not be determined from the Y positions of the data so it can not be converted to a Square Grid.");
+    return;
+  }
+
+  const float hexStep = getXStep();
+  const float squareStep = (m_SquareGridStep > 0.0f) ? m_SquareGridStep : hexStep;
+  const float xOrigin = *std::min_element(rowX.begin(), rowX.end());
+  float xMax = xOrigin;
+  for(size_t row = 0; row < rowX.size(); row++)
+  {
+    xMax = std::max(xMax, rowX[row] + static_cast<float>(rowSize[row] - 1) * hexStep);
+  }
+  const float yOrigin = rowY.front();
+  // The small tolerance keeps a point that lands on the last row or column from being lost to rounding
+  const size_t numSquareCols = static_cast<size_t>(std::floor((xMax - xOrigin) / squareStep + 1.0E-4f)) + 1;
+  const size_t numSquareRows = static_cast<size_t>(std::floor((rowY.back() - yOrigin) / squareStep + 1.0E-4f)) + 1;
+  const size_t numSquarePoints = numSquareCols * numSquareRows;
+
+  std::vector<size_t> sourceIndex(numSquarePoints);
+  Detail::HexToSquareGridImpl impl(rowY, rowX, rowStart, rowSize, hexStep, xOrigin, yOrigin, squareStep, numSquareCols, sourceIndex.data());
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numSquarePoints), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, numSquarePoints);
+#endif
+
+  auto resample = [&](auto*& data) {
+    if(data == nullptr)
+    {
+      return;
+    }
+    using T = std::remove_reference_t<decltype(*data)>;
+    T* squareData = allocateArray<T>(numSquarePoints);
+    for(size_t i = 0; i < numSquarePoints; i++)
+    {
+      squareData[i] = data[sourceIndex[i]];
+    }
+    deallocateArrayData<T>(data);
+    data = squareData;
+  };
+  resample(m_Phi1);
+  resample(m_Phi);
+  resample(m_Phi2);
+  resample(m_Iq);
+  resample(m_Ci);
+  resample(m_PhaseData);
+  resample(m_SEMSignal);
+  resample(m_Fit);
+  resample(m_X);
+  resample(m_Y);
+  // The positions describe the square grid itself rather than the hexagonal points the values came from
+  for(size_t i = 0; i < numSquarePoints; i++)
+  {
+    m_X[i] = xOrigin + static_cast<float>(i % numSquareCols) * squareStep;
+    m_Y[i] = yOrigin + static_cast<float>(i / numSquareCols) * squareStep;
+  }
+
+  setNumberOfElements(numSquarePoints);
+  setGrid(EbsdLib::Ang::SquareGrid);
+  setXStep(squareStep);
+  setYStep(squareStep);
+  setNumOddCols(static_cast<int>(numSquareCols));
+  setNumEvenCols(static_cast<int>(numSquareCols));
+  setNumRows(static_cast<int>(numSquareRows));
+}
+
 // -----------------------------------------------------------------------------
 //  Read the Header part of the ANG file
 // -----------------------------------------------------------------------------
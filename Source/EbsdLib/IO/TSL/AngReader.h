@@ -103,6 +103,19 @@ public:
 
   EBSD_INSTANCE_PROPERTY(bool, ReadHexGrid)
 
+  /**
+   * @brief When true, HexGrid files are resampled onto a square grid right after the data is parsed. Each square grid
+   * point takes the values of the nearest hexagonal grid point. The reader then reports a SqrGrid with the new
+   * dimensions and step, so no separate Hex2Sqr conversion pass is needed. Takes precedence over ReadHexGrid.
+   */
+  EBSD_INSTANCE_PROPERTY(bool, ConvertHexGridToSquareGrid)
+
+  /**
+   * @brief The X and Y step of the square grid produced by ConvertHexGridToSquareGrid. A value of 0 (the default)
+   * uses the XStep of the hexagonal grid.
+   */
+  EBSD_INSTANCE_PROPERTY(float, SquareGridStep)
+
   EBSD_INSTANCE_PROPERTY(std::string, Notes)
   EBSD_INSTANCE_PROPERTY(std::string, ColumnNotes)
 
@@ -146,6 +159,12 @@ public:
    */
   void* getPointerByName(const std::string& featureName) override;
 
+  /**
+   * @brief Hands the memory of a data column over to the caller. See EbsdReader::releasePointerByName()
+   * @param featureName The name of the feature.
+   */
+  void* releasePointerByName(const std::string& featureName) override;
+
   /**
    * @brief Returns an enumeration value that depicts the numerical
    * primitive type that the data is stored as (Int, Float, etc).
@@ -186,6 +205,12 @@ private:
    */
   void parseDataLine(std::string& line, size_t i);
 
+  /**
+   * @brief Resamples the parsed hexagonal grid data onto a square grid with nearest neighbor interpolation and
+   * updates the grid header values to match
+   */
+  void convertHexGridToSquareGrid();
+
   bool m_InsideNotes = false;
   bool m_InsideColumnNotes = false;
 
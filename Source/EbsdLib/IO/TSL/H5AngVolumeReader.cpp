@@ -37,11 +37,13 @@
 #include <cmath>
 
 #include <string>
+#include <vector>
 
 #include "H5Support/H5Lite.h"
 #include "H5Support/H5Utilities.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/EbsdTransform.h"
 #include "EbsdLib/IO/TSL/H5AngReader.h"
 
 using namespace H5Support;
@@ -325,6 +327,26 @@ int H5AngVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoint
     xstop = xpointsslice;
     ystop = ypointsslice;
 
+    // The Euler angles of the slice are rotated in place. The sample flip is done on the volume grid, so the data of
+    // the slice goes where a flip of the assembled volume would put it. The X/Y positions are not moved.
+    std::vector<size_t> destIndex;
+    bool flipsZ = false;
+    if(getApplyTransformations())
+    {
+      if(!EbsdTransform::SlicePlacementIndex(getSampleTransformationAngle(), getSampleTransformationAxis(), static_cast<size_t>(xpointsslice), static_cast<size_t>(ypointsslice),
+                                             static_cast<size_t>(xpointstemp), static_cast<size_t>(ypointstemp), destIndex, flipsZ))
+      {
+        setErrorCode(-99091);
+        setErrorMessage("Only 180 degree Sample transformations about the X, Y or Z axis of slices no larger than the volume can be applied while loading the data");
+        return getErrorCode();
+      }
+      if(nullptr != euler1Ptr && nullptr != euler2Ptr && nullptr != euler3Ptr)
+      {
+        EbsdTransform::TransformEulerAngles(euler1Ptr, euler2Ptr, euler3Ptr, euler1Ptr, euler2Ptr, euler3Ptr, static_cast<size_t>(xpointsslice * ypointsslice), getEulerTransformationAngle(),
+                                            getEulerTransformationAxis(), false);
+      }
+    }
+
     // If no stacking order preference was passed, read it from the file and use that value
     if(ZDir == EbsdLib::RefFrameZDir::UnknownRefFrameZDirection)
     {
@@ -339,12 +361,19 @@ int H5AngVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoint
       zval = static_cast<int>((zpoints - 1) - slice);
     }
 
+    if(flipsZ)
+    {
+      zval = static_cast<int>((zpoints - 1) - zval);
+    }
+
     // Copy the data from the current storage into the new memory Location
     for(int j = 0; j < ystop; j++)
     {
       for(int i = 0; i < xstop; i++)
       {
-        index = (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
+        const int placed = ((j + ystartspot) * xpointstemp) + (i + xstartspot);
+        const int positionIndex = (zval * xpointstemp * ypointstemp) + placed;
+        index = (zval * xpointstemp * ypointstemp) + (destIndex.empty() ? placed : static_cast<int>(destIndex[readerIndex]));
         if(nullptr != euler1Ptr)
         {
           m_Phi1[index] = euler1Ptr[readerIndex];
@@ -359,11 +388,11 @@ int H5AngVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoint
         }
         if(nullptr != xPtr)
         {
-          m_X[index] = xPtr[readerIndex];
+          m_X[positionIndex] = xPtr[readerIndex];
         }
         if(nullptr != yPtr)
         {
-          m_Y[index] = yPtr[readerIndex];
+          m_Y[positionIndex] = yPtr[readerIndex];
         }
         if(nullptr != iqPtr)
         {
@@ -880,6 +880,15 @@ void CubicOps::getSchmidFactorAndSS(double load[3], double& schmidfactor, double
   }
 }
 
+// -----------------------------------------------------------------------------
+void CubicOps::generateSchmidFactorMap(EbsdLib::FloatArrayType* quats, const double load[3], EbsdLib::FloatArrayType* schmidFactors, EbsdLib::Int32ArrayType* slipSystems,
+                                       EbsdLib::FloatArrayType* angleComps) const
+{
+  // The slip system table is ordered the same way as the slip systems in getSchmidFactorAndSS() and is normalized
+  // using the same constants so that both produce identical results.
+  _calcSchmidFactorMap(CubicHigh::SlipPlanes, CubicHigh::SlipDirections, 12, 1.732f, 1.414f, quats, load, schmidFactors, slipSystems, angleComps);
+}
+
 void CubicOps::getSchmidFactorAndSS(double load[3], double plane[3], double direction[3], double& schmidfactor, double angleComps[2], int& slipsys) const
 {
   schmidfactor = 0;
@@ -1268,6 +1277,13 @@ double CubicOps::getF7(const QuatD& q1, const QuatD& q2, double LD[3], bool maxS
   return F7;
 }
 
+// -----------------------------------------------------------------------------
+void CubicOps::getSlipTransmissionMetrics(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* boundaryPairs, const double LD[3], bool maxSF, EbsdLib::DoubleArrayType* mPrime,
+                                          EbsdLib::DoubleArrayType* F1, EbsdLib::DoubleArrayType* F1spt, EbsdLib::DoubleArrayType* F7) const
+{
+  _calcSlipTransmissionMetrics(CubicHigh::SlipPlanes, CubicHigh::SlipDirections, 12, quats, boundaryPairs, LD, maxSF, mPrime, F1, F1spt, F7);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1275,13 +1291,13 @@ namespace CubicHigh
 {
 class GenerateSphereCoordsImpl
 {
-  EbsdLib::FloatArrayType* m_Eulers;
+  EbsdArrayView<const float> m_Eulers;
   EbsdLib::FloatArrayType* m_xyz001;
   EbsdLib::FloatArrayType* m_xyz011;
   EbsdLib::FloatArrayType* m_xyz111;
 
 public:
-  GenerateSphereCoordsImpl(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* xyz001, EbsdLib::FloatArrayType* xyz011, EbsdLib::FloatArrayType* xyz111)
+  GenerateSphereCoordsImpl(const EbsdArrayView<const float>& eulers, EbsdLib::FloatArrayType* xyz001, EbsdLib::FloatArrayType* xyz011, EbsdLib::FloatArrayType* xyz111)
   : m_Eulers(eulers)
   , m_xyz001(xyz001)
   , m_xyz011(xyz011)
@@ -1298,7 +1314,7 @@ public:
 
     for(size_t i = start; i < end; ++i)
     {
-      OrientationType eu(m_Eulers->getValue(i * 3), m_Eulers->getValue(i * 3 + 1), m_Eulers->getValue(i * 3 + 2));
+      OrientationType eu(m_Eulers(i, 0), m_Eulers(i, 1), m_Eulers(i, 2));
       OrientationTransformation::eu2om<OrientationType, OrientationType>(eu).toGMatrix(g);
 
       EbsdMatrixMath::Transpose3x3(g, gTranpose);
@@ -1404,22 +1420,22 @@ public:
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void CubicOps::generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* xyz001, EbsdLib::FloatArrayType* xyz011, EbsdLib::FloatArrayType* xyz111) const
+void CubicOps::generateSphereCoordsFromEulers(const EbsdArrayView<const float>& eulers, EbsdLib::FloatArrayType* xyz001, EbsdLib::FloatArrayType* xyz011, EbsdLib::FloatArrayType* xyz111) const
 {
-  size_t nOrientations = eulers->getNumberOfTuples();
+  size_t nOrientations = eulers.getNumberOfTuples();
 
   // Sanity Check the size of the arrays
   if(xyz001->getNumberOfTuples() < nOrientations * CubicHigh::symSize0)
   {
-    xyz001->resizeTuples(nOrientations * CubicHigh::symSize0 * 3);
+    xyz001->resizeTuples(nOrientations * CubicHigh::symSize0);
   }
   if(xyz011->getNumberOfTuples() < nOrientations * CubicHigh::symSize1)
   {
-    xyz011->resizeTuples(nOrientations * CubicHigh::symSize1 * 3);
+    xyz011->resizeTuples(nOrientations * CubicHigh::symSize1);
   }
   if(xyz111->getNumberOfTuples() < nOrientations * CubicHigh::symSize2)
   {
-    xyz111->resizeTuples(nOrientations * CubicHigh::symSize2 * 3);
+    xyz111->resizeTuples(nOrientations * CubicHigh::symSize2);
   }
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
@@ -1615,7 +1631,6 @@ EbsdLib::Rgb CubicOps::generateIPFColor(double phi1, double phi, double phi2, do
   double p[3];
   double refDirection[3] = {0.0f, 0.0f, 0.0f};
   double chi = 0.0f, eta = 0.0f;
-  double _rgb[3] = {0.0, 0.0, 0.0};
 
   OrientationType eu(phi1, phi, phi2);
   OrientationType om(9); // Reusable for the loop
@@ -1648,6 +1663,16 @@ EbsdLib::Rgb CubicOps::generateIPFColor(double phi1, double phi, double phi2, do
     }
     break;
   }
+  return computeIPFColor(eta, chi);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdLib::Rgb CubicOps::computeIPFColor(double eta, double chi) const
+{
+  double _rgb[3] = {0.0, 0.0, 0.0};
+
   double etaMin = 0.0;
   double etaMax = 45.0;
   double etaDeg = eta * EbsdLib::Constants::k_180OverPiD;
@@ -1707,14 +1732,23 @@ EbsdLib::Rgb CubicOps::generateRodriguesColor(double r1, double r2, double r3) c
   return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(red * 255), static_cast<int32_t>(green * 255), static_cast<int32_t>(blue * 255), 255);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::array<std::string, 3> CubicOps::getDefaultPoleFigureNames() const
+{
+  return {"<001>", "<011>", "<111>"};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
 {
-  std::string label0 = std::string("<001>");
-  std::string label1 = std::string("<011>");
-  std::string label2 = std::string("<111>");
+  std::array<std::string, 3> names = getDefaultPoleFigureNames();
+  std::string label0 = names[0];
+  std::string label1 = names[1];
+  std::string label2 = names[2];
   if(!config.labels.empty())
   {
     label0 = config.labels.at(0);
@@ -1728,27 +1762,28 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleF
     label2 = config.labels.at(2);
   }
 
-  size_t numOrientations = config.eulers->getNumberOfTuples();
+  EbsdArrayView<const float> eulers = config.getEulers();
+  size_t numOrientations = eulers.getNumberOfTuples();
 
   // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
   // this is size for CUBIC ONLY, <001> Family
   std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize0, dims, label0 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * CubicHigh::symSize0, dims, label0 + std::string("xyzCoords"));
   // this is size for CUBIC ONLY, <011> Family
-  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize1, dims, label1 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * CubicHigh::symSize1, dims, label1 + std::string("xyzCoords"));
   // this is size for CUBIC ONLY, <111> Family
-  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(numOrientations * CubicHigh::symSize2, dims, label2 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * CubicHigh::symSize2, dims, label2 + std::string("xyzCoords"));
 
   config.sphereRadius = 1.0f;
 
   // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
+  generateSphereCoordsFromEulers(eulers, xyz001.get(), xyz011.get(), xyz111.get());
 
   // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
   // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
+  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label0 + "_Intensity_Image");
+  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label1 + "_Intensity_Image");
+  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label2 + "_Intensity_Image");
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
   bool doParallel = true;
@@ -1773,58 +1808,12 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleF
   }
 
   // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity011->getPointer(0);
-  count = intensity011->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity111->getPointer(0);
-  count = intensity111->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
+  PoleFigureUtilities::FindIntensityRange({intensity001.get(), intensity011.get(), intensity111.get()}, config);
 
   dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label2, true);
+  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label0);
+  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label1);
+  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label2);
 
   std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
   if(config.order.size() == 3)
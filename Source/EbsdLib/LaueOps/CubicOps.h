@@ -48,7 +48,7 @@
  * @date May 5, 2011
  * @version 1.0
  */
-class EbsdLib_EXPORT CubicOps : public LaueOps
+class EbsdLib_EXPORT CubicOps final : public LaueOps
 {
 public:
   using Self = CubicOps;
@@ -152,12 +152,17 @@ public:
   int getOdfBin(const OrientationType& rod) const override;
   void getSchmidFactorAndSS(double load[3], double& schmidfactor, double angleComps[2], int& slipsys) const override;
   void getSchmidFactorAndSS(double load[3], double plane[3], double direction[3], double& schmidfactor, double angleComps[2], int& slipsys) const override;
+  void generateSchmidFactorMap(EbsdLib::FloatArrayType* quats, const double load[3], EbsdLib::FloatArrayType* schmidFactors, EbsdLib::Int32ArrayType* slipSystems,
+                               EbsdLib::FloatArrayType* angleComps) const override;
   double getmPrime(const QuatD& q1, const QuatD& q2, double LD[3]) const override;
   double getF1(const QuatD& q1, const QuatD& q2, double LD[3], bool maxSF) const override;
   double getF1spt(const QuatD& q1, const QuatD& q2, double LD[3], bool maxSF) const override;
   double getF7(const QuatD& q1, const QuatD& q2, double LD[3], bool maxSF) const override;
+  void getSlipTransmissionMetrics(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* boundaryPairs, const double LD[3], bool maxSF, EbsdLib::DoubleArrayType* mPrime,
+                                  EbsdLib::DoubleArrayType* F1, EbsdLib::DoubleArrayType* F1spt, EbsdLib::DoubleArrayType* F7) const override;
 
-  void generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* xyz001, EbsdLib::FloatArrayType* xyz011, EbsdLib::FloatArrayType* xyz111) const override;
+  using LaueOps::generateSphereCoordsFromEulers;
+  void generateSphereCoordsFromEulers(const EbsdArrayView<const float>& eulers, EbsdLib::FloatArrayType* xyz001, EbsdLib::FloatArrayType* xyz011, EbsdLib::FloatArrayType* xyz111) const override;
 
   /**
    * @brief generateIPFColor Generates an RGB Color from a Euler Angle and Reference Direction
@@ -181,6 +186,13 @@ public:
    */
   EbsdLib::Rgb generateIPFColor(double phi1, double phi, double phi2, double dir0, double dir1, double dir2, bool degToRad) const override;
 
+  /**
+   * @brief computeIPFColor Computes the IPF color of a direction that has already been reduced into the unit triangle
+   * @param eta Azimuthal angle of the direction (radians)
+   * @param chi Polar angle of the direction (radians)
+   */
+  EbsdLib::Rgb computeIPFColor(double eta, double chi) const override;
+
   /**
    * @brief generateRodriguesColor Generates an RGB Color from a Rodrigues Vector
    * @param r1 First component of the Rodrigues Vector
@@ -198,6 +210,11 @@ public:
    */
   EbsdLib::Rgb generateMisorientationColor(const QuatD& q, const QuatD& refFrame) const override;
 
+  /**
+   * @brief Returns the default labels of the 3 pole figures in the order they are generated
+   */
+  std::array<std::string, 3> getDefaultPoleFigureNames() const override;
+
   /**
    * @brief generatePoleFigure This method will generate a number of pole figures for this crystal symmetry and the Euler
    * angles that are passed in.
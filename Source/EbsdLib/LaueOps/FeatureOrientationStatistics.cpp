@@ -0,0 +1,276 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "FeatureOrientationStatistics.h"
+
+#include <algorithm>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/PhasePartition.h"
+#include "EbsdLib/LaueOps/QuatSymmetryKernels.hpp"
+
+namespace Detail
+{
+/**
+ * @brief The FeatureStatisticsImpl class computes the mean orientation of each feature with two alignment passes
+ * (first against the first point, then against that average, as LaueOps::averageQuatsByGroup() does) and then the
+ * misorientation of every point of the feature to the mean.
+ */
+class FeatureStatisticsImpl
+{
+public:
+  FeatureStatisticsImpl(const std::vector<std::vector<double>>& symTables, const PhasePartition& features, const float* quats, const int32_t* phases, int32_t* featurePhases,
+                        int32_t* featureSizes, float* avgQuats, float* avgMisorientations, float* maxMisorientations, float* pointMisorientations)
+  : m_SymTables(symTables)
+  , m_Features(features)
+  , m_Quats(quats)
+  , m_Phases(phases)
+  , m_FeaturePhases(featurePhases)
+  , m_FeatureSizes(featureSizes)
+  , m_AvgQuats(avgQuats)
+  , m_AvgMisorientations(avgMisorientations)
+  , m_MaxMisorientations(maxMisorientations)
+  , m_PointMisorientations(pointMisorientations)
+  {
+  }
+  virtual ~FeatureStatisticsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    double ref[4];
+    double avg[4];
+    double q[4];
+    double fzQuat[4];
+    double meanTable[EbsdLib::Detail::k_MaxQuatSymOps * 4];
+    for(size_t feature = start; feature < end; feature++)
+    {
+      const size_t count = m_Features.getPhaseSize(feature);
+      const size_t* indices = m_Features.getPhaseIndices(feature);
+      m_FeatureSizes[feature] = static_cast<int32_t>(count);
+      m_FeaturePhases[feature] = count > 0 ? m_Phases[indices[0]] : -1;
+      float* avgQuat = m_AvgQuats + feature * 4;
+      avgQuat[0] = 0.0f;
+      avgQuat[1] = 0.0f;
+      avgQuat[2] = 0.0f;
+      avgQuat[3] = 1.0f;
+      m_AvgMisorientations[feature] = 0.0f;
+      m_MaxMisorientations[feature] = 0.0f;
+
+      const int32_t phase = m_FeaturePhases[feature];
+      if(count == 0 || phase < 0 || static_cast<size_t>(phase) >= m_SymTables.size() || m_SymTables[phase].empty())
+      {
+        continue;
+      }
+      const double* symTable = m_SymTables[phase].data();
+      const size_t numSym = m_SymTables[phase].size() / 4;
+
+      for(size_t c = 0; c < 4; c++)
+      {
+        ref[c] = m_Quats[indices[0] * 4 + c];
+      }
+      EbsdLib::Detail::AverageNearestQuats(symTable, numSym, m_Quats, indices, count, ref, avg);
+      EbsdLib::Detail::AverageNearestQuats(symTable, numSym, m_Quats, indices, count, avg, ref);
+
+      EbsdLib::Detail::CreateSymmetricTable(symTable, numSym, ref, false, meanTable);
+      double sum = 0.0;
+      double maxAngle = 0.0;
+      for(size_t i = 0; i < count; i++)
+      {
+        for(size_t c = 0; c < 4; c++)
+        {
+          q[c] = m_Quats[indices[i] * 4 + c];
+        }
+        double angle = EbsdLib::Detail::MisorientationAngle(meanTable, numSym, q);
+        m_PointMisorientations[indices[i]] = static_cast<float>(angle);
+        sum += angle;
+        maxAngle = std::max(maxAngle, angle);
+      }
+      m_AvgMisorientations[feature] = static_cast<float>(sum / static_cast<double>(count));
+      m_MaxMisorientations[feature] = static_cast<float>(maxAngle);
+
+      EbsdLib::Detail::NearestSymmetricQuat(symTable, numSym, nullptr, ref, fzQuat);
+      for(size_t c = 0; c < 4; c++)
+      {
+        avgQuat[c] = static_cast<float>(fzQuat[c]);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<std::vector<double>>& m_SymTables;
+  const PhasePartition& m_Features;
+  const float* m_Quats;
+  const int32_t* m_Phases;
+  int32_t* m_FeaturePhases;
+  int32_t* m_FeatureSizes;
+  float* m_AvgQuats;
+  float* m_AvgMisorientations;
+  float* m_MaxMisorientations;
+  float* m_PointMisorientations;
+};
+} // namespace Detail
+
+// -----------------------------------------------------------------------------
+FeatureOrientationStatistics::FeatureOrientationStatistics(const std::vector<uint32_t>& crystalStructures)
+: m_CrystalStructures(crystalStructures)
+{
+  m_FeaturePhases = EbsdLib::Int32ArrayType::CreateArray(0, "FeaturePhases", true);
+  m_FeatureSizes = EbsdLib::Int32ArrayType::CreateArray(0, "FeatureSizes", true);
+  m_AvgQuats = EbsdLib::FloatArrayType::CreateArray(0, {4}, "AvgQuats", true);
+  m_AvgMisorientations = EbsdLib::FloatArrayType::CreateArray(0, "AvgMisorientations", true);
+  m_MaxMisorientations = EbsdLib::FloatArrayType::CreateArray(0, "MaxMisorientations", true);
+  m_PointMisorientations = EbsdLib::FloatArrayType::CreateArray(0, "PointMisorientations", true);
+}
+
+// -----------------------------------------------------------------------------
+FeatureOrientationStatistics::~FeatureOrientationStatistics() = default;
+
+// -----------------------------------------------------------------------------
+FeatureOrientationStatistics::Pointer FeatureOrientationStatistics::New(const std::vector<uint32_t>& crystalStructures)
+{
+  Pointer sharedPtr(new FeatureOrientationStatistics(crystalStructures));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+FeatureOrientationStatistics::Pointer FeatureOrientationStatistics::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::string FeatureOrientationStatistics::getNameOfClass() const
+{
+  return ClassName();
+}
+
+// -----------------------------------------------------------------------------
+std::string FeatureOrientationStatistics::ClassName()
+{
+  return std::string("FeatureOrientationStatistics");
+}
+
+// -----------------------------------------------------------------------------
+void FeatureOrientationStatistics::compute(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* featureIds, EbsdLib::Int32ArrayType* phases, size_t numFeatures, const bool* goodPoints)
+{
+  const size_t numPoints = std::min({quats->getNumberOfTuples(), featureIds->getNumberOfTuples(), phases->getNumberOfTuples()});
+  m_NumFeatures = numFeatures;
+  m_FeaturePhases->resizeTuples(numFeatures);
+  m_FeatureSizes->resizeTuples(numFeatures);
+  m_AvgQuats->resizeTuples(numFeatures);
+  m_AvgMisorientations->resizeTuples(numFeatures);
+  m_MaxMisorientations->resizeTuples(numFeatures);
+  m_PointMisorientations->resizeTuples(numPoints);
+  m_PointMisorientations->initializeWithZeros();
+  if(numFeatures == 0)
+  {
+    return;
+  }
+
+  const std::vector<LaueOps::Pointer>& ops = LaueOps::GetAllOrientationOps();
+  std::vector<std::vector<double>> symTables(m_CrystalStructures.size());
+  for(size_t phase = 0; phase < m_CrystalStructures.size(); phase++)
+  {
+    if(m_CrystalStructures[phase] < EbsdLib::CrystalStructure::LaueGroupEnd)
+    {
+      symTables[phase] = EbsdLib::Detail::CreateQuatSymTable(*ops[m_CrystalStructures[phase]]);
+    }
+  }
+
+  PhasePartition::Pointer features = PhasePartition::New(numPoints > 0 ? featureIds->getPointer(0) : nullptr, numPoints, numFeatures, goodPoints);
+  Detail::FeatureStatisticsImpl impl(symTables, *features, numPoints > 0 ? quats->getPointer(0) : nullptr, numPoints > 0 ? phases->getPointer(0) : nullptr, m_FeaturePhases->getPointer(0),
+                                     m_FeatureSizes->getPointer(0), m_AvgQuats->getPointer(0), m_AvgMisorientations->getPointer(0), m_MaxMisorientations->getPointer(0),
+                                     numPoints > 0 ? m_PointMisorientations->getPointer(0) : nullptr);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, numFeatures);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+size_t FeatureOrientationStatistics::getNumberOfFeatures() const
+{
+  return m_NumFeatures;
+}
+
+// -----------------------------------------------------------------------------
+EbsdLib::Int32ArrayType::Pointer FeatureOrientationStatistics::getFeaturePhases() const
+{
+  return m_FeaturePhases;
+}
+
+// -----------------------------------------------------------------------------
+EbsdLib::Int32ArrayType::Pointer FeatureOrientationStatistics::getFeatureSizes() const
+{
+  return m_FeatureSizes;
+}
+
+// -----------------------------------------------------------------------------
+EbsdLib::FloatArrayType::Pointer FeatureOrientationStatistics::getAvgQuats() const
+{
+  return m_AvgQuats;
+}
+
+// -----------------------------------------------------------------------------
+EbsdLib::FloatArrayType::Pointer FeatureOrientationStatistics::getAvgMisorientations() const
+{
+  return m_AvgMisorientations;
+}
+
+// -----------------------------------------------------------------------------
+EbsdLib::FloatArrayType::Pointer FeatureOrientationStatistics::getMaxMisorientations() const
+{
+  return m_MaxMisorientations;
+}
+
+// -----------------------------------------------------------------------------
+EbsdLib::FloatArrayType::Pointer FeatureOrientationStatistics::getPointMisorientations() const
+{
+  return m_PointMisorientations;
+}
@@ -0,0 +1,151 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class FeatureOrientationStatistics FeatureOrientationStatistics.h EbsdLib/LaueOps/FeatureOrientationStatistics.h
+ * @brief The FeatureOrientationStatistics class computes the orientation statistics of every feature (e.g. grain) of
+ * an orientation map in one call: the symmetry aware mean orientation, the misorientation of every point to the mean
+ * of its feature (GROD) and the average and maximum of those misorientations per feature. The points are sorted by
+ * feature once with PhasePartition and the features are processed in parallel. The points of a feature are always
+ * visited in index order so the results do not depend on the number of threads.
+ *
+ * The phase of a feature is the phase of its first point. Every point of the feature is evaluated with the Laue
+ * class of that phase. All misorientations are in radians.
+ */
+class EbsdLib_EXPORT FeatureOrientationStatistics
+{
+public:
+  using Self = FeatureOrientationStatistics;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  /**
+   * @brief Creates an engine for the phases of a scan
+   * @param crystalStructures The EbsdLib::CrystalStructure value of each phase
+   */
+  static Pointer New(const std::vector<uint32_t>& crystalStructures);
+
+  /**
+   * @brief Returns the name of the class for FeatureOrientationStatistics
+   */
+  std::string getNameOfClass() const;
+  /**
+   * @brief Returns the name of the class for FeatureOrientationStatistics
+   */
+  static std::string ClassName();
+
+  ~FeatureOrientationStatistics();
+
+  /**
+   * @brief Computes the statistics of every feature. Results of a previous call are replaced.
+   * @param quats Per point quaternions as 4 component (x, y, z, w) tuples
+   * @param featureIds Feature id of each point. Points with an id outside of [0, numFeatures) are not part of any
+   * feature.
+   * @param phases Phase of each point
+   * @param numFeatures The number of features, including feature 0
+   * @param goodPoints Optional mask. Points where it is false are not part of any feature.
+   */
+  void compute(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* featureIds, EbsdLib::Int32ArrayType* phases, size_t numFeatures, const bool* goodPoints = nullptr);
+
+  /**
+   * @brief Returns the number of features of the last call to compute()
+   */
+  size_t getNumberOfFeatures() const;
+
+  /**
+   * @brief Returns the phase of each feature, -1 for features without any point
+   */
+  EbsdLib::Int32ArrayType::Pointer getFeaturePhases() const;
+
+  /**
+   * @brief Returns the number of points of each feature
+   */
+  EbsdLib::Int32ArrayType::Pointer getFeatureSizes() const;
+
+  /**
+   * @brief Returns the mean orientation of each feature as 4 component (x, y, z, w) quaternions in the fundamental
+   * zone, the same as LaueOps::averageQuatsByGroup(). Features without any point, or whose phase has no known Laue
+   * class, are set to the identity.
+   */
+  EbsdLib::FloatArrayType::Pointer getAvgQuats() const;
+
+  /**
+   * @brief Returns the average misorientation of the points of each feature to the mean orientation of the feature
+   */
+  EbsdLib::FloatArrayType::Pointer getAvgMisorientations() const;
+
+  /**
+   * @brief Returns the largest misorientation of the points of each feature to the mean orientation of the feature
+   */
+  EbsdLib::FloatArrayType::Pointer getMaxMisorientations() const;
+
+  /**
+   * @brief Returns the misorientation of each point to the mean orientation of its feature (GROD). Points that are
+   * not part of a feature with a known Laue class are set to 0.
+   */
+  EbsdLib::FloatArrayType::Pointer getPointMisorientations() const;
+
+protected:
+  explicit FeatureOrientationStatistics(const std::vector<uint32_t>& crystalStructures);
+
+private:
+  std::vector<uint32_t> m_CrystalStructures;
+  size_t m_NumFeatures = 0;
+  EbsdLib::Int32ArrayType::Pointer m_FeaturePhases;
+  EbsdLib::Int32ArrayType::Pointer m_FeatureSizes;
+  EbsdLib::FloatArrayType::Pointer m_AvgQuats;
+  EbsdLib::FloatArrayType::Pointer m_AvgMisorientations;
+  EbsdLib::FloatArrayType::Pointer m_MaxMisorientations;
+  EbsdLib::FloatArrayType::Pointer m_PointMisorientations;
+
+public:
+  FeatureOrientationStatistics(const FeatureOrientationStatistics&) = delete;            // Copy Constructor Not Implemented
+  FeatureOrientationStatistics(FeatureOrientationStatistics&&) = delete;                 // Move Constructor Not Implemented
+  FeatureOrientationStatistics& operator=(const FeatureOrientationStatistics&) = delete; // Copy Assignment Not Implemented
+  FeatureOrientationStatistics& operator=(FeatureOrientationStatistics&&) = delete;      // Move Assignment Not Implemented
+};
@@ -1026,13 +1026,13 @@ namespace HexagonalLow
 {
 class GenerateSphereCoordsImpl
 {
-  EbsdLib::FloatArrayType* m_Eulers;
+  EbsdArrayView<const float> m_Eulers;
   EbsdLib::FloatArrayType* m_xyz001;
   EbsdLib::FloatArrayType* m_xyz011;
   EbsdLib::FloatArrayType* m_xyz111;
 
 public:
-  GenerateSphereCoordsImpl(EbsdLib::FloatArrayType* eulerAngles, EbsdLib::FloatArrayType* xyz001Coords, EbsdLib::FloatArrayType* xyz011Coords, EbsdLib::FloatArrayType* xyz111Coords)
+  GenerateSphereCoordsImpl(const EbsdArrayView<const float>& eulerAngles, EbsdLib::FloatArrayType* xyz001Coords, EbsdLib::FloatArrayType* xyz011Coords, EbsdLib::FloatArrayType* xyz111Coords)
   : m_Eulers(eulerAngles)
   , m_xyz001(xyz001Coords)
   , m_xyz011(xyz011Coords)
@@ -1049,7 +1049,7 @@ public:
 
     for(size_t i = start; i < end; ++i)
     {
-      OrientationType eu(m_Eulers->getValue(i * 3), m_Eulers->getValue(i * 3 + 1), m_Eulers->getValue(i * 3 + 2));
+      OrientationType eu(m_Eulers(i, 0), m_Eulers(i, 1), m_Eulers(i, 2));
       OrientationTransformation::eu2om<OrientationType, OrientationType>(eu).toGMatrix(g);
 
       EbsdMatrixMath::Transpose3x3(g, gTranpose);
@@ -1095,22 +1095,22 @@ public:
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void HexagonalLowOps::generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* xyz0001, EbsdLib::FloatArrayType* xyz1010, EbsdLib::FloatArrayType* xyz1120) const
+void HexagonalLowOps::generateSphereCoordsFromEulers(const EbsdArrayView<const float>& eulers, EbsdLib::FloatArrayType* xyz0001, EbsdLib::FloatArrayType* xyz1010, EbsdLib::FloatArrayType* xyz1120) const
 {
-  size_t nOrientations = eulers->getNumberOfTuples();
+  size_t nOrientations = eulers.getNumberOfTuples();
 
   // Sanity Check the size of the arrays
   if(xyz0001->getNumberOfTuples() < nOrientations * HexagonalLow::symSize0)
   {
-    xyz0001->resizeTuples(nOrientations * HexagonalLow::symSize0 * 3);
+    xyz0001->resizeTuples(nOrientations * HexagonalLow::symSize0);
   }
   if(xyz1010->getNumberOfTuples() < nOrientations * HexagonalLow::symSize1)
   {
-    xyz1010->resizeTuples(nOrientations * HexagonalLow::symSize1 * 3);
+    xyz1010->resizeTuples(nOrientations * HexagonalLow::symSize1);
   }
   if(xyz1120->getNumberOfTuples() < nOrientations * HexagonalLow::symSize2)
   {
-    xyz1120->resizeTuples(nOrientations * HexagonalLow::symSize2 * 3);
+    xyz1120->resizeTuples(nOrientations * HexagonalLow::symSize2);
   }
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
@@ -1159,7 +1159,6 @@ EbsdLib::Rgb HexagonalLowOps::generateIPFColor(double phi1, double phi, double p
   double p[3];
   double refDirection[3] = {0.0f, 0.0f, 0.0f};
   double chi = 0.0f, eta = 0.0;
-  double _rgb[3] = {0.0, 0.0, 0.0};
 
   OrientationType eu(phi1, phi, phi2);
   OrientationType om(9); // Reusable for the loop
@@ -1194,6 +1193,16 @@ EbsdLib::Rgb HexagonalLowOps::generateIPFColor(double phi1, double phi, double p
     break;
   }
 
+  return computeIPFColor(eta, chi);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdLib::Rgb HexagonalLowOps::computeIPFColor(double eta, double chi) const
+{
+  double _rgb[3] = {0.0, 0.0, 0.0};
+
   double etaMin = 0.0;
   double etaMax = 60.0;
   double chiMax = 90.0;
@@ -1249,14 +1258,23 @@ EbsdLib::Rgb HexagonalLowOps::generateRodriguesColor(double r1, double r2, doubl
   return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(red * 255), static_cast<int32_t>(green * 255), static_cast<int32_t>(blue * 255), 255);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::array<std::string, 3> HexagonalLowOps::getDefaultPoleFigureNames() const
+{
+  return {"<0001>", "<11-20>", "<2-1-10>"};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 std::vector<EbsdLib::UInt8ArrayType::Pointer> HexagonalLowOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
 {
-  std::string label0 = std::string("<0001>");
-  std::string label1 = std::string("<11-20>");
-  std::string label2 = std::string("<2-1-10>");
+  std::array<std::string, 3> names = getDefaultPoleFigureNames();
+  std::string label0 = names[0];
+  std::string label1 = names[1];
+  std::string label2 = names[2];
   if(!config.labels.empty())
   {
     label0 = config.labels.at(0);
@@ -1270,27 +1288,28 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> HexagonalLowOps::generatePoleFigur
     label2 = config.labels.at(2);
   }
 
-  size_t numOrientations = config.eulers->getNumberOfTuples();
+  EbsdArrayView<const float> eulers = config.getEulers();
+  size_t numOrientations = eulers.getNumberOfTuples();
 
   // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
   // this is size for CUBIC ONLY, <001> Family
   std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalLow::symSize0, dims, label0 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * HexagonalLow::symSize0, dims, label0 + std::string("xyzCoords"));
   // this is size for CUBIC ONLY, <011> Family
-  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalLow::symSize1, dims, label1 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * HexagonalLow::symSize1, dims, label1 + std::string("xyzCoords"));
   // this is size for CUBIC ONLY, <111> Family
-  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalLow::symSize2, dims, label2 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * HexagonalLow::symSize2, dims, label2 + std::string("xyzCoords"));
 
   config.sphereRadius = 1.0;
 
   // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
+  generateSphereCoordsFromEulers(eulers, xyz001.get(), xyz011.get(), xyz111.get());
 
   // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
   // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
+  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label0 + "_Intensity_Image");
+  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label1 + "_Intensity_Image");
+  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label2 + "_Intensity_Image");
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
   bool doParallel = true;
 
@@ -1314,58 +1333,12 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> HexagonalLowOps::generatePoleFigur
   }
 
   // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity011->getPointer(0);
-  count = intensity011->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity111->getPointer(0);
-  count = intensity111->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
+  PoleFigureUtilities::FindIntensityRange({intensity001.get(), intensity011.get(), intensity111.get()}, config);
 
   dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label2, true);
+  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label0);
+  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label1);
+  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label2);
 
   std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
   if(config.order.size() == 3)
@@ -48,7 +48,7 @@
  * @date May 5, 2011
  * @version 1.0
  */
-class EbsdLib_EXPORT HexagonalLowOps : public LaueOps
+class EbsdLib_EXPORT HexagonalLowOps final : public LaueOps
 {
 public:
   using Self = HexagonalLowOps;
@@ -158,7 +158,8 @@ public:
   double getF1spt(const QuatD& q1, const QuatD& q2, double LD[3], bool maxSF) const override;
   double getF7(const QuatD& q1, const QuatD& q2, double LD[3], bool maxSF) const override;
 
-  void generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* c1, EbsdLib::FloatArrayType* c2, EbsdLib::FloatArrayType* c3) const override;
+  using LaueOps::generateSphereCoordsFromEulers;
+  void generateSphereCoordsFromEulers(const EbsdArrayView<const float>& eulers, EbsdLib::FloatArrayType* c1, EbsdLib::FloatArrayType* c2, EbsdLib::FloatArrayType* c3) const override;
 
   /**
    * @brief generateIPFColor Generates an RGB Color from a Euler Angle and Reference Direction
@@ -182,6 +183,13 @@ public:
    */
   EbsdLib::Rgb generateIPFColor(double e0, double e1, double phi2, double dir0, double dir1, double dir2, bool convertDegrees) const override;
 
+  /**
+   * @brief computeIPFColor Computes the IPF color of a direction that has already been reduced into the unit triangle
+   * @param eta Azimuthal angle of the direction (radians)
+   * @param chi Polar angle of the direction (radians)
+   */
+  EbsdLib::Rgb computeIPFColor(double eta, double chi) const override;
+
   /**
    * @brief generateRodriguesColor Generates an RGB Color from a Rodrigues Vector
    * @param r1 First component of the Rodrigues Vector
@@ -199,6 +207,11 @@ public:
    */
   EbsdLib::Rgb generateMisorientationColor(const QuatD& q, const QuatD& refFrame) const override;
 
+  /**
+   * @brief Returns the default labels of the 3 pole figures in the order they are generated
+   */
+  std::array<std::string, 3> getDefaultPoleFigureNames() const override;
+
   /**
    * @brief generatePoleFigure This method will generate a number of pole figures for this crystal symmetry and the Euler
    * angles that are passed in.
@@ -1058,13 +1058,13 @@ namespace HexagonalHigh
 {
 class GenerateSphereCoordsImpl
 {
-  EbsdLib::FloatArrayType* m_Eulers;
+  EbsdArrayView<const float> m_Eulers;
   EbsdLib::FloatArrayType* m_xyz001;
   EbsdLib::FloatArrayType* m_xyz011;
   EbsdLib::FloatArrayType* m_xyz111;
 
 public:
-  GenerateSphereCoordsImpl(EbsdLib::FloatArrayType* eulerAngles, EbsdLib::FloatArrayType* xyz0001Coords, EbsdLib::FloatArrayType* xyz1010Coords, EbsdLib::FloatArrayType* xyz1120Coords)
+  GenerateSphereCoordsImpl(const EbsdArrayView<const float>& eulerAngles, EbsdLib::FloatArrayType* xyz0001Coords, EbsdLib::FloatArrayType* xyz1010Coords, EbsdLib::FloatArrayType* xyz1120Coords)
   : m_Eulers(eulerAngles)
   , m_xyz001(xyz0001Coords)
   , m_xyz011(xyz1010Coords)
@@ -1082,7 +1082,7 @@ public:
     // Geneate all the Coordinates
     for(size_t i = start; i < end; ++i)
     {
-      OrientationType eu(m_Eulers->getValue(i * 3), m_Eulers->getValue(i * 3 + 1), m_Eulers->getValue(i * 3 + 2));
+      OrientationType eu(m_Eulers(i, 0), m_Eulers(i, 1), m_Eulers(i, 2));
       OrientationTransformation::eu2om<OrientationType, OrientationType>(eu).toGMatrix(g);
 
       EbsdMatrixMath::Transpose3x3(g, gTranpose);
@@ -1152,22 +1152,22 @@ public:
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void HexagonalOps::generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* xyz0001, EbsdLib::FloatArrayType* xyz1010, EbsdLib::FloatArrayType* xyz1120) const
+void HexagonalOps::generateSphereCoordsFromEulers(const EbsdArrayView<const float>& eulers, EbsdLib::FloatArrayType* xyz0001, EbsdLib::FloatArrayType* xyz1010, EbsdLib::FloatArrayType* xyz1120) const
 {
-  size_t nOrientations = eulers->getNumberOfTuples();
+  size_t nOrientations = eulers.getNumberOfTuples();
 
   // Sanity Check the size of the arrays
   if(xyz0001->getNumberOfTuples() < nOrientations * HexagonalHigh::symSize0)
   {
-    xyz0001->resizeTuples(nOrientations * HexagonalHigh::symSize0 * 3);
+    xyz0001->resizeTuples(nOrientations * HexagonalHigh::symSize0);
   }
   if(xyz1010->getNumberOfTuples() < nOrientations * HexagonalHigh::symSize1)
   {
-    xyz1010->resizeTuples(nOrientations * HexagonalHigh::symSize1 * 3);
+    xyz1010->resizeTuples(nOrientations * HexagonalHigh::symSize1);
   }
   if(xyz1120->getNumberOfTuples() < nOrientations * HexagonalHigh::symSize2)
   {
-    xyz1120->resizeTuples(nOrientations * HexagonalHigh::symSize2 * 3);
+    xyz1120->resizeTuples(nOrientations * HexagonalHigh::symSize2);
   }
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
@@ -1216,7 +1216,6 @@ EbsdLib::Rgb HexagonalOps::generateIPFColor(double phi1, double phi, double phi2
   double p[3];
   double refDirection[3] = {0.0f, 0.0f, 0.0f};
   double chi = 0.0f, eta = 0.0f;
-  double _rgb[3] = {0.0, 0.0, 0.0};
 
   OrientationType eu(phi1, phi, phi2);
   OrientationType om(9); // Reusable for the loop
@@ -1251,6 +1250,16 @@ EbsdLib::Rgb HexagonalOps::generateIPFColor(double phi1, double phi, double phi2
     break;
   }
 
+  return computeIPFColor(eta, chi);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdLib::Rgb HexagonalOps::computeIPFColor(double eta, double chi) const
+{
+  double _rgb[3] = {0.0, 0.0, 0.0};
+
   double etaMin = 0.0;
   double etaMax = 30.0;
   double chiMax = 90.0;
@@ -1306,14 +1315,23 @@ EbsdLib::Rgb HexagonalOps::generateRodriguesColor(double r1, double r2, double r
   return EbsdLib::RgbColor::dRgb(static_cast<int32_t>(red * 255), static_cast<int32_t>(green * 255), static_cast<int32_t>(blue * 255), 255);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::array<std::string, 3> HexagonalOps::getDefaultPoleFigureNames() const
+{
+  return {"<0001>", "<10-10>", "<2-1-10>"};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 std::vector<EbsdLib::UInt8ArrayType::Pointer> HexagonalOps::generatePoleFigure(PoleFigureConfiguration_t& config) const
 {
-  std::string label0 = std::string("<0001>");
-  std::string label1 = std::string("<10-10>");
-  std::string label2 = std::string("<2-1-10>");
+  std::array<std::string, 3> names = getDefaultPoleFigureNames();
+  std::string label0 = names[0];
+  std::string label1 = names[1];
+  std::string label2 = names[2];
   if(!config.labels.empty())
   {
     label0 = config.labels.at(0);
@@ -1327,27 +1345,28 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> HexagonalOps::generatePoleFigure(P
     label2 = config.labels.at(2);
   }
 
-  size_t numOrientations = config.eulers->getNumberOfTuples();
+  EbsdArrayView<const float> eulers = config.getEulers();
+  size_t numOrientations = eulers.getNumberOfTuples();
 
   // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
   // this is size for CUBIC ONLY, <001> Family
   std::vector<size_t> dims(1, 3);
-  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalHigh::symSize0, dims, label0 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * HexagonalHigh::symSize0, dims, label0 + std::string("xyzCoords"));
   // this is size for CUBIC ONLY, <011> Family
-  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalHigh::symSize1, dims, label1 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * HexagonalHigh::symSize1, dims, label1 + std::string("xyzCoords"));
   // this is size for CUBIC ONLY, <111> Family
-  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(numOrientations * HexagonalHigh::symSize2, dims, label2 + std::string("xyzCoords"), true);
+  EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateUninitializedArray(numOrientations * HexagonalHigh::symSize2, dims, label2 + std::string("xyzCoords"));
 
   config.sphereRadius = 1.0f;
 
   // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
+  generateSphereCoordsFromEulers(eulers, xyz001.get(), xyz011.get(), xyz111.get());
 
   // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
   // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
-  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image", true);
-  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image", true);
+  EbsdLib::DoubleArrayType::Pointer intensity001 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label0 + "_Intensity_Image");
+  EbsdLib::DoubleArrayType::Pointer intensity011 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label1 + "_Intensity_Image");
+  EbsdLib::DoubleArrayType::Pointer intensity111 = EbsdLib::DoubleArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, {1}, label2 + "_Intensity_Image");
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
   bool doParallel = true;
 
@@ -1371,58 +1390,12 @@ std::vector<EbsdLib::UInt8ArrayType::Pointer> HexagonalOps::generatePoleFigure(P
   }
 
   // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
-  double max = std::numeric_limits<double>::min();
-  double min = std::numeric_limits<double>::max();
-
-  double* dPtr = intensity001->getPointer(0);
-  size_t count = intensity001->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity011->getPointer(0);
-  count = intensity011->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  dPtr = intensity111->getPointer(0);
-  count = intensity111->getNumberOfTuples();
-  for(size_t i = 0; i < count; ++i)
-  {
-    if(dPtr[i] > max)
-    {
-      max = dPtr[i];
-    }
-    if(dPtr[i] < min)
-    {
-      min = dPtr[i];
-    }
-  }
-
-  config.minScale = min;
-  config.maxScale = max;
+  PoleFigureUtilities::FindIntensityRange({intensity001.get(), intensity011.get(), intensity111.get()}, config);
 
   dims[0] = 4;
-  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label0, true);
-  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label1, true);
-  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label2, true);
+  EbsdLib::UInt8ArrayType::Pointer image001 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label0);
+  EbsdLib::UInt8ArrayType::Pointer image011 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label1);
+  EbsdLib::UInt8ArrayType::Pointer image111 = EbsdLib::UInt8ArrayType::CreateUninitializedArray(config.imageDim * config.imageDim, dims, label2);
 
   std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(3);
   if(config.order.size() == 3)
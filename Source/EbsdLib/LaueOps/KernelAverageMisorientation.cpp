@@ -0,0 +1,269 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "KernelAverageMisorientation.h"
+
+#include <algorithm>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/QuatSymmetryKernels.hpp"
+#include "EbsdLib/Math/EbsdLibMath.h"
+
+namespace Detail
+{
+/**
+ * @brief Tile sizes in points. A tile of full X rows keeps the rows of its kernel in cache while it is processed.
+ */
+constexpr size_t k_KamTileY = 16;
+constexpr size_t k_KamTileZ = 4;
+
+/**
+ * @brief The KernelAverageMisorientationImpl class computes the KAM of the points of a range of tiles. Each tile is
+ * k_KamTileZ slabs by k_KamTileY rows of full X rows.
+ */
+class KernelAverageMisorientationImpl
+{
+public:
+  KernelAverageMisorientationImpl(const std::vector<std::vector<double>>& symTables, const float* quats, const int32_t* phases, const bool* goodPoints, const size_t dims[3],
+                                  const int32_t radius[3], double threshold, float* kam)
+  : m_SymTables(symTables)
+  , m_Quats(quats)
+  , m_Phases(phases)
+  , m_GoodPoints(goodPoints)
+  , m_Threshold(threshold)
+  , m_Kam(kam)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = dims[d];
+      m_Radius[d] = static_cast<size_t>(std::max(radius[d], 0));
+    }
+    m_NumTilesY = (m_Dims[1] + k_KamTileY - 1) / k_KamTileY;
+  }
+  virtual ~KernelAverageMisorientationImpl() = default;
+
+  /**
+   * @brief Returns true if the point has a known Laue class and is not masked out
+   */
+  bool isValid(size_t index) const
+  {
+    const int32_t phase = m_Phases[index];
+    return (m_GoodPoints == nullptr || m_GoodPoints[index]) && phase >= 0 && static_cast<size_t>(phase) < m_SymTables.size() && !m_SymTables[phase].empty();
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    double table[EbsdLib::Detail::k_MaxQuatSymOps * 4];
+    double q[4];
+    const size_t sliceSize = m_Dims[0] * m_Dims[1];
+    for(size_t tile = start; tile < end; tile++)
+    {
+      const size_t zStart = (tile / m_NumTilesY) * k_KamTileZ;
+      const size_t yStart = (tile % m_NumTilesY) * k_KamTileY;
+      const size_t zEnd = std::min(zStart + k_KamTileZ, m_Dims[2]);
+      const size_t yEnd = std::min(yStart + k_KamTileY, m_Dims[1]);
+      for(size_t z = zStart; z < zEnd; z++)
+      {
+        const size_t kzStart = z > m_Radius[2] ? z - m_Radius[2] : 0;
+        const size_t kzEnd = std::min(z + m_Radius[2] + 1, m_Dims[2]);
+        for(size_t y = yStart; y < yEnd; y++)
+        {
+          const size_t kyStart = y > m_Radius[1] ? y - m_Radius[1] : 0;
+          const size_t kyEnd = std::min(y + m_Radius[1] + 1, m_Dims[1]);
+          for(size_t x = 0; x < m_Dims[0]; x++)
+          {
+            const size_t index = z * sliceSize + y * m_Dims[0] + x;
+            m_Kam[index] = 0.0f;
+            if(!isValid(index))
+            {
+              continue;
+            }
+            const int32_t phase = m_Phases[index];
+            const double* symTable = m_SymTables[phase].data();
+            const size_t numSym = m_SymTables[phase].size() / 4;
+            for(size_t c = 0; c < 4; c++)
+            {
+              q[c] = m_Quats[index * 4 + c];
+            }
+            EbsdLib::Detail::CreateSymmetricTable(symTable, numSym, q, false, table);
+
+            const size_t kxStart = x > m_Radius[0] ? x - m_Radius[0] : 0;
+            const size_t kxEnd = std::min(x + m_Radius[0] + 1, m_Dims[0]);
+            double sum = 0.0;
+            size_t count = 0;
+            for(size_t kz = kzStart; kz < kzEnd; kz++)
+            {
+              for(size_t ky = kyStart; ky < kyEnd; ky++)
+              {
+                const size_t rowOffset = kz * sliceSize + ky * m_Dims[0];
+                for(size_t kx = kxStart; kx < kxEnd; kx++)
+                {
+                  const size_t neighbor = rowOffset + kx;
+                  if(neighbor == index || m_Phases[neighbor] != phase || !isValid(neighbor))
+                  {
+                    continue;
+                  }
+                  for(size_t c = 0; c < 4; c++)
+                  {
+                    q[c] = m_Quats[neighbor * 4 + c];
+                  }
+                  double angle = EbsdLib::Detail::MisorientationAngle(table, numSym, q);
+                  if(angle <= m_Threshold)
+                  {
+                    sum += angle;
+                    count++;
+                  }
+                }
+              }
+            }
+            if(count > 0)
+            {
+              m_Kam[index] = static_cast<float>(sum / static_cast<double>(count));
+            }
+          }
+        }
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<std::vector<double>>& m_SymTables;
+  const float* m_Quats;
+  const int32_t* m_Phases;
+  const bool* m_GoodPoints;
+  size_t m_Dims[3] = {0, 0, 0};
+  size_t m_Radius[3] = {0, 0, 0};
+  size_t m_NumTilesY = 0;
+  double m_Threshold;
+  float* m_Kam;
+};
+} // namespace Detail
+
+// -----------------------------------------------------------------------------
+KernelAverageMisorientation::KernelAverageMisorientation(const std::vector<uint32_t>& crystalStructures)
+: m_CrystalStructures(crystalStructures)
+, m_Threshold(5.0 * EbsdLib::Constants::k_PiOver180D)
+{
+}
+
+// -----------------------------------------------------------------------------
+KernelAverageMisorientation::~KernelAverageMisorientation() = default;
+
+// -----------------------------------------------------------------------------
+KernelAverageMisorientation::Pointer KernelAverageMisorientation::New(const std::vector<uint32_t>& crystalStructures)
+{
+  Pointer sharedPtr(new KernelAverageMisorientation(crystalStructures));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+KernelAverageMisorientation::Pointer KernelAverageMisorientation::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::string KernelAverageMisorientation::getNameOfClass() const
+{
+  return ClassName();
+}
+
+// -----------------------------------------------------------------------------
+std::string KernelAverageMisorientation::ClassName()
+{
+  return std::string("KernelAverageMisorientation");
+}
+
+// -----------------------------------------------------------------------------
+void KernelAverageMisorientation::setKernelRadius(const int32_t radius[3])
+{
+  for(size_t d = 0; d < 3; d++)
+  {
+    m_KernelRadius[d] = radius[d];
+  }
+}
+
+// -----------------------------------------------------------------------------
+void KernelAverageMisorientation::setThreshold(double threshold)
+{
+  m_Threshold = threshold;
+}
+
+// -----------------------------------------------------------------------------
+void KernelAverageMisorientation::compute(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* phases, const size_t dims[3], EbsdLib::FloatArrayType* kam, const bool* goodPoints) const
+{
+  const size_t numPoints = dims[0] * dims[1] * dims[2];
+  if(kam->getNumberOfTuples() < numPoints)
+  {
+    kam->resizeTuples(numPoints);
+  }
+  if(numPoints == 0 || quats->getNumberOfTuples() < numPoints || phases->getNumberOfTuples() < numPoints)
+  {
+    // Too few input tuples, no point is valid
+    kam->initializeWithZeros();
+    return;
+  }
+
+  const std::vector<LaueOps::Pointer>& ops = LaueOps::GetAllOrientationOps();
+  std::vector<std::vector<double>> symTables(m_CrystalStructures.size());
+  for(size_t phase = 0; phase < m_CrystalStructures.size(); phase++)
+  {
+    if(m_CrystalStructures[phase] < EbsdLib::CrystalStructure::LaueGroupEnd)
+    {
+      symTables[phase] = EbsdLib::Detail::CreateQuatSymTable(*ops[m_CrystalStructures[phase]]);
+    }
+  }
+
+  Detail::KernelAverageMisorientationImpl impl(symTables, quats->getPointer(0), phases->getPointer(0), goodPoints, dims, m_KernelRadius, m_Threshold, kam->getPointer(0));
+  const size_t numTiles = ((dims[1] + Detail::k_KamTileY - 1) / Detail::k_KamTileY) * ((dims[2] + Detail::k_KamTileZ - 1) / Detail::k_KamTileZ);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numTiles), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, numTiles);
+#endif
+}
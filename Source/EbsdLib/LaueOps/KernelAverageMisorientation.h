@@ -0,0 +1,121 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class KernelAverageMisorientation KernelAverageMisorientation.h EbsdLib/LaueOps/KernelAverageMisorientation.h
+ * @brief The KernelAverageMisorientation class computes the kernel average misorientation (KAM) of every point of a
+ * 2D or 3D orientation map: the average misorientation between the point and the points of its kernel (the box of
+ * +/- radius points around it) that have the same phase and are misoriented by no more than a threshold.
+ *
+ * The points are stored with X varying fastest, then Y, then Z, the layout of the arrays loaded by
+ * H5EbsdVolumeReader. The grid is processed in parallel in tiles of a few slabs so that the neighbors of a tile stay
+ * in cache. The symmetrically equivalent quaternions of each point are expanded once and reused for every neighbor,
+ * so each neighbor costs a 4 component dot product per symmetry operator. All misorientations are in radians.
+ */
+class EbsdLib_EXPORT KernelAverageMisorientation
+{
+public:
+  using Self = KernelAverageMisorientation;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  /**
+   * @brief Creates an engine for the phases of a scan
+   * @param crystalStructures The EbsdLib::CrystalStructure value of each phase
+   */
+  static Pointer New(const std::vector<uint32_t>& crystalStructures);
+
+  /**
+   * @brief Returns the name of the class for KernelAverageMisorientation
+   */
+  std::string getNameOfClass() const;
+  /**
+   * @brief Returns the name of the class for KernelAverageMisorientation
+   */
+  static std::string ClassName();
+
+  ~KernelAverageMisorientation();
+
+  /**
+   * @brief Sets the kernel radius in points along X, Y and Z. The default is 1 along every axis, i.e. the 26 nearest
+   * neighbors in 3D and the 8 nearest neighbors in 2D.
+   */
+  void setKernelRadius(const int32_t radius[3]);
+
+  /**
+   * @brief Sets the largest misorientation (in radians) between a point and a neighbor for the neighbor to be part of
+   * the average. Neighbors beyond it, e.g. across a grain boundary, are ignored. The default is 5 degrees.
+   */
+  void setThreshold(double threshold);
+
+  /**
+   * @brief Computes the KAM of every point
+   * @param quats Per point quaternions as 4 component (x, y, z, w) tuples
+   * @param phases Phase of each point. Points whose phase has no known Laue class are set to 0 and are not the
+   * neighbor of any point.
+   * @param dims The number of points along X, Y and Z. Use 1 for Z with 2D maps.
+   * @param kam [output] KAM of each point, resized if too small. Points without any neighbor are set to 0.
+   * All of it is set to 0 if quats or phases have fewer than dims[0] * dims[1] * dims[2] tuples.
+   * @param goodPoints Optional mask. Points where it is false are treated like points of an unknown phase.
+   */
+  void compute(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* phases, const size_t dims[3], EbsdLib::FloatArrayType* kam, const bool* goodPoints = nullptr) const;
+
+protected:
+  explicit KernelAverageMisorientation(const std::vector<uint32_t>& crystalStructures);
+
+private:
+  std::vector<uint32_t> m_CrystalStructures;
+  int32_t m_KernelRadius[3] = {1, 1, 1};
+  double m_Threshold = 0.0;
+
+public:
+  KernelAverageMisorientation(const KernelAverageMisorientation&) = delete;            // Copy Constructor Not Implemented
+  KernelAverageMisorientation(KernelAverageMisorientation&&) = delete;                 // Move Constructor Not Implemented
+  KernelAverageMisorientation& operator=(const KernelAverageMisorientation&) = delete; // Copy Assignment Not Implemented
+  KernelAverageMisorientation& operator=(KernelAverageMisorientation&&) = delete;      // Move Assignment Not Implemented
+};
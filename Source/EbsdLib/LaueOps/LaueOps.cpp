@@ -35,25 +35,44 @@
 
 #include "LaueOps.h"
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <random>
+#include <type_traits>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_group.h>
+#endif
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/EbsdMacros.h"
+#include "EbsdLib/Core/FusedOrientationTransformation.hpp"
 #include "EbsdLib/LaueOps/CubicLowOps.h"
 #include "EbsdLib/LaueOps/CubicOps.h"
 #include "EbsdLib/LaueOps/HexagonalLowOps.h"
 #include "EbsdLib/LaueOps/HexagonalOps.h"
+#include "EbsdLib/LaueOps/LaueOpsDispatch.hpp"
 #include "EbsdLib/LaueOps/MonoclinicOps.h"
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
+#include "EbsdLib/LaueOps/PhasePartition.h"
+#include "EbsdLib/LaueOps/QuatSymmetryKernels.hpp"
 #include "EbsdLib/LaueOps/TetragonalLowOps.h"
 #include "EbsdLib/LaueOps/TetragonalOps.h"
 #include "EbsdLib/LaueOps/TriclinicOps.h"
 #include "EbsdLib/LaueOps/TrigonalLowOps.h"
 #include "EbsdLib/LaueOps/TrigonalOps.h"
 #include "EbsdLib/Math/EbsdLibRandom.h"
+#include "EbsdLib/Math/EbsdMatrixMath.h"
 #include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
+#include "EbsdLib/Utilities/GaussianSmoothing.hpp"
+#include "EbsdLib/Utilities/ModifiedLambertProjection.h"
 
 namespace Detail
 {
@@ -72,6 +91,1307 @@ namespace Detail
 // const static double CosOfHalf = cosf(0.5f);
 // const static double SinOfZero = std::sin(0.0f);
 // const static double CosOfZero = cosf(0.0f);
+
+/**
+ * @brief Number of values stored per slip system in the slip transmission cache: the rotated and normalized slip
+ * plane (3) and slip direction (3), the Schmid factor and the direction component of the Schmid factor.
+ */
+const static size_t k_SlipSystemCacheStride = 8;
+
+/**
+ * @brief Same semantics as GeometryMath::CosThetaBetweenVectors but operating on values that are stored in the
+ * structure-of-arrays layout of the slip system cache.
+ */
+inline double CosThetaBetweenVectors(const double a[3], double bx, double by, double bz)
+{
+  double norm1 = std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+  double norm2 = std::sqrt(bx * bx + by * by + bz * bz);
+  if(norm1 == 0 || norm2 == 0)
+  {
+    return 1.0;
+  }
+  return (a[0] * bx + a[1] * by + a[2] * bz) / (norm1 * norm2);
+}
+
+/**
+ * @brief The SlipSystemCacheImpl class rotates the slip systems of each grain into the sample frame and stores
+ * them, along with their Schmid factors, so that they can be reused by every boundary the grain is part of.
+ *
+ * For each grain the cache holds numSlipSystems values of each of: plane x, plane y, plane z, direction x,
+ * direction y, direction z, Schmid factor and direction component.
+ */
+class SlipSystemCacheImpl
+{
+public:
+  SlipSystemCacheImpl(const double slipPlanes[][3], const double slipDirections[][3], size_t numSlipSystems, const float* quats, const double LD[3], double* cache, int32_t* maxSchmidIndex)
+  : m_SlipPlanes(slipPlanes)
+  , m_SlipDirections(slipDirections)
+  , m_NumSlipSystems(numSlipSystems)
+  , m_Quats(quats)
+  , m_LD(LD)
+  , m_Cache(cache)
+  , m_MaxSchmidIndex(maxSchmidIndex)
+  {
+  }
+  virtual ~SlipSystemCacheImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    double g[3][3];
+    double gTemp[3][3];
+    double slipPlane[3];
+    double slipDirection[3];
+    double hkl[3];
+    double uvw[3];
+    const size_t n = m_NumSlipSystems;
+
+    for(size_t grain = start; grain < end; grain++)
+    {
+      const float* q = m_Quats + grain * 4;
+      QuatD quat(q[0], q[1], q[2], q[3]);
+      OrientationTransformation::qu2om<QuatD, OrientationType>(quat).toGMatrix(gTemp);
+      EbsdMatrixMath::Transpose3x3(gTemp, g);
+
+      double* planeX = m_Cache + grain * n * k_SlipSystemCacheStride;
+      double* planeY = planeX + n;
+      double* planeZ = planeY + n;
+      double* dirX = planeZ + n;
+      double* dirY = dirX + n;
+      double* dirZ = dirY + n;
+      double* schmid = dirZ + n;
+      double* dirComp = schmid + n;
+
+      double maxSchmidFactor = 0.0;
+      int32_t maxIndex = -1;
+      for(size_t i = 0; i < n; i++)
+      {
+        slipPlane[0] = m_SlipPlanes[i][0];
+        slipPlane[1] = m_SlipPlanes[i][1];
+        slipPlane[2] = m_SlipPlanes[i][2];
+        slipDirection[0] = m_SlipDirections[i][0];
+        slipDirection[1] = m_SlipDirections[i][1];
+        slipDirection[2] = m_SlipDirections[i][2];
+        EbsdMatrixMath::Multiply3x3with3x1(g, slipPlane, hkl);
+        EbsdMatrixMath::Multiply3x3with3x1(g, slipDirection, uvw);
+        EbsdMatrixMath::Normalize3x1(hkl);
+        EbsdMatrixMath::Normalize3x1(uvw);
+        planeX[i] = hkl[0];
+        planeY[i] = hkl[1];
+        planeZ[i] = hkl[2];
+        dirX[i] = uvw[0];
+        dirY[i] = uvw[1];
+        dirZ[i] = uvw[2];
+        dirComp[i] = std::fabs(CosThetaBetweenVectors(m_LD, uvw[0], uvw[1], uvw[2]));
+        schmid[i] = dirComp[i] * std::fabs(CosThetaBetweenVectors(m_LD, hkl[0], hkl[1], hkl[2]));
+        if(schmid[i] > maxSchmidFactor)
+        {
+          maxSchmidFactor = schmid[i];
+          maxIndex = static_cast<int32_t>(i);
+        }
+      }
+      m_MaxSchmidIndex[grain] = maxIndex;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const double (*m_SlipPlanes)[3];
+  const double (*m_SlipDirections)[3];
+  size_t m_NumSlipSystems;
+  const float* m_Quats;
+  const double* m_LD;
+  double* m_Cache;
+  int32_t* m_MaxSchmidIndex;
+};
+
+/**
+ * @brief The SlipTransmissionMetricsImpl class evaluates mPrime, F1, F1spt and F7 for a range of boundaries
+ * using the slip systems cached by SlipSystemCacheImpl. The inner loops run over contiguous arrays so that
+ * the compiler is able to vectorize them.
+ */
+class SlipTransmissionMetricsImpl
+{
+public:
+  SlipTransmissionMetricsImpl(size_t numSlipSystems, size_t numGrains, const double* cache, const int32_t* maxSchmidIndex, const int32_t* boundaryPairs, bool maxSF, double* mPrime, double* F1,
+                              double* F1spt, double* F7)
+  : m_NumSlipSystems(numSlipSystems)
+  , m_NumGrains(numGrains)
+  , m_Cache(cache)
+  , m_MaxSchmidIndex(maxSchmidIndex)
+  , m_BoundaryPairs(boundaryPairs)
+  , m_MaxSF(maxSF)
+  , m_mPrime(mPrime)
+  , m_F1(F1)
+  , m_F1spt(F1spt)
+  , m_F7(F7)
+  {
+  }
+  virtual ~SlipTransmissionMetricsImpl() = default;
+
+  /**
+   * @brief Sums the absolute cosines between one slip vector of grain 1 and every slip vector of grain 2
+   */
+  static double SumAbsCosines(double ax, double ay, double az, const double* bx, const double* by, const double* bz, size_t n)
+  {
+    double sum = 0.0;
+    for(size_t j = 0; j < n; j++)
+    {
+      sum += std::fabs(ax * bx[j] + ay * by[j] + az * bz[j]);
+    }
+    return sum;
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t n = m_NumSlipSystems;
+    const size_t stride = n * k_SlipSystemCacheStride;
+    for(size_t b = start; b < end; b++)
+    {
+      const int32_t grain1 = m_BoundaryPairs[b * 2];
+      const int32_t grain2 = m_BoundaryPairs[b * 2 + 1];
+      double mPrime = 0.0;
+      double F1 = 0.0;
+      double F1spt = 0.0;
+      double F7 = 0.0;
+      if(grain1 >= 0 && grain2 >= 0 && static_cast<size_t>(grain1) < m_NumGrains && static_cast<size_t>(grain2) < m_NumGrains)
+      {
+        const double* c1 = m_Cache + static_cast<size_t>(grain1) * stride;
+        const double* c2 = m_Cache + static_cast<size_t>(grain2) * stride;
+        const double* planes1[3] = {c1, c1 + n, c1 + 2 * n};
+        const double* dirs1[3] = {c1 + 3 * n, c1 + 4 * n, c1 + 5 * n};
+        const double* schmid1 = c1 + 6 * n;
+        const double* dirComp1 = c1 + 7 * n;
+        const double* planes2[3] = {c2, c2 + n, c2 + 2 * n};
+        const double* dirs2[3] = {c2 + 3 * n, c2 + 4 * n, c2 + 5 * n};
+
+        // mPrime always compares the maximum Schmid factor systems of each grain
+        const size_t ss1 = static_cast<size_t>(std::max(m_MaxSchmidIndex[grain1], 0));
+        const size_t ss2 = static_cast<size_t>(std::max(m_MaxSchmidIndex[grain2], 0));
+        double hkl1[3] = {planes1[0][ss1], planes1[1][ss1], planes1[2][ss1]};
+        double uvw1[3] = {dirs1[0][ss1], dirs1[1][ss1], dirs1[2][ss1]};
+        double planeMisalignment = std::fabs(CosThetaBetweenVectors(hkl1, planes2[0][ss2], planes2[1][ss2], planes2[2][ss2]));
+        double directionMisalignment = std::fabs(CosThetaBetweenVectors(uvw1, dirs2[0][ss2], dirs2[1][ss2], dirs2[2][ss2]));
+        mPrime = planeMisalignment * directionMisalignment;
+
+        size_t first = 0;
+        size_t last = n;
+        if(m_MaxSF)
+        {
+          // Only the first slip system holding the maximum Schmid factor contributes
+          first = static_cast<size_t>(m_MaxSchmidIndex[grain1]);
+          last = m_MaxSchmidIndex[grain1] < 0 ? 0 : first + 1;
+        }
+        for(size_t i = first; i < last; i++)
+        {
+          double totalDirectionMisalignment = SumAbsCosines(dirs1[0][i], dirs1[1][i], dirs1[2][i], dirs2[0], dirs2[1], dirs2[2], n);
+          double totalPlaneMisalignment = SumAbsCosines(planes1[0][i], planes1[1][i], planes1[2][i], planes2[0], planes2[1], planes2[2], n);
+          F1 = std::max(F1, schmid1[i] * dirComp1[i] * totalDirectionMisalignment);
+          F1spt = std::max(F1spt, schmid1[i] * dirComp1[i] * totalDirectionMisalignment * totalPlaneMisalignment);
+          F7 = std::max(F7, dirComp1[i] * dirComp1[i] * totalDirectionMisalignment);
+        }
+      }
+      if(nullptr != m_mPrime)
+      {
+        m_mPrime[b] = mPrime;
+      }
+      if(nullptr != m_F1)
+      {
+        m_F1[b] = F1;
+      }
+      if(nullptr != m_F1spt)
+      {
+        m_F1spt[b] = F1spt;
+      }
+      if(nullptr != m_F7)
+      {
+        m_F7[b] = F7;
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  size_t m_NumSlipSystems;
+  size_t m_NumGrains;
+  const double* m_Cache;
+  const int32_t* m_MaxSchmidIndex;
+  const int32_t* m_BoundaryPairs;
+  bool m_MaxSF;
+  double* m_mPrime;
+  double* m_F1;
+  double* m_F1spt;
+  double* m_F7;
+};
+
+/**
+ * @brief The SlipTransmissionPairsImpl class is the fallback used by Laue classes that do not define slip systems. It
+ * simply calls the single boundary methods of the LaueOps instance.
+ */
+template <typename OpsType>
+class SlipTransmissionPairsImpl
+{
+public:
+  SlipTransmissionPairsImpl(const OpsType* ops, const float* quats, size_t numGrains, const int32_t* boundaryPairs, const double LD[3], bool maxSF, double* mPrime, double* F1, double* F1spt,
+                            double* F7)
+  : m_Ops(ops)
+  , m_Quats(quats)
+  , m_NumGrains(numGrains)
+  , m_BoundaryPairs(boundaryPairs)
+  , m_LD(LD)
+  , m_MaxSF(maxSF)
+  , m_mPrime(mPrime)
+  , m_F1(F1)
+  , m_F1spt(F1spt)
+  , m_F7(F7)
+  {
+  }
+  virtual ~SlipTransmissionPairsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t b = start; b < end; b++)
+    {
+      const int32_t grain1 = m_BoundaryPairs[b * 2];
+      const int32_t grain2 = m_BoundaryPairs[b * 2 + 1];
+      bool valid = grain1 >= 0 && grain2 >= 0 && static_cast<size_t>(grain1) < m_NumGrains && static_cast<size_t>(grain2) < m_NumGrains;
+      QuatD q1;
+      QuatD q2;
+      if(valid)
+      {
+        const float* p1 = m_Quats + static_cast<size_t>(grain1) * 4;
+        const float* p2 = m_Quats + static_cast<size_t>(grain2) * 4;
+        q1 = QuatD(p1[0], p1[1], p1[2], p1[3]);
+        q2 = QuatD(p2[0], p2[1], p2[2], p2[3]);
+      }
+      // The single boundary methods may normalize the loading direction in place so each gets its own copy
+      double LD[3] = {m_LD[0], m_LD[1], m_LD[2]};
+      if(nullptr != m_mPrime)
+      {
+        m_mPrime[b] = valid ? m_Ops->getmPrime(q1, q2, LD) : 0.0;
+      }
+      if(nullptr != m_F1)
+      {
+        LD[0] = m_LD[0], LD[1] = m_LD[1], LD[2] = m_LD[2];
+        m_F1[b] = valid ? m_Ops->getF1(q1, q2, LD, m_MaxSF) : 0.0;
+      }
+      if(nullptr != m_F1spt)
+      {
+        LD[0] = m_LD[0], LD[1] = m_LD[1], LD[2] = m_LD[2];
+        m_F1spt[b] = valid ? m_Ops->getF1spt(q1, q2, LD, m_MaxSF) : 0.0;
+      }
+      if(nullptr != m_F7)
+      {
+        LD[0] = m_LD[0], LD[1] = m_LD[1], LD[2] = m_LD[2];
+        m_F7[b] = valid ? m_Ops->getF7(q1, q2, LD, m_MaxSF) : 0.0;
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OpsType* m_Ops;
+  const float* m_Quats;
+  size_t m_NumGrains;
+  const int32_t* m_BoundaryPairs;
+  const double* m_LD;
+  bool m_MaxSF;
+  double* m_mPrime;
+  double* m_F1;
+  double* m_F1spt;
+  double* m_F7;
+};
+
+/**
+ * @brief Makes sure an optional output array can hold one value per boundary and returns its raw pointer
+ */
+inline double* PrepareSlipTransmissionOutput(EbsdLib::DoubleArrayType* output, size_t numBoundaries)
+{
+  if(nullptr == output)
+  {
+    return nullptr;
+  }
+  if(output->getSize() < numBoundaries)
+  {
+    output->resizeTuples(numBoundaries);
+  }
+  return output->getPointer(0);
+}
+
+/**
+ * @brief The largest slip system table the Schmid factor map kernel can evaluate.
+ */
+const static size_t k_MaxSchmidSlipSystems = 48;
+
+/**
+ * @brief Computes the crystal frame loading direction for the quaternion q (x, y, z, w) and the sample frame
+ * loading direction load.
+ */
+inline void CrystalLoadingDirection(const float* q, const double load[3], double crystalLoad[3])
+{
+  double g[3][3];
+  QuatD quat(q[0], q[1], q[2], q[3]);
+  OrientationTransformation::qu2om<QuatD, OrientationType>(quat).toGMatrix(g);
+  EbsdMatrixMath::Multiply3x3with3x1(g, load, crystalLoad);
+}
+
+/**
+ * @brief The SchmidFactorMapImpl class computes the Schmid factor, slip system and angle components for a range of
+ * points from a slip system table stored in structure-of-arrays layout (plane x, y, z then direction x, y, z). The
+ * per slip system loop runs over contiguous arrays so that the compiler is able to vectorize it.
+ */
+class SchmidFactorMapImpl
+{
+public:
+  SchmidFactorMapImpl(const double* slipSystemTable, size_t numSlipSystems, double planeNorm, double directionNorm, const float* quats, const double load[3], float* schmidFactors,
+                      int32_t* slipSystems, float* angleComps)
+  : m_SlipSystemTable(slipSystemTable)
+  , m_NumSlipSystems(numSlipSystems)
+  , m_PlaneNorm(planeNorm)
+  , m_DirectionNorm(directionNorm)
+  , m_Quats(quats)
+  , m_Load(load)
+  , m_SchmidFactors(schmidFactors)
+  , m_SlipSystems(slipSystems)
+  , m_AngleComps(angleComps)
+  {
+  }
+  virtual ~SchmidFactorMapImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t n = m_NumSlipSystems;
+    const double* planeX = m_SlipSystemTable;
+    const double* planeY = planeX + n;
+    const double* planeZ = planeY + n;
+    const double* dirX = planeZ + n;
+    const double* dirY = dirX + n;
+    const double* dirZ = dirY + n;
+
+    double crystalLoad[3];
+    double cosPhi[k_MaxSchmidSlipSystems];
+    double cosLambda[k_MaxSchmidSlipSystems];
+    double schmid[k_MaxSchmidSlipSystems];
+
+    for(size_t i = start; i < end; i++)
+    {
+      CrystalLoadingDirection(m_Quats + i * 4, m_Load, crystalLoad);
+      const double loadX = crystalLoad[0];
+      const double loadY = crystalLoad[1];
+      const double loadZ = crystalLoad[2];
+      const double mag = std::sqrt(loadX * loadX + loadY * loadY + loadZ * loadZ);
+      const double planeDenom = mag * m_PlaneNorm;
+      const double directionDenom = mag * m_DirectionNorm;
+
+      for(size_t s = 0; s < n; s++)
+      {
+        cosPhi[s] = std::fabs((planeX[s] * loadX + planeY[s] * loadY + planeZ[s] * loadZ) / planeDenom);
+        cosLambda[s] = std::fabs((dirX[s] * loadX + dirY[s] * loadY + dirZ[s] * loadZ) / directionDenom);
+        schmid[s] = cosPhi[s] * cosLambda[s];
+      }
+
+      // The first slip system wins ties, matching getSchmidFactorAndSS()
+      size_t slipSystem = 0;
+      for(size_t s = 1; s < n; s++)
+      {
+        if(schmid[s] > schmid[slipSystem])
+        {
+          slipSystem = s;
+        }
+      }
+
+      if(nullptr != m_SchmidFactors)
+      {
+        m_SchmidFactors[i] = static_cast<float>(schmid[slipSystem]);
+      }
+      if(nullptr != m_SlipSystems)
+      {
+        m_SlipSystems[i] = static_cast<int32_t>(slipSystem);
+      }
+      if(nullptr != m_AngleComps)
+      {
+        m_AngleComps[i * 2] = static_cast<float>(cosPhi[slipSystem]);
+        m_AngleComps[i * 2 + 1] = static_cast<float>(cosLambda[slipSystem]);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const double* m_SlipSystemTable;
+  size_t m_NumSlipSystems;
+  double m_PlaneNorm;
+  double m_DirectionNorm;
+  const float* m_Quats;
+  const double* m_Load;
+  float* m_SchmidFactors;
+  int32_t* m_SlipSystems;
+  float* m_AngleComps;
+};
+
+/**
+ * @brief The SchmidFactorPointsImpl class is the fallback used by Laue classes that do not define a slip system
+ * table. It simply calls getSchmidFactorAndSS() of the LaueOps instance for each point.
+ */
+template <typename OpsType>
+class SchmidFactorPointsImpl
+{
+public:
+  SchmidFactorPointsImpl(const OpsType* ops, const float* quats, const double load[3], float* schmidFactors, int32_t* slipSystems, float* angleComps)
+  : m_Ops(ops)
+  , m_Quats(quats)
+  , m_Load(load)
+  , m_SchmidFactors(schmidFactors)
+  , m_SlipSystems(slipSystems)
+  , m_AngleComps(angleComps)
+  {
+  }
+  virtual ~SchmidFactorPointsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    double crystalLoad[3];
+    for(size_t i = start; i < end; i++)
+    {
+      CrystalLoadingDirection(m_Quats + i * 4, m_Load, crystalLoad);
+      double schmidFactor = 0.0;
+      double angleComps[2] = {0.0, 0.0};
+      int slipSystem = 0;
+      m_Ops->getSchmidFactorAndSS(crystalLoad, schmidFactor, angleComps, slipSystem);
+      if(nullptr != m_SchmidFactors)
+      {
+        m_SchmidFactors[i] = static_cast<float>(schmidFactor);
+      }
+      if(nullptr != m_SlipSystems)
+      {
+        m_SlipSystems[i] = static_cast<int32_t>(slipSystem);
+      }
+      if(nullptr != m_AngleComps)
+      {
+        m_AngleComps[i * 2] = static_cast<float>(angleComps[0]);
+        m_AngleComps[i * 2 + 1] = static_cast<float>(angleComps[1]);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OpsType* m_Ops;
+  const float* m_Quats;
+  const double* m_Load;
+  float* m_SchmidFactors;
+  int32_t* m_SlipSystems;
+  float* m_AngleComps;
+};
+
+/**
+ * @brief The MisorientationPairsImpl class calls calculateMisorientation() of the LaueOps instance in double
+ * precision for each pair of orientations.
+ */
+template <typename OpsType>
+class MisorientationPairsImpl
+{
+public:
+  MisorientationPairsImpl(const OpsType* ops, const float* quats1, const float* quats2, float* axisAngles)
+  : m_Ops(ops)
+  , m_Quats1(quats1)
+  , m_Quats2(quats2)
+  , m_AxisAngles(axisAngles)
+  {
+  }
+  virtual ~MisorientationPairsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      const float* q1 = m_Quats1 + i * 4;
+      const float* q2 = m_Quats2 + i * 4;
+      OrientationD axisAngle = m_Ops->calculateMisorientation(QuatD(q1[0], q1[1], q1[2], q1[3]), QuatD(q2[0], q2[1], q2[2], q2[3]));
+      for(size_t c = 0; c < 4; c++)
+      {
+        m_AxisAngles[i * 4 + c] = static_cast<float>(axisAngle[c]);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OpsType* m_Ops;
+  const float* m_Quats1;
+  const float* m_Quats2;
+  float* m_AxisAngles;
+};
+
+/**
+ * @brief The MisorientationPairsSingleImpl class calculates misorientations entirely in float. The symmetry operators
+ * are stored in structure-of-arrays layout so that the search for the operator giving the largest |w| of the
+ * misorientation quaternion only evaluates the w component and vectorizes. The angle is computed with atan2 instead
+ * of acos so that small misorientations do not lose precision.
+ */
+class MisorientationPairsSingleImpl
+{
+public:
+  MisorientationPairsSingleImpl(const float* symTable, size_t numSym, const float* quats1, const float* quats2, float* axisAngles)
+  : m_SymTable(symTable)
+  , m_NumSym(numSym)
+  , m_Quats1(quats1)
+  , m_Quats2(quats2)
+  , m_AxisAngles(axisAngles)
+  {
+  }
+  virtual ~MisorientationPairsSingleImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    const float* symX = m_SymTable;
+    const float* symY = m_SymTable + m_NumSym;
+    const float* symZ = m_SymTable + 2 * m_NumSym;
+    const float* symW = m_SymTable + 3 * m_NumSym;
+    for(size_t i = start; i < end; i++)
+    {
+      const float* q1 = m_Quats1 + i * 4;
+      const float* q2 = m_Quats2 + i * 4;
+      QuatF qr = QuatF(q1[0], q1[1], q1[2], q1[3]) * QuatF(q2[0], q2[1], q2[2], q2[3]).conjugate();
+
+      size_t best = 0;
+      float wMax = -1.0f;
+      for(size_t s = 0; s < m_NumSym; s++)
+      {
+        float w = std::fabs(qr.w() * symW[s] - qr.x() * symX[s] - qr.y() * symY[s] - qr.z() * symZ[s]);
+        if(w > wMax)
+        {
+          wMax = w;
+          best = s;
+        }
+      }
+      QuatF qMin = QuatF(symX[best], symY[best], symZ[best], symW[best]) * qr;
+      if(qMin.w() < 0.0f)
+      {
+        qMin.negate();
+      }
+
+      float* axisAngle = m_AxisAngles + i * 4;
+      float vMag = std::sqrt(qMin.x() * qMin.x() + qMin.y() * qMin.y() + qMin.z() * qMin.z());
+      float angle = 2.0f * std::atan2(vMag, qMin.w());
+      if(vMag == 0.0f || angle == 0.0f)
+      {
+        axisAngle[0] = 0.0f;
+        axisAngle[1] = 0.0f;
+        axisAngle[2] = 1.0f;
+        axisAngle[3] = 0.0f;
+        continue;
+      }
+      axisAngle[0] = qMin.x() / vMag;
+      axisAngle[1] = qMin.y() / vMag;
+      axisAngle[2] = qMin.z() / vMag;
+      axisAngle[3] = angle;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_SymTable;
+  size_t m_NumSym;
+  const float* m_Quats1;
+  const float* m_Quats2;
+  float* m_AxisAngles;
+};
+
+/**
+ * @brief The NearestQuatsImpl class moves each quaternion of an array to its symmetrically equivalent quaternion
+ * nearest to a reference quaternion (one per element or one per group id) or, without references, nearest to the
+ * origin.
+ */
+class NearestQuatsImpl
+{
+public:
+  NearestQuatsImpl(const double* symTable, size_t numSym, const float* refQuats, size_t numRefs, const int32_t* groupIds, const float* quats, float* output)
+  : m_SymTable(symTable)
+  , m_NumSym(numSym)
+  , m_RefQuats(refQuats)
+  , m_NumRefs(numRefs)
+  , m_GroupIds(groupIds)
+  , m_Quats(quats)
+  , m_Output(output)
+  {
+  }
+  virtual ~NearestQuatsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    double q[4];
+    double ref[4];
+    double out[4];
+    for(size_t i = start; i < end; i++)
+    {
+      for(size_t c = 0; c < 4; c++)
+      {
+        q[c] = m_Quats[i * 4 + c];
+      }
+      const double* refPtr = nullptr;
+      if(m_RefQuats != nullptr)
+      {
+        size_t refIndex = i;
+        if(m_GroupIds != nullptr)
+        {
+          if(m_GroupIds[i] < 0 || static_cast<size_t>(m_GroupIds[i]) >= m_NumRefs)
+          {
+            for(size_t c = 0; c < 4; c++)
+            {
+              m_Output[i * 4 + c] = static_cast<float>(q[c]);
+            }
+            continue;
+          }
+          refIndex = static_cast<size_t>(m_GroupIds[i]);
+        }
+        for(size_t c = 0; c < 4; c++)
+        {
+          ref[c] = m_RefQuats[refIndex * 4 + c];
+        }
+        refPtr = ref;
+      }
+      EbsdLib::Detail::NearestSymmetricQuat(m_SymTable, m_NumSym, refPtr, q, out);
+      for(size_t c = 0; c < 4; c++)
+      {
+        m_Output[i * 4 + c] = static_cast<float>(out[c]);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const double* m_SymTable;
+  size_t m_NumSym;
+  const float* m_RefQuats;
+  size_t m_NumRefs;
+  const int32_t* m_GroupIds;
+  const float* m_Quats;
+  float* m_Output;
+};
+
+/**
+ * @brief The GroupAverageQuatsImpl class sums the members of each group after moving them to the symmetrically
+ * equivalent quaternion nearest to the reference of the group, on the same hemisphere as the reference, and stores
+ * the normalized sum. The members of a group are visited in index order so the sums do not depend on the number of
+ * threads.
+ */
+class GroupAverageQuatsImpl
+{
+public:
+  GroupAverageQuatsImpl(const double* symTable, size_t numSym, const PhasePartition& groups, const float* quats, const double* refQuats, double* avgQuats)
+  : m_SymTable(symTable)
+  , m_NumSym(numSym)
+  , m_Groups(groups)
+  , m_Quats(quats)
+  , m_RefQuats(refQuats)
+  , m_AvgQuats(avgQuats)
+  {
+  }
+  virtual ~GroupAverageQuatsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t group = start; group < end; group++)
+    {
+      const size_t count = m_Groups.getPhaseSize(group);
+      double* avg = m_AvgQuats + group * 4;
+      if(count == 0)
+      {
+        avg[0] = 0.0;
+        avg[1] = 0.0;
+        avg[2] = 0.0;
+        avg[3] = 1.0;
+        continue;
+      }
+      EbsdLib::Detail::AverageNearestQuats(m_SymTable, m_NumSym, m_Quats, m_Groups.getPhaseIndices(group), count, m_RefQuats + group * 4, avg);
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const double* m_SymTable;
+  size_t m_NumSym;
+  const PhasePartition& m_Groups;
+  const float* m_Quats;
+  const double* m_RefQuats;
+  double* m_AvgQuats;
+};
+
+/**
+ * @brief Writes the red, green and blue channels of a color into a 3 component tuple
+ */
+inline void StoreRgb(EbsdLib::Rgb argb, uint8_t* rgb)
+{
+  rgb[0] = static_cast<uint8_t>(EbsdLib::RgbColor::dRed(argb));
+  rgb[1] = static_cast<uint8_t>(EbsdLib::RgbColor::dGreen(argb));
+  rgb[2] = static_cast<uint8_t>(EbsdLib::RgbColor::dBlue(argb));
+}
+
+/**
+ * @brief The IPFColorsImpl class calls generateIPFColor() of the LaueOps instance in double precision for each point
+ */
+template <typename OpsType>
+class IPFColorsImpl
+{
+public:
+  IPFColorsImpl(const OpsType* ops, const EbsdArrayView<const float>& eulers, const double refDir[3], bool convertDegrees, uint8_t* rgb)
+  : m_Ops(ops)
+  , m_Eulers(eulers)
+  , m_RefDir(refDir)
+  , m_ConvertDegrees(convertDegrees)
+  , m_Rgb(rgb)
+  {
+  }
+  virtual ~IPFColorsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      EbsdLib::Rgb argb = m_Ops->generateIPFColor(m_Eulers(i, 0), m_Eulers(i, 1), m_Eulers(i, 2), m_RefDir[0], m_RefDir[1], m_RefDir[2], m_ConvertDegrees);
+      StoreRgb(argb, m_Rgb + i * 3);
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OpsType* m_Ops;
+  EbsdArrayView<const float> m_Eulers;
+  const double* m_RefDir;
+  bool m_ConvertDegrees;
+  uint8_t* m_Rgb;
+};
+
+/**
+ * @brief The IPFColorsSingleImpl class reduces the reference direction into the unit triangle in float. Only the
+ * final unit triangle test and color lookup go through the (double) virtual methods of the LaueOps instance.
+ */
+template <typename OpsType>
+class IPFColorsSingleImpl
+{
+public:
+  IPFColorsSingleImpl(const OpsType* ops, const std::vector<QuatF>& quatSym, const EbsdArrayView<const float>& eulers, const float refDir[3], bool convertDegrees, uint8_t* rgb)
+  : m_Ops(ops)
+  , m_QuatSym(quatSym)
+  , m_Eulers(eulers)
+  , m_RefDir(refDir)
+  , m_ConvertDegrees(convertDegrees)
+  , m_Rgb(rgb)
+  {
+  }
+  virtual ~IPFColorsSingleImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    namespace Fused = OrientationTransformation::Fused;
+    const bool hasInversion = m_Ops->getHasInversion();
+    const float scale = m_ConvertDegrees ? EbsdLib::Constants::k_DegToRadF : 1.0f;
+    float eu[3];
+    float qu[4];
+    float g[9];
+    for(size_t i = start; i < end; i++)
+    {
+      eu[0] = m_Eulers(i, 0) * scale;
+      eu[1] = m_Eulers(i, 1) * scale;
+      eu[2] = m_Eulers(i, 2) * scale;
+      Fused::Convert<Fused::RepType::Euler, Fused::RepType::Quaternion>(eu, qu);
+      QuatF q1(qu[0], qu[1], qu[2], qu[3]);
+
+      float chi = 0.0f;
+      float eta = 0.0f;
+      for(const QuatF& sym : m_QuatSym)
+      {
+        QuatF q = sym * q1;
+        qu[0] = q.x();
+        qu[1] = q.y();
+        qu[2] = q.z();
+        qu[3] = q.w();
+        Fused::Convert<Fused::RepType::Quaternion, Fused::RepType::OrientationMatrix>(qu, g);
+
+        float p0 = g[0] * m_RefDir[0] + g[1] * m_RefDir[1] + g[2] * m_RefDir[2];
+        float p1 = g[3] * m_RefDir[0] + g[4] * m_RefDir[1] + g[5] * m_RefDir[2];
+        float p2 = g[6] * m_RefDir[0] + g[7] * m_RefDir[1] + g[8] * m_RefDir[2];
+        float mag = std::sqrt(p0 * p0 + p1 * p1 + p2 * p2);
+        p0 /= mag;
+        p1 /= mag;
+        p2 /= mag;
+
+        if(p2 < 0.0f)
+        {
+          if(!hasInversion)
+          {
+            continue;
+          }
+          p0 = -p0, p1 = -p1, p2 = -p2;
+        }
+        chi = std::acos(std::min(p2, 1.0f));
+        eta = std::atan2(p1, p0);
+        if(m_Ops->inUnitTriangle(eta, chi))
+        {
+          break;
+        }
+      }
+      StoreRgb(m_Ops->computeIPFColor(eta, chi), m_Rgb + i * 3);
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OpsType* m_Ops;
+  const std::vector<QuatF>& m_QuatSym;
+  EbsdArrayView<const float> m_Eulers;
+  const float* m_RefDir;
+  bool m_ConvertDegrees;
+  uint8_t* m_Rgb;
+};
+
+/**
+ * @brief The bounding square of the stereographic projection of the unit triangle of a Laue class. Every inverse
+ * pole figure density image of the class covers this square.
+ */
+struct IPFDensityFrame
+{
+  double minX = -1.0;
+  double minY = -1.0;
+  double extent = 2.0;
+};
+
+/**
+ * @brief Holds the inverse pole figure frames that have been computed so far, one per Laue class
+ */
+struct IPFDensityFrameCache
+{
+  std::mutex mutex;
+  std::map<std::string, IPFDensityFrame> frames;
+};
+
+/**
+ * @brief Returns the direction on the unit sphere of a point of the stereographic projection
+ */
+inline void StereographicToSphere(double x, double y, double& eta, double& chi)
+{
+  double r2 = x * x + y * y;
+  double z = (1.0 - r2) / (1.0 + r2);
+  chi = std::acos(std::min(std::max(z, -1.0), 1.0));
+  eta = std::atan2(y, x);
+}
+
+/**
+ * @brief Returns the frame of the unit triangle of a Laue class. It is found once per class by scanning the
+ * stereographic projection with inUnitTriangle().
+ */
+IPFDensityFrame GetIPFDensityFrame(const LaueOps& ops)
+{
+  static IPFDensityFrameCache cache;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto iter = cache.frames.find(ops.getNameOfClass());
+  if(iter != cache.frames.end())
+  {
+    return iter->second;
+  }
+
+  const int scanDim = 512;
+  const double res = 2.0 / scanDim;
+  double minX = 1.0;
+  double maxX = -1.0;
+  double minY = 1.0;
+  double maxY = -1.0;
+  double eta = 0.0;
+  double chi = 0.0;
+  for(int j = 0; j < scanDim; j++)
+  {
+    double y = -1.0 + (j + 0.5) * res;
+    for(int i = 0; i < scanDim; i++)
+    {
+      double x = -1.0 + (i + 0.5) * res;
+      if(x * x + y * y > 1.0)
+      {
+        continue;
+      }
+      StereographicToSphere(x, y, eta, chi);
+      if(ops.inUnitTriangle(eta, chi))
+      {
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+      }
+    }
+  }
+
+  IPFDensityFrame frame;
+  if(minX <= maxX)
+  {
+    // Pad by one scan cell so the edges of the triangle are inside of the frame
+    minX = std::max(minX - res, -1.0);
+    minY = std::max(minY - res, -1.0);
+    maxX = std::min(maxX + res, 1.0);
+    maxY = std::min(maxY + res, 1.0);
+    frame.minX = minX;
+    frame.minY = minY;
+    frame.extent = std::max(maxX - minX, maxY - minY);
+  }
+  cache.frames[ops.getNameOfClass()] = frame;
+  return frame;
+}
+
+/**
+ * @brief The pixels of an inverse pole figure density image that overlap the unit triangle
+ */
+struct IPFDensityMask
+{
+  std::vector<std::pair<int, int>> rowSpans; ///<* The first and one past the last pixel of each row that overlaps the triangle
+  std::vector<double> coverage;              ///<* The fraction of each pixel that is inside of the triangle
+};
+
+/**
+ * @brief Finds the pixels of an inverse pole figure density image that overlap the unit triangle. The corners of
+ * every pixel are tested and only the pixels on the edge of the triangle are sampled more finely. The triangles are
+ * convex so every row is a single span of pixels.
+ */
+IPFDensityMask GetIPFDensityMask(const LaueOps& ops, const IPFDensityFrame& frame, int imageDim)
+{
+  const int k_SubSamples = 16;
+  const double pixelSize = frame.extent / std::max(imageDim, 1);
+  double eta = 0.0;
+  double chi = 0.0;
+  auto isInside = [&](double x, double y) {
+    if(x * x + y * y > 1.0)
+    {
+      return false;
+    }
+    StereographicToSphere(x, y, eta, chi);
+    return ops.inUnitTriangle(eta, chi);
+  };
+
+  const int numCorners = imageDim + 1;
+  std::vector<uint8_t> corners(static_cast<size_t>(numCorners) * numCorners);
+  for(int row = 0; row < numCorners; row++)
+  {
+    for(int col = 0; col < numCorners; col++)
+    {
+      corners[static_cast<size_t>(row) * numCorners + col] = isInside(frame.minX + col * pixelSize, frame.minY + row * pixelSize) ? 1 : 0;
+    }
+  }
+
+  IPFDensityMask mask;
+  mask.rowSpans.assign(static_cast<size_t>(std::max(imageDim, 0)), {0, 0});
+  mask.coverage.assign(static_cast<size_t>(std::max(imageDim, 0)) * std::max(imageDim, 0), 0.0);
+  for(int row = 0; row < imageDim; row++)
+  {
+    int first = imageDim;
+    int last = 0;
+    for(int col = 0; col < imageDim; col++)
+    {
+      size_t corner = static_cast<size_t>(row) * numCorners + col;
+      int numInside = corners[corner] + corners[corner + 1] + corners[corner + numCorners] + corners[corner + numCorners + 1];
+      double coverage = numInside / 4.0;
+      if(numInside != 0 && numInside != 4)
+      {
+        int subInside = 0;
+        for(int j = 0; j < k_SubSamples; j++)
+        {
+          for(int i = 0; i < k_SubSamples; i++)
+          {
+            subInside += isInside(frame.minX + (col + (i + 0.5) / k_SubSamples) * pixelSize, frame.minY + (row + (j + 0.5) / k_SubSamples) * pixelSize) ? 1 : 0;
+          }
+        }
+        coverage = static_cast<double>(subInside) / (k_SubSamples * k_SubSamples);
+      }
+      if(coverage > 0.0)
+      {
+        first = std::min(first, col);
+        last = col + 1;
+        mask.coverage[static_cast<size_t>(row) * imageDim + col] = coverage;
+      }
+    }
+    if(first < last)
+    {
+      mask.rowSpans[row] = {first, last};
+    }
+  }
+  return mask;
+}
+
+/**
+ * @brief Minimum number of orientations in a block of the inverse pole figure binning and the maximum number of
+ * blocks. The block count only depends on the number of orientations so the summation order is the same on every
+ * machine.
+ */
+const size_t k_MinIPFOrientationsPerBlock = 16384;
+const size_t k_MaxIPFBinningBlocks = 32;
+
+/**
+ * @brief The IPFDensityBinningImpl class reduces the sample direction into the unit triangle for blocks of
+ * orientations and bins the weight of each orientation into one histogram per block. Points that land in a pixel
+ * that does not overlap the triangle (rounding on the edges) are moved to the closest pixel of their row that does.
+ */
+template <typename OpsType>
+class IPFDensityBinningImpl
+{
+public:
+  IPFDensityBinningImpl(const OpsType* ops, const EbsdArrayView<const float>& eulers, const EbsdArrayView<const float>& weights, const double refDir[3], bool convertDegrees,
+                        const IPFDensityFrame& frame, int imageDim, const std::vector<std::pair<int, int>>& rowSpans, std::vector<std::vector<double>>& histograms, std::vector<double>& blockWeights)
+  : m_Ops(ops)
+  , m_Eulers(eulers)
+  , m_Weights(weights)
+  , m_RefDir(refDir)
+  , m_ConvertDegrees(convertDegrees)
+  , m_Frame(frame)
+  , m_ImageDim(imageDim)
+  , m_RowSpans(rowSpans)
+  , m_Histograms(histograms)
+  , m_BlockWeights(blockWeights)
+  {
+  }
+  virtual ~IPFDensityBinningImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t numOrientations = m_Eulers.getNumberOfTuples();
+    const size_t numBlocks = m_Histograms.size();
+    const int numSymOps = m_Ops->getNumSymOps();
+    const bool hasInversion = m_Ops->getHasInversion();
+    const double scale = m_ConvertDegrees ? EbsdLib::Constants::k_DegToRadD : 1.0;
+    const double pixelsPerUnit = m_ImageDim / m_Frame.extent;
+    double g[3][3];
+    double p[3];
+    double refDirection[3];
+    for(size_t block = start; block < end; block++)
+    {
+      std::vector<double>& histogram = m_Histograms[block];
+      double blockWeight = 0.0;
+      const size_t first = block * numOrientations / numBlocks;
+      const size_t last = (block + 1) * numOrientations / numBlocks;
+      for(size_t i = first; i < last; i++)
+      {
+        double weight = m_Weights.empty() ? 1.0 : static_cast<double>(m_Weights(i, 0));
+        OrientationD eu(m_Eulers(i, 0) * scale, m_Eulers(i, 1) * scale, m_Eulers(i, 2) * scale);
+        QuatD q1 = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+        bool reduced = false;
+        for(int j = 0; j < numSymOps; j++)
+        {
+          QuatD qu = m_Ops->getQuatSymOp(j) * q1;
+          OrientationTransformation::qu2om<QuatD, OrientationD>(qu).toGMatrix(g);
+          refDirection[0] = m_RefDir[0];
+          refDirection[1] = m_RefDir[1];
+          refDirection[2] = m_RefDir[2];
+          EbsdMatrixMath::Multiply3x3with3x1(g, refDirection, p);
+          EbsdMatrixMath::Normalize3x1(p);
+          if(p[2] < 0.0)
+          {
+            if(!hasInversion)
+            {
+              continue;
+            }
+            p[0] = -p[0], p[1] = -p[1], p[2] = -p[2];
+          }
+          if(m_Ops->inUnitTriangle(std::atan2(p[1], p[0]), std::acos(std::min(p[2], 1.0))))
+          {
+            reduced = true;
+            break;
+          }
+        }
+        if(!reduced)
+        {
+          continue;
+        }
+
+        double x = p[0] / (1.0 + p[2]);
+        double y = p[1] / (1.0 + p[2]);
+        int row = std::min(std::max(static_cast<int>((y - m_Frame.minY) * pixelsPerUnit), 0), m_ImageDim - 1);
+        const std::pair<int, int>& span = m_RowSpans[row];
+        if(span.first >= span.second)
+        {
+          continue;
+        }
+        int col = std::min(std::max(static_cast<int>((x - m_Frame.minX) * pixelsPerUnit), span.first), span.second - 1);
+        histogram[static_cast<size_t>(row) * m_ImageDim + col] += weight;
+        blockWeight += weight;
+      }
+      m_BlockWeights[block] = blockWeight;
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const OpsType* m_Ops;
+  EbsdArrayView<const float> m_Eulers;
+  EbsdArrayView<const float> m_Weights;
+  const double* m_RefDir;
+  bool m_ConvertDegrees;
+  IPFDensityFrame m_Frame;
+  int m_ImageDim;
+  const std::vector<std::pair<int, int>>& m_RowSpans;
+  std::vector<std::vector<double>>& m_Histograms;
+  std::vector<double>& m_BlockWeights;
+};
+
+/**
+ * @brief Calls functor with ops cast to its concrete Laue class so that the templated batch kernels make direct calls
+ * instead of a virtual call per point. Unknown subclasses run the kernel through the LaueOps interface.
+ */
+template <typename Functor>
+void RunWithConcreteOps(const LaueOps& ops, Functor&& functor)
+{
+  if(!EbsdLib::DispatchLaueOps(ops, functor))
+  {
+    functor(ops);
+  }
+}
+
+/**
+ * @brief Makes sure an optional output array can hold one tuple per point and returns its raw pointer
+ */
+template <typename T>
+inline T* PrepareSchmidFactorOutput(EbsdDataArray<T>* output, size_t numPoints)
+{
+  if(nullptr == output)
+  {
+    return nullptr;
+  }
+  if(output->getNumberOfTuples() < numPoints)
+  {
+    output->resizeTuples(numPoints);
+  }
+  return output->getPointer(0);
+}
+
+/**
+ * @brief Normalizes the sample loading direction. A zero length direction is returned unchanged.
+ */
+inline void NormalizeLoadingDirection(const double load[3], double normalized[3])
+{
+  normalized[0] = load[0];
+  normalized[1] = load[1];
+  normalized[2] = load[2];
+  double mag = std::sqrt(load[0] * load[0] + load[1] * load[1] + load[2] * load[2]);
+  if(mag > 0.0)
+  {
+    normalized[0] /= mag;
+    normalized[1] /= mag;
+    normalized[2] /= mag;
+  }
+}
+
+/**
+ * @brief The GeneratePyramidIntensitiesImpl class projects the sphere coordinates of one pole figure family into
+ * the intensity image of every level of a pole figure pyramid. The Lambert squares are only built and normalized
+ * once and every image size is interpolated from them.
+ */
+class GeneratePyramidIntensitiesImpl
+{
+public:
+  GeneratePyramidIntensitiesImpl(EbsdLib::FloatArrayType* xyzCoords, const PoleFigureConfiguration_t* config, std::vector<EbsdLib::DoubleArrayType*> intensities, const std::vector<int>& imageDims)
+  : m_XYZCoords(xyzCoords)
+  , m_Config(config)
+  , m_Intensities(std::move(intensities))
+  , m_ImageDims(imageDims)
+  {
+  }
+
+  void operator()() const
+  {
+    if(m_Config->discrete)
+    {
+      // The discrete projection bins the coordinates directly so there is nothing to share between the levels
+      for(size_t level = 0; level < m_ImageDims.size(); level++)
+      {
+        PoleFigureConfiguration_t levelConfig = *m_Config;
+        levelConfig.imageDim = m_ImageDims[level];
+        ComputeStereographicProjection projection(m_XYZCoords, &levelConfig, m_Intensities[level]);
+        projection();
+      }
+      return;
+    }
+
+    ModifiedLambertProjection::Pointer lambert = ComputeStereographicProjection::CreateLambertSquares(m_XYZCoords, *m_Config);
+    for(size_t level = 0; level < m_ImageDims.size(); level++)
+    {
+      m_Intensities[level]->resizeTuples(static_cast<size_t>(m_ImageDims[level] * m_ImageDims[level]));
+      m_Intensities[level]->initializeWithZeros();
+      lambert->createStereographicProjection(m_ImageDims[level], *m_Intensities[level]);
+    }
+  }
+
+private:
+  EbsdLib::FloatArrayType* m_XYZCoords = nullptr;
+  const PoleFigureConfiguration_t* m_Config = nullptr;
+  std::vector<EbsdLib::DoubleArrayType*> m_Intensities;
+  const std::vector<int>& m_ImageDims;
+};
 } // namespace Detail
 
 // -----------------------------------------------------------------------------
@@ -320,31 +1640,480 @@ int LaueOps::_calcODFBin(double dim[3], double bins[3], double step[3], const Or
 }
 
 // -----------------------------------------------------------------------------
-//
+void LaueOps::getSlipTransmissionMetrics(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* boundaryPairs, const double LD[3], bool maxSF, EbsdLib::DoubleArrayType* mPrime,
+                                         EbsdLib::DoubleArrayType* F1, EbsdLib::DoubleArrayType* F1spt, EbsdLib::DoubleArrayType* F7) const
+{
+  size_t numGrains = quats->getNumberOfTuples();
+  size_t numBoundaries = boundaryPairs->getNumberOfTuples();
+  double* mPrimePtr = Detail::PrepareSlipTransmissionOutput(mPrime, numBoundaries);
+  double* F1Ptr = Detail::PrepareSlipTransmissionOutput(F1, numBoundaries);
+  double* F1sptPtr = Detail::PrepareSlipTransmissionOutput(F1spt, numBoundaries);
+  double* F7Ptr = Detail::PrepareSlipTransmissionOutput(F7, numBoundaries);
+  if(numBoundaries == 0)
+  {
+    return;
+  }
+
+  Detail::RunWithConcreteOps(*this, [&](const auto& ops) {
+    using OpsType = std::decay_t<decltype(ops)>;
+    Detail::SlipTransmissionPairsImpl<OpsType> impl(&ops, quats->getPointer(0), numGrains, boundaryPairs->getPointer(0), LD, maxSF, mPrimePtr, F1Ptr, F1sptPtr, F7Ptr);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBoundaries), impl, tbb::auto_partitioner());
+#else
+    impl.generate(0, numBoundaries);
+#endif
+  });
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::_calcSlipTransmissionMetrics(const double slipPlanes[][3], const double slipDirections[][3], size_t numSlipSystems, EbsdLib::FloatArrayType* quats,
+                                           EbsdLib::Int32ArrayType* boundaryPairs, const double LD[3], bool maxSF, EbsdLib::DoubleArrayType* mPrime, EbsdLib::DoubleArrayType* F1,
+                                           EbsdLib::DoubleArrayType* F1spt, EbsdLib::DoubleArrayType* F7) const
+{
+  size_t numGrains = quats->getNumberOfTuples();
+  size_t numBoundaries = boundaryPairs->getNumberOfTuples();
+  double* mPrimePtr = Detail::PrepareSlipTransmissionOutput(mPrime, numBoundaries);
+  double* F1Ptr = Detail::PrepareSlipTransmissionOutput(F1, numBoundaries);
+  double* F1sptPtr = Detail::PrepareSlipTransmissionOutput(F1spt, numBoundaries);
+  double* F7Ptr = Detail::PrepareSlipTransmissionOutput(F7, numBoundaries);
+  if(numBoundaries == 0 || numGrains == 0)
+  {
+    for(double* ptr : {mPrimePtr, F1Ptr, F1sptPtr, F7Ptr})
+    {
+      if(nullptr != ptr)
+      {
+        std::fill(ptr, ptr + numBoundaries, 0.0);
+      }
+    }
+    return;
+  }
+
+  // Rotate the slip systems of every grain once
+  std::vector<double> cache(numGrains * numSlipSystems * Detail::k_SlipSystemCacheStride);
+  std::vector<int32_t> maxSchmidIndex(numGrains, -1);
+  Detail::SlipSystemCacheImpl cacheImpl(slipPlanes, slipDirections, numSlipSystems, quats->getPointer(0), LD, cache.data(), maxSchmidIndex.data());
+  Detail::SlipTransmissionMetricsImpl metricsImpl(numSlipSystems, numGrains, cache.data(), maxSchmidIndex.data(), boundaryPairs->getPointer(0), maxSF, mPrimePtr, F1Ptr, F1sptPtr, F7Ptr);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numGrains), cacheImpl, tbb::auto_partitioner());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBoundaries), metricsImpl, tbb::auto_partitioner());
+#else
+  cacheImpl.generate(0, numGrains);
+  metricsImpl.generate(0, numBoundaries);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* c1, EbsdLib::FloatArrayType* c2, EbsdLib::FloatArrayType* c3) const
+{
+  generateSphereCoordsFromEulers(EbsdArrayView<const float>::FromArray(*eulers), c1, c2, c3);
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::generateSchmidFactorMap(EbsdLib::FloatArrayType* quats, const double load[3], EbsdLib::FloatArrayType* schmidFactors, EbsdLib::Int32ArrayType* slipSystems,
+                                      EbsdLib::FloatArrayType* angleComps) const
+{
+  size_t numPoints = quats->getNumberOfTuples();
+  float* schmidPtr = Detail::PrepareSchmidFactorOutput(schmidFactors, numPoints);
+  int32_t* slipSystemPtr = Detail::PrepareSchmidFactorOutput(slipSystems, numPoints);
+  float* angleCompsPtr = Detail::PrepareSchmidFactorOutput(angleComps, numPoints);
+  if(numPoints == 0)
+  {
+    return;
+  }
+
+  double sampleLoad[3];
+  Detail::NormalizeLoadingDirection(load, sampleLoad);
+  Detail::RunWithConcreteOps(*this, [&](const auto& ops) {
+    using OpsType = std::decay_t<decltype(ops)>;
+    Detail::SchmidFactorPointsImpl<OpsType> impl(&ops, quats->getPointer(0), sampleLoad, schmidPtr, slipSystemPtr, angleCompsPtr);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), impl, tbb::auto_partitioner());
+#else
+    impl.generate(0, numPoints);
+#endif
+  });
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::calculateMisorientations(EbsdLib::FloatArrayType* quats1, EbsdLib::FloatArrayType* quats2, EbsdLib::FloatArrayType* axisAngles, EbsdLib::ComputePrecision precision) const
+{
+  size_t numPairs = std::min(quats1->getNumberOfTuples(), quats2->getNumberOfTuples());
+  if(axisAngles->getNumberOfTuples() < numPairs)
+  {
+    axisAngles->resizeTuples(numPairs);
+  }
+  if(numPairs == 0)
+  {
+    return;
+  }
+
+  if(precision == EbsdLib::ComputePrecision::Single)
+  {
+    // Transpose the symmetry operators into structure-of-arrays layout
+    const auto numSym = static_cast<size_t>(getNumSymOps());
+    std::vector<float> symTable(numSym * 4);
+    for(size_t s = 0; s < numSym; s++)
+    {
+      QuatD sym = getQuatSymOp(static_cast<int>(s));
+      symTable[s] = static_cast<float>(sym.x());
+      symTable[numSym + s] = static_cast<float>(sym.y());
+      symTable[2 * numSym + s] = static_cast<float>(sym.z());
+      symTable[3 * numSym + s] = static_cast<float>(sym.w());
+    }
+    Detail::MisorientationPairsSingleImpl impl(symTable.data(), numSym, quats1->getPointer(0), quats2->getPointer(0), axisAngles->getPointer(0));
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPairs), impl, tbb::auto_partitioner());
+#else
+    impl.generate(0, numPairs);
+#endif
+    return;
+  }
+
+  Detail::RunWithConcreteOps(*this, [&](const auto& ops) {
+    using OpsType = std::decay_t<decltype(ops)>;
+    Detail::MisorientationPairsImpl<OpsType> impl(&ops, quats1->getPointer(0), quats2->getPointer(0), axisAngles->getPointer(0));
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPairs), impl, tbb::auto_partitioner());
+#else
+    impl.generate(0, numPairs);
+#endif
+  });
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::getFZQuats(EbsdLib::FloatArrayType* quats, EbsdLib::FloatArrayType* fzQuats) const
+{
+  const size_t numPoints = quats->getNumberOfTuples();
+  if(fzQuats->getNumberOfTuples() < numPoints)
+  {
+    fzQuats->resizeTuples(numPoints);
+  }
+  if(numPoints == 0)
+  {
+    return;
+  }
+
+  std::vector<double> symTable = EbsdLib::Detail::CreateQuatSymTable(*this);
+  Detail::NearestQuatsImpl impl(symTable.data(), symTable.size() / 4, nullptr, 0, nullptr, quats->getPointer(0), fzQuats->getPointer(0));
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, numPoints);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::getNearestQuats(EbsdLib::FloatArrayType* refQuats, EbsdLib::FloatArrayType* quats, EbsdLib::FloatArrayType* nearestQuats, EbsdLib::Int32ArrayType* groupIds) const
+{
+  size_t numPoints = quats->getNumberOfTuples();
+  if(groupIds != nullptr)
+  {
+    numPoints = std::min(numPoints, groupIds->getNumberOfTuples());
+  }
+  else
+  {
+    numPoints = std::min(numPoints, refQuats->getNumberOfTuples());
+  }
+  if(nearestQuats->getNumberOfTuples() < numPoints)
+  {
+    nearestQuats->resizeTuples(numPoints);
+  }
+  if(numPoints == 0)
+  {
+    return;
+  }
+
+  std::vector<double> symTable = EbsdLib::Detail::CreateQuatSymTable(*this);
+  const float* refs = refQuats->getNumberOfTuples() > 0 ? refQuats->getPointer(0) : nullptr;
+  if(refs == nullptr && groupIds != nullptr)
+  {
+    // No group has a reference so every element is copied unchanged
+    std::copy(quats->getPointer(0), quats->getPointer(0) + numPoints * 4, nearestQuats->getPointer(0));
+    return;
+  }
+  Detail::NearestQuatsImpl impl(symTable.data(), symTable.size() / 4, refs, refQuats->getNumberOfTuples(), groupIds != nullptr ? groupIds->getPointer(0) : nullptr, quats->getPointer(0),
+                                nearestQuats->getPointer(0));
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, numPoints);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::averageQuatsByGroup(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* groupIds, size_t numGroups, EbsdLib::FloatArrayType* avgQuats) const
+{
+  if(avgQuats->getNumberOfTuples() < numGroups)
+  {
+    avgQuats->resizeTuples(numGroups);
+  }
+  if(numGroups == 0)
+  {
+    return;
+  }
+
+  const size_t numPoints = std::min(quats->getNumberOfTuples(), groupIds->getNumberOfTuples());
+  PhasePartition::Pointer groups = PhasePartition::New(numPoints > 0 ? groupIds->getPointer(0) : nullptr, numPoints, numGroups);
+  const float* quatPtr = numPoints > 0 ? quats->getPointer(0) : nullptr;
+
+  // The first member of each group is the reference of the first pass
+  std::vector<double> refQuats(numGroups * 4, 0.0);
+  for(size_t group = 0; group < numGroups; group++)
+  {
+    if(groups->getPhaseSize(group) == 0)
+    {
+      refQuats[group * 4 + 3] = 1.0;
+      continue;
+    }
+    size_t first = groups->getPhaseIndices(group)[0];
+    for(size_t c = 0; c < 4; c++)
+    {
+      refQuats[group * 4 + c] = quatPtr[first * 4 + c];
+    }
+  }
+
+  std::vector<double> symTable = EbsdLib::Detail::CreateQuatSymTable(*this);
+  std::vector<double> averages(numGroups * 4);
+  for(size_t pass = 0; pass < 2; pass++)
+  {
+    Detail::GroupAverageQuatsImpl impl(symTable.data(), symTable.size() / 4, *groups, quatPtr, refQuats.data(), averages.data());
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numGroups), impl, tbb::auto_partitioner());
+#else
+    impl.generate(0, numGroups);
+#endif
+    refQuats.swap(averages);
+  }
+
+  // Reduce the averages to the fundamental zone while they are still in double precision
+  float* avgPtr = avgQuats->getPointer(0);
+  double fzQuat[4];
+  for(size_t group = 0; group < numGroups; group++)
+  {
+    EbsdLib::Detail::NearestSymmetricQuat(symTable.data(), symTable.size() / 4, nullptr, refQuats.data() + group * 4, fzQuat);
+    for(size_t c = 0; c < 4; c++)
+    {
+      avgPtr[group * 4 + c] = static_cast<float>(fzQuat[c]);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+void LaueOps::generateIPFColors(const EbsdArrayView<const float>& eulers, const double refDir[3], bool convertDegrees, EbsdLib::UInt8ArrayType* rgb, EbsdLib::ComputePrecision precision) const
+{
+  size_t numPoints = eulers.getNumberOfTuples();
+  if(rgb->getNumberOfTuples() < numPoints)
+  {
+    rgb->resizeTuples(numPoints);
+  }
+  if(numPoints == 0)
+  {
+    return;
+  }
+
+  if(precision == EbsdLib::ComputePrecision::Single)
+  {
+    std::vector<QuatF> quatSym(static_cast<size_t>(getNumSymOps()));
+    for(size_t i = 0; i < quatSym.size(); i++)
+    {
+      quatSym[i] = getQuatSymOp(static_cast<int>(i)).to<float>();
+    }
+    const float refDirF[3] = {static_cast<float>(refDir[0]), static_cast<float>(refDir[1]), static_cast<float>(refDir[2])};
+    Detail::RunWithConcreteOps(*this, [&](const auto& ops) {
+      using OpsType = std::decay_t<decltype(ops)>;
+      Detail::IPFColorsSingleImpl<OpsType> impl(&ops, quatSym, eulers, refDirF, convertDegrees, rgb->getPointer(0));
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), impl, tbb::auto_partitioner());
+#else
+      impl.generate(0, numPoints);
+#endif
+    });
+    return;
+  }
+
+  Detail::RunWithConcreteOps(*this, [&](const auto& ops) {
+    using OpsType = std::decay_t<decltype(ops)>;
+    Detail::IPFColorsImpl<OpsType> impl(&ops, eulers, refDir, convertDegrees, rgb->getPointer(0));
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), impl, tbb::auto_partitioner());
+#else
+    impl.generate(0, numPoints);
+#endif
+  });
+}
+
 // -----------------------------------------------------------------------------
-std::vector<LaueOps::Pointer> LaueOps::GetAllOrientationOps()
+EbsdLib::DoubleArrayType::Pointer LaueOps::computeIPFDensity(const PoleFigureConfiguration_t& config, const double refDir[3], bool convertDegrees) const
 {
-  std::vector<LaueOps::Pointer> m_OrientationOps;
-  m_OrientationOps.push_back(HexagonalOps::New());
+  const int imageDim = std::max(config.imageDim, 0);
+  const size_t numPixels = static_cast<size_t>(imageDim) * imageDim;
+  EbsdLib::DoubleArrayType::Pointer density = EbsdLib::DoubleArrayType::CreateArray(numPixels, {1}, "IPF_Density", true);
+  density->initializeWithZeros();
+  if(imageDim == 0)
+  {
+    return density;
+  }
+
+  // The pixels that overlap the unit triangle and the area of each one that is inside of it on the sphere
+  const Detail::IPFDensityFrame frame = Detail::GetIPFDensityFrame(*this);
+  const double pixelSize = frame.extent / imageDim;
+  const Detail::IPFDensityMask mask = Detail::GetIPFDensityMask(*this, frame, imageDim);
+  const std::vector<std::pair<int, int>>& rowSpans = mask.rowSpans;
+  std::vector<double> areas(numPixels, 0.0);
+  double totalArea = 0.0;
+  double weightedR2 = 0.0;
+  for(int row = 0; row < imageDim; row++)
+  {
+    double y = frame.minY + (row + 0.5) * pixelSize;
+    for(int col = rowSpans[row].first; col < rowSpans[row].second; col++)
+    {
+      size_t index = static_cast<size_t>(row) * imageDim + col;
+      double x = frame.minX + (col + 0.5) * pixelSize;
+      double r2 = x * x + y * y;
+      double area = mask.coverage[index] * pixelSize * pixelSize * 4.0 / ((1.0 + r2) * (1.0 + r2));
+      areas[index] = area;
+      totalArea += area;
+      weightedR2 += area * r2;
+    }
+  }
+
+  const EbsdArrayView<const float> eulers = config.getEulers();
+  const size_t numOrientations = eulers.getNumberOfTuples();
+  if(numOrientations == 0 || totalArea <= 0.0 || (!config.weights.empty() && config.weights.getNumberOfTuples() < numOrientations))
+  {
+    return density;
+  }
+
+  const size_t numBlocks = std::min(Detail::k_MaxIPFBinningBlocks, (numOrientations + Detail::k_MinIPFOrientationsPerBlock - 1) / Detail::k_MinIPFOrientationsPerBlock);
+  std::vector<std::vector<double>> histograms(numBlocks, std::vector<double>(numPixels, 0.0));
+  std::vector<double> blockWeights(numBlocks, 0.0);
+  Detail::RunWithConcreteOps(*this, [&](const auto& ops) {
+    using OpsType = std::decay_t<decltype(ops)>;
+    Detail::IPFDensityBinningImpl<OpsType> impl(&ops, eulers, config.weights, refDir, convertDegrees, frame, imageDim, rowSpans, histograms, blockWeights);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1), impl, tbb::simple_partitioner());
+#else
+    impl.generate(0, numBlocks);
+#endif
+  });
+
+  // Sum the blocks in order so the result does not depend on the number of threads
+  std::vector<double>& counts = histograms[0];
+  double totalWeight = blockWeights[0];
+  for(size_t block = 1; block < numBlocks; block++)
+  {
+    for(size_t i = 0; i < numPixels; i++)
+    {
+      counts[i] += histograms[block][i];
+    }
+    totalWeight += blockWeights[block];
+  }
+  if(totalWeight <= 0.0)
+  {
+    return density;
+  }
+
+  // The counts and the areas are smoothed with the same kernel so that the density stays normalized at the edges
+  // of the triangle. The width of the kernel in pixels is taken at the area weighted center of the triangle.
+  std::vector<double> smoothedAreas = areas;
+  if(config.kernelHalfWidth > 0.0f)
+  {
+    double centerR2 = weightedR2 / totalArea;
+    const std::vector<double> kernel = GaussianSmoothing::CreateKernel(static_cast<double>(config.kernelHalfWidth) * (1.0 + centerR2) / 2.0 / pixelSize, imageDim - 1);
+    std::vector<double> scratch(numPixels);
+    for(std::vector<double>* values : {&counts, &smoothedAreas})
+    {
+      GaussianSmoothing::Smooth(values->data(), scratch.data(), imageDim, kernel, GaussianSmoothing::EdgePolicy::Zero);
+    }
+  }
+
+  double* densityPtr = density->getPointer(0);
+  for(size_t i = 0; i < numPixels; i++)
+  {
+    if(areas[i] > 0.0 && smoothedAreas[i] > 0.0)
+    {
+      densityPtr[i] = (counts[i] / totalWeight) / (smoothedAreas[i] / totalArea);
+    }
+  }
+  return density;
+}
 
-  m_OrientationOps.push_back(CubicOps::New());
+// -----------------------------------------------------------------------------
+EbsdLib::UInt8ArrayType::Pointer LaueOps::generateIPFDensityImage(PoleFigureConfiguration_t& config, const double refDir[3], bool convertDegrees) const
+{
+  const int imageDim = std::max(config.imageDim, 0);
+  EbsdLib::DoubleArrayType::Pointer density = computeIPFDensity(config, refDir, convertDegrees);
+  PoleFigureUtilities::FindIntensityRange({density.get()}, config);
 
-  m_OrientationOps.push_back(HexagonalLowOps::New()); // Hex Low
-  m_OrientationOps.push_back(CubicLowOps::New());     // Cubic Low
-  m_OrientationOps.push_back(TriclinicOps::New());    // Triclinic
-  m_OrientationOps.push_back(MonoclinicOps::New());   // Monoclinic
+  // The same pixels that computeIPFDensity() treats as inside of the unit triangle are colored
+  const Detail::IPFDensityMask mask = Detail::GetIPFDensityMask(*this, Detail::GetIPFDensityFrame(*this), imageDim);
+  EbsdLib::UInt8ArrayType::Pointer image = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(imageDim) * imageDim, {4}, getSymmetryName() + " IPF Density");
+  PoleFigureUtilities::CreateColorImage(density.get(), config, mask.rowSpans, image.get());
+  return image;
+}
 
-  m_OrientationOps.push_back(OrthoRhombicOps::New()); // OrthoRhombic
+// -----------------------------------------------------------------------------
+void LaueOps::_calcSchmidFactorMap(const double slipPlanes[][3], const double slipDirections[][3], size_t numSlipSystems, double planeNorm, double directionNorm, EbsdLib::FloatArrayType* quats,
+                                   const double load[3], EbsdLib::FloatArrayType* schmidFactors, EbsdLib::Int32ArrayType* slipSystems, EbsdLib::FloatArrayType* angleComps) const
+{
+  if(numSlipSystems == 0 || numSlipSystems > Detail::k_MaxSchmidSlipSystems)
+  {
+    LaueOps::generateSchmidFactorMap(quats, load, schmidFactors, slipSystems, angleComps);
+    return;
+  }
 
-  m_OrientationOps.push_back(TetragonalLowOps::New()); // Tetragonal-low
-  m_OrientationOps.push_back(TetragonalOps::New());    // Tetragonal-high
+  size_t numPoints = quats->getNumberOfTuples();
+  float* schmidPtr = Detail::PrepareSchmidFactorOutput(schmidFactors, numPoints);
+  int32_t* slipSystemPtr = Detail::PrepareSchmidFactorOutput(slipSystems, numPoints);
+  float* angleCompsPtr = Detail::PrepareSchmidFactorOutput(angleComps, numPoints);
+  if(numPoints == 0)
+  {
+    return;
+  }
 
-  m_OrientationOps.push_back(TrigonalLowOps::New()); // Trigonal-low
-  m_OrientationOps.push_back(TrigonalOps::New());    // Trigonal-High
+  // Transpose the slip system table into structure-of-arrays layout
+  std::vector<double> table(numSlipSystems * 6);
+  for(size_t s = 0; s < numSlipSystems; s++)
+  {
+    for(size_t c = 0; c < 3; c++)
+    {
+      table[c * numSlipSystems + s] = slipPlanes[s][c];
+      table[(c + 3) * numSlipSystems + s] = slipDirections[s][c];
+    }
+  }
 
-  m_OrientationOps.push_back(OrthoRhombicOps::New()); // Axis OrthorhombicOps
+  double sampleLoad[3];
+  Detail::NormalizeLoadingDirection(load, sampleLoad);
+  Detail::SchmidFactorMapImpl impl(table.data(), numSlipSystems, planeNorm, directionNorm, quats->getPointer(0), sampleLoad, schmidPtr, slipSystemPtr, angleCompsPtr);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numPoints), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, numPoints);
+#endif
+}
 
-  return m_OrientationOps;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<LaueOps::Pointer>& LaueOps::GetAllOrientationOps()
+{
+  // The Laue classes hold no state so a single set of instances is shared by the whole process. Function local static
+  // initialization is thread safe.
+  static const std::vector<LaueOps::Pointer> k_OrientationOps = {
+      HexagonalOps::New(),     // Hexagonal-High
+      CubicOps::New(),         // Cubic-High
+      HexagonalLowOps::New(),  // Hex Low
+      CubicLowOps::New(),      // Cubic Low
+      TriclinicOps::New(),     // Triclinic
+      MonoclinicOps::New(),    // Monoclinic
+      OrthoRhombicOps::New(),  // OrthoRhombic
+      TetragonalLowOps::New(), // Tetragonal-low
+      TetragonalOps::New(),    // Tetragonal-high
+      TrigonalLowOps::New(),   // Trigonal-low
+      TrigonalOps::New(),      // Trigonal-High
+      OrthoRhombicOps::New(),  // Axis OrthorhombicOps
+  };
+  return k_OrientationOps;
 }
 
 // -----------------------------------------------------------------------------
@@ -364,30 +2133,31 @@ LaueOps::Pointer LaueOps::GetOrientationOpsFromSpaceGroupNumber(size_t sgNumber)
   }
 
   size_t value = pgLaue.at(pgNumber);
+  const std::vector<LaueOps::Pointer>& ops = GetAllOrientationOps();
   switch(value)
   {
   case 1:
-    return TriclinicOps::New();
+    return ops[EbsdLib::CrystalStructure::Triclinic];
   case 2:
-    return MonoclinicOps::New();
+    return ops[EbsdLib::CrystalStructure::Monoclinic];
   case 22:
-    return OrthoRhombicOps::New();
+    return ops[EbsdLib::CrystalStructure::OrthoRhombic];
   case 4:
-    return TetragonalLowOps::New();
+    return ops[EbsdLib::CrystalStructure::Tetragonal_Low];
   case 42:
-    return TetragonalOps::New();
+    return ops[EbsdLib::CrystalStructure::Tetragonal_High];
   case 3:
-    return TrigonalLowOps::New();
+    return ops[EbsdLib::CrystalStructure::Trigonal_Low];
   case 32:
-    return TrigonalOps::New();
+    return ops[EbsdLib::CrystalStructure::Trigonal_High];
   case 6:
-    return HexagonalLowOps::New();
+    return ops[EbsdLib::CrystalStructure::Hexagonal_Low];
   case 62:
-    return HexagonalOps::New();
+    return ops[EbsdLib::CrystalStructure::Hexagonal_High];
   case 23:
-    return CubicLowOps::New();
+    return ops[EbsdLib::CrystalStructure::Cubic_Low];
   case 43:
-    return CubicOps::New();
+    return ops[EbsdLib::CrystalStructure::Cubic_High];
   default:
     return LaueOps::NullPointer();
   }
@@ -396,18 +2166,88 @@ LaueOps::Pointer LaueOps::GetOrientationOpsFromSpaceGroupNumber(size_t sgNumber)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-std::vector<std::string> LaueOps::GetLaueNames()
+std::vector<PoleFigurePyramidLevel_t> LaueOps::generatePoleFigurePyramid(PoleFigureConfiguration_t& config, const std::vector<int>& imageDims) const
 {
-  std::vector<std::string> names;
+  std::array<std::string, 3> labels = getDefaultPoleFigureNames();
+  for(size_t i = 0; i < labels.size() && i < config.labels.size(); i++)
+  {
+    labels[i] = config.labels[i];
+  }
+
+  // The sphere coordinates do not depend on the image size so they are generated once for the whole pyramid. Each
+  // subclass sizes the arrays for its own pole figure families.
+  std::array<EbsdLib::FloatArrayType::Pointer, 3> xyzCoords;
+  for(size_t i = 0; i < xyzCoords.size(); i++)
+  {
+    xyzCoords[i] = EbsdLib::FloatArrayType::CreateUninitializedArray(0, {3}, labels[i] + std::string("xyzCoords"));
+  }
+  config.sphereRadius = 1.0f;
+  generateSphereCoordsFromEulers(config.getEulers(), xyzCoords[0].get(), xyzCoords[1].get(), xyzCoords[2].get());
+
+  std::vector<PoleFigurePyramidLevel_t> pyramid(imageDims.size());
+  std::array<std::vector<EbsdLib::DoubleArrayType*>, 3> familyIntensities;
+  for(size_t level = 0; level < imageDims.size(); level++)
+  {
+    pyramid[level].imageDim = imageDims[level];
+    for(size_t i = 0; i < labels.size(); i++)
+    {
+      EbsdLib::DoubleArrayType::Pointer intensity = EbsdLib::DoubleArrayType::CreateUninitializedArray(0, {1}, labels[i] + "_Intensity_Image");
+      pyramid[level].intensities.push_back(intensity);
+      familyIntensities[i].push_back(intensity.get());
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_group g;
+  for(size_t i = 0; i < xyzCoords.size(); i++)
+  {
+    g.run(Detail::GeneratePyramidIntensitiesImpl(xyzCoords[i].get(), &config, familyIntensities[i], imageDims));
+  }
+  g.wait(); // Wait for all the threads to complete before moving on.
+#else
+  for(size_t i = 0; i < xyzCoords.size(); i++)
+  {
+    Detail::GeneratePyramidIntensitiesImpl impl(xyzCoords[i].get(), &config, familyIntensities[i], imageDims);
+    impl();
+  }
+#endif
 
-  std::vector<LaueOps::Pointer> ops = GetAllOrientationOps();
-  names.reserve(ops.size());
-  for(const auto& op : ops)
+  for(auto& level : pyramid)
   {
-    names.push_back(op->getSymmetryName());
+    PoleFigureConfiguration_t levelConfig = config;
+    levelConfig.imageDim = level.imageDim;
+
+    // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
+    PoleFigureUtilities::FindIntensityRange({level.intensities[0].get(), level.intensities[1].get(), level.intensities[2].get()}, levelConfig);
+
+    level.images.resize(3);
+    for(size_t i = 0; i < labels.size(); i++)
+    {
+      EbsdLib::UInt8ArrayType::Pointer image = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(level.imageDim * level.imageDim), {4}, labels[i]);
+      PoleFigureUtilities::CreateColorImage(level.intensities[i].get(), levelConfig, image.get());
+      size_t slot = (config.order.size() == 3) ? static_cast<size_t>(config.order[i]) : i;
+      level.images[slot] = image;
+    }
   }
+  return pyramid;
+}
 
-  return names;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<std::string> LaueOps::GetLaueNames()
+{
+  static const std::vector<std::string> k_Names = [] {
+    std::vector<std::string> names;
+    const std::vector<LaueOps::Pointer>& ops = GetAllOrientationOps();
+    names.reserve(ops.size());
+    for(const auto& op : ops)
+    {
+      names.push_back(op->getSymmetryName());
+    }
+    return names;
+  }();
+  return k_Names;
 }
 
 // -----------------------------------------------------------------------------
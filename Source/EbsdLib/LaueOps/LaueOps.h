@@ -34,10 +34,12 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "EbsdLib/Core/EbsdArrayView.hpp"
 #include "EbsdLib/Core/EbsdDataArray.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
@@ -73,14 +75,16 @@ public:
   /**
    * @brief GetAllOrientationOps This method returns a vector of each type of LaueOps placed such that the
    * index into the vector is the value of the constant at EbsdLib::CrystalStructure::***
+   * The instances are created once and shared by the whole process, so this is cheap to call from worker threads.
+   * See LaueOpsDispatch.hpp for dispatching onto the concrete classes.
    * @return Vector of LaueOps subclasses.
    */
-  static std::vector<LaueOps::Pointer> GetAllOrientationOps();
+  static const std::vector<LaueOps::Pointer>& GetAllOrientationOps();
 
   /**
    * @brief GetOrientationOpsFromSpaceGroupNumber
    * @param sgNumber
-   * @return
+   * @return The shared instance from GetAllOrientationOps() for the Laue class of the space group
    */
   static Pointer GetOrientationOpsFromSpaceGroupNumber(size_t sgNumber);
 
@@ -148,6 +152,18 @@ public:
    */
   virtual OrientationF calculateMisorientation(const QuatF& q1, const QuatF& q2) const = 0;
 
+  /**
+   * @brief calculateMisorientations Calculates the misorientation between each pair of orientations in two arrays
+   * @param quats1 First orientation of each pair as 4 component (x, y, z, w) quaternions
+   * @param quats2 Second orientation of each pair as 4 component (x, y, z, w) quaternions
+   * @param axisAngles [output] 4 component <XYZ>W axis-angle misorientations, resized if too small
+   * @param precision Double gives the same results as calculateMisorientation(). Single keeps the computation in
+   * float, the angle stays within EbsdLib::SinglePrecisionBounds::k_MisorientationAngle and the axis is a
+   * symmetrically equivalent one.
+   */
+  void calculateMisorientations(EbsdLib::FloatArrayType* quats1, EbsdLib::FloatArrayType* quats2, EbsdLib::FloatArrayType* axisAngles,
+                                EbsdLib::ComputePrecision precision = EbsdLib::ComputePrecision::Double) const;
+
   /**
    * @brief getQuatSymOp Returns the symmetry operator at index i
    * @param i The index into the Symmetry operators array
@@ -189,6 +205,42 @@ public:
    */
   virtual QuatD getFZQuat(const QuatD& qr) const;
 
+  /**
+   * @brief getFZQuats Reduces every quaternion of an array to its symmetrically equivalent quaternion with the largest
+   * |w|, i.e. the one closest to the origin, with w made non-negative. This is the array version of getFZQuat() and
+   * is available for every Laue class since it only uses the symmetry operators returned by getQuatSymOp().
+   * @param quats Input quaternions as 4 component (x, y, z, w) tuples
+   * @param fzQuats [output] 4 component (x, y, z, w) quaternions, resized if too small. Can be the same array as quats.
+   */
+  void getFZQuats(EbsdLib::FloatArrayType* quats, EbsdLib::FloatArrayType* fzQuats) const;
+
+  /**
+   * @brief getNearestQuats Finds, for every quaternion of an array, the symmetrically equivalent quaternion that is
+   * nearest to a reference quaternion. This is the array version of getNearestQuat().
+   * @param refQuats Reference quaternions as 4 component (x, y, z, w) tuples. Without groupIds there is one reference
+   * per element of quats, otherwise there is one reference per group id.
+   * @param quats Input quaternions as 4 component (x, y, z, w) tuples
+   * @param nearestQuats [output] 4 component (x, y, z, w) quaternions, resized if too small. Can be the same array as
+   * quats.
+   * @param groupIds Optional group id of each element of quats. Elements whose id is outside of refQuats are copied
+   * unchanged.
+   */
+  void getNearestQuats(EbsdLib::FloatArrayType* refQuats, EbsdLib::FloatArrayType* quats, EbsdLib::FloatArrayType* nearestQuats, EbsdLib::Int32ArrayType* groupIds = nullptr) const;
+
+  /**
+   * @brief averageQuatsByGroup Computes the average orientation of every group (e.g. grain) of an orientation map.
+   * The members of a group are moved to the symmetrically equivalent quaternion nearest the first member of the group
+   * and summed; the members are then moved again to be nearest to that first average and summed a second time, which
+   * keeps the result stable when the first member is an outlier. The normalized average is reduced with getFZQuats().
+   * Members are summed in index order so the result does not depend on the number of threads.
+   * @param quats Per point quaternions as 4 component (x, y, z, w) tuples
+   * @param groupIds Group id of each point. Points with an id outside of [0, numGroups) are ignored.
+   * @param numGroups The number of groups
+   * @param avgQuats [output] 4 component (x, y, z, w) average quaternion of each group, resized if too small. Groups
+   * without any point are set to the identity.
+   */
+  void averageQuatsByGroup(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* groupIds, size_t numGroups, EbsdLib::FloatArrayType* avgQuats) const;
+
   /**
    * @brief getMisoBin Returns the misorientation bin that the input Rodregues vector lies in.
    * @param rod
@@ -212,6 +264,21 @@ public:
 
   virtual void getSchmidFactorAndSS(double load[3], double plane[3], double direction[3], double& schmidfactor, double angleComps[2], int& slipsys) const = 0;
 
+  /**
+   * @brief generateSchmidFactorMap Computes the Schmid factor, slip system and angle components for every orientation
+   * in an array. The sample loading direction is rotated into the crystal frame of each point and the results are
+   * identical to calling getSchmidFactorAndSS() for each point. The default implementation does exactly that. CubicOps
+   * overrides this with a kernel that evaluates its precomputed slip system table; the hexagonal classes keep the per
+   * point path because their slip systems are numbered from 1 and built from per vector normalized c/a scaled axes.
+   * @param quats Per point quaternions as 4 component (x, y, z, w) tuples
+   * @param load The loading direction in the sample frame
+   * @param schmidFactors [output] Schmid factor for each point. Can be nullptr if not needed.
+   * @param slipSystems [output] Slip system index for each point. Can be nullptr if not needed.
+   * @param angleComps [output] 2 component angle components for each point. Can be nullptr if not needed.
+   */
+  virtual void generateSchmidFactorMap(EbsdLib::FloatArrayType* quats, const double load[3], EbsdLib::FloatArrayType* schmidFactors, EbsdLib::Int32ArrayType* slipSystems,
+                                       EbsdLib::FloatArrayType* angleComps) const;
+
   virtual double getmPrime(const QuatD& q1, const QuatD& q2, double LD[3]) const = 0;
 
   virtual double getF1(const QuatD& q1, const QuatD& q2, double LD[3], bool maxSF) const = 0;
@@ -220,7 +287,38 @@ public:
 
   virtual double getF7(const QuatD& q1, const QuatD& q2, double LD[3], bool maxSF) const = 0;
 
-  virtual void generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* c1, EbsdLib::FloatArrayType* c2, EbsdLib::FloatArrayType* c3) const = 0;
+  /**
+   * @brief getSlipTransmissionMetrics Computes the mPrime, F1, F1spt and F7 slip transmission metrics for every
+   * boundary in a list of grain pairs. The default implementation calls the single pair methods for each boundary.
+   * Laue classes that define slip systems override this so that the rotated slip systems of each grain are computed
+   * once and shared by every boundary that the grain is part of.
+   * @param quats Per grain quaternions as 4 component (x, y, z, w) tuples
+   * @param boundaryPairs 2 component tuples holding the indices into quats of the grains on each side of a boundary.
+   * Boundaries with an index outside of the quats array (e.g. -1) will have all metrics set to 0.0
+   * @param LD The loading direction
+   * @param maxSF Use only the slip system with the maximum Schmid factor for F1, F1spt and F7
+   * @param mPrime [output] mPrime value for each boundary. Can be nullptr if not needed.
+   * @param F1 [output] F1 value for each boundary. Can be nullptr if not needed.
+   * @param F1spt [output] F1spt value for each boundary. Can be nullptr if not needed.
+   * @param F7 [output] F7 value for each boundary. Can be nullptr if not needed.
+   */
+  virtual void getSlipTransmissionMetrics(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* boundaryPairs, const double LD[3], bool maxSF, EbsdLib::DoubleArrayType* mPrime,
+                                          EbsdLib::DoubleArrayType* F1, EbsdLib::DoubleArrayType* F1spt, EbsdLib::DoubleArrayType* F7) const;
+
+  /**
+   * @brief Computes the coordinates on the unit sphere of the 3 families of directions used for the pole figures
+   * @param eulers View of the Euler angles (3 components per orientation). The view may be strided or planar so
+   * the angles do not need to be copied into an interleaved array first.
+   * @param c1 [output] Coordinates of the first family of directions, resized if too small
+   * @param c2 [output] Coordinates of the second family of directions, resized if too small
+   * @param c3 [output] Coordinates of the third family of directions, resized if too small
+   */
+  virtual void generateSphereCoordsFromEulers(const EbsdArrayView<const float>& eulers, EbsdLib::FloatArrayType* c1, EbsdLib::FloatArrayType* c2, EbsdLib::FloatArrayType* c3) const = 0;
+
+  /**
+   * @brief Convenience overload for Euler angles stored in an interleaved 3 component array
+   */
+  void generateSphereCoordsFromEulers(EbsdLib::FloatArrayType* eulers, EbsdLib::FloatArrayType* c1, EbsdLib::FloatArrayType* c2, EbsdLib::FloatArrayType* c3) const;
 
   /**
    * @brief generateIPFColor Generates an RGB Color from a Euler Angle and Reference Direction
@@ -244,6 +342,50 @@ public:
    */
   virtual EbsdLib::Rgb generateIPFColor(double e0, double e1, double e2, double dir0, double dir1, double dir2, bool convertDegrees) const = 0;
 
+  /**
+   * @brief computeIPFColor Computes the IPF color of a direction that has already been reduced into the unit triangle
+   * @param eta Azimuthal angle of the direction (radians)
+   * @param chi Polar angle of the direction (radians)
+   */
+  virtual EbsdLib::Rgb computeIPFColor(double eta, double chi) const = 0;
+
+  /**
+   * @brief generateIPFColors Generates the IPF color of every orientation in an array
+   * @param eulers View of the Euler angles (3 components per orientation)
+   * @param refDir The sample reference direction
+   * @param convertDegrees Are the input angles in Degrees
+   * @param rgb [output] 3 component RGB tuples, resized if too small
+   * @param precision Double gives the same colors as generateIPFColor(). Single does the symmetry reduction in float,
+   * see EbsdLib::SinglePrecisionBounds for the error bounds.
+   */
+  void generateIPFColors(const EbsdArrayView<const float>& eulers, const double refDir[3], bool convertDegrees, EbsdLib::UInt8ArrayType* rgb,
+                         EbsdLib::ComputePrecision precision = EbsdLib::ComputePrecision::Double) const;
+
+  /**
+   * @brief Computes the inverse pole figure density of a sample direction. The direction is reduced into the unit
+   * triangle for every orientation in parallel (the same reduction as generateIPFColor()) and binned into an image of
+   * the stereographic projection of the unit triangle. The image frame only depends on the Laue class so images of
+   * different data sets line up. Orientations whose direction no symmetry operator brings into the unit triangle are
+   * skipped.
+   * @param config The eulers (or eulerView), weights, imageDim and kernelHalfWidth members are used. With a kernel
+   * half-width the counts are smoothed with a Gaussian kernel before they are normalized.
+   * @param refDir The sample reference direction
+   * @param convertDegrees Are the input angles in Degrees
+   * @return The imageDim x imageDim density in multiples of random distribution (MRD). Pixels outside of the unit
+   * triangle are 0.
+   */
+  EbsdLib::DoubleArrayType::Pointer computeIPFDensity(const PoleFigureConfiguration_t& config, const double refDir[3], bool convertDegrees) const;
+
+  /**
+   * @brief Computes the inverse pole figure density with computeIPFDensity() and colors it with the pole figure color
+   * table. Pixels outside of the unit triangle are white.
+   * @param config See computeIPFDensity(). The minScale and maxScale members are updated.
+   * @param refDir The sample reference direction
+   * @param convertDegrees Are the input angles in Degrees
+   * @return The imageDim x imageDim RGBA image
+   */
+  EbsdLib::UInt8ArrayType::Pointer generateIPFDensityImage(PoleFigureConfiguration_t& config, const double refDir[3], bool convertDegrees) const;
+
   /**
    * @brief generateRodriguesColor Generates an RGB Color from a Rodrigues Vector
    * @param r1 First component of the Rodrigues Vector
@@ -272,6 +414,21 @@ public:
    */
   virtual std::vector<EbsdLib::UInt8ArrayType::Pointer> generatePoleFigure(PoleFigureConfiguration_t& config) const = 0;
 
+  /**
+   * @brief Returns the default labels of the 3 pole figures in the order they are generated
+   */
+  virtual std::array<std::string, 3> getDefaultPoleFigureNames() const = 0;
+
+  /**
+   * @brief Generates the same pole figures at several image sizes. The sphere coordinates and the Lambert squares are
+   * computed once and every image size is projected from them, so each level matches what generatePoleFigure()
+   * returns for that imageDim at a fraction of the cost.
+   * @param config The pole figure configuration. The imageDim member is ignored.
+   * @param imageDims The height/width of each level of the pyramid
+   * @return One level per entry of imageDims, in the same order
+   */
+  std::vector<PoleFigurePyramidLevel_t> generatePoleFigurePyramid(PoleFigureConfiguration_t& config, const std::vector<int>& imageDims) const;
+
 protected:
   LaueOps();
 
@@ -295,6 +452,30 @@ protected:
   void _calcDetermineHomochoricValues(double random[3], double init[3], double step[3], int32_t phi[3], double& r1, double& r2, double& r3) const;
   int _calcODFBin(double dim[3], double bins[3], double step[3], const OrientationType& homochoric) const;
 
+  /**
+   * @brief _calcSlipTransmissionMetrics Computes the slip transmission metrics for a list of boundaries using the
+   * given slip system table. Each grain's slip planes and directions are rotated into the sample frame once and
+   * the boundaries are then evaluated from those cached values.
+   * @param slipPlanes The slip plane normals in the crystal frame
+   * @param slipDirections The slip directions in the crystal frame
+   * @param numSlipSystems The number of slip systems in the table
+   */
+  void _calcSlipTransmissionMetrics(const double slipPlanes[][3], const double slipDirections[][3], size_t numSlipSystems, EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* boundaryPairs,
+                                    const double LD[3], bool maxSF, EbsdLib::DoubleArrayType* mPrime, EbsdLib::DoubleArrayType* F1, EbsdLib::DoubleArrayType* F1spt,
+                                    EbsdLib::DoubleArrayType* F7) const;
+
+  /**
+   * @brief _calcSchmidFactorMap Computes the Schmid factor map for an array of orientations using the given slip
+   * system table. The table is transposed into a structure-of-arrays layout once and shared by every point.
+   * @param slipPlanes The (unnormalized) slip plane normals in the crystal frame
+   * @param slipDirections The (unnormalized) slip directions in the crystal frame
+   * @param numSlipSystems The number of slip systems in the table
+   * @param planeNorm The length used to normalize each slip plane normal
+   * @param directionNorm The length used to normalize each slip direction
+   */
+  void _calcSchmidFactorMap(const double slipPlanes[][3], const double slipDirections[][3], size_t numSlipSystems, double planeNorm, double directionNorm, EbsdLib::FloatArrayType* quats,
+                            const double load[3], EbsdLib::FloatArrayType* schmidFactors, EbsdLib::Int32ArrayType* slipSystems, EbsdLib::FloatArrayType* angleComps) const;
+
 public:
   LaueOps(const LaueOps&) = delete;            // Copy Constructor Not Implemented
   LaueOps(LaueOps&&) = delete;                 // Move Constructor Not Implemented
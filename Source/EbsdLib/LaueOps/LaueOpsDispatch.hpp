@@ -0,0 +1,178 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/LaueOps/CubicLowOps.h"
+#include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/LaueOps/HexagonalLowOps.h"
+#include "EbsdLib/LaueOps/HexagonalOps.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/MonoclinicOps.h"
+#include "EbsdLib/LaueOps/OrthoRhombicOps.h"
+#include "EbsdLib/LaueOps/TetragonalLowOps.h"
+#include "EbsdLib/LaueOps/TetragonalOps.h"
+#include "EbsdLib/LaueOps/TriclinicOps.h"
+#include "EbsdLib/LaueOps/TrigonalLowOps.h"
+#include "EbsdLib/LaueOps/TrigonalOps.h"
+
+/**
+ * @file LaueOpsDispatch.hpp
+ * @brief Compile time dispatch onto the concrete LaueOps classes. A batch kernel written as a generic functor is
+ * instantiated once per Laue class, so the Laue class is resolved once per call (or per block of points) instead of
+ * through a virtual call for every point. All of the Laue classes are final, which lets the compiler turn the calls
+ * made through the concrete type into direct calls.
+ */
+namespace EbsdLib
+{
+/**
+ * @brief Maps a concrete LaueOps class onto its index in LaueOps::GetAllOrientationOps() (the EbsdLib::CrystalStructure value)
+ */
+template <typename OpsType>
+struct LaueOpsTraits;
+
+#define EBSD_LAUE_OPS_TRAITS(OPS_TYPE, CRYSTAL_STRUCTURE)                                                                                                                                              \
+  template <>                                                                                                                                                                                          \
+  struct LaueOpsTraits<OPS_TYPE>                                                                                                                                                                       \
+  {                                                                                                                                                                                                    \
+    static constexpr uint32_t k_CrystalStructure = CRYSTAL_STRUCTURE;                                                                                                                                  \
+  };
+
+EBSD_LAUE_OPS_TRAITS(HexagonalOps, CrystalStructure::Hexagonal_High)
+EBSD_LAUE_OPS_TRAITS(CubicOps, CrystalStructure::Cubic_High)
+EBSD_LAUE_OPS_TRAITS(HexagonalLowOps, CrystalStructure::Hexagonal_Low)
+EBSD_LAUE_OPS_TRAITS(CubicLowOps, CrystalStructure::Cubic_Low)
+EBSD_LAUE_OPS_TRAITS(TriclinicOps, CrystalStructure::Triclinic)
+EBSD_LAUE_OPS_TRAITS(MonoclinicOps, CrystalStructure::Monoclinic)
+EBSD_LAUE_OPS_TRAITS(OrthoRhombicOps, CrystalStructure::OrthoRhombic)
+EBSD_LAUE_OPS_TRAITS(TetragonalLowOps, CrystalStructure::Tetragonal_Low)
+EBSD_LAUE_OPS_TRAITS(TetragonalOps, CrystalStructure::Tetragonal_High)
+EBSD_LAUE_OPS_TRAITS(TrigonalLowOps, CrystalStructure::Trigonal_Low)
+EBSD_LAUE_OPS_TRAITS(TrigonalOps, CrystalStructure::Trigonal_High)
+
+#undef EBSD_LAUE_OPS_TRAITS
+
+/**
+ * @brief Returns the shared instance of a concrete LaueOps class from the LaueOps::GetAllOrientationOps() registry
+ */
+template <typename OpsType>
+const OpsType& GetLaueOps()
+{
+  return static_cast<const OpsType&>(*LaueOps::GetAllOrientationOps()[LaueOpsTraits<OpsType>::k_CrystalStructure]);
+}
+
+/**
+ * @brief Calls functor with the shared instance of the concrete LaueOps class for a crystal structure
+ * @param crystalStructure One of the EbsdLib::CrystalStructure values
+ * @param functor Generic callable taking a const reference to the concrete LaueOps class
+ * @return false if crystalStructure is not a Laue class, in which case functor is not called
+ */
+template <typename Functor>
+bool DispatchLaueOps(uint32_t crystalStructure, Functor&& functor)
+{
+  switch(crystalStructure)
+  {
+  case CrystalStructure::Hexagonal_High:
+    functor(GetLaueOps<HexagonalOps>());
+    return true;
+  case CrystalStructure::Cubic_High:
+    functor(GetLaueOps<CubicOps>());
+    return true;
+  case CrystalStructure::Hexagonal_Low:
+    functor(GetLaueOps<HexagonalLowOps>());
+    return true;
+  case CrystalStructure::Cubic_Low:
+    functor(GetLaueOps<CubicLowOps>());
+    return true;
+  case CrystalStructure::Triclinic:
+    functor(GetLaueOps<TriclinicOps>());
+    return true;
+  case CrystalStructure::Monoclinic:
+    functor(GetLaueOps<MonoclinicOps>());
+    return true;
+  case CrystalStructure::OrthoRhombic:
+    functor(GetLaueOps<OrthoRhombicOps>());
+    return true;
+  case CrystalStructure::Tetragonal_Low:
+    functor(GetLaueOps<TetragonalLowOps>());
+    return true;
+  case CrystalStructure::Tetragonal_High:
+    functor(GetLaueOps<TetragonalOps>());
+    return true;
+  case CrystalStructure::Trigonal_Low:
+    functor(GetLaueOps<TrigonalLowOps>());
+    return true;
+  case CrystalStructure::Trigonal_High:
+    functor(GetLaueOps<TrigonalOps>());
+    return true;
+  default:
+    return false;
+  }
+}
+
+namespace Detail
+{
+template <typename OpsType, typename Functor>
+bool DispatchIfType(const LaueOps& ops, Functor& functor)
+{
+  const auto* concrete = dynamic_cast<const OpsType*>(&ops);
+  if(nullptr == concrete)
+  {
+    return false;
+  }
+  functor(*concrete);
+  return true;
+}
+} // namespace Detail
+
+/**
+ * @brief Calls functor with ops cast to its concrete LaueOps class. This is meant to be called once at the start of a
+ * batch operation, not per point.
+ * @param ops Any LaueOps instance, it does not have to come from the registry
+ * @param functor Generic callable taking a const reference to the concrete LaueOps class
+ * @return false if ops is not one of the known Laue classes, in which case functor is not called
+ */
+template <typename Functor>
+bool DispatchLaueOps(const LaueOps& ops, Functor&& functor)
+{
+  return Detail::DispatchIfType<HexagonalOps>(ops, functor) || Detail::DispatchIfType<CubicOps>(ops, functor) || Detail::DispatchIfType<HexagonalLowOps>(ops, functor) ||
+         Detail::DispatchIfType<CubicLowOps>(ops, functor) || Detail::DispatchIfType<TriclinicOps>(ops, functor) || Detail::DispatchIfType<MonoclinicOps>(ops, functor) ||
+         Detail::DispatchIfType<OrthoRhombicOps>(ops, functor) || Detail::DispatchIfType<TetragonalLowOps>(ops, functor) || Detail::DispatchIfType<TetragonalOps>(ops, functor) ||
+         Detail::DispatchIfType<TrigonalLowOps>(ops, functor) || Detail::DispatchIfType<TrigonalOps>(ops, functor);
+}
+} // namespace EbsdLib
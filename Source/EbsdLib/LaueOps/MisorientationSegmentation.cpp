@@ -0,0 +1,425 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MisorientationSegmentation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/QuatSymmetryKernels.hpp"
+#include "EbsdLib/Math/EbsdLibMath.h"
+
+namespace Detail
+{
+/**
+ * @brief Minimum number of points in a slab. A slab is always made of whole planes.
+ */
+constexpr size_t k_MinPointsPerSlab = 65536;
+
+/**
+ * @brief The SegmentationImpl class holds the union-find forest of a segmentation. Every parent is at most the index
+ * of its child and every root is the lowest index of its component. The union-find methods only touch the points of
+ * the slabs that the two arguments belong to, which lets slabs that do not share a boundary be merged concurrently.
+ */
+template <typename IndexType>
+class SegmentationImpl
+{
+public:
+  SegmentationImpl(const std::vector<std::vector<double>>& symTables, const std::vector<double>& cosHalfTolerances, const float* quats, const int32_t* phases, const bool* goodPoints,
+                   const size_t dims[3], std::vector<IndexType>& parents)
+  : m_SymTables(symTables)
+  , m_CosHalfTolerances(cosHalfTolerances)
+  , m_Quats(quats)
+  , m_Phases(phases)
+  , m_GoodPoints(goodPoints)
+  , m_Parents(parents)
+  {
+    // Slabs are made of XY planes in 3D and of X rows in 2D
+    m_RowSize = dims[0];
+    if(dims[2] > 1)
+    {
+      m_PlaneSize = dims[0] * dims[1];
+      m_NumPlanes = dims[2];
+      m_RowsPerPlane = dims[1];
+    }
+    else
+    {
+      m_PlaneSize = dims[0];
+      m_NumPlanes = dims[1];
+      m_RowsPerPlane = 1;
+    }
+    m_PlanesPerSlab = std::max<size_t>(1, (k_MinPointsPerSlab + m_PlaneSize - 1) / m_PlaneSize);
+    m_NumSlabs = (m_NumPlanes + m_PlanesPerSlab - 1) / m_PlanesPerSlab;
+  }
+  virtual ~SegmentationImpl() = default;
+
+  size_t getNumberOfSlabs() const
+  {
+    return m_NumSlabs;
+  }
+
+  /**
+   * @brief Returns true if the point has a known Laue class and is not masked out
+   */
+  bool isValid(size_t index) const
+  {
+    const int32_t phase = m_Phases[index];
+    return (m_GoodPoints == nullptr || m_GoodPoints[index]) && phase >= 0 && static_cast<size_t>(phase) < m_SymTables.size() && !m_SymTables[phase].empty();
+  }
+
+  /**
+   * @brief Finds the root of a point, halving the path on the way
+   */
+  size_t find(size_t index) const
+  {
+    while(m_Parents[index] != index)
+    {
+      m_Parents[index] = m_Parents[m_Parents[index]];
+      index = m_Parents[index];
+    }
+    return index;
+  }
+
+  /**
+   * @brief Links the components of two points under the lower of their roots
+   */
+  void unite(size_t a, size_t b) const
+  {
+    size_t rootA = find(a);
+    size_t rootB = find(b);
+    if(rootA == rootB)
+    {
+      return;
+    }
+    if(rootA < rootB)
+    {
+      m_Parents[rootB] = static_cast<IndexType>(rootA);
+    }
+    else
+    {
+      m_Parents[rootA] = static_cast<IndexType>(rootB);
+    }
+  }
+
+  /**
+   * @brief Returns true if two valid points have the same phase and are within the tolerance of that phase
+   */
+  bool isConnected(size_t index, size_t neighbor) const
+  {
+    const int32_t phase = m_Phases[index];
+    if(m_Phases[neighbor] != phase || !isValid(neighbor))
+    {
+      return false;
+    }
+    double p[4];
+    double q[4];
+    for(size_t c = 0; c < 4; c++)
+    {
+      p[c] = m_Quats[index * 4 + c];
+      q[c] = m_Quats[neighbor * 4 + c];
+    }
+    const std::vector<double>& symTable = m_SymTables[phase];
+    return EbsdLib::Detail::IsMisorientationWithin(symTable.data(), symTable.size() / 4, p, q, m_CosHalfTolerances[phase]);
+  }
+
+  /**
+   * @brief Links two points if they are not in the same component yet and are connected
+   */
+  void link(size_t index, size_t neighbor) const
+  {
+    if(find(index) != find(neighbor) && isConnected(index, neighbor))
+    {
+      unite(index, neighbor);
+    }
+  }
+
+  /**
+   * @brief Finds the components of each slab in a range, using only the neighbors inside the slab
+   */
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t slab = start; slab < end; slab++)
+    {
+      const size_t firstPlane = slab * m_PlanesPerSlab;
+      const size_t lastPlane = std::min(firstPlane + m_PlanesPerSlab, m_NumPlanes);
+      const size_t first = firstPlane * m_PlaneSize;
+      const size_t last = lastPlane * m_PlaneSize;
+      for(size_t index = first; index < last; index++)
+      {
+        m_Parents[index] = static_cast<IndexType>(index);
+      }
+      for(size_t index = first; index < last; index++)
+      {
+        if(!isValid(index))
+        {
+          continue;
+        }
+        const size_t x = index % m_RowSize;
+        const size_t row = (index / m_RowSize) % m_RowsPerPlane;
+        if(x + 1 < m_RowSize)
+        {
+          link(index, index + 1);
+        }
+        if(row + 1 < m_RowsPerPlane)
+        {
+          link(index, index + m_RowSize);
+        }
+        if(index + m_PlaneSize < last)
+        {
+          link(index, index + m_PlaneSize);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Merges the components across the boundary between a slab and the next one
+   */
+  void mergeBoundary(size_t slab) const
+  {
+    const size_t first = ((slab + 1) * m_PlanesPerSlab - 1) * m_PlaneSize;
+    const size_t last = first + m_PlaneSize;
+    for(size_t index = first; index < last; index++)
+    {
+      if(isValid(index))
+      {
+        link(index, index + m_PlaneSize);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<std::vector<double>>& m_SymTables;
+  const std::vector<double>& m_CosHalfTolerances;
+  const float* m_Quats;
+  const int32_t* m_Phases;
+  const bool* m_GoodPoints;
+  std::vector<IndexType>& m_Parents;
+  size_t m_RowSize = 0;
+  size_t m_RowsPerPlane = 0;
+  size_t m_PlaneSize = 0;
+  size_t m_NumPlanes = 0;
+  size_t m_PlanesPerSlab = 0;
+  size_t m_NumSlabs = 0;
+};
+
+/**
+ * @brief The MergeSlabsImpl class merges the boundaries of one level of the pairwise slab merge. At a given level the
+ * boundaries are separated by groups of slabs that do not touch each other, so they are merged concurrently.
+ */
+template <typename IndexType>
+class MergeSlabsImpl
+{
+public:
+  MergeSlabsImpl(const SegmentationImpl<IndexType>& segmentation, size_t level)
+  : m_Segmentation(segmentation)
+  , m_Level(level)
+  {
+  }
+  virtual ~MergeSlabsImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t group = start; group < end; group++)
+    {
+      // Boundary between the last slab of the first half of the group and the first slab of the second half
+      const size_t slab = group * 2 * m_Level + m_Level - 1;
+      if(slab + 1 < m_Segmentation.getNumberOfSlabs())
+      {
+        m_Segmentation.mergeBoundary(slab);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const SegmentationImpl<IndexType>& m_Segmentation;
+  size_t m_Level;
+};
+
+/**
+ * @brief Segments the map with union-find over parents of type IndexType, then numbers the features
+ */
+template <typename IndexType>
+size_t Segment(const std::vector<std::vector<double>>& symTables, const std::vector<double>& cosHalfTolerances, const float* quats, const int32_t* phases, const bool* goodPoints,
+               const size_t dims[3], int32_t* featureIds)
+{
+  const size_t numPoints = dims[0] * dims[1] * dims[2];
+  std::vector<IndexType> parents(numPoints);
+  SegmentationImpl<IndexType> impl(symTables, cosHalfTolerances, quats, phases, goodPoints, dims, parents);
+  const size_t numSlabs = impl.getNumberOfSlabs();
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), impl, tbb::simple_partitioner());
+#else
+  impl.generate(0, numSlabs);
+#endif
+
+  for(size_t level = 1; level < numSlabs; level *= 2)
+  {
+    MergeSlabsImpl<IndexType> merge(impl, level);
+    const size_t numGroups = (numSlabs + 2 * level - 1) / (2 * level);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numGroups, 1), merge, tbb::simple_partitioner());
+#else
+    merge.generate(0, numGroups);
+#endif
+  }
+
+  // Every parent is lower than its child, so a single forward pass resolves each point to its root and numbers the
+  // roots in increasing order
+  int32_t numFeatures = 0;
+  for(size_t index = 0; index < numPoints; index++)
+  {
+    if(!impl.isValid(index))
+    {
+      featureIds[index] = 0;
+      continue;
+    }
+    const IndexType root = parents[parents[index]];
+    parents[index] = root;
+    featureIds[index] = (root == index) ? ++numFeatures : featureIds[root];
+  }
+  return static_cast<size_t>(numFeatures) + 1;
+}
+} // namespace Detail
+
+// -----------------------------------------------------------------------------
+MisorientationSegmentation::MisorientationSegmentation(const std::vector<uint32_t>& crystalStructures)
+: m_CrystalStructures(crystalStructures)
+, m_Tolerances(crystalStructures.size(), 5.0 * EbsdLib::Constants::k_PiOver180D)
+{
+}
+
+// -----------------------------------------------------------------------------
+MisorientationSegmentation::~MisorientationSegmentation() = default;
+
+// -----------------------------------------------------------------------------
+MisorientationSegmentation::Pointer MisorientationSegmentation::New(const std::vector<uint32_t>& crystalStructures)
+{
+  Pointer sharedPtr(new MisorientationSegmentation(crystalStructures));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+MisorientationSegmentation::Pointer MisorientationSegmentation::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::string MisorientationSegmentation::getNameOfClass() const
+{
+  return ClassName();
+}
+
+// -----------------------------------------------------------------------------
+std::string MisorientationSegmentation::ClassName()
+{
+  return std::string("MisorientationSegmentation");
+}
+
+// -----------------------------------------------------------------------------
+void MisorientationSegmentation::setTolerance(double tolerance)
+{
+  std::fill(m_Tolerances.begin(), m_Tolerances.end(), tolerance);
+}
+
+// -----------------------------------------------------------------------------
+void MisorientationSegmentation::setTolerances(const std::vector<double>& tolerances)
+{
+  std::copy(tolerances.begin(), tolerances.begin() + std::min(tolerances.size(), m_Tolerances.size()), m_Tolerances.begin());
+}
+
+// -----------------------------------------------------------------------------
+std::vector<double> MisorientationSegmentation::getTolerances() const
+{
+  return m_Tolerances;
+}
+
+// -----------------------------------------------------------------------------
+size_t MisorientationSegmentation::compute(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* phases, const size_t dims[3], EbsdLib::Int32ArrayType* featureIds, const bool* goodPoints) const
+{
+  const size_t numPoints = dims[0] * dims[1] * dims[2];
+  if(featureIds->getNumberOfTuples() < numPoints)
+  {
+    featureIds->resizeTuples(numPoints);
+  }
+  if(numPoints == 0 || quats->getNumberOfTuples() < numPoints || phases->getNumberOfTuples() < numPoints)
+  {
+    // Too few input tuples, no point is valid
+    featureIds->initializeWithZeros();
+    return 1;
+  }
+
+  const std::vector<LaueOps::Pointer>& ops = LaueOps::GetAllOrientationOps();
+  std::vector<std::vector<double>> symTables(m_CrystalStructures.size());
+  std::vector<double> cosHalfTolerances(m_CrystalStructures.size());
+  for(size_t phase = 0; phase < m_CrystalStructures.size(); phase++)
+  {
+    // Every misorientation is within a tolerance of 180 degrees or more
+    cosHalfTolerances[phase] = std::cos(0.5 * std::min(m_Tolerances[phase], EbsdLib::Constants::k_PiD));
+    if(m_CrystalStructures[phase] < EbsdLib::CrystalStructure::LaueGroupEnd)
+    {
+      symTables[phase] = EbsdLib::Detail::CreateQuatSymTable(*ops[m_CrystalStructures[phase]]);
+    }
+  }
+
+  if(numPoints <= std::numeric_limits<uint32_t>::max())
+  {
+    return Detail::Segment<uint32_t>(symTables, cosHalfTolerances, quats->getPointer(0), phases->getPointer(0), goodPoints, dims, featureIds->getPointer(0));
+  }
+  return Detail::Segment<size_t>(symTables, cosHalfTolerances, quats->getPointer(0), phases->getPointer(0), goodPoints, dims, featureIds->getPointer(0));
+}
@@ -0,0 +1,126 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class MisorientationSegmentation MisorientationSegmentation.h EbsdLib/LaueOps/MisorientationSegmentation.h
+ * @brief The MisorientationSegmentation class segments a 2D or 3D orientation map into features (grains). Two face
+ * neighbors belong to the same feature when they have the same phase and their misorientation is no more than the
+ * tolerance of that phase. The features are the connected components of that relation.
+ *
+ * The points are stored with X varying fastest, then Y, then Z, the layout of the arrays loaded by
+ * H5EbsdVolumeReader. The grid is split into slabs of whole planes. The components inside each slab are found in
+ * parallel with union-find, then the slabs are merged pairwise, also in parallel. Each point is compared with its +X,
+ * +Y and +Z neighbors unless they already are in the same component. Each union links the larger root under the
+ * smaller one, so the root of a feature is always its lowest point index. Features are numbered from 1 in the order
+ * of their lowest point index, so the result does not depend on the number of threads.
+ */
+class EbsdLib_EXPORT MisorientationSegmentation
+{
+public:
+  using Self = MisorientationSegmentation;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  /**
+   * @brief Creates an engine for the phases of a scan
+   * @param crystalStructures The EbsdLib::CrystalStructure value of each phase
+   */
+  static Pointer New(const std::vector<uint32_t>& crystalStructures);
+
+  /**
+   * @brief Returns the name of the class for MisorientationSegmentation
+   */
+  std::string getNameOfClass() const;
+  /**
+   * @brief Returns the name of the class for MisorientationSegmentation
+   */
+  static std::string ClassName();
+
+  ~MisorientationSegmentation();
+
+  /**
+   * @brief Sets the misorientation tolerance (in radians) of every phase. The default is 5 degrees.
+   */
+  void setTolerance(double tolerance);
+
+  /**
+   * @brief Sets the misorientation tolerance (in radians) of each phase. Phases beyond the end of the vector keep
+   * their current tolerance.
+   */
+  void setTolerances(const std::vector<double>& tolerances);
+
+  /**
+   * @brief Returns the misorientation tolerance (in radians) of each phase
+   */
+  std::vector<double> getTolerances() const;
+
+  /**
+   * @brief Segments the map into features
+   * @param quats Per point quaternions as 4 component (x, y, z, w) tuples
+   * @param phases Phase of each point. Points whose phase has no known Laue class are not part of any feature.
+   * @param dims The number of points along X, Y and Z. Use 1 for Z with 2D maps.
+   * @param featureIds [output] Feature id of each point, resized if too small. Points that are not part of any feature
+   * are set to 0. All of it is set to 0 if quats or phases have fewer than dims[0] * dims[1] * dims[2] tuples.
+   * @param goodPoints Optional mask. Points where it is false are not part of any feature.
+   * @return The number of features, including feature 0, which is 1 if the input is too small
+   */
+  size_t compute(EbsdLib::FloatArrayType* quats, EbsdLib::Int32ArrayType* phases, const size_t dims[3], EbsdLib::Int32ArrayType* featureIds, const bool* goodPoints = nullptr) const;
+
+protected:
+  explicit MisorientationSegmentation(const std::vector<uint32_t>& crystalStructures);
+
+private:
+  std::vector<uint32_t> m_CrystalStructures;
+  std::vector<double> m_Tolerances;
+
+public:
+  MisorientationSegmentation(const MisorientationSegmentation&) = delete;            // Copy Constructor Not Implemented
+  MisorientationSegmentation(MisorientationSegmentation&&) = delete;                 // Move Constructor Not Implemented
+  MisorientationSegmentation& operator=(const MisorientationSegmentation&) = delete; // Copy Assignment Not Implemented
+  MisorientationSegmentation& operator=(MisorientationSegmentation&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,203 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "PhasePartition.h"
+
+#include <algorithm>
+
+namespace
+{
+// -----------------------------------------------------------------------------
+template <typename T>
+void PreparePartitionOutput(EbsdDataArray<T>* output, size_t numPoints)
+{
+  if(output != nullptr && output->getNumberOfTuples() < numPoints)
+  {
+    output->resizeTuples(numPoints);
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+PhasePartition::PhasePartition(const int32_t* phases, size_t numPoints, size_t numPhases, const bool* goodPoints)
+: m_NumPoints(numPoints)
+, m_Offsets(numPhases + 1, 0)
+{
+  auto isPartitioned = [&](size_t i) {
+    return phases[i] >= 0 && static_cast<size_t>(phases[i]) < numPhases && (goodPoints == nullptr || goodPoints[i]);
+  };
+
+  // Counting sort: histogram the phases, prefix sum into offsets, then place each index. Walking the points in order
+  // keeps the indices of every phase increasing.
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    if(isPartitioned(i))
+    {
+      m_Offsets[phases[i] + 1]++;
+    }
+  }
+  for(size_t phase = 0; phase < numPhases; phase++)
+  {
+    m_Offsets[phase + 1] += m_Offsets[phase];
+  }
+  m_Indices.resize(m_Offsets[numPhases]);
+  std::vector<size_t> next(m_Offsets.begin(), m_Offsets.end() - 1);
+  for(size_t i = 0; i < numPoints; i++)
+  {
+    if(isPartitioned(i))
+    {
+      m_Indices[next[phases[i]]++] = i;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+PhasePartition::~PhasePartition() = default;
+
+// -----------------------------------------------------------------------------
+PhasePartition::Pointer PhasePartition::New(const int32_t* phases, size_t numPoints, size_t numPhases, const bool* goodPoints)
+{
+  Pointer sharedPtr(new PhasePartition(phases, numPoints, numPhases, goodPoints));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+PhasePartition::Pointer PhasePartition::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::string PhasePartition::getNameOfClass() const
+{
+  return ClassName();
+}
+
+// -----------------------------------------------------------------------------
+std::string PhasePartition::ClassName()
+{
+  return std::string("PhasePartition");
+}
+
+// -----------------------------------------------------------------------------
+size_t PhasePartition::getNumberOfPoints() const
+{
+  return m_NumPoints;
+}
+
+// -----------------------------------------------------------------------------
+size_t PhasePartition::getNumberOfPhases() const
+{
+  return m_Offsets.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+size_t PhasePartition::getPhaseSize(size_t phase) const
+{
+  return m_Offsets[phase + 1] - m_Offsets[phase];
+}
+
+// -----------------------------------------------------------------------------
+const size_t* PhasePartition::getPhaseIndices(size_t phase) const
+{
+  return m_Indices.data() + m_Offsets[phase];
+}
+
+// -----------------------------------------------------------------------------
+void PhasePartition::generateIPFColors(const std::vector<uint32_t>& crystalStructures, const EbsdArrayView<const float>& eulers, const double refDir[3], bool convertDegrees,
+                                       EbsdLib::UInt8ArrayType* rgb, EbsdLib::ComputePrecision precision) const
+{
+  if(eulers.getNumberOfTuples() < m_NumPoints)
+  {
+    return;
+  }
+  PreparePartitionOutput(rgb, m_NumPoints);
+  forEachPhase(crystalStructures, [&](size_t phase, const LaueOps& ops) {
+    EbsdLib::FloatArrayType::Pointer phaseEulers = gather(eulers, phase);
+    EbsdLib::UInt8ArrayType::Pointer phaseRgb = EbsdLib::UInt8ArrayType::CreateUninitializedArray(phaseEulers->getNumberOfTuples(), {3}, "PhaseRgb");
+    ops.generateIPFColors(EbsdArrayView<const float>::FromArray(*phaseEulers), refDir, convertDegrees, phaseRgb.get(), precision);
+    scatter(*phaseRgb, phase, *rgb);
+  });
+}
+
+// -----------------------------------------------------------------------------
+void PhasePartition::calculateMisorientations(const std::vector<uint32_t>& crystalStructures, EbsdLib::FloatArrayType* quats1, EbsdLib::FloatArrayType* quats2, EbsdLib::FloatArrayType* axisAngles,
+                                              EbsdLib::ComputePrecision precision) const
+{
+  if(quats1 == nullptr || quats2 == nullptr || quats1->getNumberOfTuples() < m_NumPoints || quats2->getNumberOfTuples() < m_NumPoints)
+  {
+    return;
+  }
+  PreparePartitionOutput(axisAngles, m_NumPoints);
+  forEachPhase(crystalStructures, [&](size_t phase, const LaueOps& ops) {
+    EbsdLib::FloatArrayType::Pointer phaseQuats1 = gather(EbsdArrayView<const float>::FromArray(*quats1), phase);
+    EbsdLib::FloatArrayType::Pointer phaseQuats2 = gather(EbsdArrayView<const float>::FromArray(*quats2), phase);
+    EbsdLib::FloatArrayType::Pointer phaseAxisAngles = EbsdLib::FloatArrayType::CreateUninitializedArray(phaseQuats1->getNumberOfTuples(), {4}, "PhaseAxisAngles");
+    ops.calculateMisorientations(phaseQuats1.get(), phaseQuats2.get(), phaseAxisAngles.get(), precision);
+    scatter(*phaseAxisAngles, phase, *axisAngles);
+  });
+}
+
+// -----------------------------------------------------------------------------
+void PhasePartition::generateSchmidFactorMap(const std::vector<uint32_t>& crystalStructures, EbsdLib::FloatArrayType* quats, const double load[3], EbsdLib::FloatArrayType* schmidFactors,
+                                             EbsdLib::Int32ArrayType* slipSystems, EbsdLib::FloatArrayType* angleComps) const
+{
+  if(quats == nullptr || quats->getNumberOfTuples() < m_NumPoints)
+  {
+    return;
+  }
+  PreparePartitionOutput(schmidFactors, m_NumPoints);
+  PreparePartitionOutput(slipSystems, m_NumPoints);
+  PreparePartitionOutput(angleComps, m_NumPoints);
+  forEachPhase(crystalStructures, [&](size_t phase, const LaueOps& ops) {
+    EbsdLib::FloatArrayType::Pointer phaseQuats = gather(EbsdArrayView<const float>::FromArray(*quats), phase);
+    const size_t count = phaseQuats->getNumberOfTuples();
+    EbsdLib::FloatArrayType::Pointer phaseSchmids = EbsdLib::FloatArrayType::CreateUninitializedArray(count, {1}, "PhaseSchmidFactors");
+    EbsdLib::Int32ArrayType::Pointer phaseSlipSystems = EbsdLib::Int32ArrayType::CreateUninitializedArray(count, {1}, "PhaseSlipSystems");
+    EbsdLib::FloatArrayType::Pointer phaseAngleComps = EbsdLib::FloatArrayType::CreateUninitializedArray(count, {2}, "PhaseAngleComps");
+    ops.generateSchmidFactorMap(phaseQuats.get(), load, phaseSchmids.get(), phaseSlipSystems.get(), phaseAngleComps.get());
+    if(schmidFactors != nullptr)
+    {
+      scatter(*phaseSchmids, phase, *schmidFactors);
+    }
+    if(slipSystems != nullptr)
+    {
+      scatter(*phaseSlipSystems, phase, *slipSystems);
+    }
+    if(angleComps != nullptr)
+    {
+      scatter(*phaseAngleComps, phase, *angleComps);
+    }
+  });
+}
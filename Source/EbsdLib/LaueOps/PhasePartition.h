@@ -0,0 +1,211 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdArrayView.hpp"
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+/**
+ * @class PhasePartition PhasePartition.h EbsdLib/LaueOps/PhasePartition.h
+ * @brief The PhasePartition class sorts the points of a multi-phase scan by phase once (counting sort). Batch
+ * operations can then run each phase as a single call on a contiguous block of points. The Laue class is chosen once
+ * per phase instead of once per point. Each phase's inputs are gathered into dense arrays, the LaueOps batch API runs
+ * on them in parallel, and the results are scattered back to the original point order.
+ *
+ * The generateIPFColors(), calculateMisorientations() and generateSchmidFactorMap() convenience methods cover the
+ * LaueOps batch APIs. Any other batch operation can be built from forEachPhase(), gather() and scatter().
+ */
+class EbsdLib_EXPORT PhasePartition
+{
+public:
+  using Self = PhasePartition;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  /**
+   * @brief Sorts the points of a scan by phase
+   * @param phases The phase of each point
+   * @param numPoints The number of points in the scan
+   * @param numPhases The number of phases, including phase 0. Points with a phase outside of [0, numPhases) are not
+   * part of any phase.
+   * @param goodPoints Optional mask. Points where it is false are not part of any phase.
+   */
+  static Pointer New(const int32_t* phases, size_t numPoints, size_t numPhases, const bool* goodPoints = nullptr);
+
+  /**
+   * @brief Returns the name of the class for PhasePartition
+   */
+  std::string getNameOfClass() const;
+  /**
+   * @brief Returns the name of the class for PhasePartition
+   */
+  static std::string ClassName();
+
+  ~PhasePartition();
+
+  /**
+   * @brief Returns the number of points in the scan that was partitioned
+   */
+  size_t getNumberOfPoints() const;
+
+  size_t getNumberOfPhases() const;
+
+  /**
+   * @brief Returns the number of points that belong to a phase
+   */
+  size_t getPhaseSize(size_t phase) const;
+
+  /**
+   * @brief Returns the indices (in increasing order) of the points that belong to a phase
+   */
+  const size_t* getPhaseIndices(size_t phase) const;
+
+  /**
+   * @brief Copies the tuples of the points that belong to a phase into a new dense array
+   */
+  template <typename T>
+  typename EbsdDataArray<T>::Pointer gather(const EbsdArrayView<const T>& input, size_t phase) const
+  {
+    const size_t numComps = input.getNumberOfComponents();
+    const size_t count = getPhaseSize(phase);
+    const size_t* indices = getPhaseIndices(phase);
+    typename EbsdDataArray<T>::Pointer phaseValues = EbsdDataArray<T>::CreateUninitializedArray(count, {numComps}, "PhaseValues");
+    T* dest = phaseValues->getPointer(0);
+    for(size_t i = 0; i < count; i++)
+    {
+      input.getTuple(indices[i], dest + i * numComps);
+    }
+    return phaseValues;
+  }
+
+  /**
+   * @brief Copies the tuples of a dense per phase array back to the original positions of the points in output
+   */
+  template <typename T>
+  void scatter(const EbsdDataArray<T>& phaseValues, size_t phase, EbsdDataArray<T>& output) const
+  {
+    const size_t numComps = static_cast<size_t>(phaseValues.getNumberOfComponents());
+    const size_t count = getPhaseSize(phase);
+    const size_t* indices = getPhaseIndices(phase);
+    const T* src = phaseValues.getPointer(0);
+    T* dest = output.getPointer(0);
+    for(size_t i = 0; i < count; i++)
+    {
+      for(size_t c = 0; c < numComps; c++)
+      {
+        dest[indices[i] * numComps + c] = src[i * numComps + c];
+      }
+    }
+  }
+
+  /**
+   * @brief Calls functor(phase, ops) for every phase that has points and a known Laue class
+   * @param crystalStructures The EbsdLib::CrystalStructure value of each phase
+   * @param functor Callable taking the phase index and the const LaueOps& of that phase
+   */
+  template <typename Functor>
+  void forEachPhase(const std::vector<uint32_t>& crystalStructures, Functor&& functor) const
+  {
+    const std::vector<LaueOps::Pointer>& ops = LaueOps::GetAllOrientationOps();
+    const size_t numPhases = std::min(getNumberOfPhases(), crystalStructures.size());
+    for(size_t phase = 0; phase < numPhases; phase++)
+    {
+      if(getPhaseSize(phase) == 0 || crystalStructures[phase] >= EbsdLib::CrystalStructure::LaueGroupEnd)
+      {
+        continue;
+      }
+      functor(phase, *ops[crystalStructures[phase]]);
+    }
+  }
+
+  /**
+   * @brief Generates the IPF colors of a multi-phase scan with LaueOps::generateIPFColors(). Points that are not
+   * part of a phase with a known Laue class are left unchanged. Does nothing if eulers has fewer tuples than
+   * getNumberOfPoints().
+   * @param crystalStructures The EbsdLib::CrystalStructure value of each phase
+   * @param rgb [output] 3 component RGB tuples, resized if too small
+   */
+  void generateIPFColors(const std::vector<uint32_t>& crystalStructures, const EbsdArrayView<const float>& eulers, const double refDir[3], bool convertDegrees, EbsdLib::UInt8ArrayType* rgb,
+                         EbsdLib::ComputePrecision precision = EbsdLib::ComputePrecision::Double) const;
+
+  /**
+   * @brief Calculates the misorientations of a multi-phase scan with LaueOps::calculateMisorientations(). The phase of
+   * each pair is the phase of its first point. Pairs that are not part of a phase with a known Laue class are left
+   * unchanged. Does nothing if quats1 or quats2 has fewer tuples than getNumberOfPoints().
+   * @param crystalStructures The EbsdLib::CrystalStructure value of each phase
+   * @param axisAngles [output] 4 component axis-angle tuples, resized if too small
+   */
+  void calculateMisorientations(const std::vector<uint32_t>& crystalStructures, EbsdLib::FloatArrayType* quats1, EbsdLib::FloatArrayType* quats2, EbsdLib::FloatArrayType* axisAngles,
+                                EbsdLib::ComputePrecision precision = EbsdLib::ComputePrecision::Double) const;
+
+  /**
+   * @brief Computes the Schmid factor map of a multi-phase scan with LaueOps::generateSchmidFactorMap(). Points that
+   * are not part of a phase with a known Laue class are left unchanged. Does nothing if quats has fewer tuples than
+   * getNumberOfPoints().
+   * @param crystalStructures The EbsdLib::CrystalStructure value of each phase
+   * @param schmidFactors [output] Can be nullptr if not needed. Resized if too small.
+   * @param slipSystems [output] Can be nullptr if not needed. Resized if too small.
+   * @param angleComps [output] Can be nullptr if not needed. Resized if too small.
+   */
+  void generateSchmidFactorMap(const std::vector<uint32_t>& crystalStructures, EbsdLib::FloatArrayType* quats, const double load[3], EbsdLib::FloatArrayType* schmidFactors,
+                               EbsdLib::Int32ArrayType* slipSystems, EbsdLib::FloatArrayType* angleComps) const;
+
+protected:
+  PhasePartition(const int32_t* phases, size_t numPoints, size_t numPhases, const bool* goodPoints);
+
+private:
+  size_t m_NumPoints = 0;
+  std::vector<size_t> m_Offsets;
+  std::vector<size_t> m_Indices;
+
+public:
+  PhasePartition(const PhasePartition&) = delete;            // Copy Constructor Not Implemented
+  PhasePartition(PhasePartition&&) = delete;                 // Move Constructor Not Implemented
+  PhasePartition& operator=(const PhasePartition&) = delete; // Copy Assignment Not Implemented
+  PhasePartition& operator=(PhasePartition&&) = delete;      // Move Assignment Not Implemented
+};
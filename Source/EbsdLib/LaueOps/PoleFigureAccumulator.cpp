@@ -0,0 +1,304 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "PoleFigureAccumulator.h"
+
+#include <algorithm>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_group.h>
+#endif
+
+namespace Detail
+{
+/**
+ * @brief The AccumulateLambertImpl class adds the sphere coordinates of one pole figure family to its Lambert squares.
+ * Each coordinate is added the same way ModifiedLambertProjection::LambertBallToSquare() does.
+ */
+class AccumulateLambertImpl
+{
+public:
+  AccumulateLambertImpl(EbsdLib::FloatArrayType* xyzCoords, ModifiedLambertProjection* projection, double weight)
+  : m_XYZCoords(xyzCoords)
+  , m_Projection(projection)
+  , m_Weight(weight)
+  {
+  }
+
+  void operator()() const
+  {
+    size_t numCoords = m_XYZCoords->getNumberOfTuples();
+    float sqCoord[2];
+    for(size_t i = 0; i < numCoords; i++)
+    {
+      sqCoord[0] = 0.0f;
+      sqCoord[1] = 0.0f;
+      bool nhCheck = m_Projection->getSquareCoord(m_XYZCoords->getPointer(i * 3), sqCoord);
+      m_Projection->addInterpolatedValues(nhCheck ? ModifiedLambertProjection::NorthSquare : ModifiedLambertProjection::SouthSquare, sqCoord, m_Weight);
+    }
+  }
+
+private:
+  EbsdLib::FloatArrayType* m_XYZCoords = nullptr;
+  ModifiedLambertProjection* m_Projection = nullptr;
+  double m_Weight = 1.0;
+};
+
+/**
+ * @brief The ProjectLambertImpl class creates the stereographic intensity image of one pole figure family
+ */
+class ProjectLambertImpl
+{
+public:
+  ProjectLambertImpl(ModifiedLambertProjection* projection, int imageDim, EbsdLib::DoubleArrayType* intensity)
+  : m_Projection(projection)
+  , m_ImageDim(imageDim)
+  , m_Intensity(intensity)
+  {
+  }
+
+  void operator()() const
+  {
+    m_Projection->createStereographicProjection(m_ImageDim, *m_Intensity);
+  }
+
+private:
+  ModifiedLambertProjection* m_Projection = nullptr;
+  int m_ImageDim = 0;
+  EbsdLib::DoubleArrayType* m_Intensity = nullptr;
+};
+} // namespace Detail
+
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::PoleFigureAccumulator(LaueOps::Pointer ops, int lambertDim)
+: m_LaueOps(std::move(ops))
+, m_LambertDimension(lambertDim)
+{
+  for(size_t i = 0; i < m_Counts.size(); i++)
+  {
+    m_Counts[i] = ModifiedLambertProjection::New();
+    m_Counts[i]->initializeSquares(m_LambertDimension, 1.0f);
+    m_Normalized[i] = ModifiedLambertProjection::New();
+    m_Normalized[i]->initializeSquares(m_LambertDimension, 1.0f);
+  }
+}
+
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::~PoleFigureAccumulator() = default;
+
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::Pointer PoleFigureAccumulator::New(LaueOps::Pointer ops, int lambertDim)
+{
+  Pointer sharedPtr(new PoleFigureAccumulator(std::move(ops), lambertDim));
+  return sharedPtr;
+}
+
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::Pointer PoleFigureAccumulator::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::string PoleFigureAccumulator::getNameOfClass() const
+{
+  return ClassName();
+}
+
+// -----------------------------------------------------------------------------
+std::string PoleFigureAccumulator::ClassName()
+{
+  return std::string("PoleFigureAccumulator");
+}
+
+// -----------------------------------------------------------------------------
+size_t PoleFigureAccumulator::getNumberOfOrientations() const
+{
+  return m_NumOrientations;
+}
+
+// -----------------------------------------------------------------------------
+int PoleFigureAccumulator::getLambertDimension() const
+{
+  return m_LambertDimension;
+}
+
+// -----------------------------------------------------------------------------
+LaueOps::Pointer PoleFigureAccumulator::getLaueOps() const
+{
+  return m_LaueOps;
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::addOrientations(const EbsdArrayView<const float>& eulers)
+{
+  accumulate(eulers, 1.0);
+  m_NumOrientations += eulers.getNumberOfTuples();
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::removeOrientations(const EbsdArrayView<const float>& eulers)
+{
+  size_t numOrientations = eulers.getNumberOfTuples();
+  if(numOrientations >= m_NumOrientations)
+  {
+    // Start over from exact zeros instead of keeping the rounding left behind by the subtraction
+    clear();
+    return;
+  }
+  accumulate(eulers, -1.0);
+  m_NumOrientations -= numOrientations;
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::clear()
+{
+  for(const auto& counts : m_Counts)
+  {
+    counts->getNorthSquare()->initializeWithZeros();
+    counts->getSouthSquare()->initializeWithZeros();
+  }
+  m_NumOrientations = 0;
+  m_NormalizedValid = false;
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::accumulate(const EbsdArrayView<const float>& eulers, double weight)
+{
+  if(eulers.getNumberOfTuples() == 0)
+  {
+    return;
+  }
+
+  std::array<EbsdLib::FloatArrayType::Pointer, 3> xyzCoords;
+  for(auto& xyz : xyzCoords)
+  {
+    xyz = EbsdLib::FloatArrayType::CreateUninitializedArray(0, {3}, "xyzCoords");
+  }
+  // **** Parallelized
+  m_LaueOps->generateSphereCoordsFromEulers(eulers, xyzCoords[0].get(), xyzCoords[1].get(), xyzCoords[2].get());
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_group g;
+  for(size_t i = 0; i < xyzCoords.size(); i++)
+  {
+    g.run(Detail::AccumulateLambertImpl(xyzCoords[i].get(), m_Counts[i].get(), weight));
+  }
+  g.wait(); // Wait for all the threads to complete before moving on.
+#else
+  for(size_t i = 0; i < xyzCoords.size(); i++)
+  {
+    Detail::AccumulateLambertImpl impl(xyzCoords[i].get(), m_Counts[i].get(), weight);
+    impl();
+  }
+#endif
+  m_NormalizedValid = false;
+}
+
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::updateNormalizedSquares()
+{
+  if(m_NormalizedValid)
+  {
+    return;
+  }
+  for(size_t i = 0; i < m_Counts.size(); i++)
+  {
+    const EbsdLib::DoubleArrayType& north = *m_Counts[i]->getNorthSquare();
+    const EbsdLib::DoubleArrayType& south = *m_Counts[i]->getSouthSquare();
+    std::copy(north.begin(), north.end(), m_Normalized[i]->getNorthSquare()->begin());
+    std::copy(south.begin(), south.end(), m_Normalized[i]->getSouthSquare()->begin());
+    m_Normalized[i]->normalizeSquaresToMRD();
+  }
+  m_NormalizedValid = true;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::DoubleArrayType::Pointer> PoleFigureAccumulator::generateIntensities(int imageDim)
+{
+  std::array<std::string, 3> labels = m_LaueOps->getDefaultPoleFigureNames();
+  std::vector<EbsdLib::DoubleArrayType::Pointer> intensities(labels.size());
+  for(size_t i = 0; i < labels.size(); i++)
+  {
+    intensities[i] = EbsdLib::DoubleArrayType::CreateArray(static_cast<size_t>(imageDim * imageDim), {1}, labels[i] + "_Intensity_Image", true);
+    intensities[i]->initializeWithZeros();
+  }
+  if(m_NumOrientations == 0)
+  {
+    return intensities;
+  }
+
+  updateNormalizedSquares();
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::task_group g;
+  for(size_t i = 0; i < intensities.size(); i++)
+  {
+    g.run(Detail::ProjectLambertImpl(m_Normalized[i].get(), imageDim, intensities[i].get()));
+  }
+  g.wait(); // Wait for all the threads to complete before moving on.
+#else
+  for(size_t i = 0; i < intensities.size(); i++)
+  {
+    Detail::ProjectLambertImpl impl(m_Normalized[i].get(), imageDim, intensities[i].get());
+    impl();
+  }
+#endif
+  return intensities;
+}
+
+// -----------------------------------------------------------------------------
+std::vector<EbsdLib::UInt8ArrayType::Pointer> PoleFigureAccumulator::generatePoleFigure(PoleFigureConfiguration_t& config)
+{
+  std::array<std::string, 3> labels = m_LaueOps->getDefaultPoleFigureNames();
+  for(size_t i = 0; i < labels.size() && i < config.labels.size(); i++)
+  {
+    labels[i] = config.labels[i];
+  }
+
+  std::vector<EbsdLib::DoubleArrayType::Pointer> intensities = generateIntensities(config.imageDim);
+
+  // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
+  PoleFigureUtilities::FindIntensityRange({intensities[0].get(), intensities[1].get(), intensities[2].get()}, config);
+
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures(labels.size());
+  for(size_t i = 0; i < labels.size(); i++)
+  {
+    EbsdLib::UInt8ArrayType::Pointer image = EbsdLib::UInt8ArrayType::CreateUninitializedArray(static_cast<size_t>(config.imageDim * config.imageDim), {4}, labels[i]);
+    PoleFigureUtilities::CreateColorImage(intensities[i].get(), config, image.get());
+    size_t slot = (config.order.size() == 3) ? static_cast<size_t>(config.order[i]) : i;
+    poleFigures[slot] = image;
+  }
+  return poleFigures;
+}
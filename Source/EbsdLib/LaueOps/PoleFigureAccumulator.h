@@ -0,0 +1,163 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdArrayView.hpp"
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Utilities/ModifiedLambertProjection.h"
+#include "EbsdLib/Utilities/PoleFigureUtilities.h"
+
+/**
+ * @class PoleFigureAccumulator PoleFigureAccumulator.h EbsdLib/LaueOps/PoleFigureAccumulator.h
+ * @brief The PoleFigureAccumulator class keeps the raw Modified Lambert counts of the 3 pole figures of one Laue class
+ * so that orientations can be added and removed in batches. This suits live acquisition and interactive selections.
+ * Only the orientations of a batch are projected onto the sphere. The normalized squares are rebuilt the first time
+ * a pole figure is requested after a change. Adding orientations in several batches produces the same pole figures as
+ * LaueOps::generatePoleFigure() on all of them at once.
+ *
+ * The intensities always come from the Lambert squares. PoleFigureConfiguration_t::discrete therefore only changes
+ * the coloring of the images.
+ */
+class EbsdLib_EXPORT PoleFigureAccumulator
+{
+public:
+  using Self = PoleFigureAccumulator;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  /**
+   * @brief Creates an empty accumulator
+   * @param ops The Laue class whose pole figures are accumulated
+   * @param lambertDim The dimensions in voxels of the Lambert squares
+   */
+  static Pointer New(LaueOps::Pointer ops, int lambertDim);
+
+  /**
+   * @brief Returns the name of the class for PoleFigureAccumulator
+   */
+  std::string getNameOfClass() const;
+  /**
+   * @brief Returns the name of the class for PoleFigureAccumulator
+   */
+  static std::string ClassName();
+
+  ~PoleFigureAccumulator();
+
+  /**
+   * @brief Adds a batch of orientations to the pole figures
+   * @param eulers The Euler Angles (in Radians) of the orientations
+   */
+  void addOrientations(const EbsdArrayView<const float>& eulers);
+
+  /**
+   * @brief Removes a batch of orientations that was previously added. Removing orientations that were never added
+   * leaves the pole figures undefined. Removing more orientations than were added empties the accumulator.
+   * @param eulers The Euler Angles (in Radians) of the orientations
+   */
+  void removeOrientations(const EbsdArrayView<const float>& eulers);
+
+  /**
+   * @brief Removes every orientation
+   */
+  void clear();
+
+  /**
+   * @brief Returns the number of orientations currently accumulated
+   */
+  size_t getNumberOfOrientations() const;
+
+  /**
+   * @brief Returns the dimensions in voxels of the Lambert squares
+   */
+  int getLambertDimension() const;
+
+  /**
+   * @brief Returns the Laue class whose pole figures are accumulated
+   */
+  LaueOps::Pointer getLaueOps() const;
+
+  /**
+   * @brief Projects the normalized (MRD) Lambert squares into the stereographic intensity image of each pole figure.
+   * The images are all zeros when the accumulator is empty.
+   * @param imageDim The height/width of the intensity images
+   * @return The 3 intensity images in the order the Laue class generates them
+   */
+  std::vector<EbsdLib::DoubleArrayType::Pointer> generateIntensities(int imageDim);
+
+  /**
+   * @brief Generates the RGBA pole figures of the accumulated orientations the same way LaueOps::generatePoleFigure()
+   * does. The eulers, lambertDim and sphereRadius members of the configuration are not used.
+   * @param config The pole figure configuration. The minScale and maxScale members are updated.
+   */
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> generatePoleFigure(PoleFigureConfiguration_t& config);
+
+protected:
+  PoleFigureAccumulator(LaueOps::Pointer ops, int lambertDim);
+
+  /**
+   * @brief Adds the sphere coordinates of a batch of orientations to the raw counts with the given weight
+   */
+  void accumulate(const EbsdArrayView<const float>& eulers, double weight);
+
+  /**
+   * @brief Rebuilds the normalized squares from the raw counts if they changed since the last call
+   */
+  void updateNormalizedSquares();
+
+private:
+  LaueOps::Pointer m_LaueOps;
+  int m_LambertDimension = 0;
+  size_t m_NumOrientations = 0;
+  bool m_NormalizedValid = false;
+  std::array<ModifiedLambertProjection::Pointer, 3> m_Counts;
+  std::array<ModifiedLambertProjection::Pointer, 3> m_Normalized;
+
+public:
+  PoleFigureAccumulator(const PoleFigureAccumulator&) = delete;            // Copy Constructor Not Implemented
+  PoleFigureAccumulator(PoleFigureAccumulator&&) = delete;                 // Move Constructor Not Implemented
+  PoleFigureAccumulator& operator=(const PoleFigureAccumulator&) = delete; // Copy Assignment Not Implemented
+  PoleFigureAccumulator& operator=(PoleFigureAccumulator&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,274 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/LaueOps/LaueOps.h"
+
+/**
+ * @file QuatSymmetryKernels.hpp
+ * @brief Inline kernels shared by the batch quaternion methods of LaueOps and the feature based engines. They work on
+ * the symmetry operators of a Laue class stored in structure-of-arrays layout so that the loops over the operators
+ * vectorize, and they do not make any virtual call.
+ */
+namespace EbsdLib
+{
+namespace Detail
+{
+/**
+ * @brief Copies the quaternion symmetry operators of a Laue class into structure-of-arrays layout (all x, then all y,
+ * all z and all w) so the products with every operator are computed in loops that vectorize.
+ */
+inline std::vector<double> CreateQuatSymTable(const LaueOps& ops)
+{
+  const auto numSym = static_cast<size_t>(ops.getNumSymOps());
+  std::vector<double> symTable(numSym * 4);
+  for(size_t s = 0; s < numSym; s++)
+  {
+    QuatD sym = ops.getQuatSymOp(static_cast<int>(s));
+    symTable[s] = sym.x();
+    symTable[numSym + s] = sym.y();
+    symTable[2 * numSym + s] = sym.z();
+    symTable[3 * numSym + s] = sym.w();
+  }
+  return symTable;
+}
+
+/**
+ * @brief Maximum number of symmetry operators of any Laue class
+ */
+constexpr size_t k_MaxQuatSymOps = 24;
+
+/**
+ * @brief Finds the product sym * q over all symmetry operators that is nearest to ref, or nearest to the origin when
+ * ref is nullptr, and stores it with w made non-negative. The distances and the selection of the operator are the
+ * same as LaueOps::_calcNearestQuat() and LaueOps::_calcQuatNearestOrigin().
+ * @param sameHemisphere Instead of making w non-negative, measure the distance to ref regardless of the sign of the
+ * product and store the product on the same hemisphere as ref. This is what averaging needs, since members near
+ * w = 0 would otherwise be summed with opposite signs.
+ */
+inline void NearestSymmetricQuat(const double* symTable, size_t numSym, const double* ref, const double q[4], double out[4], bool sameHemisphere = false)
+{
+  const double* symX = symTable;
+  const double* symY = symTable + numSym;
+  const double* symZ = symTable + 2 * numSym;
+  const double* symW = symTable + 3 * numSym;
+  double dist[k_MaxQuatSymOps];
+  if(ref == nullptr)
+  {
+    for(size_t s = 0; s < numSym; s++)
+    {
+      double w = q[3] * symW[s] - q[0] * symX[s] - q[1] * symY[s] - q[2] * symZ[s];
+      dist[s] = 1.0 - w * w;
+    }
+  }
+  else
+  {
+    for(size_t s = 0; s < numSym; s++)
+    {
+      double x = q[0] * symW[s] + q[3] * symX[s] + q[2] * symY[s] - q[1] * symZ[s];
+      double y = q[1] * symW[s] + q[3] * symY[s] + q[0] * symZ[s] - q[2] * symX[s];
+      double z = q[2] * symW[s] + q[3] * symZ[s] + q[1] * symX[s] - q[0] * symY[s];
+      double w = q[3] * symW[s] - q[0] * symX[s] - q[1] * symY[s] - q[2] * symZ[s];
+      double dot = w * ref[3] + x * ref[0] + y * ref[1] + z * ref[2];
+      if(sameHemisphere)
+      {
+        dist[s] = 1.0 - std::fabs(dot);
+      }
+      else
+      {
+        dist[s] = 1.0 - (w < 0.0 ? -dot : dot);
+      }
+    }
+  }
+
+  size_t best = 0;
+  double smallestDist = 1000000.0;
+  for(size_t s = 0; s < numSym; s++)
+  {
+    best = dist[s] < smallestDist ? s : best;
+    smallestDist = dist[s] < smallestDist ? dist[s] : smallestDist;
+  }
+  out[0] = q[0] * symW[best] + q[3] * symX[best] + q[2] * symY[best] - q[1] * symZ[best];
+  out[1] = q[1] * symW[best] + q[3] * symY[best] + q[0] * symZ[best] - q[2] * symX[best];
+  out[2] = q[2] * symW[best] + q[3] * symZ[best] + q[1] * symX[best] - q[0] * symY[best];
+  out[3] = q[3] * symW[best] - q[0] * symX[best] - q[1] * symY[best] - q[2] * symZ[best];
+  bool flip = out[3] < 0.0;
+  if(sameHemisphere && ref != nullptr)
+  {
+    flip = (out[0] * ref[0] + out[1] * ref[1] + out[2] * ref[2] + out[3] * ref[3]) < 0.0;
+  }
+  if(flip)
+  {
+    for(size_t c = 0; c < 4; c++)
+    {
+      out[c] = -out[c];
+    }
+  }
+}
+
+/**
+ * @brief Stores the product of every symmetry operator with q in structure-of-arrays layout, conj(sym) * q when
+ * conjugateSym is true and sym * q otherwise. The dot product of p with conj(sym) * ref is the dot product of sym * p
+ * with ref, and the dot product of p with sym * mean is the w component of the misorientation sym * mean * conj(p).
+ * With the table built once per reference quaternion, the search over the operators for any other quaternion takes a
+ * single 4 component dot product per operator.
+ */
+inline void CreateSymmetricTable(const double* symTable, size_t numSym, const double q[4], bool conjugateSym, double* table)
+{
+  const double sign = conjugateSym ? -1.0 : 1.0;
+  for(size_t s = 0; s < numSym; s++)
+  {
+    QuatD sym(sign * symTable[s], sign * symTable[numSym + s], sign * symTable[2 * numSym + s], symTable[3 * numSym + s]);
+    QuatD product = sym * QuatD(q[0], q[1], q[2], q[3]);
+    table[s] = product.x();
+    table[numSym + s] = product.y();
+    table[2 * numSym + s] = product.z();
+    table[3 * numSym + s] = product.w();
+  }
+}
+
+/**
+ * @brief Returns the index of the entry of a table from CreateSymmetricTable() whose dot product with q has the largest
+ * magnitude, and stores that dot product
+ */
+inline size_t LargestAbsDot(const double* table, size_t numSym, const double q[4], double& dot)
+{
+  const double* tableX = table;
+  const double* tableY = table + numSym;
+  const double* tableZ = table + 2 * numSym;
+  const double* tableW = table + 3 * numSym;
+  double dots[k_MaxQuatSymOps] = {};
+  for(size_t s = 0; s < numSym; s++)
+  {
+    dots[s] = q[0] * tableX[s] + q[1] * tableY[s] + q[2] * tableZ[s] + q[3] * tableW[s];
+  }
+  // Branch free selection, the winning operator is not predictable
+  size_t best = 0;
+  double bestDot = dots[0];
+  double bestAbs = std::fabs(bestDot);
+  for(size_t s = 1; s < numSym; s++)
+  {
+    const double value = std::fabs(dots[s]);
+    const bool larger = value > bestAbs;
+    best = larger ? s : best;
+    bestDot = larger ? dots[s] : bestDot;
+    bestAbs = larger ? value : bestAbs;
+  }
+  dot = bestDot;
+  return best;
+}
+
+/**
+ * @brief Averages the quaternions quats[indices[i]] after moving each one to the symmetrically equivalent quaternion
+ * nearest to ref, on the same hemisphere as ref. The quaternions are summed in the order of indices. The average is
+ * set to ref when the sum vanishes.
+ */
+inline void AverageNearestQuats(const double* symTable, size_t numSym, const float* quats, const size_t* indices, size_t count, const double ref[4], double avg[4])
+{
+  double refTable[k_MaxQuatSymOps * 4];
+  CreateSymmetricTable(symTable, numSym, ref, true, refTable);
+
+  double q[4];
+  double dot = 0.0;
+  double sum[4] = {0.0, 0.0, 0.0, 0.0};
+  for(size_t i = 0; i < count; i++)
+  {
+    for(size_t c = 0; c < 4; c++)
+    {
+      q[c] = quats[indices[i] * 4 + c];
+    }
+    size_t best = LargestAbsDot(refTable, numSym, q, dot);
+    QuatD sym(symTable[best], symTable[numSym + best], symTable[2 * numSym + best], symTable[3 * numSym + best]);
+    QuatD nearest = sym * QuatD(q[0], q[1], q[2], q[3]);
+    const double sign = dot < 0.0 ? -1.0 : 1.0;
+    sum[0] += sign * nearest.x();
+    sum[1] += sign * nearest.y();
+    sum[2] += sign * nearest.z();
+    sum[3] += sign * nearest.w();
+  }
+  double norm = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2] + sum[3] * sum[3]);
+  for(size_t c = 0; c < 4; c++)
+  {
+    avg[c] = norm > 0.0 ? sum[c] / norm : ref[c];
+  }
+}
+
+/**
+ * @brief Returns the misorientation angle (in radians) between the quaternion a table was built from with
+ * CreateSymmetricTable(..., false, ...) and q. This is the same angle as LaueOps::calculateMisorientation(). The angle
+ * is computed with atan2 instead of acos so that small misorientations do not lose precision.
+ */
+inline double MisorientationAngle(const double* table, size_t numSym, const double q[4])
+{
+  double dot = 0.0;
+  size_t best = LargestAbsDot(table, numSym, q, dot);
+  QuatD qMin = QuatD(table[best], table[numSym + best], table[2 * numSym + best], table[3 * numSym + best]) * QuatD(q[0], q[1], q[2], q[3]).conjugate();
+  double vMag = std::sqrt(qMin.x() * qMin.x() + qMin.y() * qMin.y() + qMin.z() * qMin.z());
+  return 2.0 * std::atan2(vMag, std::fabs(dot));
+}
+
+/**
+ * @brief Returns true if the misorientation between p and q is no more than the angle whose half angle cosine is
+ * cosHalfAngle. This is the comparison of LaueOps::calculateMisorientation() with the angle, without any
+ * trigonometric call and without expanding the symmetric equivalents of p. The dot product of sym * p with q is the
+ * dot product of sym with q * conj(p), so the operators are scanned against that single product and the scan stops at
+ * the first one within the angle, which is the identity for most neighbors inside a grain. The quaternions do not have
+ * to be normalized.
+ */
+inline bool IsMisorientationWithin(const double* symTable, size_t numSym, const double p[4], const double q[4], double cosHalfAngle)
+{
+  // d = q * conj(p)
+  const double dx = -q[3] * p[0] + q[0] * p[3] - q[1] * p[2] + q[2] * p[1];
+  const double dy = -q[3] * p[1] + q[1] * p[3] - q[2] * p[0] + q[0] * p[2];
+  const double dz = -q[3] * p[2] + q[2] * p[3] - q[0] * p[1] + q[1] * p[0];
+  const double dw = q[3] * p[3] + q[0] * p[0] + q[1] * p[1] + q[2] * p[2];
+  const double limit = cosHalfAngle * cosHalfAngle * (dx * dx + dy * dy + dz * dz + dw * dw);
+  for(size_t s = 0; s < numSym; s++)
+  {
+    const double dot = symTable[s] * dx + symTable[numSym + s] * dy + symTable[2 * numSym + s] * dz + symTable[3 * numSym + s] * dw;
+    if(dot * dot >= limit)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace Detail
+} // namespace EbsdLib
@@ -0,0 +1,156 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "DiscreteSampler.h"
+
+#include <algorithm>
+
+// -----------------------------------------------------------------------------
+DiscreteSampler::DiscreteSampler() = default;
+
+// -----------------------------------------------------------------------------
+DiscreteSampler::~DiscreteSampler() = default;
+
+// -----------------------------------------------------------------------------
+void DiscreteSampler::initialize(std::vector<double>& weights)
+{
+  const size_t numBins = weights.size();
+  m_TotalWeight = 0.0;
+  for(double& weight : weights)
+  {
+    if(!(weight > 0.0))
+    {
+      weight = 0.0;
+    }
+    m_TotalWeight += weight;
+  }
+
+  m_Threshold.assign(numBins, 1.0);
+  m_Alias.resize(numBins);
+  m_Probability.assign(numBins, 0.0);
+  for(size_t i = 0; i < numBins; i++)
+  {
+    m_Alias[i] = static_cast<uint32_t>(i);
+  }
+  if(numBins == 0)
+  {
+    return;
+  }
+  if(m_TotalWeight <= 0.0)
+  {
+    // Every column falls through to its alias, which is bin 0
+    std::fill(m_Threshold.begin(), m_Threshold.end(), 0.0);
+    std::fill(m_Alias.begin(), m_Alias.end(), 0);
+    return;
+  }
+
+  // Vose's method: scale the probabilities so the average column holds 1.0, then repeatedly top up a column that
+  // holds less than 1.0 with the excess of a column that holds more.
+  std::vector<double> scaled(numBins);
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  small.reserve(numBins);
+  large.reserve(numBins);
+  const double scale = static_cast<double>(numBins) / m_TotalWeight;
+  for(size_t i = 0; i < numBins; i++)
+  {
+    m_Probability[i] = weights[i] / m_TotalWeight;
+    scaled[i] = weights[i] * scale;
+    if(scaled[i] < 1.0)
+    {
+      small.push_back(static_cast<uint32_t>(i));
+    }
+    else
+    {
+      large.push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  while(!small.empty() && !large.empty())
+  {
+    const uint32_t less = small.back();
+    small.pop_back();
+    const uint32_t more = large.back();
+    m_Threshold[less] = scaled[less];
+    m_Alias[less] = more;
+    scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+    if(scaled[more] < 1.0)
+    {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+  // Whatever is left over only differs from 1.0 by round off
+  for(uint32_t bin : large)
+  {
+    m_Threshold[bin] = 1.0;
+  }
+  for(uint32_t bin : small)
+  {
+    m_Threshold[bin] = 1.0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t DiscreteSampler::size() const
+{
+  return m_Threshold.size();
+}
+
+// -----------------------------------------------------------------------------
+double DiscreteSampler::getTotalWeight() const
+{
+  return m_TotalWeight;
+}
+
+// -----------------------------------------------------------------------------
+double DiscreteSampler::getProbability(size_t bin) const
+{
+  return m_Probability[bin];
+}
+
+// -----------------------------------------------------------------------------
+size_t DiscreteSampler::sample(double random) const
+{
+  const size_t numBins = m_Threshold.size();
+  if(numBins == 0)
+  {
+    return 0;
+  }
+  const double scaled = random * static_cast<double>(numBins);
+  const size_t column = std::min(static_cast<size_t>(scaled), numBins - 1);
+  const double fraction = scaled - static_cast<double>(column);
+  return (fraction < m_Threshold[column]) ? column : m_Alias[column];
+}
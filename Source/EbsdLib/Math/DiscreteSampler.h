@@ -0,0 +1,133 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @brief The DiscreteSampler class draws bin indices from a discrete distribution, for example an ODF, in constant
+ * time per draw. It builds a Walker/Vose alias table once from the bin weights. The weights do not have to be
+ * normalized. If every weight is zero (or there are no bins) every draw returns bin 0.
+ *
+ * The sampler is immutable after construction so a single instance can be shared by any number of threads as long
+ * as each thread uses its own random number generator.
+ */
+class EbsdLib_EXPORT DiscreteSampler
+{
+public:
+  DiscreteSampler();
+
+  /**
+   * @brief Builds the alias table from a std::vector like container of weights
+   * @param weights The (unnormalized) weight of each bin. Negative weights are treated as zero.
+   */
+  template <typename Container>
+  explicit DiscreteSampler(const Container& weights)
+  : DiscreteSampler(weights, weights.size())
+  {
+  }
+
+  /**
+   * @brief Builds the alias table from the first count weights of a container or array
+   * @param weights The (unnormalized) weight of each bin. Negative weights are treated as zero.
+   * @param count The number of bins
+   */
+  template <typename Container>
+  DiscreteSampler(const Container& weights, size_t count)
+  {
+    std::vector<double> values(count);
+    for(size_t i = 0; i < count; i++)
+    {
+      values[i] = static_cast<double>(weights[i]);
+    }
+    initialize(values);
+  }
+
+  virtual ~DiscreteSampler();
+
+  DiscreteSampler(const DiscreteSampler&) = default;
+  DiscreteSampler(DiscreteSampler&&) noexcept = default;
+  DiscreteSampler& operator=(const DiscreteSampler&) = default;
+  DiscreteSampler& operator=(DiscreteSampler&&) noexcept = default;
+
+  /**
+   * @brief Returns the number of bins
+   */
+  size_t size() const;
+
+  /**
+   * @brief Returns the sum of the (clamped) weights the table was built from
+   */
+  double getTotalWeight() const;
+
+  /**
+   * @brief Returns the probability of drawing the given bin
+   * @param bin
+   */
+  double getProbability(size_t bin) const;
+
+  /**
+   * @brief Maps one uniform random value onto a bin. The integer part of random * size() picks a column of the
+   * alias table and the fractional part decides between that column and its alias.
+   * @param random A uniform random value in [0, 1)
+   * @return The bin index
+   */
+  size_t sample(double random) const;
+
+  /**
+   * @brief Draws a bin using the given random number generator
+   * @param generator A standard library random number engine
+   * @return The bin index
+   */
+  template <class Generator>
+  size_t operator()(Generator& generator) const
+  {
+    return sample(std::generate_canonical<double, 53>(generator));
+  }
+
+private:
+  std::vector<double> m_Threshold;
+  std::vector<uint32_t> m_Alias;
+  std::vector<double> m_Probability;
+  double m_TotalWeight = 0.0;
+
+  void initialize(std::vector<double>& weights);
+};
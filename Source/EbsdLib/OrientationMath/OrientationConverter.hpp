@@ -35,13 +35,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
 
 #include <string>
 
+#include "EbsdLib/Core/EbsdArrayView.hpp"
 #include "EbsdLib/Core/EbsdSetGetMacros.h"
+#include "EbsdLib/Core/FusedOrientationTransformation.hpp"
 #include "EbsdLib/Core/Orientation.hpp"
 #include "EbsdLib/Core/OrientationRepresentation.h"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
@@ -189,12 +192,56 @@ public:
   void setInputData(DataArrayPointerType& input)
   {
     m_InputData = input;
+    m_InputView = EbsdArrayView<T>();
   }
   DataArrayPointerType getInputData() const
   {
     return m_InputData;
   }
 
+  /**
+   * @brief Uses orientations that live in memory owned by someone else as the input, for example a range of tuples
+   * or a subset of the components of a larger array. Views whose components are adjacent in memory are used in
+   * place (the tuple stride may be anything). Planar or otherwise component strided views are gathered into an
+   * internal interleaved array first because the conversion functors read each tuple as one contiguous block.
+   *
+   * Like the array input, the sanity checks may modify the viewed values in place.
+   * @param input The view of the input orientations
+   */
+  void setInputView(const EbsdArrayView<T>& input)
+  {
+    if(input.isComponentContiguous())
+    {
+      m_InputData = DataArrayPointerType();
+      m_InputView = input;
+      return;
+    }
+    const size_t numTuples = input.getNumberOfTuples();
+    const size_t numComps = input.getNumberOfComponents();
+    std::vector<size_t> cDims = {numComps};
+    DataArrayPointerType gathered = DataArrayType::CreateArray(numTuples, cDims, "Input Orientations", true);
+    T* ptr = gathered->getPointer(0);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      input.getTuple(i, ptr + i * numComps);
+    }
+    m_InputData = gathered;
+    m_InputView = EbsdArrayView<T>();
+  }
+
+  /**
+   * @brief Returns the input orientations as a view. If the input was given as an array this is a view of
+   * that whole array.
+   */
+  EbsdArrayView<T> getInputView() const
+  {
+    if(nullptr != m_InputView.data() || nullptr == m_InputData)
+    {
+      return m_InputView;
+    }
+    return EbsdArrayView<T>::FromArray(*m_InputData);
+  }
+
   /**
    * @brief Sets/Gets the output orientations
    */
@@ -281,6 +328,28 @@ public:
 protected:
   OrientationConverter() = default;
 
+  /**
+   * @brief Creates a densely packed copy of the input orientations. This is used by the conversions from a
+   * representation to itself.
+   */
+  DataArrayPointerType copyInputData() const
+  {
+    if(nullptr == m_InputView.data())
+    {
+      return std::dynamic_pointer_cast<DataArrayType>(m_InputData->deepCopy());
+    }
+    const size_t numTuples = m_InputView.getNumberOfTuples();
+    const size_t numComps = m_InputView.getNumberOfComponents();
+    std::vector<size_t> cDims = {numComps};
+    DataArrayPointerType output = DataArrayType::CreateArray(numTuples, cDims, "Input Orientations", true);
+    T* outPtr = output->getPointer(0);
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      std::copy_n(m_InputView.getTuplePointer(i), numComps, outPtr + i * numComps);
+    }
+    return output;
+  }
+
 public:
   OrientationConverter(const OrientationConverter&) = delete;            // Copy Constructor Not Implemented
   OrientationConverter(OrientationConverter&&) = delete;                 // Move Constructor Not Implemented
@@ -289,26 +358,28 @@ public:
 
 private:
   DataArrayPointerType m_InputData;
+  EbsdArrayView<T> m_InputView;
   DataArrayPointerType m_OutputData;
 };
 
 /**
  * @brief This macro is used to create a functor that wraps a paricular conversion
- * method with a functor class so it can be passed to the parallel algorithms
+ * method with a functor class so it can be passed to the parallel algorithms. The conversion
+ * is done with OrientationTransformation::LocalOrientation as the input, output and intermediate
+ * types so that multi step conversions run without any heap allocations.
  */
 
 #define OC_CONVERTOR_FUNCTOR(CLASSNAME, INSTRIDE, OUTSTRIDE, CONVERSION_METHOD)                                                                                                                        \
-  template <typename InputType>                                                                                                                                                                        \
+  template <typename NumericType>                                                                                                                                                                      \
   class CLASSNAME                                                                                                                                                                                      \
   {                                                                                                                                                                                                    \
   public:                                                                                                                                                                                              \
     CLASSNAME() = default;                                                                                                                                                                             \
-    void operator()(InputType* input, InputType* output)                                                                                                                                               \
+    void operator()(NumericType* input, NumericType* output)                                                                                                                                           \
     {                                                                                                                                                                                                  \
-      using OrientationInputType = Orientation<InputType>;                                                                                                                                             \
-      OrientationInputType inputOrientation(input, INSTRIDE);                                                                                                                                          \
-      OrientationInputType outputOrientation(output, OUTSTRIDE);                                                                                                                                       \
-      outputOrientation = OrientationTransformation::CONVERSION_METHOD<OrientationInputType, OrientationInputType>(inputOrientation);                                                                  \
+      using LocalType = OrientationTransformation::LocalOrientation<NumericType>;                                                                                                                      \
+      LocalType inputOrientation(input, INSTRIDE);                                                                                                                                                     \
+      OrientationTransformation::CONVERSION_METHOD<LocalType, LocalType>(inputOrientation).copyInto(output);                                                                                           \
     }                                                                                                                                                                                                  \
   };
 
@@ -320,10 +391,9 @@ private:
     CLASSNAME() = default;                                                                                                                                                                             \
     void operator()(NumericType* input, NumericType* output)                                                                                                                                           \
     {                                                                                                                                                                                                  \
-      using InputType = Orientation<NumericType>;                                                                                                                                                      \
-      using OutputType = Quaternion<NumericType>;                                                                                                                                                      \
-      InputType inputOrientation(input, INSTRIDE);                                                                                                                                                     \
-      OrientationTransformation::CONVERSION_METHOD<InputType, OutputType>(inputOrientation).copyInto(output, Quaternion<NumericType>::Order::VectorScalar);                                            \
+      using LocalType = OrientationTransformation::LocalOrientation<NumericType>;                                                                                                                      \
+      LocalType inputOrientation(input, INSTRIDE);                                                                                                                                                     \
+      OrientationTransformation::CONVERSION_METHOD<LocalType, LocalType>(inputOrientation).copyInto(output);                                                                                           \
     }                                                                                                                                                                                                  \
   };
 
@@ -335,11 +405,9 @@ private:
     CLASSNAME() = default;                                                                                                                                                                             \
     void operator()(NumericType* input, NumericType* output)                                                                                                                                           \
     {                                                                                                                                                                                                  \
-      using QuaternionType = Quaternion<NumericType>;                                                                                                                                                  \
-      using OutputType = Orientation<NumericType>;                                                                                                                                                     \
-      QuaternionType inputQuat(input[0], input[1], input[2], input[3]);                                                                                                                                \
-      OutputType outputOrientation = OrientationTransformation::CONVERSION_METHOD<QuaternionType, OutputType>(inputQuat);                                                                              \
-      outputOrientation.copyInto(output, OUTSTRIDE);                                                                                                                                                   \
+      using LocalType = OrientationTransformation::LocalOrientation<NumericType>;                                                                                                                      \
+      LocalType inputOrientation(input, INSTRIDE);                                                                                                                                                     \
+      OrientationTransformation::CONVERSION_METHOD<LocalType, LocalType>(inputOrientation).copyInto(output);                                                                                           \
     }                                                                                                                                                                                                  \
   };
 
@@ -464,10 +532,10 @@ private:
 
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)                                                                                                                         \
   sanityCheckInputData();                                                                                                                                                                              \
-  DataArrayPointerType input = this->getInputData();                                                                                                                                                   \
-  T* inPtr = input->getPointer(0);                                                                                                                                                                     \
-  size_t nTuples = this->getInputData()->getNumberOfTuples();                                                                                                                                          \
-  int inStride = input->getNumberOfComponents();                                                                                                                                                       \
+  EbsdArrayView<T> input = this->getInputView();                                                                                                                                                       \
+  T* inPtr = input.data();                                                                                                                                                                             \
+  size_t nTuples = input.getNumberOfTuples();                                                                                                                                                          \
+  size_t inStride = input.getTupleStride();                                                                                                                                                            \
   size_t outStride = OUTSTRIDE;                                                                                                                                                                        \
   std::vector<size_t> cDims = {outStride};                                                                                                                                                             \
   DataArrayPointerType output = DataArrayType::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME, true);                                                                                                     \
@@ -480,10 +548,10 @@ private:
 
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)                                                                                                                         \
   sanityCheckInputData();                                                                                                                                                                              \
-  DataArrayPointerType input = this->getInputData();                                                                                                                                                   \
-  T* inPtr = input->getPointer(0);                                                                                                                                                                     \
-  size_t nTuples = this->getInputData()->getNumberOfTuples();                                                                                                                                          \
-  int inStride = input->getNumberOfComponents();                                                                                                                                                       \
+  EbsdArrayView<T> input = this->getInputView();                                                                                                                                                       \
+  T* inPtr = input.data();                                                                                                                                                                             \
+  size_t nTuples = input.getNumberOfTuples();                                                                                                                                                          \
+  size_t inStride = input.getTupleStride();                                                                                                                                                            \
   size_t outStride = OUTSTRIDE;                                                                                                                                                                        \
   std::vector<size_t> cDims = {outStride}; /* Create the n component (nx1) based array.*/                                                                                                              \
   DataArrayPointerType output = DataArrayType::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME, true);                                                                                                     \
@@ -567,8 +635,7 @@ public:
 
   void toEulers() override
   {
-    DataArrayPointerType input = this->getInputData();
-    DataArrayPointerType output = std::dynamic_pointer_cast<DataArrayType>(input->deepCopy());
+    DataArrayPointerType output = this->copyInputData();
     this->setOutputData(output);
   }
 
@@ -604,10 +671,10 @@ public:
 
   void sanityCheckInputData() override
   {
-    DataArrayPointerType input = this->getInputData();
-    T* inPtr = input->getPointer(0);
-    size_t nTuples = input->getNumberOfTuples();
-    int inStride = input->getNumberOfComponents();
+    EbsdArrayView<T> input = this->getInputView();
+    T* inPtr = input.data();
+    size_t nTuples = input.getNumberOfTuples();
+    size_t inStride = input.getTupleStride();
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
     bool doParallel = true;
@@ -758,8 +825,7 @@ public:
 
   void toOrientationMatrix() override
   {
-    DataArrayPointerType input = this->getInputData();
-    DataArrayPointerType output = std::dynamic_pointer_cast<DataArrayType>(input->deepCopy());
+    DataArrayPointerType output = this->copyInputData();
     this->setOutputData(output);
   }
 
@@ -795,10 +861,10 @@ public:
 
   void sanityCheckInputData() override
   {
-    DataArrayPointerType input = this->getInputData();
-    T* inPtr = input->getPointer(0);
-    size_t nTuples = input->getNumberOfTuples();
-    int inStride = input->getNumberOfComponents();
+    EbsdArrayView<T> input = this->getInputView();
+    T* inPtr = input.data();
+    size_t nTuples = input.getNumberOfTuples();
+    size_t inStride = input.getTupleStride();
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
     bool doParallel = true;
@@ -928,9 +994,7 @@ public:
 
   void toQuaternion() override
   {
-    using PointerType = DataArrayPointerType;
-    PointerType input = this->getInputData();
-    PointerType output = std::dynamic_pointer_cast<DataArrayType>(input->deepCopy());
+    DataArrayPointerType output = this->copyInputData();
     this->setOutputData(output);
   }
 
@@ -961,10 +1025,10 @@ public:
      * go
      */
 #if 0
-      DataArrayPointerType input = this->getInputData();
-      T* inPtr = input->getPointer(0);
-      size_t nTuples = input->getNumberOfTuples();
-      int inStride = input->getNumberOfComponents();
+      EbsdArrayView<T> input = this->getInputView();
+      T* inPtr = input.data();
+      size_t nTuples = input.getNumberOfTuples();
+      size_t inStride = input.getTupleStride();
 
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
         tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), QuaternionSanityCheck<T>(inPtr, inStride), tbb::auto_partitioner());
@@ -1091,9 +1155,7 @@ public:
 
   void toAxisAngle() override
   {
-    using PointerType = DataArrayPointerType;
-    PointerType input = this->getInputData();
-    PointerType output = std::dynamic_pointer_cast<DataArrayType>(input->deepCopy());
+    DataArrayPointerType output = this->copyInputData();
     this->setOutputData(output);
   }
 
@@ -1119,10 +1181,10 @@ public:
      * go
      */
 #if 0
-      DataArrayPointerType input = this->getInputData();
-      T* inPtr = input->getPointer(0);
-      size_t nTuples = input->getNumberOfTuples();
-      int inStride = input->getNumberOfComponents();
+      EbsdArrayView<T> input = this->getInputView();
+      T* inPtr = input.data();
+      size_t nTuples = input.getNumberOfTuples();
+      size_t inStride = input.getTupleStride();
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
       tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), AxisAngleSanityCheck<T>(inPtr, inStride), tbb::auto_partitioner());
 #else
@@ -1255,9 +1317,7 @@ public:
 
   void toRodrigues() override
   {
-    using PointerType = DataArrayPointerType;
-    PointerType input = this->getInputData();
-    PointerType output = std::dynamic_pointer_cast<DataArrayType>(input->deepCopy());
+    DataArrayPointerType output = this->copyInputData();
     this->setOutputData(output);
   }
 
@@ -1278,10 +1338,10 @@ public:
      * go
      */
 #if 0
-      DataArrayPointerType input = this->getInputData();
-      T* inPtr = input->getPointer(0);
-      size_t nTuples = input->getNumberOfTuples();
-      int inStride = input->getNumberOfComponents();
+      EbsdArrayView<T> input = this->getInputView();
+      T* inPtr = input.data();
+      size_t nTuples = input.getNumberOfTuples();
+      size_t inStride = input.getTupleStride();
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
         tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), RodriguesSanityCheck<DataArrayType>(inPtr, inStride), tbb::auto_partitioner());
 #else
@@ -1419,9 +1479,7 @@ public:
 
   void toHomochoric() override
   {
-    using PointerType = DataArrayPointerType;
-    PointerType input = this->getInputData();
-    PointerType output = std::dynamic_pointer_cast<DataArrayType>(input->deepCopy());
+    DataArrayPointerType output = this->copyInputData();
     this->setOutputData(output);
   }
 
@@ -1437,10 +1495,10 @@ public:
      * go
      */
 #if 0
-      DataArrayPointerType input = this->getInputData();
-      T* inPtr = input->getPointer(0);
-      size_t nTuples = input->getNumberOfTuples();
-      int inStride = input->getNumberOfComponents();
+      EbsdArrayView<T> input = this->getInputView();
+      T* inPtr = input.data();
+      size_t nTuples = input.getNumberOfTuples();
+      size_t inStride = input.getTupleStride();
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
       tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), HomochoricSanityCheck<T>(inPtr, inStride), tbb::auto_partitioner());
       }
@@ -1584,9 +1642,7 @@ public:
 
   void toCubochoric() override
   {
-    using PointerType = DataArrayPointerType;
-    PointerType input = this->getInputData();
-    PointerType output = std::dynamic_pointer_cast<DataArrayType>(input->deepCopy());
+    DataArrayPointerType output = this->copyInputData();
     this->setOutputData(output);
   }
 
@@ -1597,10 +1653,10 @@ public:
      * go
      */
 #if 0
-      DataArrayPointerType input = this->getInputData();
-      T* inPtr = input->getPointer(0);
-      size_t nTuples = input->getNumberOfTuples();
-      int inStride = input->getNumberOfComponents();
+      EbsdArrayView<T> input = this->getInputView();
+      T* inPtr = input.data();
+      size_t nTuples = input.getNumberOfTuples();
+      size_t inStride = input.getTupleStride();
 #ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
       tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples), CubochoricSanityCheck<T>(inPtr, inStride), tbb::auto_partitioner());
 #else
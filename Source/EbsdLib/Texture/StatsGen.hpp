@@ -39,16 +39,88 @@
 #define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
 #endif
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <random>
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/EbsdLib.h"
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/Math/DiscreteSampler.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/EbsdLibRandom.h"
 #include "EbsdLib/Texture/Texture.hpp"
 
+namespace Detail
+{
+/**
+ * @brief The GenODFEulersImpl class fills the Euler angles of a range of fixed size blocks of points. Every block
+ * seeds its own generator from the base seed and the block index so the angles do not depend on how the blocks
+ * are scheduled across threads.
+ */
+template <typename T, class LaueOpsType>
+class GenODFEulersImpl
+{
+public:
+  static constexpr size_t k_BlockSize = 4096;
+
+  GenODFEulersImpl(const DiscreteSampler& sampler, T* eulers, size_t npoints, uint64_t seed)
+  : m_Sampler(sampler)
+  , m_Eulers(eulers)
+  , m_NumPoints(npoints)
+  , m_Seed(seed)
+  {
+  }
+  virtual ~GenODFEulersImpl() = default;
+
+  void generate(size_t startBlock, size_t endBlock) const
+  {
+    LaueOpsType ops;
+    std::uniform_real_distribution<> distribution(0.0, 1.0);
+    std::array<double, 3> randx3 = {0.0, 0.0, 0.0};
+    for(size_t block = startBlock; block < endBlock; block++)
+    {
+      std::seed_seq seedSequence = {static_cast<uint32_t>(m_Seed), static_cast<uint32_t>(m_Seed >> 32), static_cast<uint32_t>(block), static_cast<uint32_t>(static_cast<uint64_t>(block) >> 32)};
+      std::mt19937_64 generator(seedSequence);
+      const size_t start = block * k_BlockSize;
+      const size_t end = std::min(start + k_BlockSize, m_NumPoints);
+      for(size_t i = start; i < end; i++)
+      {
+        const int choose = static_cast<int>(m_Sampler.sample(distribution(generator)));
+        randx3[0] = distribution(generator);
+        randx3[1] = distribution(generator);
+        randx3[2] = distribution(generator);
+        OrientationD eu = ops.determineEulerAngles(randx3.data(), choose);
+        m_Eulers[3 * i + 0] = static_cast<T>(eu[0]);
+        m_Eulers[3 * i + 1] = static_cast<T>(eu[1]);
+        m_Eulers[3 * i + 2] = static_cast<T>(eu[2]);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const DiscreteSampler& m_Sampler;
+  T* m_Eulers;
+  size_t m_NumPoints;
+  uint64_t m_Seed;
+};
+} // namespace Detail
+
 /**
  * @brief This class contains static functions to generate ODF and MDF data as X,Y points. This data can be discretized
  * onto a regular grid which would result in standard ODF Pole Figures and a regular 2D MDF plot.
@@ -244,45 +316,33 @@ public:
   template <typename T, class LaueOpsType, class ContainerType>
   static int GenODFPlotData(const ContainerType& odf, T* eulers, size_t npoints)
   {
-    std::random_device randomDevice;           // Will be used to obtain a seed for the random number engine
-    std::mt19937_64 generator(randomDevice()); // Standard mersenne_twister_engine seeded with rd()
     std::mt19937_64::result_type seed = static_cast<std::mt19937_64::result_type>(std::chrono::steady_clock::now().time_since_epoch().count());
-    generator.seed(seed);
-    std::uniform_real_distribution<> distribution(0.0, 1.0);
-    std::array<double, 3> randx3;
-
-    int err = 0;
-    int choose = 0;
-    T totaldensity;
-    T random, density;
-
     LaueOpsType ops;
-    T td1;
-    for(size_t i = 0; i < npoints; i++)
-    {
-      random = distribution(generator);
-      choose = 0;
-      totaldensity = 0;
-      for(int j = 0; j < ops.getODFSize(); j++)
-      {
-        density = odf[j];
-        td1 = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random < totaldensity && random >= td1)
-        {
-          choose = static_cast<int>(j);
-          break;
-        }
-      }
-      randx3[0] = distribution(generator);
-      randx3[1] = distribution(generator);
-      randx3[2] = distribution(generator);
-      OrientationD eu = ops.determineEulerAngles(randx3.data(), choose);
-      eulers[3 * i + 0] = eu[0];
-      eulers[3 * i + 1] = eu[1];
-      eulers[3 * i + 2] = eu[2];
-    }
-    return err;
+    DiscreteSampler sampler(odf, std::min(odf.size(), static_cast<size_t>(ops.getODFSize())));
+    return GenODFPlotData<T, LaueOpsType>(sampler, eulers, npoints, seed);
+  }
+
+  /**
+   * @brief Generates Euler angles distributed according to an ODF whose alias table has already been built. The
+   * same sampler can be reused for any number of calls. The points are generated in parallel blocks and the
+   * result only depends on the seed.
+   * @param sampler The sampler built from the ODF bin data of the LaueOpsType
+   * @param eulers Euler angles to be generated. This memory must already be preallocated.
+   * @param npoints The number of Euler angles to generate
+   * @param seed The seed for the random number generators
+   */
+  template <typename T, class LaueOpsType>
+  static int GenODFPlotData(const DiscreteSampler& sampler, T* eulers, size_t npoints, uint64_t seed)
+  {
+    using ImplType = Detail::GenODFEulersImpl<T, LaueOpsType>;
+    const size_t numBlocks = (npoints + ImplType::k_BlockSize - 1) / ImplType::k_BlockSize;
+    ImplType impl(sampler, eulers, npoints, seed);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), impl, tbb::auto_partitioner());
+#else
+    impl.generate(0, numBlocks);
+#endif
+    return 0;
   }
 #if 0
 
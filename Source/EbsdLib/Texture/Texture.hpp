@@ -51,6 +51,7 @@
 #include "EbsdLib/LaueOps/HexagonalOps.h"
 #include "EbsdLib/LaueOps/LaueOps.h"
 #include "EbsdLib/LaueOps/OrthoRhombicOps.h"
+#include "EbsdLib/Math/DiscreteSampler.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/EbsdLibRandom.h"
 
@@ -232,8 +233,9 @@ public:
 
     int mbin;
     int choose1, choose2;
-    float totaldensity;
-    float random1, random2, density;
+
+    // Build the alias table once so each ODF draw is constant time instead of a scan over every bin
+    DiscreteSampler odfSampler(odf, odfsize);
 
     for(int i = 0; i < mdfsize; i++)
     {
@@ -254,25 +256,8 @@ public:
 
     for(int i = 0; i < remainingcount; i++)
     {
-      random1 = static_cast<float>(distribution(generator));
-      random2 = static_cast<float>(distribution(generator));
-      choose1 = 0;
-      choose2 = 0;
-      totaldensity = 0;
-      for(size_t j = 0; j < odfsize; j++)
-      {
-        density = odf[j];
-        float d = totaldensity;
-        totaldensity = totaldensity + density;
-        if(random1 >= d && random1 < totaldensity)
-        {
-          choose1 = static_cast<int>(j);
-        }
-        if(random2 >= d && random2 < totaldensity)
-        {
-          choose2 = static_cast<int>(j);
-        }
-      }
+      choose1 = static_cast<int>(odfSampler.sample(distribution(generator)));
+      choose2 = static_cast<int>(odfSampler.sample(distribution(generator)));
       // This is used to create a random Homochoric vector
       std::array<double, 3> randx3 = {distribution(generator), distribution(generator), distribution(generator)};
       OrientationD eu = orientationOps.determineEulerAngles(randx3.data(), choose1);
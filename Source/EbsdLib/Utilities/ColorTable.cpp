@@ -37,10 +37,31 @@
 
 #include <algorithm>
 #include <iostream>
+#include <map>
+#include <mutex>
 
 //#include <QtCore/QJsonArray>
 
 using namespace EbsdLib;
+
+namespace
+{
+/**
+ * @brief Holds the packed color lookup tables that have been computed so far, one per number of colors
+ */
+struct ColorLookupTableCache
+{
+  std::mutex mutex;
+  std::map<int, std::shared_ptr<const std::vector<EbsdLib::Rgb>>> tables;
+};
+
+ColorLookupTableCache& GetColorLookupTableCache()
+{
+  static ColorLookupTableCache cache;
+  return cache;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -99,3 +120,24 @@ void EbsdColorTable::GetColorTable(int numColors, std::vector<float>& colorsOut)
     colorsOut[3 * i + 2] = b;
   }
 }
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<const std::vector<EbsdLib::Rgb>> EbsdColorTable::GetColorLookupTable(int numColors)
+{
+  numColors = std::max(numColors, 0);
+  ColorLookupTableCache& cache = GetColorLookupTableCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  std::shared_ptr<const std::vector<EbsdLib::Rgb>>& table = cache.tables[numColors];
+  if(nullptr == table)
+  {
+    std::vector<float> colors(static_cast<size_t>(numColors) * 3, 0.0f);
+    GetColorTable(numColors, colors);
+    std::vector<EbsdLib::Rgb> packed(static_cast<size_t>(numColors));
+    for(size_t i = 0; i < packed.size(); i++)
+    {
+      packed[i] = RgbColor::dRgb(static_cast<int>(colors[3 * i] * 255.0f), static_cast<int>(colors[3 * i + 1] * 255.0f), static_cast<int>(colors[3 * i + 2] * 255.0f), 255);
+    }
+    table = std::make_shared<const std::vector<EbsdLib::Rgb>>(std::move(packed));
+  }
+  return table;
+}
@@ -36,6 +36,7 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -138,6 +139,14 @@ public:
    */
   static void GetColorTable(int numColors, std::vector<float>& colors);
 
+  /**
+   * @brief Returns the color table of GetColorTable() as packed, fully opaque ARGB values. Each table is
+   * computed once per number of colors and then shared, so this is cheap to call for every image.
+   * @param numColors The number of colors in the table
+   * @return The shared lookup table with numColors entries
+   */
+  static std::shared_ptr<const std::vector<EbsdLib::Rgb>> GetColorLookupTable(int numColors);
+
 public:
   EbsdColorTable(const EbsdColorTable&) = delete;            // Copy Constructor Not Implemented
   EbsdColorTable(EbsdColorTable&&) = delete;                 // Move Constructor Not Implemented
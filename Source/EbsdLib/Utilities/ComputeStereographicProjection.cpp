@@ -38,6 +38,31 @@
 #endif
 #include "EbsdLib/Utilities/ModifiedLambertProjection.h"
 
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+/**
+ * @brief Throws std::invalid_argument unless there is one weight per orientation. The coordinates of each orientation
+ * are contiguous, so the number of coordinates has to be a whole, non zero multiple of the number of weights.
+ */
+void CheckWeights(size_t numCoords, const EbsdArrayView<const float>& weights)
+{
+  if(weights.empty())
+  {
+    return;
+  }
+  const size_t numWeights = weights.getNumberOfTuples();
+  if(numCoords < numWeights || numCoords % numWeights != 0)
+  {
+    std::stringstream ss;
+    ss << "ComputeStereographicProjection: " << numWeights << " weights do not match " << numCoords << " sphere coordinates. There has to be one weight per orientation.";
+    throw std::invalid_argument(ss.str());
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -58,6 +83,7 @@ ComputeStereographicProjection::~ComputeStereographicProjection() = default;
 // -----------------------------------------------------------------------------
 void ComputeStereographicProjection::operator()() const
 {
+  CheckWeights(m_XYZCoords->getNumberOfTuples(), m_Config->weights);
   m_Intensity->resizeTuples(static_cast<size_t>(m_Config->imageDim * m_Config->imageDim));
   m_Intensity->initializeWithZeros();
 
@@ -67,6 +93,8 @@ void ComputeStereographicProjection::operator()() const
     double* intensity = m_Intensity->getPointer(0);
     size_t numCoords = m_XYZCoords->getNumberOfTuples();
     float* xyzPtr = m_XYZCoords->getPointer(0);
+    const EbsdArrayView<const float>& weights = m_Config->weights;
+    const size_t coordsPerWeight = weights.empty() ? 0 : numCoords / weights.getNumberOfTuples();
     for(size_t i = 0; i < numCoords; i++)
     {
       if(xyzPtr[i * 3 + 2] < 0.0f)
@@ -83,7 +111,14 @@ void ComputeStereographicProjection::operator()() const
 
       size_t index = static_cast<size_t>((yCoord * m_Config->imageDim) + xCoord);
 
-      intensity[index]++;
+      if(coordsPerWeight == 0)
+      {
+        intensity[index]++;
+      }
+      else
+      {
+        intensity[index] += weights(i / coordsPerWeight, 0);
+      }
     }
 #if CSP_DEBUG_OUTPUT
     // This chunk is here for some debugging....
@@ -99,8 +134,7 @@ void ComputeStereographicProjection::operator()() const
   }
   else
   {
-    ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::LambertBallToSquare(m_XYZCoords, m_Config->lambertDim, m_Config->sphereRadius);
-    lambert->normalizeSquaresToMRD();
+    ModifiedLambertProjection::Pointer lambert = CreateLambertSquares(m_XYZCoords, *m_Config);
 #if CSP_DEBUG_OUTPUT
     int dim = lambert->getDimension();
     std::string filename = std::string("/tmp/Lambert-%1.h5").arg(dim).arg(m_Config->);
@@ -111,3 +145,23 @@ void ComputeStereographicProjection::operator()() const
     lambert->createStereographicProjection(m_Config->imageDim, *m_Intensity);
   }
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ModifiedLambertProjection::Pointer ComputeStereographicProjection::CreateLambertSquares(EbsdLib::FloatArrayType* xyzCoords, const PoleFigureConfiguration_t& config)
+{
+  CheckWeights(xyzCoords->getNumberOfTuples(), config.weights);
+  ModifiedLambertProjection::Pointer lambert;
+  if(config.weights.empty() && config.kernelHalfWidth <= 0.0f)
+  {
+    lambert = ModifiedLambertProjection::LambertBallToSquare(xyzCoords, config.lambertDim, config.sphereRadius);
+  }
+  else
+  {
+    lambert = ModifiedLambertProjection::LambertBallToSquare(xyzCoords, config.lambertDim, config.sphereRadius, config.weights);
+    lambert->smoothSquares(config.kernelHalfWidth);
+  }
+  lambert->normalizeSquaresToMRD();
+  return lambert;
+}
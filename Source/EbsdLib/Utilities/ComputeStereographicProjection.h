@@ -33,6 +33,7 @@
 
 #include "EbsdLib/Core/EbsdDataArray.hpp"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/Utilities/ModifiedLambertProjection.h"
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
 
 /**
@@ -54,10 +55,20 @@ public:
   virtual ~ComputeStereographicProjection();
 
   /**
-   * @brief operator ()
+   * @brief Computes the intensity image. Throws std::invalid_argument if the configuration has weights but not one
+   * per orientation.
    */
   void operator()() const;
 
+  /**
+   * @brief Creates the normalized (MRD) Lambert squares of a set of XYZ coordinates. The weights and kernelHalfWidth
+   * members of the configuration select the weighted binning and the kernel smoothing. Throws std::invalid_argument
+   * if there are weights but not one per orientation.
+   * @param xyzCoords The XYZ coordinates on the unit sphere
+   * @param config The pole figure configuration
+   */
+  static ModifiedLambertProjection::Pointer CreateLambertSquares(EbsdLib::FloatArrayType* xyzCoords, const PoleFigureConfiguration_t& config);
+
 protected:
   /**
    * @brief ComputeStereographicProjection
@@ -0,0 +1,127 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * Separable Gaussian smoothing of square images. It is shared by the Lambert squares of the pole figures and the
+ * inverse pole figure density images, which only differ in how the edges of the image are treated.
+ */
+namespace GaussianSmoothing
+{
+/**
+ * @brief How a convolution treats the neighbors of a pixel that fall off an edge of the image
+ */
+enum class EdgePolicy
+{
+  Zero,       ///< Pixels outside of the image count as 0
+  LambertWrap ///< Neighbors wrap to the opposite edge with the other coordinate mirrored, the way the Lambert squares join
+};
+
+/**
+ * @brief Creates a normalized 1D Gaussian kernel. The kernel extends 3 sigma to each side but no further than maxRadius.
+ * @param halfWidth Half width at half maximum of the Gaussian in pixels
+ * @param maxRadius The largest radius of the kernel in pixels
+ */
+inline std::vector<double> CreateKernel(double halfWidth, int maxRadius)
+{
+  const double sigma = halfWidth / std::sqrt(2.0 * std::log(2.0));
+  const int radius = std::min(static_cast<int>(std::ceil(3.0 * sigma)), maxRadius);
+  std::vector<double> kernel(static_cast<size_t>(2 * radius + 1));
+  double kernelSum = 0.0;
+  for(int k = -radius; k <= radius; k++)
+  {
+    kernel[k + radius] = std::exp(-0.5 * (k * k) / (sigma * sigma));
+    kernelSum += kernel[k + radius];
+  }
+  for(auto& value : kernel)
+  {
+    value /= kernelSum;
+  }
+  return kernel;
+}
+
+/**
+ * @brief Convolves a dim x dim image with a 1D kernel along its rows (alongX) or its columns
+ */
+inline void Convolve(const double* input, double* output, int dim, const std::vector<double>& kernel, bool alongX, EdgePolicy edges)
+{
+  const int radius = static_cast<int>(kernel.size() / 2);
+  for(int y = 0; y < dim; y++)
+  {
+    for(int x = 0; x < dim; x++)
+    {
+      int kStart = -radius;
+      int kEnd = radius;
+      if(edges == EdgePolicy::Zero)
+      {
+        kStart = std::max(-radius, alongX ? -x : -y);
+        kEnd = std::min(radius, alongX ? dim - 1 - x : dim - 1 - y);
+      }
+      double sum = 0.0;
+      for(int k = kStart; k <= kEnd; k++)
+      {
+        int a = alongX ? x + k : x;
+        int b = alongX ? y : y + k;
+        if(alongX && (a < 0 || a > dim - 1))
+        {
+          a = (a < 0) ? a + dim : a - dim;
+          b = dim - b - 1;
+        }
+        else if(!alongX && (b < 0 || b > dim - 1))
+        {
+          a = dim - a - 1;
+          b = (b < 0) ? b + dim : b - dim;
+        }
+        sum += kernel[k + radius] * input[b * dim + a];
+      }
+      output[y * dim + x] = sum;
+    }
+  }
+}
+
+/**
+ * @brief Smooths a dim x dim image in place, first along its rows and then along its columns
+ * @param scratch Holds at least dim * dim values
+ */
+inline void Smooth(double* values, double* scratch, int dim, const std::vector<double>& kernel, EdgePolicy edges)
+{
+  Convolve(values, scratch, dim, kernel, true, edges);
+  Convolve(scratch, values, dim, kernel, false, edges);
+}
+} // namespace GaussianSmoothing
@@ -35,11 +35,21 @@
 
 #include "ModifiedLambertProjection.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <vector>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
 
 #include "EbsdLib/Core/EbsdMacros.h"
 #include "EbsdLib/Math/EbsdLibMath.h"
 #include "EbsdLib/Math/EbsdMatrixMath.h"
+#include "EbsdLib/Utilities/GaussianSmoothing.hpp"
 
 #define WRITE_LAMBERT_SQUARE_COORD_VTK 0
 
@@ -59,6 +69,61 @@ double calcInterpolatedValue(const ModifiedLambertProjection& self, const std::a
     return self.getInterpolatedValue(ModifiedLambertProjection::Square::SouthSquare, sqCoord.data());
   }
 };
+
+/**
+ * @brief Minimum number of coordinates in a block of the weighted binning and the maximum number of blocks. The
+ * block count only depends on the number of coordinates so the summation order is the same on every machine.
+ */
+const size_t k_MinCoordsPerBlock = 65536;
+const size_t k_MaxBinningBlocks = 32;
+
+/**
+ * @brief The WeightedLambertBinningImpl class bins blocks of weighted XYZ coordinates into one pair of squares per
+ * block
+ */
+class WeightedLambertBinningImpl
+{
+public:
+  WeightedLambertBinningImpl(EbsdLib::FloatArrayType* coords, const EbsdArrayView<const float>& weights, std::vector<ModifiedLambertProjection::Pointer>& blocks)
+  : m_Coords(coords)
+  , m_Weights(weights)
+  , m_Blocks(blocks)
+  {
+  }
+
+  void generate(size_t start, size_t end) const
+  {
+    const size_t numCoords = m_Coords->getNumberOfTuples();
+    const size_t numBlocks = m_Blocks.size();
+    const size_t coordsPerWeight = m_Weights.empty() ? 0 : numCoords / m_Weights.getNumberOfTuples();
+    float sqCoord[2];
+    for(size_t block = start; block < end; block++)
+    {
+      ModifiedLambertProjection& squareProj = *m_Blocks[block];
+      const size_t first = block * numCoords / numBlocks;
+      const size_t last = (block + 1) * numCoords / numBlocks;
+      for(size_t i = first; i < last; i++)
+      {
+        double weight = (coordsPerWeight == 0) ? 1.0 : static_cast<double>(m_Weights(i / coordsPerWeight, 0));
+        sqCoord[0] = 0.0f;
+        sqCoord[1] = 0.0f;
+        bool nhCheck = squareProj.getSquareCoord(m_Coords->getPointer(i * 3), sqCoord);
+        squareProj.addInterpolatedValues(nhCheck ? ModifiedLambertProjection::NorthSquare : ModifiedLambertProjection::SouthSquare, sqCoord, weight);
+      }
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+private:
+  EbsdLib::FloatArrayType* m_Coords = nullptr;
+  EbsdArrayView<const float> m_Weights;
+  std::vector<ModifiedLambertProjection::Pointer>& m_Blocks;
+};
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -145,6 +210,53 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::LambertBallToSquar
   return squareProj;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ModifiedLambertProjection::Pointer ModifiedLambertProjection::LambertBallToSquare(EbsdLib::FloatArrayType* coords, int dimension, float sphereRadius, const EbsdArrayView<const float>& weights)
+{
+  ModifiedLambertProjection::Pointer squareProj = ModifiedLambertProjection::New();
+  squareProj->initializeSquares(dimension, sphereRadius);
+
+  const size_t numCoords = coords->getNumberOfTuples();
+  if(numCoords == 0 || (!weights.empty() && numCoords % weights.getNumberOfTuples() != 0))
+  {
+    return squareProj;
+  }
+
+  // The first block is binned straight into the result
+  const size_t numBlocks = std::min(k_MaxBinningBlocks, (numCoords + k_MinCoordsPerBlock - 1) / k_MinCoordsPerBlock);
+  std::vector<ModifiedLambertProjection::Pointer> blocks(numBlocks);
+  blocks[0] = squareProj;
+  for(size_t block = 1; block < numBlocks; block++)
+  {
+    blocks[block] = ModifiedLambertProjection::New();
+    blocks[block]->initializeSquares(dimension, sphereRadius);
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1), WeightedLambertBinningImpl(coords, weights, blocks), tbb::simple_partitioner());
+#else
+  WeightedLambertBinningImpl serial(coords, weights, blocks);
+  serial.generate(0, numBlocks);
+#endif
+
+  double* north = squareProj->getNorthSquare()->getPointer(0);
+  double* south = squareProj->getSouthSquare()->getPointer(0);
+  const size_t numBins = squareProj->getNorthSquare()->getNumberOfTuples();
+  for(size_t block = 1; block < numBlocks; block++)
+  {
+    const double* blockNorth = blocks[block]->getNorthSquare()->getPointer(0);
+    const double* blockSouth = blocks[block]->getSouthSquare()->getPointer(0);
+    for(size_t i = 0; i < numBins; i++)
+    {
+      north[i] += blockNorth[i];
+      south[i] += blockSouth[i];
+    }
+  }
+  return squareProj;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -508,8 +620,9 @@ void ModifiedLambertProjection::normalizeSquares()
     nTotal = nTotal + north[i];
     sTotal = sTotal + south[i];
   }
-  double oneOverNTotal = 1.0 / nTotal;
-  double oneOverSTotal = 1.0 / sTotal;
+  // An empty square, such as one with only zero weights, stays zero instead of becoming NaN
+  double oneOverNTotal = nTotal > 0.0 ? 1.0 / nTotal : 0.0;
+  double oneOverSTotal = sTotal > 0.0 ? 1.0 / sTotal : 0.0;
 
   // Divide each bin by the total of all the bins for that Hemisphere
   for(size_t i = 0; i < npoints; ++i)
@@ -539,6 +652,25 @@ void ModifiedLambertProjection::normalizeSquaresToMRD()
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::smoothSquares(float halfWidth)
+{
+  if(halfWidth <= 0.0f || m_Dimension < 2)
+  {
+    return;
+  }
+
+  // Near the poles of the squares a distance on the Lambert square is the angle on the sphere scaled by the radius
+  const std::vector<double> kernel = GaussianSmoothing::CreateKernel(static_cast<double>(halfWidth) * m_SphereRadius / m_StepSize, m_Dimension - 1);
+  std::vector<double> scratch(static_cast<size_t>(m_Dimension * m_Dimension));
+  for(const auto& square : {m_NorthSquare, m_SouthSquare})
+  {
+    GaussianSmoothing::Smooth(square->getPointer(0), scratch.data(), m_Dimension, kernel, GaussianSmoothing::EdgePolicy::LambertWrap);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
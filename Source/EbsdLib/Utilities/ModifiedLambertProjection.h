@@ -37,6 +37,7 @@
 
 #include <memory>
 
+#include "EbsdLib/Core/EbsdArrayView.hpp"
 #include "EbsdLib/Core/EbsdDataArray.hpp"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/Utilities/PoleFigureUtilities.h"
@@ -93,6 +94,19 @@ public:
    */
   static Pointer LambertBallToSquare(EbsdLib::FloatArrayType* coords, int dimension, float sphereRadius);
 
+  /**
+   * @brief Creates the north and south squares from weighted XYZ coordinates. The coordinates are split into a fixed
+   * number of blocks that are binned in parallel and then summed in block order, so the result does not depend on
+   * the number of threads.
+   * @param coords The XYZ cartesian coords that are all on the Unit Sphere (Radius = 1)
+   * @param dimension The Dimension of the modified lambert projections images
+   * @param sphereRadius The radius of the sphere from where the coordinates are coming from.
+   * @param weights The weight of each group of coordinates. The coordinates are split evenly between the weights, which
+   * matches the layout of LaueOps::generateSphereCoordsFromEulers() with one weight per orientation. When it is empty
+   * every coordinate has a weight of 1.
+   */
+  static Pointer LambertBallToSquare(EbsdLib::FloatArrayType* coords, int dimension, float sphereRadius, const EbsdArrayView<const float>& weights);
+
   /**
    * @brief Getter property for Dimension
    * @return Value of Dimension
@@ -202,6 +216,14 @@ public:
    */
   void normalizeSquaresToMRD();
 
+  /**
+   * @brief Smooths both squares with a Gaussian kernel using two separable passes. The squares are treated as a
+   * centrosymmetric sphere: a neighbor that falls off an edge is taken from the opposite edge, the same way
+   * addInterpolatedValues() wraps.
+   * @param halfWidth The angle (in Radians) at which the kernel falls to half of its peak value
+   */
+  void smoothSquares(float halfWidth);
+
   /**
    * @brief createStereographicProjection
    * @param stereoGraphicProjectionDims
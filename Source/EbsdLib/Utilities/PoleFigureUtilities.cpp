@@ -35,8 +35,19 @@
 
 #include "PoleFigureUtilities.h"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <utility>
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
 
 #include "EbsdLib/LaueOps/CubicOps.h"
 #include "EbsdLib/LaueOps/HexagonalOps.h"
@@ -47,6 +58,140 @@
 #define WRITE_XYZ_SPHERE_COORD_VTK 0
 #define WRITE_LAMBERT_SQUARES 0
 
+namespace
+{
+constexpr uint32_t k_White = 0xFFFFFFFF;
+constexpr uint32_t k_Black = 0xFF000000;
+
+/**
+ * @brief The first and one past the last pixel of each image row that lie inside the unit circle of a pole figure
+ */
+using CircleSpans = std::vector<std::pair<int, int>>;
+
+/**
+ * @brief Holds the circle spans that have been computed so far, one per image dimension
+ */
+struct CircleSpanCache
+{
+  std::mutex mutex;
+  std::map<int, std::shared_ptr<const CircleSpans>> spans;
+};
+
+CircleSpanCache& GetCircleSpanCache()
+{
+  static CircleSpanCache cache;
+  return cache;
+}
+
+/**
+ * @brief Returns the circle spans of a square pole figure image. The inside test is the same pixel center test that
+ * was previously done for every pixel of every image.
+ */
+std::shared_ptr<const CircleSpans> GetCircleSpans(int imageDim)
+{
+  CircleSpanCache& cache = GetCircleSpanCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  std::shared_ptr<const CircleSpans>& spans = cache.spans[imageDim];
+  if(nullptr != spans)
+  {
+    return spans;
+  }
+
+  const int halfDim = imageDim / 2;
+  const float res = 2.0f / static_cast<float>(imageDim);
+  CircleSpans rows(static_cast<size_t>(std::max(imageDim, 0)), {0, 0});
+  for(int y = 0; y < imageDim; y++)
+  {
+    const float ytmp = float(y - halfDim) * res + (res * 0.5f);
+    int first = imageDim;
+    int last = 0;
+    for(int x = 0; x < imageDim; x++)
+    {
+      const float xtmp = float(x - halfDim) * res + (res * 0.5f);
+      if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
+      {
+        first = std::min(first, x);
+        last = x + 1;
+      }
+    }
+    rows[y] = (first < last) ? std::make_pair(first, last) : std::make_pair(0, 0);
+  }
+  spans = std::make_shared<const CircleSpans>(std::move(rows));
+  return spans;
+}
+} // namespace
+
+namespace Detail
+{
+/**
+ * @brief The CreateColorImageImpl class colors a range of rows of a pole figure image. Pixels outside of the span of
+ * their row (the circle for pole figures) are white and the intensities inside of it are scaled into the color lookup
+ * table.
+ */
+class CreateColorImageImpl
+{
+public:
+  CreateColorImageImpl(const double* data, uint32_t* rgba, int imageDim, const CircleSpans& spans, const std::vector<EbsdLib::Rgb>& colors, float min, float max, bool blackAndWhite)
+  : m_Data(data)
+  , m_Rgba(rgba)
+  , m_ImageDim(imageDim)
+  , m_Spans(spans)
+  , m_Colors(colors)
+  , m_Min(min)
+  , m_Max(max)
+  , m_BlackAndWhite(blackAndWhite)
+  {
+  }
+  virtual ~CreateColorImageImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    const int numColors = static_cast<int>(m_Colors.size());
+    const EbsdLib::Rgb* colors = m_Colors.data();
+    const double min = m_Min;
+    const double range = static_cast<double>(m_Max - m_Min);
+    for(size_t y = start; y < end; y++)
+    {
+      const size_t rowOffset = y * static_cast<size_t>(m_ImageDim);
+      const double* values = m_Data + rowOffset;
+      uint32_t* row = m_Rgba + rowOffset;
+      const int first = m_Spans[y].first;
+      const int last = m_Spans[y].second;
+      std::fill(row, row + first, k_White);
+      for(int x = first; x < last; x++)
+      {
+        const double value = (values[x] - min) / range;
+        const int bin = std::min(static_cast<int>(value * numColors), numColors - 1);
+        uint32_t color = k_Black;
+        if(bin >= 0)
+        {
+          color = m_BlackAndWhite ? (value > 0.0 ? k_Black : k_White) : colors[bin];
+        }
+        row[x] = color;
+      }
+      std::fill(row + last, row + m_ImageDim, k_White);
+    }
+  }
+
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const double* m_Data;
+  uint32_t* m_Rgba;
+  int m_ImageDim;
+  const CircleSpans& m_Spans;
+  const std::vector<EbsdLib::Rgb>& m_Colors;
+  float m_Min;
+  float m_Max;
+  bool m_BlackAndWhite;
+};
+} // namespace Detail
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -108,81 +253,46 @@ EbsdLib::UInt8ArrayType::Pointer PoleFigureUtilities::CreateColorImage(EbsdLib::
 // -----------------------------------------------------------------------------
 void PoleFigureUtilities::CreateColorImage(EbsdLib::DoubleArrayType* data, PoleFigureConfiguration_t& config, EbsdLib::UInt8ArrayType* image)
 {
-  int width = config.imageDim;
-  int height = config.imageDim;
-
-  int halfWidth = width / 2;
-  int halfHeight = height / 2;
-
-  float xres = 2.0f / static_cast<float>(width);
-  float yres = 2.0f / static_cast<float>(height);
-  float xtmp, ytmp;
+  // The circle only depends on the image size so it is computed once and shared by every image that is colored.
+  std::shared_ptr<const CircleSpans> spans = GetCircleSpans(std::max(config.imageDim, 0));
+  CreateColorImage(data, config, *spans, image);
+}
 
-  float max = static_cast<float>(config.maxScale);
-  float min = static_cast<float>(config.minScale);
+// -----------------------------------------------------------------------------
+void PoleFigureUtilities::CreateColorImage(EbsdLib::DoubleArrayType* data, PoleFigureConfiguration_t& config, const std::vector<std::pair<int, int>>& rowSpans, EbsdLib::UInt8ArrayType* image)
+{
+  const int imageDim = std::max(config.imageDim, 0);
+  std::shared_ptr<const std::vector<EbsdLib::Rgb>> colors = EbsdColorTable::GetColorLookupTable(config.numColors);
 
-  // Initialize the image with all zeros
-  image->initializeWithZeros();
+  // Every pixel is written below so the image does not need to be cleared first
   uint32_t* rgbaPtr = reinterpret_cast<uint32_t*>(image->getPointer(0));
+  const bool blackAndWhite = !config.discreteHeatMap && config.discrete;
+  Detail::CreateColorImageImpl impl(data->getPointer(0), rgbaPtr, imageDim, rowSpans, *colors, static_cast<float>(config.minScale), static_cast<float>(config.maxScale), blackAndWhite);
+#ifdef EbsdLib_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(imageDim)), impl, tbb::auto_partitioner());
+#else
+  impl.generate(0, static_cast<size_t>(imageDim));
+#endif
+}
 
-  int numColors = config.numColors;
-  std::vector<float> colors(numColors * 3, 0.0f);
-  EbsdColorTable::GetColorTable(config.numColors, colors);
-
-  float r = 0.0f, g = 0.0f, b = 0.0f;
-
-  double* dataPtr = data->getPointer(0);
-  size_t idx = 0;
-  double value;
-  int bin;
-  for(int64_t y = 0; y < height; y++)
+// -----------------------------------------------------------------------------
+void PoleFigureUtilities::FindIntensityRange(const std::vector<const EbsdLib::DoubleArrayType*>& intensities, PoleFigureConfiguration_t& config)
+{
+  // The starting values match what every pole figure generator has always used
+  double max = std::numeric_limits<double>::min();
+  double min = std::numeric_limits<double>::max();
+  for(const EbsdLib::DoubleArrayType* intensity : intensities)
   {
-    for(int64_t x = 0; x < width; x++)
+    const double* dPtr = intensity->getPointer(0);
+    const size_t count = intensity->getNumberOfTuples();
+    for(size_t i = 0; i < count; ++i)
     {
-      xtmp = float(x - halfWidth) * xres + (xres * 0.5f);
-      ytmp = float(y - halfHeight) * yres + (yres * 0.5f);
-      idx = (width * y) + x;
-      if((xtmp * xtmp + ytmp * ytmp) <= 1.0) // Inside the circle
-      {
-        value = dataPtr[y * width + x];
-        value = (value - min) / (max - min);
-        bin = int(value * numColors);
-        if(bin > numColors - 1)
-        {
-          bin = numColors - 1;
-        }
-        if(bin < 0 || bin >= colors.size())
-        {
-          r = 0x00;
-          b = 0x00;
-          g = 0x00;
-        }
-        else if(!config.discreteHeatMap && config.discrete)
-        {
-          float frgb = 1.0f;
-          if(value > 0.0)
-          {
-            frgb = 0.0f;
-          }
-          r = frgb;
-          b = frgb;
-          g = frgb;
-        }
-        else
-        {
-          r = colors[3 * bin];
-          g = colors[3 * bin + 1];
-          b = colors[3 * bin + 2];
-        }
-
-        rgbaPtr[idx] = EbsdLib::RgbColor::dRgb(static_cast<int>(r * 255.0f), static_cast<int>(g * 255.0f), static_cast<int>(b * 255.0f), 255);
-      }
-      else // Outside the Circle - Set pixel to White
-      {
-        rgbaPtr[idx] = 0xFFFFFFFF; // White
-      }
+      max = (dPtr[i] > max) ? dPtr[i] : max;
+      min = (dPtr[i] < min) ? dPtr[i] : min;
     }
   }
+  config.minScale = min;
+  config.maxScale = max;
 }
 
 // -----------------------------------------------------------------------------
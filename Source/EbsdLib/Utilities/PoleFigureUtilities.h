@@ -38,8 +38,10 @@
 #include <memory>
 
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "EbsdLib/Core/EbsdArrayView.hpp"
 #include "EbsdLib/Core/EbsdDataArray.hpp"
 #include "EbsdLib/EbsdLib.h"
 
@@ -73,6 +75,47 @@ struct PoleFigureConfiguration_t
   std::vector<std::string> labels; ///<* The labels for each of the 3 Pole Figures
   std::vector<unsigned int> order; ///<* The order that the pole figures should appear in.
   std::string phaseName;           ///<* The Names of the phase
+
+  /**
+   * @brief Optional view of the Euler Angles (in Radians). When it is not empty it is used instead of eulers which
+   * allows strided or planar (one array per angle) data to be used without copying it.
+   */
+  EbsdArrayView<const float> eulerView;
+
+  /**
+   * @brief Returns the Euler angles to use for the pole figure: eulerView if it was set, otherwise a view of eulers
+   */
+  EbsdArrayView<const float> getEulers() const
+  {
+    if(!eulerView.empty())
+    {
+      return eulerView;
+    }
+    return EbsdArrayView<const float>::FromArray(*eulers);
+  }
+
+  /**
+   * @brief Optional weight of each orientation, such as its area fraction. When it is empty every orientation counts
+   * once.
+   */
+  EbsdArrayView<const float> weights;
+
+  /**
+   * @brief Half-width (in Radians) of the Gaussian kernel that the Lambert squares are smoothed with before they are
+   * projected. 0 turns the smoothing off. Discrete pole figures are never smoothed.
+   */
+  float kernelHalfWidth = 0.0f;
+};
+
+/**
+ * @struct PoleFigurePyramidLevel_t
+ * @brief The pole figures of one image size of a pole figure pyramid
+ */
+struct PoleFigurePyramidLevel_t
+{
+  int imageDim = 0;                                            ///<* The height/width of the images of this level
+  std::vector<EbsdLib::DoubleArrayType::Pointer> intensities;  ///<* The intensity image of each pole figure in the order they are generated
+  std::vector<EbsdLib::UInt8ArrayType::Pointer> images;        ///<* The RGBA image of each pole figure in the order of the configuration
 };
 
 /**
@@ -102,13 +145,32 @@ public:
   static EbsdLib::UInt8ArrayType::Pointer CreateColorImage(EbsdLib::DoubleArrayType* data, int width, int height, int nColors, const std::string& name, double min, double max);
 
   /**
-   * @brief CreateColorImage
-   * @param data
+   * @brief Colors an intensity image with the color table and scale of the configuration. Pixels outside of the
+   * pole figure circle are white. The rows of the image are colored in parallel.
+   * @param data The intensity image which is config.imageDim x config.imageDim
    * @param config
-   * @param image
+   * @param image [output] RGBA image with the same dimensions as the intensity image
    */
   static void CreateColorImage(EbsdLib::DoubleArrayType* data, PoleFigureConfiguration_t& config, EbsdLib::UInt8ArrayType* image);
 
+  /**
+   * @brief Colors an intensity image the same way as above but with an arbitrary region instead of the pole figure
+   * circle. Each row is colored in [first, last) of its span and is white outside of it.
+   * @param data The intensity image which is config.imageDim x config.imageDim
+   * @param config
+   * @param rowSpans The first and one past the last colored pixel of each of the config.imageDim rows
+   * @param image [output] RGBA image with the same dimensions as the intensity image
+   */
+  static void CreateColorImage(EbsdLib::DoubleArrayType* data, PoleFigureConfiguration_t& config, const std::vector<std::pair<int, int>>& rowSpans, EbsdLib::UInt8ArrayType* image);
+
+  /**
+   * @brief Finds the smallest and largest value over a set of intensity images and stores them as the minScale and
+   * maxScale of the configuration so that all of the images share one color scale
+   * @param intensities The intensity images
+   * @param config [output]
+   */
+  static void FindIntensityRange(const std::vector<const EbsdLib::DoubleArrayType*>& intensities, PoleFigureConfiguration_t& config);
+
 private:
   /**
    * @brief GenerateHexPoleFigures
@@ -0,0 +1,421 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+/**
+ * Python bindings for the EbsdLib readers and batch orientation kernels. The data columns of a reader are moved into
+ * NumPy arrays without a copy: the reader hands its memory over and the array frees it, so the arrays stay valid when
+ * the reader reads another file or is destroyed. The batch calls read their inputs from the NumPy buffers and write
+ * their outputs into NumPy owned memory, so no per element copies are made on either side.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "EbsdLib/Core/EbsdArrayView.hpp"
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/EbsdReader.h"
+#include "EbsdLib/IO/HKL/CtfReader.h"
+#include "EbsdLib/IO/TSL/AngFields.h"
+#include "EbsdLib/IO/TSL/AngReader.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/PhasePartition.h"
+#include "EbsdLib/OrientationMath/OrientationConverter.hpp"
+
+#ifdef EbsdLib_ENABLE_HDF5
+#include "EbsdLib/IO/BrukerNano/H5EspritFields.h"
+#include "EbsdLib/IO/BrukerNano/H5EspritReader.h"
+#include "EbsdLib/IO/TSL/H5OIMReader.h"
+#endif
+
+namespace py = pybind11;
+
+namespace
+{
+const std::map<std::string, int32_t> k_RepresentationIndexMap = {{"eu", 0}, {"om", 1}, {"qu", 2}, {"aa", 3}, {"ro", 4}, {"ho", 5}, {"cu", 6}};
+
+/**
+ * @brief Wraps memory that a reader released with releasePointerByName() in a NumPy array. The capsule frees the
+ * memory with delete[] when the array is garbage collected.
+ */
+template <typename T>
+py::array OwnedColumn(void* data, py::ssize_t numElements)
+{
+  py::capsule owner(data, [](void* ptr) { delete[] static_cast<T*>(ptr); });
+  return py::array_t<T>(py::array::ShapeContainer{numElements}, static_cast<T*>(data), owner);
+}
+
+using OwnedColumnFunction = py::array (*)(void*, py::ssize_t);
+
+// -----------------------------------------------------------------------------
+OwnedColumnFunction GetOwnedColumnFunction(EbsdLib::NumericTypes::Type type)
+{
+  switch(type)
+  {
+  case EbsdLib::NumericTypes::Type::Int8:
+    return &OwnedColumn<int8_t>;
+  case EbsdLib::NumericTypes::Type::UInt8:
+    return &OwnedColumn<uint8_t>;
+  case EbsdLib::NumericTypes::Type::Int16:
+    return &OwnedColumn<int16_t>;
+  case EbsdLib::NumericTypes::Type::UInt16:
+    return &OwnedColumn<uint16_t>;
+  case EbsdLib::NumericTypes::Type::Int32:
+    return &OwnedColumn<int32_t>;
+  case EbsdLib::NumericTypes::Type::UInt32:
+    return &OwnedColumn<uint32_t>;
+  case EbsdLib::NumericTypes::Type::Int64:
+    return &OwnedColumn<int64_t>;
+  case EbsdLib::NumericTypes::Type::UInt64:
+    return &OwnedColumn<uint64_t>;
+  case EbsdLib::NumericTypes::Type::Float:
+    return &OwnedColumn<float>;
+  case EbsdLib::NumericTypes::Type::Double:
+    return &OwnedColumn<double>;
+  case EbsdLib::NumericTypes::Type::Bool:
+    return &OwnedColumn<bool>;
+  case EbsdLib::NumericTypes::Type::SizeT:
+    return &OwnedColumn<size_t>;
+  case EbsdLib::NumericTypes::Type::UnknownNumType:
+    break;
+  }
+  throw py::value_error("The column has an unsupported numeric type");
+}
+
+/**
+ * @brief Moves a reader column into a NumPy array without copying it. The reader no longer holds the column
+ * afterwards, so a column can be taken once per read.
+ * @return The array or None if the column was not read, was already taken or can not be released by the reader
+ */
+py::object ReleaseColumn(EbsdReader& reader, const std::string& name)
+{
+  if(reader.getPointerByName(name) == nullptr)
+  {
+    return py::none();
+  }
+  OwnedColumnFunction ownedColumn = GetOwnedColumnFunction(reader.getPointerType(name));
+  const auto numElements = static_cast<py::ssize_t>(reader.getNumberOfElements());
+  void* data = reader.releasePointerByName(name);
+  if(data == nullptr)
+  {
+    return py::none();
+  }
+  return ownedColumn(data, numElements);
+}
+
+/**
+ * @brief Adds the column() and columns() methods to a reader class
+ * @param names Returns the names of the columns the reader can have
+ */
+template <typename ReaderType, typename ClassType, typename NamesFunction>
+void DefineColumns(ClassType& cls, NamesFunction names)
+{
+  cls.def(
+      "column",
+      [](ReaderType& reader, const std::string& name) {
+        py::object column = ReleaseColumn(reader, name);
+        if(column.is_none())
+        {
+          throw py::key_error(name);
+        }
+        return column;
+      },
+      py::arg("name"), "Moves a data column out of the reader into a NumPy array without copying it. Raises KeyError if the column was not read or was already taken.");
+  cls.def(
+      "columns",
+      [names](ReaderType& reader) {
+        py::dict columns;
+        for(const auto& name : names(reader))
+        {
+          py::object column = ReleaseColumn(reader, name);
+          if(!column.is_none())
+          {
+            columns[py::str(name)] = column;
+          }
+        }
+        return columns;
+      },
+      "Moves every column that was read and not yet taken out of the reader. Returns a dict of NumPy arrays.");
+}
+
+// -----------------------------------------------------------------------------
+const LaueOps& GetLaueOps(uint32_t crystalStructure)
+{
+  const std::vector<LaueOps::Pointer>& ops = LaueOps::GetAllOrientationOps();
+  if(crystalStructure >= ops.size() || crystalStructure == EbsdLib::CrystalStructure::LaueGroupEnd)
+  {
+    throw py::value_error("Unknown crystal structure " + std::to_string(crystalStructure));
+  }
+  return *ops[crystalStructure];
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+using InputArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+// -----------------------------------------------------------------------------
+size_t CheckTuples(const py::array& array, py::ssize_t numComps, const std::string& name)
+{
+  if(array.ndim() != 2 || array.shape(1) != numComps)
+  {
+    throw py::value_error(name + " must have the shape (N, " + std::to_string(numComps) + ")");
+  }
+  return static_cast<size_t>(array.shape(0));
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+py::array_t<T> ConvertOrientations(InputArray<T> input, const std::string& inputType, const std::string& outputType)
+{
+  using ArrayType = EbsdDataArray<T>;
+  using OCType = OrientationConverter<ArrayType, T>;
+
+  auto inputIter = k_RepresentationIndexMap.find(inputType);
+  auto outputIter = k_RepresentationIndexMap.find(outputType);
+  if(inputIter == k_RepresentationIndexMap.end() || outputIter == k_RepresentationIndexMap.end())
+  {
+    throw py::value_error("Representations are one of 'eu', 'om', 'qu', 'aa', 'ro', 'ho' and 'cu'");
+  }
+  const std::vector<int32_t> counts = OCType::template GetComponentCounts<std::vector<int32_t>>();
+  const size_t numTuples = CheckTuples(input, counts[inputIter->second], "input");
+
+  std::vector<typename OCType::Pointer> converters(7);
+  converters[0] = EulerConverter<ArrayType, T>::New();
+  converters[1] = OrientationMatrixConverter<ArrayType, T>::New();
+  converters[2] = QuaternionConverter<ArrayType, T>::New();
+  converters[3] = AxisAngleConverter<ArrayType, T>::New();
+  converters[4] = RodriguesConverter<ArrayType, T>::New();
+  converters[5] = HomochoricConverter<ArrayType, T>::New();
+  converters[6] = CubochoricConverter<ArrayType, T>::New();
+
+  // The converters correct out of range values of their input in place, so they read a copy of the caller's array
+  std::vector<T> inputCopy(input.data(), input.data() + input.size());
+  typename OCType::Pointer converter = converters[inputIter->second];
+  converter->setInputView(EbsdArrayView<T>(inputCopy.data(), numTuples, static_cast<size_t>(counts[inputIter->second])));
+  {
+    py::gil_scoped_release release;
+    converter->convertRepresentationTo(OCType::GetOrientationTypes()[outputIter->second]);
+  }
+
+  // The result is handed to NumPy as is. The capsule keeps the converter's output array alive.
+  typename ArrayType::Pointer output = converter->getOutputData();
+  auto* holder = new typename ArrayType::Pointer(output);
+  py::capsule owner(holder, [](void* ptr) { delete reinterpret_cast<typename ArrayType::Pointer*>(ptr); });
+  const auto shape = std::vector<py::ssize_t>{static_cast<py::ssize_t>(output->getNumberOfTuples()), static_cast<py::ssize_t>(output->getNumberOfComponents())};
+  return py::array_t<T>(shape, output->getPointer(0), owner);
+}
+
+// -----------------------------------------------------------------------------
+py::array_t<uint8_t> NewColorArray(size_t numTuples, EbsdLib::UInt8ArrayType::Pointer& wrapper)
+{
+  py::array_t<uint8_t> rgb({static_cast<py::ssize_t>(numTuples), static_cast<py::ssize_t>(3)});
+  std::fill_n(rgb.mutable_data(), numTuples * 3, static_cast<uint8_t>(0));
+  wrapper = EbsdLib::UInt8ArrayType::WrapPointer(rgb.mutable_data(), numTuples, {3}, "IPF Colors", false);
+  return rgb;
+}
+
+// -----------------------------------------------------------------------------
+EbsdLib::ComputePrecision ToPrecision(bool singlePrecision)
+{
+  return singlePrecision ? EbsdLib::ComputePrecision::Single : EbsdLib::ComputePrecision::Double;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+PYBIND11_MODULE(_ebsdlib, m)
+{
+  m.doc() = "EbsdLib readers and batch orientation kernels";
+
+  py::class_<EbsdReader, std::shared_ptr<EbsdReader>> ebsdReader(m, "EbsdReader");
+  ebsdReader.def_property("file_name", &EbsdReader::getFileName, &EbsdReader::setFileName)
+      .def("read_file", &EbsdReader::readFile, py::call_guard<py::gil_scoped_release>(), "Reads the header and data. Returns the error code, 0 or greater on success.")
+      .def("read_header_only", &EbsdReader::readHeaderOnly, py::call_guard<py::gil_scoped_release>())
+      .def_property_readonly("error_code", &EbsdReader::getErrorCode)
+      .def_property_readonly("error_message", &EbsdReader::getErrorMessage)
+      .def_property_readonly("original_header", &EbsdReader::getOriginalHeader)
+      .def_property_readonly("number_of_elements", &EbsdReader::getNumberOfElements)
+      .def_property_readonly("x_dimension", &EbsdReader::getXDimension)
+      .def_property_readonly("y_dimension", &EbsdReader::getYDimension)
+      .def_property("use_binary_cache", &EbsdReader::getUseBinaryCache, &EbsdReader::setUseBinaryCache)
+      .def_property("apply_transformations", &EbsdReader::getApplyTransformations, &EbsdReader::setApplyTransformations)
+      .def_property("sample_transformation_angle", &EbsdReader::getSampleTransformationAngle, &EbsdReader::setSampleTransformationAngle)
+      .def_property("sample_transformation_axis", &EbsdReader::getSampleTransformationAxis, &EbsdReader::setSampleTransformationAxis)
+      .def_property("euler_transformation_angle", &EbsdReader::getEulerTransformationAngle, &EbsdReader::setEulerTransformationAngle)
+      .def_property("euler_transformation_axis", &EbsdReader::getEulerTransformationAxis, &EbsdReader::setEulerTransformationAxis);
+
+  py::class_<AngReader, EbsdReader, std::shared_ptr<AngReader>> angReader(m, "AngReader");
+  angReader.def(py::init([]() { return std::make_shared<AngReader>(); }))
+      .def_property_readonly("grid", &AngReader::getGrid)
+      .def_property_readonly("x_step", &AngReader::getXStep)
+      .def_property_readonly("y_step", &AngReader::getYStep)
+      .def_property_readonly("num_odd_cols", &AngReader::getNumOddCols)
+      .def_property_readonly("num_even_cols", &AngReader::getNumEvenCols)
+      .def_property_readonly("num_rows", &AngReader::getNumRows)
+      .def_property_readonly("crystal_structures",
+                             [](AngReader& reader) {
+                               std::vector<uint32_t> crystalStructures;
+                               for(const auto& phase : reader.getPhaseVector())
+                               {
+                                 crystalStructures.push_back(phase->determineLaueGroup());
+                               }
+                               return crystalStructures;
+                             })
+      .def_property("convert_hex_grid_to_square_grid", &AngReader::getConvertHexGridToSquareGrid, &AngReader::setConvertHexGridToSquareGrid);
+  DefineColumns<AngReader>(angReader, [](AngReader&) { return AngFields().getFieldNames(); });
+
+  py::class_<CtfReader, EbsdReader, std::shared_ptr<CtfReader>> ctfReader(m, "CtfReader");
+  ctfReader.def(py::init([]() { return std::make_shared<CtfReader>(); }))
+      .def_property_readonly("x_cells", &CtfReader::getXCells)
+      .def_property_readonly("y_cells", &CtfReader::getYCells)
+      .def_property_readonly("z_cells", &CtfReader::getZCells)
+      .def_property_readonly("x_step", &CtfReader::getXStep)
+      .def_property_readonly("y_step", &CtfReader::getYStep)
+      .def_property_readonly("crystal_structures", [](CtfReader& reader) {
+        std::vector<uint32_t> crystalStructures;
+        for(const auto& phase : reader.getPhaseVector())
+        {
+          crystalStructures.push_back(phase->determineLaueGroup());
+        }
+        return crystalStructures;
+      });
+  DefineColumns<CtfReader>(ctfReader, [](CtfReader& reader) { return reader.getColumnNames(); });
+
+#ifdef EbsdLib_ENABLE_HDF5
+  py::class_<H5OIMReader, AngReader, std::shared_ptr<H5OIMReader>> h5OIMReader(m, "H5OIMReader");
+  h5OIMReader.def(py::init(&H5OIMReader::New))
+      .def_property("hdf5_path", &H5OIMReader::getHDF5Path, &H5OIMReader::setHDF5Path)
+      .def("read_scan_names", [](H5OIMReader& reader) {
+        std::list<std::string> names;
+        reader.readScanNames(names);
+        return std::vector<std::string>(names.begin(), names.end());
+      });
+
+  py::class_<H5EspritReader, EbsdReader, std::shared_ptr<H5EspritReader>> h5EspritReader(m, "H5EspritReader");
+  h5EspritReader.def(py::init(&H5EspritReader::New))
+      .def_property("hdf5_path", &H5EspritReader::getHDF5Path, &H5EspritReader::setHDF5Path)
+      .def_property_readonly("x_step", &H5EspritReader::getXStep)
+      .def_property_readonly("y_step", &H5EspritReader::getYStep)
+      .def("read_scan_names", [](H5EspritReader& reader) {
+        std::list<std::string> names;
+        reader.readScanNames(names);
+        return std::vector<std::string>(names.begin(), names.end());
+      });
+  DefineColumns<H5EspritReader>(h5EspritReader, [](H5EspritReader&) { return H5EspritFields().getFieldNames(); });
+#endif
+
+  m.def("convert_orientations", &ConvertOrientations<float>, py::arg("input"), py::arg("input_type"), py::arg("output_type"));
+  m.def("convert_orientations", &ConvertOrientations<double>, py::arg("input"), py::arg("input_type"), py::arg("output_type"),
+        "Converts an (N, components) array of orientations between the 'eu', 'om', 'qu', 'aa', 'ro', 'ho' and 'cu' representations. "
+        "The input array is not modified.");
+
+  m.def(
+      "ipf_colors",
+      [](const InputArray<float>& eulers, uint32_t crystalStructure, const std::array<double, 3>& refDir, bool degrees, bool singlePrecision) {
+        const size_t numTuples = CheckTuples(eulers, 3, "eulers");
+        const LaueOps& ops = GetLaueOps(crystalStructure);
+        EbsdLib::UInt8ArrayType::Pointer wrapper;
+        py::array_t<uint8_t> rgb = NewColorArray(numTuples, wrapper);
+        {
+          py::gil_scoped_release release;
+          ops.generateIPFColors(EbsdArrayView<const float>(eulers.data(), numTuples, 3), refDir.data(), degrees, wrapper.get(), ToPrecision(singlePrecision));
+        }
+        return rgb;
+      },
+      py::arg("eulers"), py::arg("crystal_structure"), py::arg("ref_dir") = std::array<double, 3>{0.0, 0.0, 1.0}, py::arg("degrees") = false, py::arg("single_precision") = false,
+      "Returns the (N, 3) uint8 IPF colors of (N, 3) Euler angles of a single crystal structure.");
+  m.def(
+      "ipf_colors",
+      [](const InputArray<float>& eulers, const InputArray<int32_t>& phases, const std::vector<uint32_t>& crystalStructures, const std::array<double, 3>& refDir, bool degrees, bool singlePrecision) {
+        const size_t numTuples = CheckTuples(eulers, 3, "eulers");
+        if(static_cast<size_t>(phases.size()) != numTuples)
+        {
+          throw py::value_error("phases must have one value per orientation");
+        }
+        EbsdLib::UInt8ArrayType::Pointer wrapper;
+        py::array_t<uint8_t> rgb = NewColorArray(numTuples, wrapper);
+        {
+          py::gil_scoped_release release;
+          PhasePartition::Pointer partition = PhasePartition::New(phases.data(), numTuples, crystalStructures.size());
+          partition->generateIPFColors(crystalStructures, EbsdArrayView<const float>(eulers.data(), numTuples, 3), refDir.data(), degrees, wrapper.get(), ToPrecision(singlePrecision));
+        }
+        return rgb;
+      },
+      py::arg("eulers"), py::arg("phases"), py::arg("crystal_structures"), py::arg("ref_dir") = std::array<double, 3>{0.0, 0.0, 1.0}, py::arg("degrees") = false,
+      py::arg("single_precision") = false, "Returns the (N, 3) uint8 IPF colors of a multi-phase scan. crystal_structures holds the crystal structure of each phase.");
+
+  m.def(
+      "misorientations",
+      [](const InputArray<float>& quats1, const InputArray<float>& quats2, uint32_t crystalStructure, bool singlePrecision) {
+        const size_t numTuples = CheckTuples(quats1, 4, "quats1");
+        if(CheckTuples(quats2, 4, "quats2") != numTuples)
+        {
+          throw py::value_error("quats1 and quats2 must have the same number of orientations");
+        }
+        const LaueOps& ops = GetLaueOps(crystalStructure);
+        py::array_t<float> axisAngles({static_cast<py::ssize_t>(numTuples), static_cast<py::ssize_t>(4)});
+        EbsdLib::FloatArrayType::Pointer q1 = EbsdLib::FloatArrayType::WrapPointer(const_cast<float*>(quats1.data()), numTuples, {4}, "Quats1", false);
+        EbsdLib::FloatArrayType::Pointer q2 = EbsdLib::FloatArrayType::WrapPointer(const_cast<float*>(quats2.data()), numTuples, {4}, "Quats2", false);
+        EbsdLib::FloatArrayType::Pointer output = EbsdLib::FloatArrayType::WrapPointer(axisAngles.mutable_data(), numTuples, {4}, "Axis Angles", false);
+        {
+          py::gil_scoped_release release;
+          ops.calculateMisorientations(q1.get(), q2.get(), output.get(), ToPrecision(singlePrecision));
+        }
+        return axisAngles;
+      },
+      py::arg("quats1"), py::arg("quats2"), py::arg("crystal_structure"), py::arg("single_precision") = false,
+      "Returns the (N, 4) <xyz>w axis-angle misorientations between two (N, 4) arrays of x, y, z, w quaternions.");
+
+  py::module_ crystalStructure = m.def_submodule("CrystalStructure", "The crystal structure values used by crystal_structure arguments");
+  crystalStructure.attr("Hexagonal_High") = EbsdLib::CrystalStructure::Hexagonal_High;
+  crystalStructure.attr("Cubic_High") = EbsdLib::CrystalStructure::Cubic_High;
+  crystalStructure.attr("Hexagonal_Low") = EbsdLib::CrystalStructure::Hexagonal_Low;
+  crystalStructure.attr("Cubic_Low") = EbsdLib::CrystalStructure::Cubic_Low;
+  crystalStructure.attr("Triclinic") = EbsdLib::CrystalStructure::Triclinic;
+  crystalStructure.attr("Monoclinic") = EbsdLib::CrystalStructure::Monoclinic;
+  crystalStructure.attr("OrthoRhombic") = EbsdLib::CrystalStructure::OrthoRhombic;
+  crystalStructure.attr("Tetragonal_Low") = EbsdLib::CrystalStructure::Tetragonal_Low;
+  crystalStructure.attr("Tetragonal_High") = EbsdLib::CrystalStructure::Tetragonal_High;
+  crystalStructure.attr("Trigonal_Low") = EbsdLib::CrystalStructure::Trigonal_Low;
+  crystalStructure.attr("Trigonal_High") = EbsdLib::CrystalStructure::Trigonal_High;
+}
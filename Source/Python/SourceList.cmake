@@ -0,0 +1,26 @@
+#------------------------------------------------------------------------------
+# Python bindings for the readers and batch orientation kernels. The module is
+# imported by the pyebsd package as ebsd._ebsdlib
+#------------------------------------------------------------------------------
+find_package(Python COMPONENTS Interpreter Development.Module REQUIRED)
+find_package(pybind11 CONFIG REQUIRED)
+
+pybind11_add_module(_ebsdlib ${EbsdLibProj_SOURCE_DIR}/Source/Python/EbsdLibModule.cpp)
+target_link_libraries(_ebsdlib PRIVATE EbsdLib)
+target_include_directories(_ebsdlib PRIVATE ${EbsdLibProj_SOURCE_DIR}/Source)
+
+if(EbsdLib_INSTALL_FILES)
+  install(TARGETS _ebsdlib
+    LIBRARY DESTINATION python/ebsd
+    COMPONENT Python
+  )
+endif()
+
+#------------------------------------------------------------------------------
+# Smoke test of the module, needs NumPy
+if(EbsdLib_ENABLE_TESTING)
+  add_test(NAME EbsdLibPythonTest
+    COMMAND ${Python_EXECUTABLE} ${EbsdLibProj_SOURCE_DIR}/Source/Python/Test/EbsdLibModuleTest.py ${EbsdLibProj_SOURCE_DIR}/Data/EbsdTestFiles/Test_1.ang
+  )
+  set_tests_properties(EbsdLibPythonTest PROPERTIES ENVIRONMENT "PYTHONPATH=$<TARGET_FILE_DIR:_ebsdlib>")
+endif()
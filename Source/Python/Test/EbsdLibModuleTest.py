@@ -0,0 +1,110 @@
+"""
+Smoke test of the _ebsdlib Python module. Reads a small .ang file and checks the data columns against the values in
+the file, and checks convert_orientations against values computed with the C++ OrientationConverter classes.
+
+Usage: python EbsdLibModuleTest.py <path/to/Test_1.ang>
+The directory holding the compiled _ebsdlib module has to be on the Python path.
+"""
+import sys
+
+import numpy as np
+
+import _ebsdlib
+
+# Every column of a .ang file in the order they are written
+ANG_COLUMNS = ['Phi1', 'Phi', 'Phi2', 'X Position', 'Y Position', 'Image Quality', 'Confidence Index', 'PhaseData', 'SEM Signal', 'Fit']
+
+EULERS = np.array([[0.1, 0.2, 0.3], [1.0, 0.5, 2.0], [3.0, 1.2, 5.5]], dtype=np.float32)
+
+# The output of EulerConverter<EbsdDataArray<float>, float> for EULERS
+EXPECTED = {
+  'om': [
+    [0.921649158, 0.383557081, 0.0587108023, -0.387517214, 0.90211308, 0.18979606, 0.0198338386, -0.197676808, 0.980066597],
+    [-0.896325111, 0.0809768438, 0.435940415, -0.183987588, -0.962467492, -0.199511424, 0.403422683, -0.259034723, 0.87758255],
+    [-0.66549933, 0.353106946, -0.657591105, -0.734718084, -0.154656276, 0.660507917, 0.131529361, 0.92271173, 0.362357706],
+  ],
+  'qu': [
+    [-0.0993346721, 0.00996671245, -0.197676808, 0.975170374],
+    [-0.217117399, 0.118611783, -0.966485322, 0.0685381517],
+    [0.178044409, -0.535837054, -0.738666594, 0.368171901],
+  ],
+  'ho': [
+    [-0.0998325571, 0.0100166677, -0.198667616],
+    [-0.280918151, 0.153466284, -1.25049055],
+    [0.207765892, -0.625285923, -0.861974359],
+  ],
+}
+
+
+def read_ang(filepath: str) -> _ebsdlib.AngReader:
+  reader = _ebsdlib.AngReader()
+  reader.file_name = filepath
+  err = reader.read_file()
+  assert err >= 0, f'{filepath}: {reader.error_message} ({err})'
+  return reader
+
+
+def test_columns(filepath: str) -> None:
+  text = np.loadtxt(filepath, comments='#', dtype=np.float64)
+  reader = read_ang(filepath)
+  assert reader.number_of_elements == text.shape[0]
+
+  columns = reader.columns()
+  assert list(columns.keys()) == ANG_COLUMNS
+  for index, name in enumerate(ANG_COLUMNS):
+    column = columns[name]
+    assert column.shape == (text.shape[0],), name
+    expected = text[:, index].astype(column.dtype)
+    np.testing.assert_allclose(column, expected, rtol=1.0e-6, err_msg=name)
+  assert columns['PhaseData'].dtype == np.int32
+
+  # The columns were moved out of the reader, so they can not be taken twice
+  try:
+    reader.column('Phi1')
+    assert False, 'A column was returned twice'
+  except KeyError:
+    pass
+  assert reader.columns() == {}
+
+  # The arrays own the reader's memory, so they are unchanged by a second read and outlive the reader
+  reader.read_file()
+  again = reader.column('Phi1')
+  assert not np.shares_memory(columns['Phi1'], again)
+  np.testing.assert_array_equal(again, columns['Phi1'])
+  again[:] = -1.0
+  np.testing.assert_allclose(columns['Phi1'], text[:, 0].astype(np.float32), rtol=1.0e-6)
+  del reader
+  np.testing.assert_array_equal(columns['Image Quality'], text[:, 5].astype(np.float32))
+
+
+def test_convert_orientations() -> None:
+  for output_type, expected in EXPECTED.items():
+    for dtype in (np.float32, np.float64):
+      eulers = EULERS.astype(dtype)
+      result = _ebsdlib.convert_orientations(eulers, 'eu', output_type)
+      np.testing.assert_array_equal(eulers, EULERS.astype(dtype), err_msg='The input was modified')
+      assert result.dtype == dtype, output_type
+      np.testing.assert_allclose(result, np.array(expected), rtol=1.0e-5, atol=1.0e-6, err_msg=f'{output_type} {dtype}')
+
+  # eu -> qu -> eu returns the input
+  quats = _ebsdlib.convert_orientations(EULERS, 'eu', 'qu')
+  np.testing.assert_allclose(_ebsdlib.convert_orientations(quats, 'qu', 'eu'), EULERS, atol=1.0e-5)
+
+  # Out of range input values are corrected in the converter's copy, not in the caller's array
+  wrapped = np.array([[7.0, 0.5, -1.0]], dtype=np.float64)
+  _ebsdlib.convert_orientations(wrapped, 'eu', 'qu')
+  np.testing.assert_array_equal(wrapped, [[7.0, 0.5, -1.0]])
+
+
+def main() -> int:
+  if len(sys.argv) != 2:
+    print(__doc__)
+    return 1
+  test_columns(sys.argv[1])
+  test_convert_orientations()
+  print('EbsdLibModuleTest passed')
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -33,15 +33,31 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
 
+#include "EbsdLib/Core/EbsdTransform.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/IO/EbsdBinaryCache.h"
+#include "EbsdLib/IO/EbsdHeaderScanner.h"
+#include "EbsdLib/IO/TSL/AngFields.h"
 #include "EbsdLib/IO/TSL/AngReader.h"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/EbsdMatrixMath.h"
 
 #ifdef EbsdLib_ENABLE_HDF5
 #include "EbsdLib/IO/TSL/H5AngImporter.h"
+#include "EbsdLib/IO/TSL/H5AngVolumeReader.h"
 #include "H5Support/H5Lite.h"
 #include "H5Support/H5Utilities.h"
 #endif
@@ -132,6 +148,542 @@ public:
     DREAM3D_REQUIRED(err, ==, -400)
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestHexGridToSquareGrid()
+  {
+    // The rows of this file are not offset, so resampling at the file's own step must reproduce the hexagonal data
+    AngReader hexReader;
+    hexReader.setFileName(UnitTest::AngImportTest::HexHeader);
+    hexReader.setReadHexGrid(true);
+    int err = hexReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    AngReader reader;
+    reader.setFileName(UnitTest::AngImportTest::HexHeader);
+    reader.setConvertHexGridToSquareGrid(true);
+    err = reader.readFile();
+    if(err != 0)
+    {
+      DREAM3D_TEST_THROW_EXCEPTION("readFile() failed with error " + std::to_string(err) + ": " + reader.getErrorMessage())
+    }
+    DREAM3D_REQUIRE_EQUAL(reader.getGrid(), EbsdLib::Ang::SquareGrid)
+    DREAM3D_REQUIRED(reader.getNumberOfElements(), ==, hexReader.getNumberOfElements())
+    DREAM3D_REQUIRED(reader.getXDimension(), ==, 40)
+    DREAM3D_REQUIRED(reader.getYDimension(), ==, 4)
+    for(size_t i = 0; i < reader.getNumberOfElements(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(reader.getSEMSignalPointer()[i], hexReader.getSEMSignalPointer()[i])
+    }
+
+    // A true hexagonal grid: even rows are shifted by half a step and have one column less
+    const int numRows = 5;
+    const int numOddCols = 6;
+    const int numEvenCols = 5;
+    const float hexStep = 1.0f;
+    const float rowStep = 0.866025f;
+    std::string hexFile = UnitTest::TestTempDir + "/HexToSquareGrid.ang";
+    {
+      std::ofstream out(hexFile, std::ios_base::out);
+      out << "# Phase 1\n# MaterialName  \tNickel\n# Symmetry              43\n# GRID: HexGrid\n# XSTEP: " << hexStep << "\n# YSTEP: " << rowStep << "\n# NCOLS_ODD: " << numOddCols
+          << "\n# NCOLS_EVEN: " << numEvenCols << "\n# NROWS: " << numRows << "\n#\n";
+      int index = 0;
+      for(int row = 0; row < numRows; row++)
+      {
+        int numCols = (row % 2 == 0) ? numOddCols : numEvenCols;
+        float offset = (row % 2 == 0) ? 0.0f : 0.5f * hexStep;
+        for(int col = 0; col < numCols; col++)
+        {
+          out << static_cast<float>(index) << " 0.0 0.0 " << offset + col * hexStep << " " << row * rowStep << " 100.0 0.5 1 0 1.0\n";
+          index++;
+        }
+      }
+    }
+
+    AngReader squareReader;
+    squareReader.setFileName(hexFile);
+    squareReader.setConvertHexGridToSquareGrid(true);
+    squareReader.setSquareGridStep(0.5f);
+    err = squareReader.readFile();
+    if(err != 0)
+    {
+      DREAM3D_TEST_THROW_EXCEPTION("readFile() failed with error " + std::to_string(err) + ": " + squareReader.getErrorMessage())
+    }
+    DREAM3D_REQUIRE_EQUAL(squareReader.getXStep(), 0.5f)
+    DREAM3D_REQUIRE_EQUAL(squareReader.getYStep(), 0.5f)
+    const int numSquareCols = squareReader.getXDimension();
+    const int numSquareRows = squareReader.getYDimension();
+    DREAM3D_REQUIRED(numSquareCols, ==, 11)
+    DREAM3D_REQUIRED(numSquareRows, ==, 7)
+    DREAM3D_REQUIRED(squareReader.getNumberOfElements(), ==, static_cast<size_t>(numSquareCols * numSquareRows))
+
+    // Every square grid point carries the index of a nearest hexagonal point in phi1. Equidistant points may be
+    // resolved either way, so the distance to the chosen point is compared against the brute force minimum.
+    auto hexPosition = [&](int index, float& hexX, float& hexY) {
+      int row = 0;
+      while(index >= ((row % 2 == 0) ? numOddCols : numEvenCols))
+      {
+        index -= (row % 2 == 0) ? numOddCols : numEvenCols;
+        row++;
+      }
+      hexX = ((row % 2 == 0) ? 0.0f : 0.5f * hexStep) + static_cast<float>(index) * hexStep;
+      hexY = static_cast<float>(row) * rowStep;
+    };
+    const int numHexPoints = (numRows / 2 + 1) * numOddCols + (numRows / 2) * numEvenCols;
+    for(int i = 0; i < numSquareCols * numSquareRows; i++)
+    {
+      float x = squareReader.getXPositionPointer()[i];
+      float y = squareReader.getYPositionPointer()[i];
+      DREAM3D_REQUIRE(std::fabs(x - 0.5f * static_cast<float>(i % numSquareCols)) < 1.0E-5f)
+      DREAM3D_REQUIRE(std::fabs(y - 0.5f * static_cast<float>(i / numSquareCols)) < 1.0E-5f)
+
+      float hexX = 0.0f;
+      float hexY = 0.0f;
+      float bestDistance = std::numeric_limits<float>::max();
+      for(int index = 0; index < numHexPoints; index++)
+      {
+        hexPosition(index, hexX, hexY);
+        bestDistance = std::min(bestDistance, (x - hexX) * (x - hexX) + (y - hexY) * (y - hexY));
+      }
+      hexPosition(static_cast<int>(squareReader.getPhi1Pointer()[i]), hexX, hexY);
+      DREAM3D_REQUIRE((x - hexX) * (x - hexX) + (y - hexY) * (y - hexY) <= bestDistance + 1.0E-4f)
+    }
+    std::remove(hexFile.c_str());
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestApplyTransformations()
+  {
+    const int numCols = 5;
+    const int numRows = 3;
+    std::string angFile = UnitTest::TestTempDir + "/ApplyTransformations.ang";
+    {
+      std::ofstream out(angFile, std::ios_base::out);
+      out << "# Phase 1\n# MaterialName  \tNickel\n# Symmetry              43\n# GRID: SqrGrid\n# XSTEP: 1.0\n# YSTEP: 1.0\n# NCOLS_ODD: " << numCols << "\n# NCOLS_EVEN: " << numCols
+          << "\n# NROWS: " << numRows << "\n#\n";
+      for(int i = 0; i < numCols * numRows; i++)
+      {
+        out << 0.1f + 0.4f * static_cast<float>(i) << " " << 0.05f + 0.2f * static_cast<float>(i) << " " << 6.0f - 0.35f * static_cast<float>(i) << " " << i % numCols << " " << i / numCols << " "
+            << static_cast<float>(i) << " 0.5 1 0 1.0\n";
+      }
+    }
+
+    AngReader plainReader;
+    plainReader.setFileName(angFile);
+    int err = plainReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    // The standard TSL transformation: 180 degrees about <010> for the sample and 90 degrees about <001> for the Eulers
+    AngReader reader;
+    reader.setFileName(angFile);
+    reader.setApplyTransformations(true);
+    reader.setSampleTransformationAngle(180.0f);
+    reader.setSampleTransformationAxis({0.0f, 1.0f, 0.0f});
+    reader.setEulerTransformationAngle(90.0f);
+    reader.setEulerTransformationAxis({0.0f, 0.0f, 1.0f});
+    err = reader.readFile();
+    std::cout << reader.getErrorMessage();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    double rotation[3][3];
+    OrientationTransformation::ax2om<OrientationD, OrientationD>(OrientationD(0.0, 0.0, 1.0, EbsdLib::Constants::k_PiOver2D)).toGMatrix(rotation);
+    for(int i = 0; i < numCols * numRows; i++)
+    {
+      // A 180 degree rotation about Y mirrors the columns of a single slice
+      int source = (i / numCols) * numCols + (numCols - 1 - i % numCols);
+      DREAM3D_REQUIRE_EQUAL(reader.getImageQualityPointer()[i], plainReader.getImageQualityPointer()[source])
+      DREAM3D_REQUIRE_EQUAL(reader.getXPositionPointer()[i], plainReader.getXPositionPointer()[i])
+
+      double g[3][3];
+      double expected[3][3];
+      double actual[3][3];
+      OrientationD eu(plainReader.getPhi1Pointer()[source], plainReader.getPhiPointer()[source], plainReader.getPhi2Pointer()[source]);
+      OrientationTransformation::eu2om<OrientationD, OrientationD>(eu).toGMatrix(g);
+      EbsdMatrixMath::Multiply3x3with3x3(g, rotation, expected);
+      eu = OrientationD(reader.getPhi1Pointer()[i], reader.getPhiPointer()[i], reader.getPhi2Pointer()[i]);
+      OrientationTransformation::eu2om<OrientationD, OrientationD>(eu).toGMatrix(actual);
+      for(size_t r = 0; r < 3; r++)
+      {
+        for(size_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRE(std::fabs(actual[r][c] - expected[r][c]) < 1.0E-5)
+        }
+      }
+    }
+
+    // Rotations that do not just reorder the points are rejected
+    AngReader unsupportedReader;
+    unsupportedReader.setFileName(angFile);
+    unsupportedReader.setApplyTransformations(true);
+    unsupportedReader.setSampleTransformationAngle(45.0f);
+    err = unsupportedReader.readFile();
+    DREAM3D_REQUIRED(err, <, 0)
+    std::remove(angFile.c_str());
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSlicePlacementIndex()
+  {
+    // Exposes the volume handling of EbsdReader::applyTransformations() on arrays that were assembled by hand
+    class VolumeReader : public AngReader
+    {
+    public:
+      using AngReader::applyTransformations;
+      using AngReader::setImageQualityPointer;
+    };
+
+    // The slices are smaller than the volume by an odd number of points, so they are not centered exactly
+    const size_t xVolume = 6;
+    const size_t yVolume = 5;
+    const size_t numSlices = 2;
+    const size_t planeSize = xVolume * yVolume;
+    const std::array<std::array<size_t, 2>, numSlices> sliceDims = {{{6, 5}, {3, 2}}};
+    const std::array<std::array<float, 3>, 3> axes = {{{0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}}};
+
+    for(const std::array<float, 3>& axis : axes)
+    {
+      // What the volume readers load without transformations, with -1 where no slice has data
+      VolumeReader reader;
+      reader.setXDimension(static_cast<int>(xVolume));
+      reader.setYDimension(static_cast<int>(yVolume));
+      reader.setNumberOfElements(planeSize * numSlices);
+      auto* expected = new float[planeSize * numSlices];
+      std::fill(expected, expected + planeSize * numSlices, -1.0f);
+      for(size_t z = 0; z < numSlices; z++)
+      {
+        const size_t xStart = (xVolume - sliceDims[z][0]) / 2;
+        const size_t yStart = (yVolume - sliceDims[z][1]) / 2;
+        for(size_t i = 0; i < sliceDims[z][0] * sliceDims[z][1]; i++)
+        {
+          expected[z * planeSize + (i / sliceDims[z][0] + yStart) * xVolume + (i % sliceDims[z][0] + xStart)] = static_cast<float>(100 * z + i);
+        }
+      }
+      reader.setImageQualityPointer(expected);
+      reader.setSampleTransformationAngle(180.0f);
+      reader.setSampleTransformationAxis(axis);
+      int err = reader.applyTransformations({EbsdLib::Ang::Phi1, EbsdLib::Ang::Phi, EbsdLib::Ang::Phi2}, {EbsdLib::Ang::ImageQuality}, false);
+      DREAM3D_REQUIRED(err, ==, 0)
+
+      // What the volume readers load with the transformations applied slice by slice
+      std::vector<float> actual(planeSize * numSlices, -1.0f);
+      for(size_t z = 0; z < numSlices; z++)
+      {
+        std::vector<size_t> destIndex;
+        bool flipsZ = false;
+        DREAM3D_REQUIRE(EbsdTransform::SlicePlacementIndex(180.0f, axis, sliceDims[z][0], sliceDims[z][1], xVolume, yVolume, destIndex, flipsZ))
+        DREAM3D_REQUIRE_EQUAL(destIndex.size(), sliceDims[z][0] * sliceDims[z][1])
+        const size_t zval = flipsZ ? numSlices - 1 - z : z;
+        for(size_t i = 0; i < destIndex.size(); i++)
+        {
+          actual[zval * planeSize + destIndex[i]] = static_cast<float>(100 * z + i);
+        }
+      }
+
+      for(size_t i = 0; i < planeSize * numSlices; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(actual[i], reader.getImageQualityPointer()[i])
+      }
+    }
+
+    // Slices larger than the volume can not be placed
+    std::vector<size_t> destIndex;
+    bool flipsZ = false;
+    DREAM3D_REQUIRE(!EbsdTransform::SlicePlacementIndex(180.0f, {0.0f, 1.0f, 0.0f}, xVolume + 1, yVolume, xVolume, yVolume, destIndex, flipsZ))
+  }
+
+#ifdef EbsdLib_ENABLE_HDF5
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestVolumeReaderTransformations()
+  {
+    // Exposes the volume handling of EbsdReader::applyTransformations() on arrays that were assembled by hand
+    class VolumeReader : public AngReader
+    {
+    public:
+      using AngReader::applyTransformations;
+      using AngReader::setImageQualityPointer;
+      using AngReader::setPhaseDataPointer;
+      using AngReader::setPhi1Pointer;
+      using AngReader::setPhiPointer;
+      using AngReader::setPhi2Pointer;
+    };
+
+    // The second slice is smaller than the volume by an odd number of points in X and Y
+    const int64_t xVolume = 6;
+    const int64_t yVolume = 5;
+    const int64_t numSlices = 2;
+    const size_t numPoints = static_cast<size_t>(xVolume * yVolume * numSlices);
+    const std::array<std::array<int, 2>, 2> sliceDims = {{{6, 5}, {3, 2}}};
+    std::string h5File = UnitTest::TestTempDir + "/VolumeReaderTransformations.h5ebsd";
+    {
+      hid_t fileId = H5Utilities::createFile(h5File);
+      DREAM3D_REQUIRE(fileId > 0)
+      for(int64_t z = 0; z < numSlices; z++)
+      {
+        const int numCols = sliceDims[z][0];
+        const int numRows = sliceDims[z][1];
+        std::string angFile = UnitTest::TestTempDir + "/VolumeReaderTransformations_" + std::to_string(z) + ".ang";
+        {
+          std::ofstream out(angFile, std::ios_base::out);
+          out << "# Phase 1\n# MaterialName  \tNickel\n# Symmetry              43\n# GRID: SqrGrid\n# XSTEP: 1.0\n# YSTEP: 1.0\n# NCOLS_ODD: " << numCols << "\n# NCOLS_EVEN: " << numCols
+              << "\n# NROWS: " << numRows << "\n#\n";
+          for(int i = 0; i < numCols * numRows; i++)
+          {
+            // The image quality identifies each point and is never 0, which marks the points that no slice covers
+            const auto value = static_cast<float>(100 * z + i);
+            out << 0.1f + 0.04f * value << " " << 0.05f + 0.02f * value << " " << 6.0f - 0.035f * value << " " << i % numCols << " " << i / numCols << " " << 1.0f + value << " 0.5 1 0 1.0\n";
+          }
+        }
+        EbsdImporter::Pointer importer = H5AngImporter::New();
+        int err = importer->importFile(fileId, z, angFile);
+        DREAM3D_REQUIRED(err, >=, 0)
+        std::remove(angFile.c_str());
+      }
+
+      // The volume header, with the standard TSL transformations
+      const int64_t zStart = 0;
+      const int64_t zEnd = numSlices - 1;
+      const float resolution = 1.0f;
+      const uint32_t stackingOrder = EbsdLib::RefFrameZDir::LowtoHigh;
+      const float sampleAngle = 180.0f;
+      const float eulerAngle = 90.0f;
+      const std::vector<float> sampleAxis = {0.0f, 1.0f, 0.0f};
+      const std::vector<float> eulerAxis = {0.0f, 0.0f, 1.0f};
+      hsize_t axisDims[1] = {3};
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZStartIndex, zStart), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZEndIndex, zEnd), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::XPoints, xVolume), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::YPoints, yVolume), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::XResolution, resolution), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::YResolution, resolution), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::ZResolution, resolution), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::StackingOrder, stackingOrder), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::SampleTransformationAngle, sampleAngle), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writePointerDataset(fileId, EbsdLib::H5Ebsd::SampleTransformationAxis, 1, axisDims, sampleAxis.data()), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeScalarDataset(fileId, EbsdLib::H5Ebsd::EulerTransformationAngle, eulerAngle), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writePointerDataset(fileId, EbsdLib::H5Ebsd::EulerTransformationAxis, 1, axisDims, eulerAxis.data()), >=, 0)
+      DREAM3D_REQUIRED(H5Lite::writeStringDataset(fileId, EbsdLib::H5Ebsd::Manufacturer, EbsdLib::Ang::Manufacturer), >=, 0)
+      H5Utilities::closeFile(fileId);
+    }
+
+    auto loadVolume = [&](bool applyTransformations) {
+      std::shared_ptr<H5AngVolumeReader> volumeReader = std::dynamic_pointer_cast<H5AngVolumeReader>(H5AngVolumeReader::New());
+      volumeReader->setFileName(h5File);
+      volumeReader->setSliceStart(0);
+      volumeReader->setSliceEnd(static_cast<int>(numSlices - 1));
+      volumeReader->setApplyTransformations(applyTransformations);
+      volumeReader->readAllArrays(true);
+      int err = volumeReader->loadData(xVolume, yVolume, numSlices, EbsdLib::RefFrameZDir::LowtoHigh);
+      DREAM3D_REQUIRED(err, >=, 0)
+      return volumeReader;
+    };
+    std::shared_ptr<H5AngVolumeReader> plain = loadVolume(false);
+    std::shared_ptr<H5AngVolumeReader> transformed = loadVolume(true);
+
+    // Apply the same transformations to the whole volume that was loaded without them
+    VolumeReader expected;
+    expected.setXDimension(static_cast<int>(xVolume));
+    expected.setYDimension(static_cast<int>(yVolume));
+    expected.setNumberOfElements(numPoints);
+    expected.setSampleTransformationAngle(180.0f);
+    expected.setSampleTransformationAxis({0.0f, 1.0f, 0.0f});
+    expected.setEulerTransformationAngle(90.0f);
+    expected.setEulerTransformationAxis({0.0f, 0.0f, 1.0f});
+    expected.setPhi1Pointer(plain->getPhi1Pointer(true));
+    expected.setPhiPointer(plain->getPhiPointer(true));
+    expected.setPhi2Pointer(plain->getPhi2Pointer(true));
+    expected.setImageQualityPointer(plain->getImageQualityPointer(true));
+    expected.setPhaseDataPointer(plain->getPhaseDataPointer(true));
+    int err = expected.applyTransformations({EbsdLib::Ang::Phi1, EbsdLib::Ang::Phi, EbsdLib::Ang::Phi2}, {EbsdLib::Ang::ImageQuality, EbsdLib::Ang::PhaseData}, false);
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    size_t numCovered = 0;
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(transformed->getImageQualityPointer()[i], expected.getImageQualityPointer()[i])
+      DREAM3D_REQUIRE_EQUAL(transformed->getPhaseDataPointer()[i], expected.getPhaseDataPointer()[i])
+      if(expected.getImageQualityPointer()[i] == 0.0f)
+      {
+        continue;
+      }
+      // Only the points covered by a slice have Euler angles, the others are 0 in one volume and rotated in the other
+      numCovered++;
+      double actualG[3][3];
+      double expectedG[3][3];
+      OrientationD eu(transformed->getPhi1Pointer()[i], transformed->getPhiPointer()[i], transformed->getPhi2Pointer()[i]);
+      OrientationTransformation::eu2om<OrientationD, OrientationD>(eu).toGMatrix(actualG);
+      eu = OrientationD(expected.getPhi1Pointer()[i], expected.getPhiPointer()[i], expected.getPhi2Pointer()[i]);
+      OrientationTransformation::eu2om<OrientationD, OrientationD>(eu).toGMatrix(expectedG);
+      for(size_t r = 0; r < 3; r++)
+      {
+        for(size_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRE(std::fabs(actualG[r][c] - expectedG[r][c]) < 1.0E-5)
+        }
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(numCovered, static_cast<size_t>(6 * 5 + 3 * 2))
+    std::remove(h5File.c_str());
+  }
+#endif
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBinaryCache()
+  {
+    std::string angFile = UnitTest::TestTempDir + "/BinaryCache.ang";
+    std::string cacheFile = EbsdBinaryCache::CacheFilePath(angFile);
+    fs::remove(cacheFile);
+    fs::copy_file(UnitTest::AngImportTest::TestFile1, angFile, fs::copy_options::overwrite_existing);
+
+    AngReader parsedReader;
+    parsedReader.setFileName(angFile);
+    parsedReader.setUseBinaryCache(true);
+    int err = parsedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE(fs::exists(cacheFile))
+
+    AngReader cachedReader;
+    cachedReader.setFileName(angFile);
+    cachedReader.setUseBinaryCache(true);
+    err = cachedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    size_t numElements = cachedReader.getNumberOfElements();
+    DREAM3D_REQUIRED(numElements, ==, parsedReader.getNumberOfElements())
+    DREAM3D_REQUIRED(cachedReader.getNumFeatures(), ==, parsedReader.getNumFeatures())
+    for(size_t i = 0; i < numElements; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(cachedReader.getPhi1Pointer()[i], parsedReader.getPhi1Pointer()[i])
+      DREAM3D_REQUIRE_EQUAL(cachedReader.getImageQualityPointer()[i], parsedReader.getImageQualityPointer()[i])
+      DREAM3D_REQUIRE_EQUAL(cachedReader.getPhaseDataPointer()[i], parsedReader.getPhaseDataPointer()[i])
+      DREAM3D_REQUIRE_EQUAL(cachedReader.getYPositionPointer()[i], parsedReader.getYPositionPointer()[i])
+    }
+
+    // Replace the cached values so that a read that uses the cache can be told apart from one that parses the file
+    std::vector<float> marker(numElements, 0.25f);
+    std::vector<EbsdBinaryCache::Column> columns;
+    for(const auto& name : AngFields().getFieldNames())
+    {
+      if(parsedReader.getPointerByName(name) != nullptr)
+      {
+        columns.push_back({name, parsedReader.getPointerType(name), parsedReader.getPointerByName(name)});
+      }
+    }
+    for(auto& column : columns)
+    {
+      if(column.name == EbsdLib::Ang::ImageQuality)
+      {
+        column.data = marker.data();
+      }
+    }
+    EbsdBinaryCache::Write(angFile, "AngReader", numElements, parsedReader.getNumFeatures(), columns);
+    AngReader markerReader;
+    markerReader.setFileName(angFile);
+    markerReader.setUseBinaryCache(true);
+    err = markerReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE_EQUAL(markerReader.getImageQualityPointer()[0], 0.25f)
+    DREAM3D_REQUIRE_EQUAL(markerReader.getPhi1Pointer()[0], parsedReader.getPhi1Pointer()[0])
+
+    // A cache that is missing any of the reader's columns is ignored and the file is parsed
+    EbsdBinaryCache::Write(angFile, "AngReader", numElements, parsedReader.getNumFeatures(), {{EbsdLib::Ang::ImageQuality, EbsdLib::NumericTypes::Type::Float, marker.data()}});
+    AngReader partialReader;
+    partialReader.setFileName(angFile);
+    partialReader.setUseBinaryCache(true);
+    err = partialReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    for(size_t i = 0; i < numElements; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(partialReader.getImageQualityPointer()[i], parsedReader.getImageQualityPointer()[i])
+      DREAM3D_REQUIRE_EQUAL(partialReader.getPhi1Pointer()[i], parsedReader.getPhi1Pointer()[i])
+      DREAM3D_REQUIRE_EQUAL(partialReader.getPhaseDataPointer()[i], parsedReader.getPhaseDataPointer()[i])
+    }
+
+    // A cached column whose type does not match the reader's is ignored as well
+    for(auto& column : columns)
+    {
+      if(column.name == EbsdLib::Ang::ImageQuality)
+      {
+        column.type = EbsdLib::NumericTypes::Type::Int32;
+      }
+    }
+    EbsdBinaryCache::Write(angFile, "AngReader", numElements, parsedReader.getNumFeatures(), columns);
+    AngReader mistypedReader;
+    mistypedReader.setFileName(angFile);
+    mistypedReader.setUseBinaryCache(true);
+    err = mistypedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE_EQUAL(mistypedReader.getImageQualityPointer()[0], parsedReader.getImageQualityPointer()[0])
+
+    // A source file that changed after the cache was written is parsed again
+    {
+      std::ofstream out(angFile, std::ios_base::out | std::ios_base::app);
+      out << "\n";
+    }
+    AngReader changedReader;
+    changedReader.setFileName(angFile);
+    changedReader.setUseBinaryCache(true);
+    err = changedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE_EQUAL(changedReader.getImageQualityPointer()[0], parsedReader.getImageQualityPointer()[0])
+
+#if REMOVE_TEST_FILES
+    fs::remove(angFile);
+    fs::remove(cacheFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestHeaderScanner()
+  {
+    std::vector<std::string> files = {UnitTest::AngImportTest::TestFile1, UnitTest::AngImportTest::HexHeader, UnitTest::TestTempDir + "/DoesNotExist.ang", UnitTest::AngImportTest::TestFile1 + ".txt"};
+    std::vector<EbsdHeaderScanner::HeaderInfo> headers = EbsdHeaderScanner::ScanFiles(files);
+    DREAM3D_REQUIRED(headers.size(), ==, files.size())
+
+    for(size_t f = 0; f < 2; f++)
+    {
+      AngReader reader;
+      reader.setFileName(files[f]);
+      reader.readHeaderOnly();
+      const EbsdHeaderScanner::HeaderInfo& header = headers[f];
+      DREAM3D_REQUIRED(header.errorCode, ==, 0)
+      DREAM3D_REQUIRE(header.fileType == EbsdHeaderScanner::FileType::Ang)
+      DREAM3D_REQUIRE(header.gridType == (reader.getGrid() == EbsdLib::Ang::HexGrid ? EbsdHeaderScanner::GridType::Hex : EbsdHeaderScanner::GridType::Square))
+      DREAM3D_REQUIRED(header.xCells, ==, reader.getNumOddCols())
+      DREAM3D_REQUIRED(header.xCellsEven, ==, reader.getNumEvenCols())
+      DREAM3D_REQUIRED(header.yCells, ==, reader.getNumRows())
+      DREAM3D_REQUIRE_EQUAL(header.xStep, reader.getXStep())
+      DREAM3D_REQUIRE_EQUAL(header.yStep, reader.getYStep())
+      DREAM3D_REQUIRED(header.numPhases, ==, static_cast<int32_t>(reader.getPhaseVector().size()))
+      for(size_t p = 0; p < reader.getPhaseVector().size(); p++)
+      {
+        DREAM3D_REQUIRED(header.crystalStructures[p], ==, reader.getPhaseVector()[p]->determineLaueGroup())
+      }
+    }
+    DREAM3D_REQUIRED(headers[0].numberOfPoints, ==, 160)
+    DREAM3D_REQUIRED(headers[2].errorCode, ==, -100)
+    DREAM3D_REQUIRED(headers[3].errorCode, ==, -101)
+
+    // A header cut off by the end of the buffer is reported as incomplete
+    std::ifstream in(UnitTest::AngImportTest::TestFile1, std::ios_base::in | std::ios_base::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EbsdHeaderScanner::HeaderInfo partial = EbsdHeaderScanner::ScanAngHeader(contents.data(), headers[0].headerSize / 2, false);
+    DREAM3D_REQUIRED(partial.errorCode, ==, -102)
+    EbsdHeaderScanner::HeaderInfo complete = EbsdHeaderScanner::ScanAngHeader(contents.data(), contents.size(), true);
+    DREAM3D_REQUIRED(complete.errorCode, ==, 0)
+    DREAM3D_REQUIRE(contents[complete.headerSize] != '#')
+    DREAM3D_REQUIRE(contents[complete.headerSize - 1] == '\n')
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -163,6 +715,32 @@ public:
     DREAM3D_REQUIRED(ptr[159], ==, 12.56637f)
   }
 
+  // -----------------------------------------------------------------------------
+  void TestReleasePointerByName()
+  {
+    AngReader reader;
+    reader.setFileName(UnitTest::AngImportTest::TestFile1);
+    int err = reader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+
+    // The released column belongs to the caller and the reader forgets it
+    float* phi1 = static_cast<float*>(reader.releasePointerByName(EbsdLib::Ang::Phi1));
+    DREAM3D_REQUIRE(phi1 != nullptr)
+    DREAM3D_REQUIRED(phi1[159], ==, 12.56637f)
+    DREAM3D_REQUIRE(reader.getPhi1Pointer() == nullptr)
+    DREAM3D_REQUIRE(reader.releasePointerByName(EbsdLib::Ang::Phi1) == nullptr)
+    DREAM3D_REQUIRE(reader.releasePointerByName("Not A Column") == nullptr)
+
+    // The next read allocates a new column that the reader owns again
+    err = reader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE(reader.getPhi1Pointer() != nullptr)
+    DREAM3D_REQUIRE(reader.getPhi1Pointer() != phi1)
+    DREAM3D_REQUIRE(reader.getPhi1Ownership())
+    DREAM3D_REQUIRED(reader.getPhi1Pointer()[159], ==, phi1[159])
+    delete[] phi1;
+  }
+
   void operator()()
   {
     int err = EXIT_SUCCESS;
@@ -171,8 +749,17 @@ public:
     DREAM3D_REGISTER_TEST(TestNormalFile())
     DREAM3D_REGISTER_TEST(TestMissingHeaders())
     DREAM3D_REGISTER_TEST(TestHexGrid())
+    DREAM3D_REGISTER_TEST(TestHexGridToSquareGrid())
+    DREAM3D_REGISTER_TEST(TestApplyTransformations())
+    DREAM3D_REGISTER_TEST(TestSlicePlacementIndex())
+#ifdef EbsdLib_ENABLE_HDF5
+    DREAM3D_REGISTER_TEST(TestVolumeReaderTransformations())
+#endif
+    DREAM3D_REGISTER_TEST(TestBinaryCache())
+    DREAM3D_REGISTER_TEST(TestHeaderScanner())
     DREAM3D_REGISTER_TEST(TestMissingGrid())
     DREAM3D_REGISTER_TEST(TestShortFile())
+    DREAM3D_REGISTER_TEST(TestReleasePointerByName())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
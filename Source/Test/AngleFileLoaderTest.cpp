@@ -33,147 +33,249 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
-#include <stdlib.h>
-
-#include <stdio.h>
-
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 #include <string>
 
-#include <QtCore/QDir>
-#include <fstream>
-
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/EbsdLib.h"
-#include "EbsdLib/Utilities/IO/AngleFileLoader.h"
+#include "EbsdLib/IO/AngleFileLoader.h"
+#include "EbsdLib/Math/EbsdLibMath.h"
 
 #include "UnitTestSupport.hpp"
 
-#include "TestFileLocations.h"
+#include "EbsdLib/Test/EbsdLibTestFileLocations.h"
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void RemoveTestFiles()
+class AngleFileLoaderTest
 {
+public:
+  AngleFileLoaderTest() = default;
+  virtual ~AngleFileLoaderTest() = default;
+
+  AngleFileLoaderTest(const AngleFileLoaderTest&) = delete;            // Copy Constructor Not Implemented
+  AngleFileLoaderTest(AngleFileLoaderTest&&) = delete;                 // Move Constructor Not Implemented
+  AngleFileLoaderTest& operator=(const AngleFileLoaderTest&) = delete; // Copy Assignment Not Implemented
+  AngleFileLoaderTest& operator=(AngleFileLoaderTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(AngleFileLoaderTest)
+
+  const size_t k_AngleCount = 1000;
+
+  // -----------------------------------------------------------------------------
+  std::string getOutputFile() const
+  {
+    return UnitTest::TestTempDir + "/AngleFileLoaderTest.txt";
+  }
+
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
 #if REMOVE_TEST_FILES
-  std::fstream::remove(UnitTest::AngleFileLoaderTest::OutputFile);
+    fs::remove(getOutputFile());
 #endif
-}
+  }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void makeTestFile(const std::string delim, const std::string& outputFile)
-{
-  int count = 1000;
-  float e0, e1, e2;
+  // -----------------------------------------------------------------------------
+  float expectedAngle(size_t i, int comp) const
+  {
+    const float scale[3] = {0.001f, 0.0025f, 0.0058f};
+    return static_cast<float>(i) * scale[comp];
+  }
 
-  FILE* f = fopen(outputFile.c_str(), "wb");
+  // -----------------------------------------------------------------------------
+  void makeTestFile(const std::string& delim, const std::string& outputFile)
+  {
+    FILE* f = fopen(outputFile.c_str(), "wb");
+    fprintf(f, "# Angles written by the AngleFileLoaderTest\n");
+    fprintf(f, "Angle Count:%zu\n", k_AngleCount);
+    for(size_t i = 0; i < k_AngleCount; ++i)
+    {
+      fprintf(f, "%0.6f%s%0.6f%s%0.6f%s%0.6f%s%0.6f\n", expectedAngle(i, 0), delim.c_str(), expectedAngle(i, 1), delim.c_str(), expectedAngle(i, 2), delim.c_str(), 1.0f, delim.c_str(),
+              static_cast<float>(i));
+    }
+    fclose(f);
+  }
 
-  fprintf(f, "%d\n", count);
+  // -----------------------------------------------------------------------------
+  void checkAngles(const EbsdLib::FloatArrayType::Pointer& angles, float factor)
+  {
+    DREAM3D_REQUIRE_VALID_POINTER(angles.get())
+    DREAM3D_REQUIRE_EQUAL(angles->getNumberOfTuples(), k_AngleCount)
+    DREAM3D_REQUIRE_EQUAL(angles->getNumberOfComponents(), 5)
+    for(size_t i = 0; i < k_AngleCount; i++)
+    {
+      for(int c = 0; c < 3; c++)
+      {
+        float expected = expectedAngle(i, c) * factor;
+        DREAM3D_REQUIRE(std::fabs(angles->getComponent(i, c) - expected) <= 1.0E-5f * std::max(1.0f, std::fabs(expected)))
+      }
+      DREAM3D_REQUIRE_EQUAL(angles->getComponent(i, 3), 1.0f)
+      DREAM3D_REQUIRE_EQUAL(angles->getComponent(i, 4), static_cast<float>(i))
+    }
+  }
 
-  for(int i = 0; i < count; ++i)
+  // -----------------------------------------------------------------------------
+  void loadDelimited(const std::string& fileDelimiter, const std::string& delimiter, size_t readBlockSize)
   {
-    e0 = static_cast<float>(i) * 0.1;
-    e1 = static_cast<float>(i) * 0.25;
-    e2 = static_cast<float>(i) * 0.58;
-    fprintf(f, "%0.6f%s%0.6f%s%0.6f\n", e0, delim.c_str(), e1, delim.c_str(), e2);
+    makeTestFile(fileDelimiter, getOutputFile());
+
+    AngleFileLoader::Pointer reader = AngleFileLoader::New();
+    reader->setInputFile(getOutputFile());
+    reader->setDelimiter(delimiter);
+    reader->setAngleRepresentation(AngleFileLoader::EulerAngles);
+    reader->setReadBlockSize(readBlockSize);
+    EbsdLib::FloatArrayType::Pointer angles = reader->loadData();
+    int err = reader->getErrorCode();
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+    checkAngles(angles, 1.0f);
   }
-  fclose(f);
-}
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void TestLoadingSpaceDelimited()
-{
-  // Create a Teset File
-  makeTestFile(" ", UnitTest::AngleFileLoaderTest::OutputFile);
-
-  AngleFileLoader::Pointer reader = AngleFileLoader::New();
-  reader->setInputFile(UnitTest::AngleFileLoaderTest::OutputFile);
-  reader->setDelimiter(" ");
-  reader->setAngleRepresentation(AngleFileLoader::EulerAngles);
-  reader->loadData();
-  int err = reader->getErrorCode();
-  DREAM3D_REQUIRE_EQUAL(err, 0)
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void TestLoadingCommaDelimited()
-{
-  // Create a Teset File
-  makeTestFile(", ", UnitTest::AngleFileLoaderTest::OutputFile);
-
-  AngleFileLoader::Pointer reader = AngleFileLoader::New();
-  reader->setInputFile(UnitTest::AngleFileLoaderTest::OutputFile);
-  reader->setDelimiter(",");
-  reader->setAngleRepresentation(AngleFileLoader::EulerAngles);
-  reader->loadData();
-  int err = reader->getErrorCode();
-  DREAM3D_REQUIRE_EQUAL(err, 0)
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void TestLoadingSemiColonDelimited()
-{
-  // Create a Teset File
-  makeTestFile(";", UnitTest::AngleFileLoaderTest::OutputFile);
-
-  AngleFileLoader::Pointer reader = AngleFileLoader::New();
-  reader->setInputFile(UnitTest::AngleFileLoaderTest::OutputFile);
-  reader->setDelimiter(";");
-  reader->setAngleRepresentation(AngleFileLoader::EulerAngles);
-  reader->loadData();
-  int err = reader->getErrorCode();
-  DREAM3D_REQUIRE_EQUAL(err, 0)
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void TestLoadingTabDelimited()
-{
-  // Create a Teset File
-  makeTestFile("\t", UnitTest::AngleFileLoaderTest::OutputFile);
-
-  AngleFileLoader::Pointer reader = AngleFileLoader::New();
-  reader->setInputFile(UnitTest::AngleFileLoaderTest::OutputFile);
-  reader->setDelimiter("\t");
-  reader->setAngleRepresentation(AngleFileLoader::EulerAngles);
-  reader->loadData();
-  int err = reader->getErrorCode();
-  DREAM3D_REQUIRE_EQUAL(err, 0)
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-int main(int argc, char* argv[])
-{
-  std::cout << "<===== Start " << getNameOfClass() << std::endl;
+  // -----------------------------------------------------------------------------
+  void TestLoadingSpaceDelimited()
+  {
+    loadDelimited(" ", " ", AngleFileLoader::k_DefaultReadBlockSize);
+    loadDelimited("   ", " ", AngleFileLoader::k_DefaultReadBlockSize);
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestLoadingCommaDelimited()
+  {
+    loadDelimited(", ", ",", AngleFileLoader::k_DefaultReadBlockSize);
+  }
 
-  int err = EXIT_SUCCESS;
-  QDir dir(UnitTest::AngleFileLoaderTest::TestDir);
-  dir.mkpath(".");
+  // -----------------------------------------------------------------------------
+  void TestLoadingSemiColonDelimited()
+  {
+    loadDelimited(";", ";", AngleFileLoader::k_DefaultReadBlockSize);
+    loadDelimited(";;", ";", AngleFileLoader::k_DefaultReadBlockSize);
+  }
 
-#if !REMOVE_TEST_FILES
-  DREAM3D_REGISTER_TEST(RemoveTestFiles())
-#endif
+  // -----------------------------------------------------------------------------
+  void TestLoadingTabDelimited()
+  {
+    loadDelimited("\t", "\t", AngleFileLoader::k_DefaultReadBlockSize);
+  }
 
-  DREAM3D_REGISTER_TEST(TestLoadingSpaceDelimited())
-  DREAM3D_REGISTER_TEST(TestLoadingCommaDelimited())
-  DREAM3D_REGISTER_TEST(TestLoadingSemiColonDelimited())
-  DREAM3D_REGISTER_TEST(TestLoadingTabDelimited())
+  // -----------------------------------------------------------------------------
+  void TestSmallReadBlocks()
+  {
+    // Lines are split across blocks and some blocks are shorter than a single line
+    loadDelimited(",", ",", 7);
+    loadDelimited(" ", " ", 1000);
+  }
 
-#if REMOVE_TEST_FILES
-  DREAM3D_REGISTER_TEST(RemoveTestFiles())
-#endif
+  // -----------------------------------------------------------------------------
+  void TestDegreesAndQuaternions()
+  {
+    makeTestFile(" ", getOutputFile());
+
+    AngleFileLoader::Pointer reader = AngleFileLoader::New();
+    reader->setInputFile(getOutputFile());
+    reader->setDelimiter(" ");
+    reader->setFileAnglesInDegrees(true);
+    reader->setOutputAnglesInDegrees(false);
+    EbsdLib::FloatArrayType::Pointer angles = reader->loadData();
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), 0)
+    checkAngles(angles, EbsdLib::Constants::k_DegToRadF);
+
+    reader->setFileAnglesInDegrees(false);
+    reader->setOutputAnglesInDegrees(true);
+    angles = reader->loadData();
+    checkAngles(angles, EbsdLib::Constants::k_RadToDegF);
+
+    EbsdLib::FloatArrayType::Pointer quats = reader->loadQuaternions();
+    DREAM3D_REQUIRE_VALID_POINTER(quats.get())
+    DREAM3D_REQUIRE_EQUAL(quats->getNumberOfTuples(), k_AngleCount)
+    DREAM3D_REQUIRE_EQUAL(quats->getNumberOfComponents(), 4)
+    DREAM3D_REQUIRE_EQUAL(reader->getOutputAnglesInDegrees(), true)
+    for(size_t i = 0; i < k_AngleCount; i++)
+    {
+      OrientationF eu(expectedAngle(i, 0), expectedAngle(i, 1), expectedAngle(i, 2));
+      QuatF q = OrientationTransformation::eu2qu<OrientationF, QuatF>(eu);
+      DREAM3D_REQUIRE(std::fabs(quats->getComponent(i, 0) - q.x()) < 1.0E-4f)
+      DREAM3D_REQUIRE(std::fabs(quats->getComponent(i, 1) - q.y()) < 1.0E-4f)
+      DREAM3D_REQUIRE(std::fabs(quats->getComponent(i, 2) - q.z()) < 1.0E-4f)
+      DREAM3D_REQUIRE(std::fabs(quats->getComponent(i, 3) - q.w()) < 1.0E-4f)
+    }
+  }
 
-  PRINT_TEST_SUMMARY();
-  return err;
-}
+  // -----------------------------------------------------------------------------
+  void TestQuaternionRepresentation()
+  {
+    FILE* f = fopen(getOutputFile().c_str(), "wb");
+    fprintf(f, "Angle Count:3\n");
+    fprintf(f, "0.0 0.0 0.0 1.0 0.5 2.0\n");
+    fprintf(f, "# A comment line still uses up a tuple\n");
+    fprintf(f, "0.0 0.0 0.70710678 0.70710678 1.0 3.0\r\n");
+    fclose(f);
+
+    AngleFileLoader::Pointer reader = AngleFileLoader::New();
+    reader->setInputFile(getOutputFile());
+    reader->setDelimiter(" ");
+    reader->setAngleRepresentation(AngleFileLoader::QuaternionAngles);
+    EbsdLib::FloatArrayType::Pointer angles = reader->loadData();
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), 0)
+    DREAM3D_REQUIRE_VALID_POINTER(angles.get())
+    DREAM3D_REQUIRE_EQUAL(angles->getNumberOfTuples(), 3)
+    DREAM3D_REQUIRE_EQUAL(angles->getComponent(0, 3), 0.5f)
+    DREAM3D_REQUIRE_EQUAL(angles->getComponent(0, 4), 2.0f)
+    DREAM3D_REQUIRE_EQUAL(angles->getComponent(1, 4), 0.0f)
+    DREAM3D_REQUIRE_EQUAL(angles->getComponent(2, 3), 1.0f)
+    DREAM3D_REQUIRE_EQUAL(angles->getComponent(2, 4), 3.0f)
+    OrientationF eu = OrientationTransformation::qu2eu<QuatF, OrientationF>(QuatF(0.0f, 0.0f, 0.70710678f, 0.70710678f));
+    for(int c = 0; c < 3; c++)
+    {
+      DREAM3D_REQUIRE(std::fabs(angles->getComponent(2, c) - eu[c]) < 1.0E-5f)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestBadFiles()
+  {
+    AngleFileLoader::Pointer reader = AngleFileLoader::New();
+    reader->setInputFile(getOutputFile());
+    reader->setDelimiter(",");
+
+    FILE* f = fopen(getOutputFile().c_str(), "wb");
+    fprintf(f, "Count:3\n");
+    fclose(f);
+    DREAM3D_REQUIRE_NULL_POINTER(reader->loadData().get())
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -102)
+
+    f = fopen(getOutputFile().c_str(), "wb");
+    fprintf(f, "Angle Count:3\n1,2,3,4,5\n1,2,3,4,5\n");
+    fclose(f);
+    DREAM3D_REQUIRE_NULL_POINTER(reader->loadData().get())
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -104)
+
+    f = fopen(getOutputFile().c_str(), "wb");
+    fprintf(f, "Angle Count:3\n1,2,3,4,5\n1,2,x,4,5\n1,2,3,4\n");
+    fclose(f);
+    DREAM3D_REQUIRE_NULL_POINTER(reader->loadData().get())
+    DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -103)
+    DREAM3D_REQUIRE(reader->getErrorMessage().find("Line 3 ") != std::string::npos)
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = EXIT_SUCCESS;
+    fs::create_directories(UnitTest::TestTempDir);
+
+    DREAM3D_REGISTER_TEST(TestLoadingSpaceDelimited())
+    DREAM3D_REGISTER_TEST(TestLoadingCommaDelimited())
+    DREAM3D_REGISTER_TEST(TestLoadingSemiColonDelimited())
+    DREAM3D_REGISTER_TEST(TestLoadingTabDelimited())
+    DREAM3D_REGISTER_TEST(TestSmallReadBlocks())
+    DREAM3D_REGISTER_TEST(TestDegreesAndQuaternions())
+    DREAM3D_REGISTER_TEST(TestQuaternionRepresentation())
+    DREAM3D_REGISTER_TEST(TestBadFiles())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
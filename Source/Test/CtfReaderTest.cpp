@@ -38,7 +38,10 @@
 
 #include <cstring>
 #include <fstream>
+#include <vector>
 
+#include "EbsdLib/IO/EbsdBinaryCache.h"
+#include "EbsdLib/IO/EbsdHeaderScanner.h"
 #include "EbsdLib/IO/HKL/CtfReader.h"
 
 #include "UnitTestSupport.hpp"
@@ -87,6 +90,13 @@ public:
     float* euler3 = reinterpret_cast<float*>(reader.getPointerByName(EbsdLib::Ctf::Euler3));
     DREAM3D_REQUIRE(euler3 != nullptr)
     DREAM3D_REQUIRE(euler3[1] == 29.394f)
+
+    // A released column belongs to the caller and the reader forgets it
+    float* released = static_cast<float*>(reader.releasePointerByName(EbsdLib::Ctf::Euler3));
+    DREAM3D_REQUIRE(released == euler3)
+    DREAM3D_REQUIRE(reader.getPointerByName(EbsdLib::Ctf::Euler3) == nullptr)
+    DREAM3D_REQUIRE(reader.releasePointerByName(EbsdLib::Ctf::Euler3) == nullptr)
+    delete[] released;
   }
 
   // -----------------------------------------------------------------------------
@@ -232,6 +242,93 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestBinaryCache()
+  {
+    std::string ctfFile = UnitTest::TestTempDir + "/BinaryCache.ctf";
+    std::string cacheFile = EbsdBinaryCache::CacheFilePath(ctfFile);
+    fs::remove(cacheFile);
+    fs::copy_file(UnitTest::CtfReaderTest::USInputFile1, ctfFile, fs::copy_options::overwrite_existing);
+
+    CtfReader parsedReader;
+    parsedReader.setFileName(ctfFile);
+    parsedReader.setUseBinaryCache(true);
+    int err = parsedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRE(fs::exists(cacheFile))
+
+    // Mark the cache so that a read that uses it can be told apart from one that parses the file
+    size_t numElements = parsedReader.getNumberOfElements();
+    std::vector<float> marker(numElements, 0.25f);
+    std::vector<EbsdBinaryCache::Column> columns;
+    for(const auto& name : parsedReader.getColumnNames())
+    {
+      if(parsedReader.getPointerByName(name) != nullptr)
+      {
+        columns.push_back({name, parsedReader.getPointerType(name), parsedReader.getPointerByName(name)});
+      }
+    }
+    for(auto& column : columns)
+    {
+      if(column.name == EbsdLib::Ctf::Euler1)
+      {
+        column.data = marker.data();
+      }
+    }
+    EbsdBinaryCache::Write(ctfFile, parsedReader.getNameOfClass(), numElements, parsedReader.getNumFeatures(), columns);
+
+    CtfReader cachedReader;
+    cachedReader.setFileName(ctfFile);
+    cachedReader.setUseBinaryCache(true);
+    err = cachedReader.readFile();
+    DREAM3D_REQUIRED(err, ==, 0)
+    DREAM3D_REQUIRED(cachedReader.getNumberOfElements(), ==, numElements)
+    float* euler1 = reinterpret_cast<float*>(cachedReader.getPointerByName(EbsdLib::Ctf::Euler1));
+    float* euler2 = reinterpret_cast<float*>(cachedReader.getPointerByName(EbsdLib::Ctf::Euler2));
+    int* phases = reinterpret_cast<int*>(cachedReader.getPointerByName(EbsdLib::Ctf::Phase));
+    for(size_t i = 0; i < numElements; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(euler1[i], 0.25f)
+      DREAM3D_REQUIRE_EQUAL(euler2[i], reinterpret_cast<float*>(parsedReader.getPointerByName(EbsdLib::Ctf::Euler2))[i])
+      DREAM3D_REQUIRE_EQUAL(phases[i], reinterpret_cast<int*>(parsedReader.getPointerByName(EbsdLib::Ctf::Phase))[i])
+    }
+
+#if REMOVE_TEST_FILES
+    fs::remove(ctfFile);
+    fs::remove(cacheFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestHeaderScanner()
+  {
+    std::vector<std::string> files = {UnitTest::CtfReaderTest::USInputFile1, UnitTest::CtfReaderTest::EuropeanInputFile1};
+    std::vector<EbsdHeaderScanner::HeaderInfo> headers = EbsdHeaderScanner::ScanFiles(files);
+    for(size_t f = 0; f < files.size(); f++)
+    {
+      CtfReader reader;
+      reader.setFileName(files[f]);
+      reader.readHeaderOnly();
+      const EbsdHeaderScanner::HeaderInfo& header = headers[f];
+      DREAM3D_REQUIRED(header.errorCode, ==, 0)
+      DREAM3D_REQUIRE(header.fileType == EbsdHeaderScanner::FileType::Ctf)
+      DREAM3D_REQUIRED(header.xCells, ==, reader.getXCells())
+      DREAM3D_REQUIRED(header.yCells, ==, reader.getYCells())
+      DREAM3D_REQUIRE_EQUAL(header.xStep, reader.getXStep())
+      DREAM3D_REQUIRE_EQUAL(header.yStep, reader.getYStep())
+      DREAM3D_REQUIRED(header.numberOfPoints, ==, 200)
+      DREAM3D_REQUIRED(header.numPhases, ==, reader.getNumPhases())
+      for(size_t p = 0; p < reader.getPhaseVector().size(); p++)
+      {
+        DREAM3D_REQUIRED(header.crystalStructures[p], ==, reader.getPhaseVector()[p]->determineLaueGroup())
+      }
+    }
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -247,6 +344,8 @@ public:
     DREAM3D_REGISTER_TEST(TestShortFile())
     DREAM3D_REGISTER_TEST(TestZeroXYCells())
     DREAM3D_REGISTER_TEST(TestWriteCtfFile());
+    DREAM3D_REGISTER_TEST(TestBinaryCache())
+    DREAM3D_REGISTER_TEST(TestHeaderScanner())
   }
 
 public:
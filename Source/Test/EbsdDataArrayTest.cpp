@@ -0,0 +1,399 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "EbsdLib/Core/ArrayAllocator.h"
+#include "EbsdLib/Core/EbsdArrayView.hpp"
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/OrientationMath/OrientationConverter.hpp"
+
+#include "UnitTestSupport.hpp"
+
+class EbsdDataArrayTest
+{
+public:
+  EbsdDataArrayTest() = default;
+  virtual ~EbsdDataArrayTest() = default;
+
+  EbsdDataArrayTest(const EbsdDataArrayTest&) = delete;            // Copy Constructor Not Implemented
+  EbsdDataArrayTest(EbsdDataArrayTest&&) = delete;                 // Move Constructor Not Implemented
+  EbsdDataArrayTest& operator=(const EbsdDataArrayTest&) = delete; // Copy Assignment Not Implemented
+  EbsdDataArrayTest& operator=(EbsdDataArrayTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(EbsdDataArrayTest)
+
+  // -----------------------------------------------------------------------------
+  void TestAllocationInitialization()
+  {
+    EbsdLib::FloatArrayType::Pointer array = EbsdLib::FloatArrayType::CreateArray(100, {3}, "Zeroed", true);
+    DREAM3D_REQUIRE_VALID_POINTER(array.get())
+    DREAM3D_REQUIRE_EQUAL(array->getSize(), 300)
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(array->getValue(i), 0.0f)
+    }
+
+    EbsdLib::FloatArrayType::Pointer uninit = EbsdLib::FloatArrayType::CreateUninitializedArray(100, {3}, "Uninitialized");
+    DREAM3D_REQUIRE_VALID_POINTER(uninit.get())
+    DREAM3D_REQUIRE_EQUAL(uninit->isAllocated(), true)
+    DREAM3D_REQUIRE_EQUAL(uninit->getNumberOfTuples(), 100)
+    DREAM3D_REQUIRE_EQUAL(uninit->getInitializeOnAllocate(), false)
+
+    // Growing an initializing array still fills the new tuples with the init value
+    array->setInitValue(5.0f);
+    array->resizeTuples(200);
+    DREAM3D_REQUIRE_EQUAL(array->getValue(299), 0.0f)
+    DREAM3D_REQUIRE_EQUAL(array->getValue(300), 5.0f)
+    DREAM3D_REQUIRE_EQUAL(array->getValue(599), 5.0f)
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPooledAllocator()
+  {
+    EbsdLib::PooledArrayAllocator::Pointer pool = EbsdLib::PooledArrayAllocator::New();
+
+    {
+      EbsdLib::DoubleArrayType::Pointer array = EbsdLib::DoubleArrayType::CreateArray(0, "Pooled", true);
+      array->setAllocator(pool);
+      array->resizeTuples(1000);
+      DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), 1000)
+      DREAM3D_REQUIRE_EQUAL(array->getValue(999), 0.0)
+      array->setValue(10, 42.0);
+
+      // Erasing tuples reallocates through the pool and keeps the remaining values
+      std::vector<size_t> idxs = {0, 1, 2};
+      DREAM3D_REQUIRE_EQUAL(array->eraseTuples(idxs), 0)
+      DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), 997)
+      DREAM3D_REQUIRE_EQUAL(array->getValue(7), 42.0)
+    }
+    DREAM3D_REQUIRE(pool->getCachedBytes() > 0)
+
+    // Same sized arrays get their memory back from the pool
+    EbsdLib::ArrayAllocator::SetDefault(pool);
+    size_t systemAllocations = pool->getSystemAllocationCount();
+    for(int i = 0; i < 5; i++)
+    {
+      EbsdLib::DoubleArrayType::Pointer array = EbsdLib::DoubleArrayType::CreateUninitializedArray(4096, {1}, "Intensity");
+      DREAM3D_REQUIRE_VALID_POINTER(array.get())
+      DREAM3D_REQUIRE(array->getAllocator() == pool)
+      std::fill(array->begin(), array->end(), static_cast<double>(i));
+      DREAM3D_REQUIRE_EQUAL(array->getValue(4095), static_cast<double>(i))
+    }
+    EbsdLib::ArrayAllocator::SetDefault(nullptr);
+    DREAM3D_REQUIRE_EQUAL(pool->getSystemAllocationCount(), systemAllocations + 1)
+    DREAM3D_REQUIRE(pool->getReuseCount() >= 4)
+
+    // A zeroing allocation from the pool must not see the previous contents
+    {
+      EbsdLib::DoubleArrayType::Pointer array = EbsdLib::DoubleArrayType::CreateArray(0, "Pooled", true);
+      array->setAllocator(pool);
+      array->resizeTuples(4096);
+      DREAM3D_REQUIRE_EQUAL(array->getValue(4095), 0.0)
+    }
+
+    pool->releaseCachedMemory();
+    DREAM3D_REQUIRE_EQUAL(pool->getCachedBytes(), 0)
+
+    // Arrays created after the default was cleared use new[] again
+    EbsdLib::DoubleArrayType::Pointer plain = EbsdLib::DoubleArrayType::CreateArray(10, "Plain", true);
+    DREAM3D_REQUIRE(plain->getAllocator() == nullptr)
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestEraseTuples()
+  {
+    // Index based removal compacts the array in place
+    EbsdLib::Int32ArrayType::Pointer array = EbsdLib::Int32ArrayType::CreateArray(10, {2}, "Indexed", true);
+    for(size_t i = 0; i < array->getSize(); i++)
+    {
+      array->setValue(i, static_cast<int32_t>(i));
+    }
+    const int32_t* data = array->getPointer(0);
+    std::vector<size_t> idxs = {1, 4, 5, 9};
+    DREAM3D_REQUIRE_EQUAL(array->eraseTuples(idxs), 0)
+    DREAM3D_REQUIRE(array->getPointer(0) == data)
+    DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), 6)
+    DREAM3D_REQUIRE_EQUAL(array->getSize(), 12)
+    std::vector<int32_t> expectedTuples = {0, 2, 3, 6, 7, 8};
+    for(size_t i = 0; i < expectedTuples.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(array->getComponent(i, 0), expectedTuples[i] * 2)
+      DREAM3D_REQUIRE_EQUAL(array->getComponent(i, 1), expectedTuples[i] * 2 + 1)
+    }
+
+    // Masks must have one flag per tuple
+    std::vector<bool> eraseMask(5, false);
+    DREAM3D_REQUIRE_EQUAL(array->eraseTuplesByMask(eraseMask), -100)
+
+    // Small arrays take the serial path
+    eraseMask.assign(6, false);
+    eraseMask[0] = true;
+    eraseMask[3] = true;
+    DREAM3D_REQUIRE_EQUAL(array->eraseTuplesByMask(eraseMask), 0)
+    DREAM3D_REQUIRE(array->getPointer(0) == data)
+    DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), 4)
+    DREAM3D_REQUIRE_EQUAL(array->getComponent(0, 1), 5)
+    DREAM3D_REQUIRE_EQUAL(array->getComponent(2, 0), 14)
+    DREAM3D_REQUIRE_EQUAL(array->getComponent(3, 1), 17)
+
+    eraseMask.assign(4, true);
+    DREAM3D_REQUIRE_EQUAL(array->eraseTuplesByMask(eraseMask), 0)
+    DREAM3D_REQUIRE_EQUAL(array->getNumberOfTuples(), 0)
+
+    // Large arrays are compacted over several windows when parallel algorithms are enabled
+    const size_t numTuples = 2500000;
+    EbsdLib::FloatArrayType::Pointer large = EbsdLib::FloatArrayType::CreateUninitializedArray(numTuples, {3}, "Large");
+    std::vector<bool> largeMask(numTuples, false);
+    std::vector<float> expected;
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        large->setComponent(i, static_cast<int>(c), static_cast<float>(i * 3 + c));
+      }
+      // Keep a long run at the start and remove an irregular pattern after that
+      largeMask[i] = (i > 100000) && (i % 7 == 0 || i % 11 == 3);
+      if(!largeMask[i])
+      {
+        expected.push_back(static_cast<float>(i * 3));
+      }
+    }
+    const float* largeData = large->getPointer(0);
+    DREAM3D_REQUIRE_EQUAL(large->eraseTuplesByMask(largeMask), 0)
+    DREAM3D_REQUIRE(large->getPointer(0) == largeData)
+    DREAM3D_REQUIRE_EQUAL(large->getNumberOfTuples(), expected.size())
+    for(size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(large->getComponent(i, 0), expected[i])
+      DREAM3D_REQUIRE_EQUAL(large->getComponent(i, 2), expected[i] + 2.0f)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestMoveSemantics()
+  {
+    EbsdLib::FloatArrayType source(10, "Source", {3}, 1.0f);
+    source.setValue(29, 7.0f);
+    const float* data = source.getPointer(0);
+
+    EbsdLib::FloatArrayType moved(std::move(source));
+    DREAM3D_REQUIRE(moved.getPointer(0) == data)
+    DREAM3D_REQUIRE_EQUAL(moved.getNumberOfTuples(), 10)
+    DREAM3D_REQUIRE_EQUAL(moved.getNumberOfComponents(), 3)
+    DREAM3D_REQUIRE_EQUAL(moved.getValue(29), 7.0f)
+    DREAM3D_REQUIRE_EQUAL(moved.getName(), std::string("Source"))
+    DREAM3D_REQUIRE_EQUAL(source.isAllocated(), false)
+    DREAM3D_REQUIRE_EQUAL(source.getSize(), 0)
+    DREAM3D_REQUIRE(source.getPointer(0) == nullptr)
+
+    // Move assignment releases the old memory of the target and takes over the source
+    EbsdLib::FloatArrayType target(5, "Target", {1}, 0.0f);
+    target = std::move(moved);
+    DREAM3D_REQUIRE(target.getPointer(0) == data)
+    DREAM3D_REQUIRE_EQUAL(target.getNumberOfTuples(), 10)
+    DREAM3D_REQUIRE_EQUAL(target.getNumberOfComponents(), 3)
+    DREAM3D_REQUIRE_EQUAL(moved.isAllocated(), false)
+
+    // Memory from an allocator is released through that allocator by the new owner
+    EbsdLib::PooledArrayAllocator::Pointer pool = EbsdLib::PooledArrayAllocator::New();
+    {
+      EbsdLib::DoubleArrayType pooled(0, "Pooled", {1}, 0.0);
+      pooled.setAllocator(pool);
+      pooled.resizeTuples(1024);
+      EbsdLib::DoubleArrayType owner(std::move(pooled));
+      DREAM3D_REQUIRE_EQUAL(owner.getNumberOfTuples(), 1024)
+      DREAM3D_REQUIRE_EQUAL(pool->getCachedBytes(), 0)
+    }
+    DREAM3D_REQUIRE_EQUAL(pool->getCachedBytes(), 1024 * sizeof(double))
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestArrayView()
+  {
+    // 4 tuples of 5 components where the Euler angles are components 1-3
+    EbsdLib::FloatArrayType::Pointer rows = EbsdLib::FloatArrayType::CreateArray(4, {5}, "Rows", true);
+    for(size_t i = 0; i < rows->getSize(); i++)
+    {
+      rows->setValue(i, static_cast<float>(i));
+    }
+
+    EbsdArrayView<float> whole = EbsdArrayView<float>::FromArray(*rows);
+    DREAM3D_REQUIRE_EQUAL(whole.getNumberOfTuples(), 4)
+    DREAM3D_REQUIRE_EQUAL(whole.getNumberOfComponents(), 5)
+    DREAM3D_REQUIRE_EQUAL(whole.isContiguous(), true)
+    DREAM3D_REQUIRE_EQUAL(whole(2, 3), 13.0f)
+
+    EbsdArrayView<const float> eulers = whole.componentView(1, 3);
+    DREAM3D_REQUIRE_EQUAL(eulers.getNumberOfComponents(), 3)
+    DREAM3D_REQUIRE_EQUAL(eulers.getTupleStride(), 5)
+    DREAM3D_REQUIRE_EQUAL(eulers.isComponentContiguous(), true)
+    DREAM3D_REQUIRE_EQUAL(eulers.isContiguous(), false)
+    DREAM3D_REQUIRE_EQUAL(eulers(0, 0), 1.0f)
+    DREAM3D_REQUIRE_EQUAL(eulers(3, 2), 18.0f)
+
+    EbsdArrayView<const float> tail = eulers.subView(2, 2);
+    DREAM3D_REQUIRE_EQUAL(tail.getNumberOfTuples(), 2)
+    DREAM3D_REQUIRE_EQUAL(tail(0, 0), 11.0f)
+    DREAM3D_REQUIRE(tail.getTuplePointer(1) == rows->getPointer(16))
+
+    // Column major data through the component stride
+    std::vector<double> columns = {0.0, 1.0, 2.0, 10.0, 11.0, 12.0};
+    EbsdArrayView<double> columnView(columns.data(), 3, 2, 1, 3);
+    DREAM3D_REQUIRE_EQUAL(columnView(1, 1), 11.0)
+    double tuple[2] = {0.0, 0.0};
+    columnView.getTuple(2, tuple);
+    DREAM3D_REQUIRE_EQUAL(tuple[0], 2.0)
+    DREAM3D_REQUIRE_EQUAL(tuple[1], 12.0)
+
+    // Planar data, one array per component
+    std::vector<float> phi1 = {0.1f, 0.2f, 0.3f};
+    std::vector<float> phi = {0.4f, 0.5f, 0.6f};
+    std::vector<float> phi2 = {0.7f, 0.8f, 0.9f};
+    EbsdArrayView<float> planar = EbsdArrayView<float>::FromComponents({phi1.data(), phi.data(), phi2.data()}, 3);
+    DREAM3D_REQUIRE_EQUAL(planar.isPlanar(), true)
+    DREAM3D_REQUIRE_EQUAL(planar.isComponentContiguous(), false)
+    DREAM3D_REQUIRE_EQUAL(planar(1, 2), 0.8f)
+    planar(2, 1) = 1.5f;
+    DREAM3D_REQUIRE_EQUAL(phi[2], 1.5f)
+    EbsdArrayView<float> lastTwo = planar.subView(1, 2).componentView(1, 2);
+    DREAM3D_REQUIRE_EQUAL(lastTwo(0, 0), 0.5f)
+    DREAM3D_REQUIRE_EQUAL(lastTwo(1, 1), 0.9f)
+
+    // Pole figure sphere coordinates are identical for interleaved and planar Euler angles
+    EbsdLib::FloatArrayType::Pointer interleaved = EbsdLib::FloatArrayType::CreateArray(3, {3}, "Eulers", true);
+    for(size_t i = 0; i < 3; i++)
+    {
+      interleaved->setComponent(i, 0, phi1[i]);
+      interleaved->setComponent(i, 1, phi[i]);
+      interleaved->setComponent(i, 2, phi2[i]);
+    }
+    CubicOps ops;
+    std::vector<EbsdLib::FloatArrayType::Pointer> coords;
+    for(size_t i = 0; i < 6; i++)
+    {
+      coords.push_back(EbsdLib::FloatArrayType::CreateArray(0, {3}, "Coords", true));
+    }
+    ops.generateSphereCoordsFromEulers(interleaved.get(), coords[0].get(), coords[1].get(), coords[2].get());
+    ops.generateSphereCoordsFromEulers(planar, coords[3].get(), coords[4].get(), coords[5].get());
+    for(size_t c = 0; c < 3; c++)
+    {
+      DREAM3D_REQUIRE_EQUAL(coords[c]->getSize(), coords[c + 3]->getSize())
+      for(size_t i = 0; i < coords[c]->getSize(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(coords[c]->getValue(i), coords[c + 3]->getValue(i))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestConverterInputView()
+  {
+    using EulerConverterType = EulerConverter<EbsdLib::FloatArrayType, float>;
+
+    // Euler angles stored in components 1-3 of a 4 component array, phases in component 0
+    EbsdLib::FloatArrayType::Pointer rows = EbsdLib::FloatArrayType::CreateArray(3, {4}, "Rows", true);
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(3, {3}, "Eulers", true);
+    for(size_t i = 0; i < 3; i++)
+    {
+      rows->setComponent(i, 0, 1.0f);
+      for(int c = 0; c < 3; c++)
+      {
+        float value = 0.1f * static_cast<float>(i + 1) + 0.2f * static_cast<float>(c);
+        rows->setComponent(i, c + 1, value);
+        eulers->setComponent(i, c, value);
+      }
+    }
+
+    EulerConverterType::Pointer arrayConverter = EulerConverterType::New();
+    arrayConverter->setInputData(eulers);
+    arrayConverter->toQuaternion();
+    EbsdLib::FloatArrayType::Pointer expected = arrayConverter->getOutputData();
+
+    EulerConverterType::Pointer viewConverter = EulerConverterType::New();
+    viewConverter->setInputView(EbsdArrayView<float>::FromArray(*rows).componentView(1, 3));
+    DREAM3D_REQUIRE(viewConverter->getInputData() == nullptr)
+    viewConverter->toQuaternion();
+    EbsdLib::FloatArrayType::Pointer quats = viewConverter->getOutputData();
+    DREAM3D_REQUIRE_EQUAL(quats->getNumberOfTuples(), 3)
+    for(size_t i = 0; i < quats->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(quats->getValue(i), expected->getValue(i))
+    }
+    // The phase column is not touched by the sanity check
+    DREAM3D_REQUIRE_EQUAL(rows->getComponent(2, 0), 1.0f)
+
+    viewConverter->toEulers();
+    EbsdLib::FloatArrayType::Pointer copy = viewConverter->getOutputData();
+    DREAM3D_REQUIRE_EQUAL(copy->getNumberOfComponents(), 3)
+    DREAM3D_REQUIRE_EQUAL(copy->getComponent(2, 1), eulers->getComponent(2, 1))
+
+    // Planar input is gathered into an interleaved array
+    std::vector<float> angles[3];
+    for(int c = 0; c < 3; c++)
+    {
+      for(size_t i = 0; i < 3; i++)
+      {
+        angles[c].push_back(eulers->getComponent(i, c));
+      }
+    }
+    viewConverter->setInputView(EbsdArrayView<float>::FromComponents({angles[0].data(), angles[1].data(), angles[2].data()}, 3));
+    DREAM3D_REQUIRE_VALID_POINTER(viewConverter->getInputData().get())
+    viewConverter->toQuaternion();
+    quats = viewConverter->getOutputData();
+    for(size_t i = 0; i < quats->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(quats->getValue(i), expected->getValue(i))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestAllocationInitialization())
+    DREAM3D_REGISTER_TEST(TestPooledAllocator())
+    DREAM3D_REGISTER_TEST(TestEraseTuples())
+    DREAM3D_REGISTER_TEST(TestMoveSemantics())
+    DREAM3D_REGISTER_TEST(TestArrayView())
+    DREAM3D_REGISTER_TEST(TestConverterInputView())
+  }
+};
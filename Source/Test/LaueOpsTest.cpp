@@ -0,0 +1,1331 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "EbsdLib/Core/EbsdArrayView.hpp"
+#include "EbsdLib/Core/EbsdDataArray.hpp"
+#include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/Orientation.hpp"
+#include "EbsdLib/Core/OrientationTransformation.hpp"
+#include "EbsdLib/Core/Quaternion.hpp"
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/LaueOps/CubicOps.h"
+#include "EbsdLib/LaueOps/FeatureOrientationStatistics.h"
+#include "EbsdLib/LaueOps/HexagonalOps.h"
+#include "EbsdLib/LaueOps/KernelAverageMisorientation.h"
+#include "EbsdLib/LaueOps/LaueOps.h"
+#include "EbsdLib/LaueOps/LaueOpsDispatch.hpp"
+#include "EbsdLib/LaueOps/MisorientationSegmentation.h"
+#include "EbsdLib/LaueOps/PhasePartition.h"
+#include "EbsdLib/LaueOps/PoleFigureAccumulator.h"
+#include "EbsdLib/Math/EbsdLibMath.h"
+#include "EbsdLib/Math/EbsdMatrixMath.h"
+#include "EbsdLib/Utilities/ColorTable.h"
+#include "EbsdLib/Utilities/ComputeStereographicProjection.h"
+#include "EbsdLib/Utilities/ModifiedLambertProjection.h"
+#include "EbsdLib/Utilities/PoleFigureUtilities.h"
+
+#include "UnitTestSupport.hpp"
+
+class LaueOpsTest
+{
+public:
+  LaueOpsTest() = default;
+  virtual ~LaueOpsTest() = default;
+
+  LaueOpsTest(const LaueOpsTest&) = delete;            // Copy Constructor Not Implemented
+  LaueOpsTest(LaueOpsTest&&) = delete;                 // Move Constructor Not Implemented
+  LaueOpsTest& operator=(const LaueOpsTest&) = delete; // Copy Assignment Not Implemented
+  LaueOpsTest& operator=(LaueOpsTest&&) = delete;      // Move Assignment Not Implemented
+
+  EBSD_GET_NAME_OF_CLASS_DECL(LaueOpsTest)
+
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief Creates an array of random unit quaternions (x, y, z, w) using a fixed seed
+   */
+  EbsdLib::FloatArrayType::Pointer CreateRandomQuats(size_t numQuats)
+  {
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    EbsdLib::FloatArrayType::Pointer quats = EbsdLib::FloatArrayType::CreateArray(numQuats, {4}, "Quats", true);
+    for(size_t i = 0; i < numQuats; i++)
+    {
+      OrientationD eu(EbsdLib::Constants::k_2PiD * distribution(generator), EbsdLib::Constants::k_PiD * distribution(generator), EbsdLib::Constants::k_2PiD * distribution(generator));
+      QuatD q = OrientationTransformation::eu2qu<OrientationD, QuatD>(eu);
+      quats->setComponent(i, 0, static_cast<float>(q.x()));
+      quats->setComponent(i, 1, static_cast<float>(q.y()));
+      quats->setComponent(i, 2, static_cast<float>(q.z()));
+      quats->setComponent(i, 3, static_cast<float>(q.w()));
+    }
+    return quats;
+  }
+
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief Creates an array of Euler angles (radians) of the quaternions from CreateRandomQuats()
+   */
+  EbsdLib::FloatArrayType::Pointer CreateRandomEulers(size_t numEulers)
+  {
+    EbsdLib::FloatArrayType::Pointer quats = CreateRandomQuats(numEulers);
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(numEulers, {3}, "Eulers", true);
+    for(size_t i = 0; i < numEulers; i++)
+    {
+      const float* q = quats->getTuplePointer(i);
+      OrientationF eu = OrientationTransformation::qu2eu<QuatF, OrientationF>(QuatF(q[0], q[1], q[2], q[3]));
+      eulers->setComponent(i, 0, eu[0]);
+      eulers->setComponent(i, 1, eu[1]);
+      eulers->setComponent(i, 2, eu[2]);
+    }
+    return eulers;
+  }
+
+  // -----------------------------------------------------------------------------
+  QuatD GetQuat(EbsdLib::FloatArrayType::Pointer& quats, int32_t index)
+  {
+    float* q = quats->getTuplePointer(static_cast<size_t>(index));
+    return QuatD(q[0], q[1], q[2], q[3]);
+  }
+
+  struct PerturbedBlockMap
+  {
+    EbsdLib::FloatArrayType::Pointer quats;
+    EbsdLib::Int32ArrayType::Pointer phases;
+    std::unique_ptr<bool[]> goodPoints;
+    std::vector<int32_t> blocks;
+  };
+
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief Creates a map of dims points in which blocks of blockSize^3 points share one of numCenters random
+   * orientations, each point rotated away from its center by about spread radians. The phase of a point is
+   * phaseOf(x, y, z, index, block) and it is a good point if isGood(x, y, z, index).
+   */
+  template <typename PhaseFunction, typename MaskFunction>
+  PerturbedBlockMap CreatePerturbedBlockMap(const std::array<size_t, 3>& dims, size_t blockSize, size_t numCenters, double spread, PhaseFunction phaseOf, MaskFunction isGood)
+  {
+    const size_t numPoints = dims[0] * dims[1] * dims[2];
+    EbsdLib::FloatArrayType::Pointer centers = CreateRandomQuats(numCenters);
+    // The noise starts at the second quaternion so that it is not correlated with the centers of the same seed
+    EbsdLib::FloatArrayType::Pointer noise = CreateRandomQuats(numPoints + 1);
+    PerturbedBlockMap map;
+    map.quats = EbsdLib::FloatArrayType::CreateArray(numPoints, {4}, "Quats", true);
+    map.phases = EbsdLib::Int32ArrayType::CreateArray(numPoints, "Phases", true);
+    map.goodPoints.reset(new bool[numPoints]);
+    map.blocks.resize(numPoints);
+    const double norm = std::sqrt(1.0 + spread * spread);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          const size_t index = (z * dims[1] + y) * dims[0] + x;
+          const auto block = static_cast<int32_t>(((x / blockSize) + (y / blockSize) * 5 + (z / blockSize) * 11) % numCenters);
+          QuatD n = GetQuat(noise, static_cast<int32_t>(index + 1));
+          double scale = spread / std::sqrt(n.x() * n.x() + n.y() * n.y() + n.z() * n.z()) / norm;
+          QuatD q = GetQuat(centers, block) * QuatD(n.x() * scale, n.y() * scale, n.z() * scale, 1.0 / norm);
+          for(size_t c = 0; c < 4; c++)
+          {
+            map.quats->setComponent(index, c, static_cast<float>(q[c]));
+          }
+          map.phases->setValue(index, phaseOf(x, y, z, index, block));
+          map.goodPoints[index] = isGood(x, y, z, index);
+          map.blocks[index] = block;
+        }
+      }
+    }
+    return map;
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestSlipTransmissionMetrics()
+  {
+    const size_t numGrains = 50;
+    const size_t numBoundaries = 400;
+    EbsdLib::FloatArrayType::Pointer quats = CreateRandomQuats(numGrains);
+
+    std::mt19937_64 generator(1234);
+    std::uniform_int_distribution<int32_t> distribution(0, static_cast<int32_t>(numGrains - 1));
+    EbsdLib::Int32ArrayType::Pointer pairs = EbsdLib::Int32ArrayType::CreateArray(numBoundaries, {2}, "Pairs", true);
+    for(size_t b = 0; b < numBoundaries; b++)
+    {
+      pairs->setComponent(b, 0, distribution(generator));
+      pairs->setComponent(b, 1, distribution(generator));
+    }
+    // An exterior boundary should produce zeros
+    pairs->setComponent(0, 0, -1);
+
+    CubicOps ops;
+    const double LD[3] = {0.2, 0.3, 1.0};
+    for(bool maxSF : {true, false})
+    {
+      EbsdLib::DoubleArrayType::Pointer mPrime = EbsdLib::DoubleArrayType::CreateArray(0, "mPrime", true);
+      EbsdLib::DoubleArrayType::Pointer F1 = EbsdLib::DoubleArrayType::CreateArray(0, "F1", true);
+      EbsdLib::DoubleArrayType::Pointer F1spt = EbsdLib::DoubleArrayType::CreateArray(0, "F1spt", true);
+      EbsdLib::DoubleArrayType::Pointer F7 = EbsdLib::DoubleArrayType::CreateArray(0, "F7", true);
+      ops.getSlipTransmissionMetrics(quats.get(), pairs.get(), LD, maxSF, mPrime.get(), F1.get(), F1spt.get(), F7.get());
+
+      DREAM3D_REQUIRE_EQUAL(mPrime->getNumberOfTuples(), numBoundaries)
+      DREAM3D_REQUIRE_EQUAL(F7->getNumberOfTuples(), numBoundaries)
+      DREAM3D_REQUIRE_EQUAL(mPrime->getValue(0), 0.0)
+      DREAM3D_REQUIRE_EQUAL(F1->getValue(0), 0.0)
+
+      for(size_t boundary = 1; boundary < numBoundaries; boundary++)
+      {
+        QuatD q1 = GetQuat(quats, pairs->getComponent(boundary, 0));
+        QuatD q2 = GetQuat(quats, pairs->getComponent(boundary, 1));
+        double ld[3] = {LD[0], LD[1], LD[2]};
+        DREAM3D_REQUIRE(std::fabs(ops.getmPrime(q1, q2, ld) - mPrime->getValue(boundary)) < 1.0E-9)
+        DREAM3D_REQUIRE(std::fabs(ops.getF1(q1, q2, ld, maxSF) - F1->getValue(boundary)) < 1.0E-9)
+        DREAM3D_REQUIRE(std::fabs(ops.getF1spt(q1, q2, ld, maxSF) - F1spt->getValue(boundary)) < 1.0E-9)
+        DREAM3D_REQUIRE(std::fabs(ops.getF7(q1, q2, ld, maxSF) - F7->getValue(boundary)) < 1.0E-9)
+      }
+    }
+
+    // Outputs that are not needed can be skipped
+    EbsdLib::DoubleArrayType::Pointer F7 = EbsdLib::DoubleArrayType::CreateArray(0, "F7", true);
+    ops.getSlipTransmissionMetrics(quats.get(), pairs.get(), LD, true, nullptr, nullptr, nullptr, F7.get());
+    DREAM3D_REQUIRE_EQUAL(F7->getNumberOfTuples(), numBoundaries)
+  }
+
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief Compares the Schmid factor map against getSchmidFactorAndSS() for every point
+   */
+  void CompareSchmidFactorMap(const LaueOps& ops, EbsdLib::FloatArrayType::Pointer& quats, const double load[3])
+  {
+    const size_t numPoints = quats->getNumberOfTuples();
+    EbsdLib::FloatArrayType::Pointer schmids = EbsdLib::FloatArrayType::CreateArray(0, "Schmids", true);
+    EbsdLib::Int32ArrayType::Pointer slipSystems = EbsdLib::Int32ArrayType::CreateArray(0, "SlipSystems", true);
+    EbsdLib::FloatArrayType::Pointer angleComps = EbsdLib::FloatArrayType::CreateArray(0, {2}, "AngleComps", true);
+    ops.generateSchmidFactorMap(quats.get(), load, schmids.get(), slipSystems.get(), angleComps.get());
+
+    DREAM3D_REQUIRE_EQUAL(schmids->getNumberOfTuples(), numPoints)
+    DREAM3D_REQUIRE_EQUAL(slipSystems->getNumberOfTuples(), numPoints)
+    DREAM3D_REQUIRE_EQUAL(angleComps->getNumberOfTuples(), numPoints)
+
+    double sampleLoad[3] = {load[0], load[1], load[2]};
+    EbsdMatrixMath::Normalize3x1(sampleLoad);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      double g[3][3];
+      double crystalLoad[3];
+      OrientationTransformation::qu2om<QuatD, OrientationD>(GetQuat(quats, static_cast<int32_t>(i))).toGMatrix(g);
+      EbsdMatrixMath::Multiply3x3with3x1(g, sampleLoad, crystalLoad);
+      double schmidFactor = 0.0;
+      double comps[2] = {0.0, 0.0};
+      int slipSystem = 0;
+      ops.getSchmidFactorAndSS(crystalLoad, schmidFactor, comps, slipSystem);
+      DREAM3D_REQUIRE(std::fabs(schmids->getValue(i) - schmidFactor) < 1.0E-6)
+      DREAM3D_REQUIRE_EQUAL(slipSystems->getValue(i), slipSystem)
+      DREAM3D_REQUIRE(std::fabs(angleComps->getComponent(i, 0) - comps[0]) < 1.0E-6)
+      DREAM3D_REQUIRE(std::fabs(angleComps->getComponent(i, 1) - comps[1]) < 1.0E-6)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestSchmidFactorMap()
+  {
+    EbsdLib::FloatArrayType::Pointer quats = CreateRandomQuats(2000);
+    const double load[3] = {1.0, 2.0, 3.0};
+
+    CubicOps cubicOps;
+    CompareSchmidFactorMap(cubicOps, quats, load);
+    // Hexagonal has its own slip systems in getSchmidFactorAndSS() but is deliberately left on the per point fallback
+    HexagonalOps hexOps;
+    CompareSchmidFactorMap(hexOps, quats, load);
+
+    // Outputs that are not needed can be skipped
+    EbsdLib::Int32ArrayType::Pointer slipSystems = EbsdLib::Int32ArrayType::CreateArray(0, "SlipSystems", true);
+    cubicOps.generateSchmidFactorMap(quats.get(), load, nullptr, slipSystems.get(), nullptr);
+    DREAM3D_REQUIRE_EQUAL(slipSystems->getNumberOfTuples(), quats->getNumberOfTuples())
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestMisorientations()
+  {
+    const size_t numPairs = 2000;
+    EbsdLib::FloatArrayType::Pointer quats1 = CreateRandomQuats(numPairs);
+    EbsdLib::FloatArrayType::Pointer quats2 = CreateRandomQuats(numPairs + 1);
+    // Shift the second set by one so that the pairs differ, and make one pair identical
+    quats2->eraseTuples({0});
+    for(size_t c = 0; c < 4; c++)
+    {
+      quats2->setComponent(0, c, quats1->getComponent(0, c));
+    }
+
+    for(const LaueOps::Pointer& ops : LaueOps::GetAllOrientationOps())
+    {
+      EbsdLib::FloatArrayType::Pointer doubleResult = EbsdLib::FloatArrayType::CreateArray(0, {4}, "Double", true);
+      EbsdLib::FloatArrayType::Pointer singleResult = EbsdLib::FloatArrayType::CreateArray(0, {4}, "Single", true);
+      ops->calculateMisorientations(quats1.get(), quats2.get(), doubleResult.get());
+      ops->calculateMisorientations(quats1.get(), quats2.get(), singleResult.get(), EbsdLib::ComputePrecision::Single);
+      DREAM3D_REQUIRE_EQUAL(doubleResult->getNumberOfTuples(), numPairs)
+      DREAM3D_REQUIRE_EQUAL(singleResult->getNumberOfTuples(), numPairs)
+
+      // The double path loses the axis of the identical pair, so the comparison starts at the second pair
+      for(size_t i = 1; i < numPairs; i++)
+      {
+        OrientationD axisAngle = ops->calculateMisorientation(GetQuat(quats1, static_cast<int32_t>(i)), GetQuat(quats2, static_cast<int32_t>(i)));
+        for(size_t c = 0; c < 4; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(doubleResult->getComponent(i, c), static_cast<float>(axisAngle[c]))
+        }
+        DREAM3D_REQUIRE(std::fabs(singleResult->getComponent(i, 3) - axisAngle[3]) < EbsdLib::SinglePrecisionBounds::k_MisorientationAngle)
+      }
+      DREAM3D_REQUIRE(singleResult->getComponent(0, 3) < EbsdLib::SinglePrecisionBounds::k_MisorientationAngle)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestNearestQuats()
+  {
+    const size_t numQuats = 2000;
+    EbsdLib::FloatArrayType::Pointer quats = CreateRandomQuats(numQuats);
+    EbsdLib::FloatArrayType::Pointer refQuats = CreateRandomQuats(numQuats + 1);
+    refQuats->eraseTuples({0});
+
+    for(const LaueOps::Pointer& ops : LaueOps::GetAllOrientationOps())
+    {
+      EbsdLib::FloatArrayType::Pointer fzQuats = EbsdLib::FloatArrayType::CreateArray(0, {4}, "FZQuats", true);
+      ops->getFZQuats(quats.get(), fzQuats.get());
+      DREAM3D_REQUIRE_EQUAL(fzQuats->getNumberOfTuples(), numQuats)
+      const std::string className = ops->getNameOfClass();
+      const bool hasFZQuat = className == CubicOps::ClassName() || className == HexagonalOps::ClassName() || className == "HexagonalLowOps" || className == "OrthoRhombicOps";
+      for(size_t i = 0; i < numQuats; i++)
+      {
+        QuatD fz = GetQuat(fzQuats, static_cast<int32_t>(i));
+        DREAM3D_REQUIRE(fz.w() >= 0.0)
+        DREAM3D_REQUIRE(ops->calculateMisorientation(GetQuat(quats, static_cast<int32_t>(i)), fz)[3] < 1.0E-3)
+        if(hasFZQuat)
+        {
+          QuatD expected = ops->getFZQuat(GetQuat(quats, static_cast<int32_t>(i)));
+          DREAM3D_REQUIRE_EQUAL(fz.x(), static_cast<float>(expected.x()))
+          DREAM3D_REQUIRE_EQUAL(fz.y(), static_cast<float>(expected.y()))
+          DREAM3D_REQUIRE_EQUAL(fz.z(), static_cast<float>(expected.z()))
+          DREAM3D_REQUIRE_EQUAL(fz.w(), static_cast<float>(expected.w()))
+        }
+      }
+
+      // One reference per element
+      EbsdLib::FloatArrayType::Pointer nearest = EbsdLib::FloatArrayType::CreateArray(0, {4}, "Nearest", true);
+      ops->getNearestQuats(refQuats.get(), quats.get(), nearest.get());
+      DREAM3D_REQUIRE_EQUAL(nearest->getNumberOfTuples(), numQuats)
+      for(size_t i = 0; i < numQuats; i++)
+      {
+        QuatD expected = ops->getNearestQuat(GetQuat(refQuats, static_cast<int32_t>(i)), GetQuat(quats, static_cast<int32_t>(i)));
+        for(size_t c = 0; c < 4; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(nearest->getComponent(i, c), static_cast<float>(expected[c]))
+        }
+      }
+
+      // One reference per group id, elements with an unknown group are copied unchanged
+      const int32_t numGroups = 7;
+      EbsdLib::Int32ArrayType::Pointer groupIds = EbsdLib::Int32ArrayType::CreateArray(numQuats, "GroupIds", true);
+      for(size_t i = 0; i < numQuats; i++)
+      {
+        groupIds->setValue(i, static_cast<int32_t>(i % (numGroups + 1)) - 1);
+      }
+      ops->getNearestQuats(refQuats.get(), quats.get(), nearest.get(), groupIds.get());
+      for(size_t i = 0; i < numQuats; i++)
+      {
+        int32_t group = groupIds->getValue(i);
+        QuatD expected = GetQuat(quats, static_cast<int32_t>(i));
+        if(group >= 0)
+        {
+          expected = ops->getNearestQuat(GetQuat(refQuats, group), expected);
+        }
+        for(size_t c = 0; c < 4; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(nearest->getComponent(i, c), static_cast<float>(expected[c]))
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestAverageQuatsByGroup()
+  {
+    CubicOps ops;
+    const size_t numGroups = 20;
+    const size_t pairsPerGroup = 50;
+    EbsdLib::FloatArrayType::Pointer centers = CreateRandomQuats(numGroups);
+
+    // Each group holds pairs of small rotations about its center, q0 * d and q0 * d^-1, with a random symmetry
+    // operator applied to each member. The exact average of every group is then q0.
+    std::mt19937_64 generator(7);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    const size_t numPoints = numGroups * pairsPerGroup * 2 + 3;
+    EbsdLib::FloatArrayType::Pointer quats = EbsdLib::FloatArrayType::CreateArray(numPoints, {4}, "Quats", true);
+    EbsdLib::Int32ArrayType::Pointer groupIds = EbsdLib::Int32ArrayType::CreateArray(numPoints, "GroupIds", true);
+    size_t index = 0;
+    auto addMember = [&](const QuatD& q, int32_t group) {
+      QuatD member = ops.getQuatSymOp(static_cast<int>(distribution(generator) * ops.getNumSymOps()) % ops.getNumSymOps()) * q;
+      for(size_t c = 0; c < 4; c++)
+      {
+        quats->setComponent(index, c, static_cast<float>(member[c]));
+      }
+      groupIds->setValue(index, group);
+      index++;
+    };
+    for(size_t p = 0; p < pairsPerGroup; p++)
+    {
+      for(size_t group = 0; group < numGroups; group++)
+      {
+        double halfAngle = 0.5 * 5.0 * EbsdLib::Constants::k_PiOver180D * distribution(generator);
+        double theta = std::acos(2.0 * distribution(generator) - 1.0);
+        double phi = EbsdLib::Constants::k_2PiD * distribution(generator);
+        double s = std::sin(halfAngle);
+        QuatD delta(s * std::sin(theta) * std::cos(phi), s * std::sin(theta) * std::sin(phi), s * std::cos(theta), std::cos(halfAngle));
+        QuatD center = GetQuat(centers, static_cast<int32_t>(group));
+        addMember(center * delta, static_cast<int32_t>(group));
+        addMember(center * delta.conjugate(), static_cast<int32_t>(group));
+      }
+    }
+    // Points outside of the groups are ignored and the last group is empty
+    for(; index < numPoints;)
+    {
+      addMember(QuatD(0.0, 0.0, 0.0, 1.0), (index % 2 == 0) ? -1 : static_cast<int32_t>(numGroups + 1));
+    }
+
+    EbsdLib::FloatArrayType::Pointer avgQuats = EbsdLib::FloatArrayType::CreateArray(0, {4}, "AvgQuats", true);
+    ops.averageQuatsByGroup(quats.get(), groupIds.get(), numGroups + 1, avgQuats.get());
+    DREAM3D_REQUIRE_EQUAL(avgQuats->getNumberOfTuples(), numGroups + 1)
+    for(size_t group = 0; group < numGroups; group++)
+    {
+      QuatD avg = GetQuat(avgQuats, static_cast<int32_t>(group));
+      DREAM3D_REQUIRE(avg.w() >= 0.0)
+      DREAM3D_REQUIRE(ops.calculateMisorientation(avg, GetQuat(centers, static_cast<int32_t>(group)))[3] < 1.0E-3)
+      QuatD fz = ops.getFZQuat(avg);
+      DREAM3D_REQUIRE(std::fabs(fz.w() - avg.w()) < 1.0E-6)
+    }
+    DREAM3D_REQUIRE_EQUAL(avgQuats->getComponent(numGroups, 3), 1.0f)
+
+    // Summation order does not depend on the number of threads
+    EbsdLib::FloatArrayType::Pointer again = EbsdLib::FloatArrayType::CreateArray(0, {4}, "Again", true);
+    ops.averageQuatsByGroup(quats.get(), groupIds.get(), numGroups + 1, again.get());
+    DREAM3D_REQUIRE(std::equal(avgQuats->begin(), avgQuats->end(), again->begin()))
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestFeatureOrientationStatistics()
+  {
+    // Phase 0 is unknown, phase 1 is cubic and phase 2 is hexagonal
+    const std::vector<uint32_t> crystalStructures = {EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Cubic_High, EbsdLib::CrystalStructure::Hexagonal_High};
+    const size_t numFeatures = 12;
+    const size_t numPoints = 3000;
+
+    // Every point is the center of its feature rotated by a few degrees. Feature 0 is left empty and feature 1 belongs
+    // to the unknown phase.
+    auto phaseOf = [](size_t, size_t, size_t, size_t, int32_t block) { return block == 0 ? 0 : 1 + (block + 1) % 2; };
+    auto isGood = [](size_t, size_t, size_t, size_t index) { return index % 50 != 3; };
+    PerturbedBlockMap map = CreatePerturbedBlockMap({numPoints, 1, 1}, 1, numFeatures - 1, 0.05, phaseOf, isGood);
+    EbsdLib::FloatArrayType::Pointer quats = map.quats;
+    EbsdLib::Int32ArrayType::Pointer phases = map.phases;
+    std::unique_ptr<bool[]> goodPoints = std::move(map.goodPoints);
+    EbsdLib::Int32ArrayType::Pointer featureIds = EbsdLib::Int32ArrayType::CreateArray(numPoints, "FeatureIds", true);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      featureIds->setValue(i, i % 100 == 99 ? -1 : map.blocks[i] + 1);
+    }
+
+    FeatureOrientationStatistics::Pointer stats = FeatureOrientationStatistics::New(crystalStructures);
+    stats->compute(quats.get(), featureIds.get(), phases.get(), numFeatures, goodPoints.get());
+    DREAM3D_REQUIRE_EQUAL(stats->getNumberOfFeatures(), numFeatures)
+    EbsdLib::FloatArrayType::Pointer avgQuats = stats->getAvgQuats();
+    EbsdLib::FloatArrayType::Pointer pointMisorientations = stats->getPointMisorientations();
+    DREAM3D_REQUIRE_EQUAL(avgQuats->getNumberOfTuples(), numFeatures)
+    DREAM3D_REQUIRE_EQUAL(pointMisorientations->getNumberOfTuples(), numPoints)
+    DREAM3D_REQUIRE_EQUAL(stats->getFeaturePhases()->getValue(0), -1)
+    DREAM3D_REQUIRE_EQUAL(stats->getFeatureSizes()->getValue(0), 0)
+    DREAM3D_REQUIRE_EQUAL(stats->getFeaturePhases()->getValue(1), 0)
+    DREAM3D_REQUIRE_EQUAL(avgQuats->getComponent(1, 3), 1.0f)
+
+    // The mean of each feature matches LaueOps::averageQuatsByGroup() with the same points
+    const std::vector<LaueOps::Pointer>& allOps = LaueOps::GetAllOrientationOps();
+    EbsdLib::Int32ArrayType::Pointer groupIds = EbsdLib::Int32ArrayType::CreateArray(numPoints, "GroupIds", true);
+    for(int32_t phase = 1; phase < 3; phase++)
+    {
+      const LaueOps& ops = *allOps[crystalStructures[phase]];
+      for(size_t i = 0; i < numPoints; i++)
+      {
+        bool member = goodPoints[i] && featureIds->getValue(i) >= 0 && phases->getValue(i) == phase;
+        groupIds->setValue(i, member ? featureIds->getValue(i) : -1);
+      }
+      EbsdLib::FloatArrayType::Pointer expected = EbsdLib::FloatArrayType::CreateArray(0, {4}, "Expected", true);
+      ops.averageQuatsByGroup(quats.get(), groupIds.get(), numFeatures, expected.get());
+      for(size_t feature = 2; feature < numFeatures; feature++)
+      {
+        if(stats->getFeaturePhases()->getValue(feature) != phase)
+        {
+          continue;
+        }
+        for(size_t c = 0; c < 4; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(avgQuats->getComponent(feature, c), expected->getComponent(feature, c))
+        }
+      }
+    }
+
+    // Point misorientations are the misorientations to the mean, the per feature values summarize them
+    std::vector<double> sums(numFeatures, 0.0);
+    std::vector<double> maxima(numFeatures, 0.0);
+    std::vector<int32_t> counts(numFeatures, 0);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      int32_t feature = featureIds->getValue(i);
+      if(feature < 0 || !goodPoints[i] || feature == 1)
+      {
+        DREAM3D_REQUIRE_EQUAL(pointMisorientations->getValue(i), 0.0f)
+        continue;
+      }
+      const LaueOps& ops = *allOps[crystalStructures[stats->getFeaturePhases()->getValue(feature)]];
+      double angle = ops.calculateMisorientation(GetQuat(avgQuats, feature), GetQuat(quats, static_cast<int32_t>(i)))[3];
+      DREAM3D_REQUIRE(std::fabs(pointMisorientations->getValue(i) - angle) < 1.0E-4)
+      DREAM3D_REQUIRE(angle < 0.11)
+      sums[feature] += pointMisorientations->getValue(i);
+      maxima[feature] = std::max(maxima[feature], static_cast<double>(pointMisorientations->getValue(i)));
+      counts[feature]++;
+    }
+    for(size_t feature = 2; feature < numFeatures; feature++)
+    {
+      DREAM3D_REQUIRE_EQUAL(stats->getFeatureSizes()->getValue(feature), counts[feature])
+      DREAM3D_REQUIRE(std::fabs(stats->getAvgMisorientations()->getValue(feature) - sums[feature] / counts[feature]) < 1.0E-5)
+      DREAM3D_REQUIRE_EQUAL(stats->getMaxMisorientations()->getValue(feature), static_cast<float>(maxima[feature]))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestKernelAverageMisorientation()
+  {
+    const std::vector<uint32_t> crystalStructures = {EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Cubic_High, EbsdLib::CrystalStructure::Hexagonal_High};
+    const std::vector<LaueOps::Pointer>& allOps = LaueOps::GetAllOrientationOps();
+    const std::array<std::array<size_t, 3>, 2> allDims = {{{19, 23, 9}, {31, 17, 1}}};
+    const int32_t radius[3] = {2, 1, 1};
+    const double threshold = 5.0 * EbsdLib::Constants::k_PiOver180D;
+
+    for(const std::array<size_t, 3>& dims : allDims)
+    {
+      // Blocks of 4x4x4 points share an orientation up to a few degrees of noise, so the kernels of most points mix
+      // neighbors below and above the threshold
+      const size_t numPoints = dims[0] * dims[1] * dims[2];
+      auto phaseOf = [](size_t x, size_t, size_t, size_t index, int32_t) { return index % 37 == 5 ? 0 : 1 + static_cast<int32_t>((x / 10) % 2); };
+      auto isGood = [](size_t, size_t, size_t, size_t index) { return index % 29 != 11; };
+      PerturbedBlockMap map = CreatePerturbedBlockMap(dims, 4, 64, 0.03, phaseOf, isGood);
+      EbsdLib::FloatArrayType::Pointer quats = map.quats;
+      EbsdLib::Int32ArrayType::Pointer phases = map.phases;
+      std::unique_ptr<bool[]> goodPoints = std::move(map.goodPoints);
+
+      // calculateMisorientation() takes the acos of w, which loses precision for small angles unless the float
+      // quaternions are normalized again in double. The engine uses atan2, which does not depend on the norm.
+      auto normalizedQuat = [this, &quats](size_t index) {
+        QuatD q = GetQuat(quats, static_cast<int32_t>(index));
+        double norm = std::sqrt(q.x() * q.x() + q.y() * q.y() + q.z() * q.z() + q.w() * q.w());
+        return QuatD(q.x() / norm, q.y() / norm, q.z() / norm, q.w() / norm);
+      };
+
+      KernelAverageMisorientation::Pointer engine = KernelAverageMisorientation::New(crystalStructures);
+      engine->setKernelRadius(radius);
+      engine->setThreshold(threshold);
+      EbsdLib::FloatArrayType::Pointer kam = EbsdLib::FloatArrayType::CreateArray(0, "KAM", true);
+      engine->compute(quats.get(), phases.get(), dims.data(), kam.get(), goodPoints.get());
+      DREAM3D_REQUIRE_EQUAL(kam->getNumberOfTuples(), numPoints)
+
+      size_t numPartial = 0;
+      for(size_t z = 0; z < dims[2]; z++)
+      {
+        for(size_t y = 0; y < dims[1]; y++)
+        {
+          for(size_t x = 0; x < dims[0]; x++)
+          {
+            const size_t index = (z * dims[1] + y) * dims[0] + x;
+            const int32_t phase = phases->getValue(index);
+            if(phase == 0 || !goodPoints[index])
+            {
+              DREAM3D_REQUIRE_EQUAL(kam->getValue(index), 0.0f)
+              continue;
+            }
+            double sum = 0.0;
+            size_t count = 0;
+            size_t numNeighbors = 0;
+            for(int32_t kz = static_cast<int32_t>(z) - radius[2]; kz <= static_cast<int32_t>(z) + radius[2]; kz++)
+            {
+              for(int32_t ky = static_cast<int32_t>(y) - radius[1]; ky <= static_cast<int32_t>(y) + radius[1]; ky++)
+              {
+                for(int32_t kx = static_cast<int32_t>(x) - radius[0]; kx <= static_cast<int32_t>(x) + radius[0]; kx++)
+                {
+                  if(kx < 0 || ky < 0 || kz < 0 || kx >= static_cast<int32_t>(dims[0]) || ky >= static_cast<int32_t>(dims[1]) || kz >= static_cast<int32_t>(dims[2]))
+                  {
+                    continue;
+                  }
+                  const size_t neighbor = (kz * dims[1] + ky) * dims[0] + kx;
+                  if(neighbor == index || phases->getValue(neighbor) != phase || !goodPoints[neighbor])
+                  {
+                    continue;
+                  }
+                  numNeighbors++;
+                  double angle = allOps[crystalStructures[phase]]->calculateMisorientation(normalizedQuat(index), normalizedQuat(neighbor))[3];
+                  if(angle <= threshold)
+                  {
+                    sum += angle;
+                    count++;
+                  }
+                }
+              }
+            }
+            numPartial += (count > 0 && count < numNeighbors) ? 1 : 0;
+            float expected = count > 0 ? static_cast<float>(sum / static_cast<double>(count)) : 0.0f;
+            DREAM3D_REQUIRE(std::fabs(kam->getValue(index) - expected) < 1.0E-5)
+          }
+        }
+      }
+      DREAM3D_REQUIRE(numPartial > numPoints / 4)
+
+      // Too few phases leave no valid point, the values of the previous call are cleared
+      EbsdLib::Int32ArrayType::Pointer shortPhases = EbsdLib::Int32ArrayType::CreateArray(numPoints - 1, "Phases", true);
+      engine->compute(quats.get(), shortPhases.get(), dims.data(), kam.get(), goodPoints.get());
+      DREAM3D_REQUIRE_EQUAL(kam->getNumberOfTuples(), numPoints)
+      DREAM3D_REQUIRE(std::all_of(kam->begin(), kam->end(), [](float value) { return value == 0.0f; }))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestMisorientationSegmentation()
+  {
+    const std::vector<uint32_t> crystalStructures = {EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Cubic_High, EbsdLib::CrystalStructure::Hexagonal_High};
+    const std::vector<double> tolerances = {0.0, 5.0 * EbsdLib::Constants::k_PiOver180D, 3.0 * EbsdLib::Constants::k_PiOver180D};
+    const std::vector<LaueOps::Pointer>& allOps = LaueOps::GetAllOrientationOps();
+    // Both maps are split into several slabs, so the slab boundaries are merged
+    const std::array<std::array<size_t, 3>, 2> allDims = {{{64, 48, 64}, {300, 600, 1}}};
+
+    for(const std::array<size_t, 3>& dims : allDims)
+    {
+      // Blocks of 8x8x8 points share an orientation up to about a degree of noise. The mask and the phase change
+      // split some blocks into several features and the features wrap around masked points.
+      const size_t numPoints = dims[0] * dims[1] * dims[2];
+      auto phaseOf = [](size_t x, size_t y, size_t, size_t index, int32_t) { return index % 41 == 7 ? 0 : 1 + static_cast<int32_t>(((x + y) / 12) % 2); };
+      auto isGood = [](size_t x, size_t y, size_t z, size_t) { return (x + 2 * y + 3 * z) % 17 != 4; };
+      PerturbedBlockMap map = CreatePerturbedBlockMap(dims, 8, 64, 0.008, phaseOf, isGood);
+      EbsdLib::FloatArrayType::Pointer quats = map.quats;
+      EbsdLib::Int32ArrayType::Pointer phases = map.phases;
+      std::unique_ptr<bool[]> goodPoints = std::move(map.goodPoints);
+
+      auto normalizedQuat = [this, &quats](size_t index) {
+        QuatD q = GetQuat(quats, static_cast<int32_t>(index));
+        double norm = std::sqrt(q.x() * q.x() + q.y() * q.y() + q.z() * q.z() + q.w() * q.w());
+        return QuatD(q.x() / norm, q.y() / norm, q.z() / norm, q.w() / norm);
+      };
+
+      MisorientationSegmentation::Pointer engine = MisorientationSegmentation::New(crystalStructures);
+      engine->setTolerances(tolerances);
+      EbsdLib::Int32ArrayType::Pointer featureIds = EbsdLib::Int32ArrayType::CreateArray(0, "FeatureIds", true);
+      size_t numFeatures = engine->compute(quats.get(), phases.get(), dims.data(), featureIds.get(), goodPoints.get());
+      DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), numPoints)
+
+      // Flood fill seeded in point order, which numbers the features in the order of their lowest point index
+      std::vector<int32_t> expected(numPoints, -1);
+      std::vector<size_t> stack;
+      int32_t numExpected = 0;
+      for(size_t seed = 0; seed < numPoints; seed++)
+      {
+        if(expected[seed] >= 0)
+        {
+          continue;
+        }
+        if(phases->getValue(seed) == 0 || !goodPoints[seed])
+        {
+          expected[seed] = 0;
+          continue;
+        }
+        expected[seed] = ++numExpected;
+        stack.push_back(seed);
+        while(!stack.empty())
+        {
+          const size_t index = stack.back();
+          stack.pop_back();
+          const int32_t phase = phases->getValue(index);
+          const size_t x = index % dims[0];
+          const size_t y = (index / dims[0]) % dims[1];
+          const size_t z = index / (dims[0] * dims[1]);
+          const std::array<std::array<int64_t, 3>, 6> offsets = {{{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}}};
+          for(const std::array<int64_t, 3>& offset : offsets)
+          {
+            const int64_t nx = static_cast<int64_t>(x) + offset[0];
+            const int64_t ny = static_cast<int64_t>(y) + offset[1];
+            const int64_t nz = static_cast<int64_t>(z) + offset[2];
+            if(nx < 0 || ny < 0 || nz < 0 || nx >= static_cast<int64_t>(dims[0]) || ny >= static_cast<int64_t>(dims[1]) || nz >= static_cast<int64_t>(dims[2]))
+            {
+              continue;
+            }
+            const size_t neighbor = (static_cast<size_t>(nz) * dims[1] + static_cast<size_t>(ny)) * dims[0] + static_cast<size_t>(nx);
+            if(expected[neighbor] >= 0 || phases->getValue(neighbor) != phase || !goodPoints[neighbor])
+            {
+              continue;
+            }
+            double angle = allOps[crystalStructures[phase]]->calculateMisorientation(normalizedQuat(index), normalizedQuat(neighbor))[3];
+            if(angle <= tolerances[phase])
+            {
+              expected[neighbor] = expected[index];
+              stack.push_back(neighbor);
+            }
+          }
+        }
+      }
+
+      DREAM3D_REQUIRE_EQUAL(numFeatures, static_cast<size_t>(numExpected) + 1)
+      for(size_t index = 0; index < numPoints; index++)
+      {
+        DREAM3D_REQUIRE_EQUAL(featureIds->getValue(index), expected[index])
+      }
+      DREAM3D_REQUIRE(numExpected > 100)
+
+      // Too few phases leave no feature, the ids of the previous call are cleared
+      EbsdLib::Int32ArrayType::Pointer shortPhases = EbsdLib::Int32ArrayType::CreateArray(numPoints - 1, "Phases", true);
+      DREAM3D_REQUIRE_EQUAL(engine->compute(quats.get(), shortPhases.get(), dims.data(), featureIds.get(), goodPoints.get()), 1)
+      DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), numPoints)
+      DREAM3D_REQUIRE(std::all_of(featureIds->begin(), featureIds->end(), [](int32_t value) { return value == 0; }))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestIPFColors()
+  {
+    const size_t numPoints = 5000;
+    std::mt19937_64 generator(4321);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(numPoints, {3}, "Eulers", true);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      eulers->setComponent(i, 0, 360.0f * distribution(generator));
+      eulers->setComponent(i, 1, 180.0f * distribution(generator));
+      eulers->setComponent(i, 2, 360.0f * distribution(generator));
+    }
+    EbsdArrayView<const float> eulerView = EbsdArrayView<const float>::FromArray(*eulers);
+    double refDir[3] = {0.0, 0.0, 1.0};
+
+    for(const LaueOps::Pointer& ops : LaueOps::GetAllOrientationOps())
+    {
+      EbsdLib::UInt8ArrayType::Pointer doubleColors = EbsdLib::UInt8ArrayType::CreateArray(0, {3}, "Double", true);
+      EbsdLib::UInt8ArrayType::Pointer singleColors = EbsdLib::UInt8ArrayType::CreateArray(0, {3}, "Single", true);
+      ops->generateIPFColors(eulerView, refDir, true, doubleColors.get());
+      ops->generateIPFColors(eulerView, refDir, true, singleColors.get(), EbsdLib::ComputePrecision::Single);
+      DREAM3D_REQUIRE_EQUAL(doubleColors->getNumberOfTuples(), numPoints)
+      DREAM3D_REQUIRE_EQUAL(singleColors->getNumberOfTuples(), numPoints)
+
+      size_t numOutliers = 0;
+      for(size_t i = 0; i < numPoints; i++)
+      {
+        double eu[3] = {eulers->getComponent(i, 0), eulers->getComponent(i, 1), eulers->getComponent(i, 2)};
+        EbsdLib::Rgb argb = ops->generateIPFColor(eu, refDir, true);
+        DREAM3D_REQUIRE_EQUAL(doubleColors->getComponent(i, 0), EbsdLib::RgbColor::dRed(argb))
+        DREAM3D_REQUIRE_EQUAL(doubleColors->getComponent(i, 1), EbsdLib::RgbColor::dGreen(argb))
+        DREAM3D_REQUIRE_EQUAL(doubleColors->getComponent(i, 2), EbsdLib::RgbColor::dBlue(argb))
+
+        int32_t maxDiff = 0;
+        for(size_t c = 0; c < 3; c++)
+        {
+          maxDiff = std::max(maxDiff, std::abs(static_cast<int32_t>(singleColors->getComponent(i, c)) - static_cast<int32_t>(doubleColors->getComponent(i, c))));
+        }
+        if(maxDiff > EbsdLib::SinglePrecisionBounds::k_IPFColorChannel)
+        {
+          numOutliers++;
+        }
+      }
+      DREAM3D_REQUIRE(static_cast<double>(numOutliers) <= EbsdLib::SinglePrecisionBounds::k_IPFColorOutlierFraction * static_cast<double>(numPoints))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPhasePartition()
+  {
+    const size_t numPoints = 3000;
+    // Phase 0 has no Laue class, phases -1 and 4 are out of range
+    const std::vector<uint32_t> crystalStructures = {EbsdLib::CrystalStructure::UnknownCrystalStructure, EbsdLib::CrystalStructure::Cubic_High, EbsdLib::CrystalStructure::Hexagonal_High,
+                                                     EbsdLib::CrystalStructure::OrthoRhombic};
+    std::mt19937_64 generator(777);
+    std::uniform_int_distribution<int32_t> phaseDistribution(-1, 4);
+    std::vector<int32_t> phases(numPoints);
+    std::unique_ptr<bool[]> goodPoints(new bool[numPoints]);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      phases[i] = phaseDistribution(generator);
+      goodPoints[i] = (i % 7) != 0;
+    }
+
+    PhasePartition::Pointer partition = PhasePartition::New(phases.data(), numPoints, crystalStructures.size(), goodPoints.get());
+    DREAM3D_REQUIRE_EQUAL(partition->getNumberOfPhases(), crystalStructures.size())
+    std::vector<int32_t> owner(numPoints, -1);
+    for(size_t phase = 0; phase < partition->getNumberOfPhases(); phase++)
+    {
+      const size_t* indices = partition->getPhaseIndices(phase);
+      for(size_t i = 0; i < partition->getPhaseSize(phase); i++)
+      {
+        DREAM3D_REQUIRE(i == 0 || indices[i - 1] < indices[i])
+        DREAM3D_REQUIRE_EQUAL(phases[indices[i]], static_cast<int32_t>(phase))
+        owner[indices[i]] = static_cast<int32_t>(phase);
+      }
+    }
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      bool expected = phases[i] >= 0 && phases[i] < 4 && goodPoints[i];
+      DREAM3D_REQUIRE_EQUAL((owner[i] >= 0), expected)
+    }
+
+    // Every batch API matches running the phase's LaueOps over the whole map. Points that are not part of a phase with
+    // a known Laue class keep their previous value.
+    EbsdLib::FloatArrayType::Pointer quats1 = CreateRandomQuats(numPoints);
+    EbsdLib::FloatArrayType::Pointer quats2 = CreateRandomQuats(numPoints + 1);
+    quats2->eraseTuples({0});
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(numPoints, {3}, "Eulers", true);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      OrientationD euler = OrientationTransformation::qu2eu<QuatD, OrientationD>(GetQuat(quats1, static_cast<int32_t>(i)));
+      for(size_t c = 0; c < 3; c++)
+      {
+        eulers->setComponent(i, c, static_cast<float>(euler[c]));
+      }
+    }
+    const double refDir[3] = {0.0, 1.0, 0.0};
+    const double load[3] = {1.0, 0.0, 1.0};
+    EbsdLib::UInt8ArrayType::Pointer colors = EbsdLib::UInt8ArrayType::CreateArray(numPoints, {3}, "Colors", true);
+    colors->initializeWithValue(7);
+    EbsdLib::FloatArrayType::Pointer axisAngles = EbsdLib::FloatArrayType::CreateArray(0, {4}, "AxisAngles", true);
+    EbsdLib::FloatArrayType::Pointer schmids = EbsdLib::FloatArrayType::CreateArray(0, "Schmids", true);
+    EbsdLib::Int32ArrayType::Pointer slipSystems = EbsdLib::Int32ArrayType::CreateArray(0, "SlipSystems", true);
+    partition->generateIPFColors(crystalStructures, EbsdArrayView<const float>::FromArray(*eulers), refDir, false, colors.get());
+    partition->calculateMisorientations(crystalStructures, quats1.get(), quats2.get(), axisAngles.get());
+    partition->generateSchmidFactorMap(crystalStructures, quats1.get(), load, schmids.get(), slipSystems.get(), nullptr);
+    DREAM3D_REQUIRE_EQUAL(axisAngles->getNumberOfTuples(), numPoints)
+    DREAM3D_REQUIRE_EQUAL(schmids->getNumberOfTuples(), numPoints)
+
+    const std::vector<LaueOps::Pointer>& allOps = LaueOps::GetAllOrientationOps();
+    for(size_t phase = 1; phase < crystalStructures.size(); phase++)
+    {
+      const LaueOps& ops = *allOps[crystalStructures[phase]];
+      EbsdLib::UInt8ArrayType::Pointer refColors = EbsdLib::UInt8ArrayType::CreateArray(0, {3}, "RefColors", true);
+      EbsdLib::FloatArrayType::Pointer refAxisAngles = EbsdLib::FloatArrayType::CreateArray(0, {4}, "RefAxisAngles", true);
+      EbsdLib::FloatArrayType::Pointer refSchmids = EbsdLib::FloatArrayType::CreateArray(0, "RefSchmids", true);
+      EbsdLib::Int32ArrayType::Pointer refSlipSystems = EbsdLib::Int32ArrayType::CreateArray(0, "RefSlipSystems", true);
+      ops.generateIPFColors(EbsdArrayView<const float>::FromArray(*eulers), refDir, false, refColors.get());
+      ops.calculateMisorientations(quats1.get(), quats2.get(), refAxisAngles.get());
+      ops.generateSchmidFactorMap(quats1.get(), load, refSchmids.get(), refSlipSystems.get(), nullptr);
+      for(size_t i = 0; i < numPoints; i++)
+      {
+        if(owner[i] != static_cast<int32_t>(phase))
+        {
+          continue;
+        }
+        for(size_t c = 0; c < 3; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(colors->getComponent(i, c), refColors->getComponent(i, c))
+        }
+        for(size_t c = 0; c < 4; c++)
+        {
+          DREAM3D_REQUIRE_EQUAL(axisAngles->getComponent(i, c), refAxisAngles->getComponent(i, c))
+        }
+        DREAM3D_REQUIRE_EQUAL(schmids->getValue(i), refSchmids->getValue(i))
+        DREAM3D_REQUIRE_EQUAL(slipSystems->getValue(i), refSlipSystems->getValue(i))
+      }
+    }
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      if(owner[i] <= 0)
+      {
+        DREAM3D_REQUIRE_EQUAL(colors->getComponent(i, 0), 7)
+      }
+    }
+
+    // Inputs with fewer tuples than the partition has points are rejected without touching the output
+    EbsdLib::FloatArrayType::Pointer shortQuats = CreateRandomQuats(numPoints - 1);
+    EbsdLib::FloatArrayType::Pointer untouched = EbsdLib::FloatArrayType::CreateArray(0, {4}, "Untouched", true);
+    partition->calculateMisorientations(crystalStructures, quats1.get(), shortQuats.get(), untouched.get());
+    DREAM3D_REQUIRE_EQUAL(untouched->getNumberOfTuples(), 0)
+    partition->calculateMisorientations(crystalStructures, shortQuats.get(), quats2.get(), untouched.get());
+    DREAM3D_REQUIRE_EQUAL(untouched->getNumberOfTuples(), 0)
+    EbsdLib::FloatArrayType::Pointer untouchedSchmids = EbsdLib::FloatArrayType::CreateArray(0, "UntouchedSchmids", true);
+    partition->generateSchmidFactorMap(crystalStructures, shortQuats.get(), load, untouchedSchmids.get(), nullptr, nullptr);
+    DREAM3D_REQUIRE_EQUAL(untouchedSchmids->getNumberOfTuples(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestLaueOpsRegistry()
+  {
+    const std::vector<LaueOps::Pointer>& ops = LaueOps::GetAllOrientationOps();
+    DREAM3D_REQUIRE_EQUAL(ops.size(), 12)
+    // Every call hands out the same instances
+    DREAM3D_REQUIRE(&ops == &LaueOps::GetAllOrientationOps())
+    DREAM3D_REQUIRE(LaueOps::GetOrientationOpsFromSpaceGroupNumber(225).get() == ops[EbsdLib::CrystalStructure::Cubic_High].get())
+    DREAM3D_REQUIRE_EQUAL(LaueOps::GetLaueNames().size(), ops.size())
+
+    for(uint32_t crystalStructure = 0; crystalStructure < EbsdLib::CrystalStructure::LaueGroupEnd; crystalStructure++)
+    {
+      std::string className;
+      const LaueOps* instance = nullptr;
+      bool dispatched = EbsdLib::DispatchLaueOps(crystalStructure, [&](const auto& concrete) {
+        using OpsType = std::decay_t<decltype(concrete)>;
+        static_assert(!std::is_same<OpsType, LaueOps>::value, "Dispatch must resolve the concrete Laue class");
+        className = concrete.getNameOfClass();
+        instance = &concrete;
+      });
+      DREAM3D_REQUIRE(dispatched)
+      DREAM3D_REQUIRE_EQUAL(className, ops[crystalStructure]->getNameOfClass())
+      DREAM3D_REQUIRE(instance == ops[crystalStructure].get())
+
+      // Dispatching an instance resolves the same concrete class
+      className.clear();
+      DREAM3D_REQUIRE(EbsdLib::DispatchLaueOps(*ops[crystalStructure], [&](const auto& concrete) { className = concrete.getNameOfClass(); }))
+      DREAM3D_REQUIRE_EQUAL(className, ops[crystalStructure]->getNameOfClass())
+    }
+
+    bool called = false;
+    DREAM3D_REQUIRE(!EbsdLib::DispatchLaueOps(EbsdLib::CrystalStructure::UnknownCrystalStructure, [&](const auto& /*concrete*/) { called = true; }))
+    DREAM3D_REQUIRE(!called)
+
+    CubicOps localOps;
+    DREAM3D_REQUIRE(EbsdLib::DispatchLaueOps(localOps, [&](const auto& concrete) { called = std::is_same<std::decay_t<decltype(concrete)>, CubicOps>::value; }))
+    DREAM3D_REQUIRE(called)
+  }
+
+  // -----------------------------------------------------------------------------
+  /**
+   * @brief Colors one pixel at a time the way CreateColorImage did before it used lookup tables
+   */
+  void ReferenceColorImage(const double* data, int imageDim, int numColors, float min, float max, bool blackAndWhite, uint32_t* rgba)
+  {
+    std::vector<float> colors(static_cast<size_t>(numColors) * 3, 0.0f);
+    EbsdColorTable::GetColorTable(numColors, colors);
+    const int half = imageDim / 2;
+    const float res = 2.0f / static_cast<float>(imageDim);
+    for(int y = 0; y < imageDim; y++)
+    {
+      for(int x = 0; x < imageDim; x++)
+      {
+        float xtmp = float(x - half) * res + (res * 0.5f);
+        float ytmp = float(y - half) * res + (res * 0.5f);
+        size_t idx = static_cast<size_t>(imageDim * y + x);
+        if((xtmp * xtmp + ytmp * ytmp) > 1.0)
+        {
+          rgba[idx] = 0xFFFFFFFF;
+          continue;
+        }
+        double value = (data[idx] - min) / (max - min);
+        int bin = std::min(int(value * numColors), numColors - 1);
+        float r = 0.0f;
+        float g = 0.0f;
+        float b = 0.0f;
+        if(bin >= 0 && blackAndWhite)
+        {
+          r = g = b = (value > 0.0) ? 0.0f : 1.0f;
+        }
+        else if(bin >= 0)
+        {
+          r = colors[3 * bin];
+          g = colors[3 * bin + 1];
+          b = colors[3 * bin + 2];
+        }
+        rgba[idx] = EbsdLib::RgbColor::dRgb(static_cast<int>(r * 255.0f), static_cast<int>(g * 255.0f), static_cast<int>(b * 255.0f), 255);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPoleFigureColorImage()
+  {
+    std::shared_ptr<const std::vector<EbsdLib::Rgb>> lut = EbsdColorTable::GetColorLookupTable(64);
+    DREAM3D_REQUIRE_EQUAL(lut->size(), 64)
+    DREAM3D_REQUIRE(lut.get() == EbsdColorTable::GetColorLookupTable(64).get())
+
+    std::mt19937_64 generator(7);
+    std::uniform_real_distribution<double> distribution(-0.5, 4.0);
+    for(int imageDim : {1, 17, 64, 131})
+    {
+      const size_t numPixels = static_cast<size_t>(imageDim * imageDim);
+      EbsdLib::DoubleArrayType::Pointer intensity = EbsdLib::DoubleArrayType::CreateArray(numPixels, "Intensity", true);
+      for(size_t i = 0; i < numPixels; i++)
+      {
+        (*intensity)[i] = distribution(generator);
+      }
+      PoleFigureConfiguration_t config;
+      config.imageDim = imageDim;
+      config.numColors = 32;
+      config.discreteHeatMap = false;
+      PoleFigureUtilities::FindIntensityRange({intensity.get()}, config);
+      // Part of the intensities fall below the scale so the black pixels are covered too
+      config.minScale = 0.0;
+
+      for(bool discrete : {false, true})
+      {
+        config.discrete = discrete;
+        EbsdLib::UInt8ArrayType::Pointer image = EbsdLib::UInt8ArrayType::CreateArray(numPixels, {4}, "Image", true);
+        PoleFigureUtilities::CreateColorImage(intensity.get(), config, image.get());
+        std::vector<uint32_t> expected(numPixels);
+        ReferenceColorImage(intensity->getPointer(0), imageDim, config.numColors, static_cast<float>(config.minScale), static_cast<float>(config.maxScale), discrete, expected.data());
+        const uint32_t* rgba = reinterpret_cast<const uint32_t*>(image->getPointer(0));
+        for(size_t i = 0; i < numPixels; i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(rgba[i], expected[i])
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPoleFigurePyramid()
+  {
+    const size_t numOrientations = 500;
+    EbsdLib::FloatArrayType::Pointer eulers = CreateRandomEulers(numOrientations);
+
+    const std::vector<int> imageDims = {32, 65, 128};
+    for(const auto& ops : LaueOps::GetAllOrientationOps())
+    {
+      for(bool discrete : {false, true})
+      {
+        PoleFigureConfiguration_t config;
+        config.eulers = eulers.get();
+        config.lambertDim = 24;
+        config.numColors = 16;
+        config.discrete = discrete;
+        config.discreteHeatMap = false;
+        config.order = {2, 0, 1};
+        std::vector<PoleFigurePyramidLevel_t> pyramid = ops->generatePoleFigurePyramid(config, imageDims);
+        DREAM3D_REQUIRE_EQUAL(pyramid.size(), imageDims.size())
+
+        std::array<std::string, 3> names = ops->getDefaultPoleFigureNames();
+        for(size_t level = 0; level < pyramid.size(); level++)
+        {
+          DREAM3D_REQUIRE_EQUAL(pyramid[level].imageDim, imageDims[level])
+          DREAM3D_REQUIRE_EQUAL(pyramid[level].images.size(), 3)
+          DREAM3D_REQUIRE_EQUAL(pyramid[level].intensities.size(), 3)
+          DREAM3D_REQUIRE_EQUAL(pyramid[level].images[0]->getName(), names[1])
+          DREAM3D_REQUIRE_EQUAL(pyramid[level].images[1]->getName(), names[2])
+          DREAM3D_REQUIRE_EQUAL(pyramid[level].images[2]->getName(), names[0])
+
+          // Every level has to match the pole figures generated on their own at that size
+          config.imageDim = imageDims[level];
+          std::vector<EbsdLib::UInt8ArrayType::Pointer> expected = ops->generatePoleFigure(config);
+          for(size_t i = 0; i < expected.size(); i++)
+          {
+            const EbsdLib::UInt8ArrayType& image = *pyramid[level].images[i];
+            DREAM3D_REQUIRE_EQUAL(image.getNumberOfTuples(), expected[i]->getNumberOfTuples())
+            DREAM3D_REQUIRE(std::equal(image.begin(), image.end(), expected[i]->begin()))
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestPoleFigureAccumulator()
+  {
+    const size_t numOrientations = 600;
+    const size_t firstBatch = 350;
+    const size_t extraBatch = 100;
+    EbsdLib::FloatArrayType::Pointer eulers = CreateRandomEulers(numOrientations + extraBatch);
+    const float* eulerPtr = eulers->getPointer(0);
+    EbsdArrayView<const float> all(eulerPtr, numOrientations, 3);
+    EbsdArrayView<const float> first(eulerPtr, firstBatch, 3);
+    EbsdArrayView<const float> second(eulerPtr + firstBatch * 3, numOrientations - firstBatch, 3);
+    EbsdArrayView<const float> extra(eulerPtr + numOrientations * 3, extraBatch, 3);
+
+    for(const auto& ops : {LaueOps::Pointer(CubicOps::New()), LaueOps::Pointer(HexagonalOps::New())})
+    {
+      PoleFigureConfiguration_t config;
+      config.eulerView = all;
+      config.imageDim = 64;
+      config.lambertDim = 32;
+      config.numColors = 16;
+      config.discrete = false;
+      config.discreteHeatMap = false;
+      std::vector<EbsdLib::UInt8ArrayType::Pointer> expected = ops->generatePoleFigure(config);
+
+      PoleFigureAccumulator::Pointer accumulator = PoleFigureAccumulator::New(ops, config.lambertDim);
+      DREAM3D_REQUIRE_EQUAL(accumulator->getNumberOfOrientations(), 0)
+      accumulator->addOrientations(first);
+      accumulator->addOrientations(second);
+      DREAM3D_REQUIRE_EQUAL(accumulator->getNumberOfOrientations(), numOrientations)
+
+      // Adding the orientations in batches matches generating the pole figures from all of them at once
+      PoleFigureConfiguration_t accumulatedConfig = config;
+      std::vector<EbsdLib::UInt8ArrayType::Pointer> poleFigures = accumulator->generatePoleFigure(accumulatedConfig);
+      DREAM3D_REQUIRE_EQUAL(poleFigures.size(), expected.size())
+      DREAM3D_REQUIRE_EQUAL(accumulatedConfig.maxScale, config.maxScale)
+      for(size_t i = 0; i < expected.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(poleFigures[i]->getName(), expected[i]->getName())
+        DREAM3D_REQUIRE(std::equal(poleFigures[i]->begin(), poleFigures[i]->end(), expected[i]->begin()))
+      }
+
+      // Adding and then removing a batch only leaves rounding behind
+      std::vector<EbsdLib::DoubleArrayType::Pointer> before = accumulator->generateIntensities(config.imageDim);
+      accumulator->addOrientations(extra);
+      DREAM3D_REQUIRE_EQUAL(accumulator->getNumberOfOrientations(), numOrientations + extraBatch)
+      accumulator->removeOrientations(extra);
+      DREAM3D_REQUIRE_EQUAL(accumulator->getNumberOfOrientations(), numOrientations)
+      std::vector<EbsdLib::DoubleArrayType::Pointer> after = accumulator->generateIntensities(config.imageDim);
+      for(size_t i = 0; i < before.size(); i++)
+      {
+        for(size_t p = 0; p < before[i]->getNumberOfTuples(); p++)
+        {
+          DREAM3D_REQUIRE(std::fabs((*before[i])[p] - (*after[i])[p]) < 1.0E-6)
+        }
+      }
+
+      accumulator->removeOrientations(all);
+      DREAM3D_REQUIRE_EQUAL(accumulator->getNumberOfOrientations(), 0)
+      std::vector<EbsdLib::DoubleArrayType::Pointer> empty = accumulator->generateIntensities(config.imageDim);
+      for(const auto& intensity : empty)
+      {
+        DREAM3D_REQUIRE(std::all_of(intensity->begin(), intensity->end(), [](double value) { return value == 0.0; }))
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestWeightedPoleFigures()
+  {
+    // Enough coordinates for the weighted binning to use several blocks
+    const size_t numOrientations = 20000;
+    const size_t halfOrientations = numOrientations / 2;
+    EbsdLib::FloatArrayType::Pointer eulers = CreateRandomEulers(numOrientations);
+    CubicOps ops;
+    EbsdLib::FloatArrayType::Pointer xyz001 = EbsdLib::FloatArrayType::CreateArray(0, {3}, "xyz001", true);
+    EbsdLib::FloatArrayType::Pointer xyz011 = EbsdLib::FloatArrayType::CreateArray(0, {3}, "xyz011", true);
+    EbsdLib::FloatArrayType::Pointer xyz111 = EbsdLib::FloatArrayType::CreateArray(0, {3}, "xyz111", true);
+    ops.generateSphereCoordsFromEulers(EbsdArrayView<const float>::FromArray(*eulers), xyz001.get(), xyz011.get(), xyz111.get());
+    const size_t coordsPerOrientation = xyz111->getNumberOfTuples() / numOrientations;
+    EbsdLib::FloatArrayType::Pointer halfXyz111 = EbsdLib::FloatArrayType::CreateArray(halfOrientations * coordsPerOrientation, {3}, "halfXyz111", true);
+    std::copy(xyz111->begin(), xyz111->begin() + halfXyz111->getSize(), halfXyz111->begin());
+
+    // Orientations with a weight of 0 do not contribute
+    std::vector<float> weights(numOrientations, 0.0f);
+    std::fill(weights.begin(), weights.begin() + halfOrientations, 1.0f);
+    for(bool discrete : {false, true})
+    {
+      PoleFigureConfiguration_t config;
+      config.imageDim = 64;
+      config.lambertDim = 32;
+      config.sphereRadius = 1.0f;
+      config.discrete = discrete;
+      EbsdLib::DoubleArrayType::Pointer expected = EbsdLib::DoubleArrayType::CreateArray(0, {1}, "Expected", true);
+      ComputeStereographicProjection(halfXyz111.get(), &config, expected.get())();
+
+      config.weights = EbsdArrayView<const float>(weights.data(), numOrientations, 1);
+      EbsdLib::DoubleArrayType::Pointer weighted = EbsdLib::DoubleArrayType::CreateArray(0, {1}, "Weighted", true);
+      ComputeStereographicProjection(xyz111.get(), &config, weighted.get())();
+      DREAM3D_REQUIRE_EQUAL(weighted->getNumberOfTuples(), expected->getNumberOfTuples())
+      for(size_t i = 0; i < expected->getNumberOfTuples(); i++)
+      {
+        DREAM3D_REQUIRE(std::fabs((*weighted)[i] - (*expected)[i]) < 1.0E-9 * std::max(1.0, std::fabs((*expected)[i])))
+      }
+
+      // Weights that are not one per orientation are reported instead of being read out of bounds or ignored
+      config.weights = EbsdArrayView<const float>(weights.data(), numOrientations - 1, 1);
+      bool caught = false;
+      try
+      {
+        ComputeStereographicProjection(xyz111.get(), &config, weighted.get())();
+      } catch(const std::invalid_argument&)
+      {
+        caught = true;
+      }
+      DREAM3D_REQUIRE(caught)
+    }
+
+    // Squares without any weight normalize to zero instead of NaN
+    ModifiedLambertProjection::Pointer empty = ModifiedLambertProjection::New();
+    empty->initializeSquares(16, 1.0f);
+    empty->normalizeSquaresToMRD();
+    DREAM3D_REQUIRE(std::all_of(empty->getNorthSquare()->begin(), empty->getNorthSquare()->end(), [](double value) { return value == 0.0; }))
+    DREAM3D_REQUIRE(std::all_of(empty->getSouthSquare()->begin(), empty->getSouthSquare()->end(), [](double value) { return value == 0.0; }))
+
+    // Smoothing keeps the total intensity of the squares and spreads out a single spike evenly
+    ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::New();
+    const int lambertDim = 64;
+    lambert->initializeSquares(lambertDim, 1.0f);
+    const int center = lambertDim / 2 * lambertDim + lambertDim / 2;
+    lambert->setValue(ModifiedLambertProjection::NorthSquare, center, 1.0);
+    lambert->setValue(ModifiedLambertProjection::SouthSquare, 0, 1.0);
+    lambert->smoothSquares(5.0f * EbsdLib::Constants::k_DegToRadF);
+    for(const auto& square : {lambert->getNorthSquare(), lambert->getSouthSquare()})
+    {
+      double total = 0.0;
+      for(double value : *square)
+      {
+        total += value;
+      }
+      DREAM3D_REQUIRE(std::fabs(total - 1.0) < 1.0E-9)
+    }
+    DREAM3D_REQUIRE(lambert->getValue(ModifiedLambertProjection::NorthSquare, center) < 0.5)
+    DREAM3D_REQUIRE_EQUAL(lambert->getValue(ModifiedLambertProjection::NorthSquare, center - 1), lambert->getValue(ModifiedLambertProjection::NorthSquare, center + 1))
+    DREAM3D_REQUIRE_EQUAL(lambert->getValue(ModifiedLambertProjection::NorthSquare, center - lambertDim), lambert->getValue(ModifiedLambertProjection::NorthSquare, center + lambertDim))
+
+    // A smoothed pole figure has a lower peak than the binned one
+    PoleFigureConfiguration_t config;
+    config.eulers = eulers.get();
+    config.imageDim = 64;
+    config.lambertDim = 32;
+    config.numColors = 16;
+    config.discrete = false;
+    config.discreteHeatMap = false;
+    ops.generatePoleFigure(config);
+    double binnedMax = config.maxScale;
+    config.kernelHalfWidth = 10.0f * EbsdLib::Constants::k_DegToRadF;
+    ops.generatePoleFigure(config);
+    DREAM3D_REQUIRE(config.maxScale < binnedMax)
+  }
+
+  // -----------------------------------------------------------------------------
+  void TestIPFDensity()
+  {
+    // Uniformly distributed orientations (Shoemake's method). Uniform Euler angles would not be uniform in SO(3).
+    const size_t numOrientations = 100000;
+    std::mt19937_64 generator(11);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    EbsdLib::FloatArrayType::Pointer eulers = EbsdLib::FloatArrayType::CreateArray(numOrientations, {3}, "Eulers", true);
+    for(size_t i = 0; i < numOrientations; i++)
+    {
+      double u1 = distribution(generator);
+      double u2 = EbsdLib::Constants::k_2PiD * distribution(generator);
+      double u3 = EbsdLib::Constants::k_2PiD * distribution(generator);
+      QuatD q(std::sqrt(1.0 - u1) * std::sin(u2), std::sqrt(1.0 - u1) * std::cos(u2), std::sqrt(u1) * std::sin(u3), std::sqrt(u1) * std::cos(u3));
+      if(q.w() < 0.0)
+      {
+        q = QuatD(-q.x(), -q.y(), -q.z(), -q.w());
+      }
+      OrientationD eu = OrientationTransformation::qu2eu<QuatD, OrientationD>(q);
+      eulers->setComponent(i, 0, static_cast<float>(eu[0]));
+      eulers->setComponent(i, 1, static_cast<float>(eu[1]));
+      eulers->setComponent(i, 2, static_cast<float>(eu[2]));
+    }
+    const double refDir[3] = {0.0, 0.0, 1.0};
+
+    for(const auto& ops : {LaueOps::Pointer(CubicOps::New()), LaueOps::Pointer(HexagonalOps::New())})
+    {
+      // Random orientations give a density of about 1 MRD everywhere in the triangle
+      PoleFigureConfiguration_t config;
+      config.eulers = eulers.get();
+      config.imageDim = 24;
+      config.numColors = 16;
+      config.discrete = false;
+      config.discreteHeatMap = false;
+      config.kernelHalfWidth = 5.0f * EbsdLib::Constants::k_DegToRadF;
+      EbsdLib::DoubleArrayType::Pointer density = ops->computeIPFDensity(config, refDir, false);
+      DREAM3D_REQUIRE_EQUAL(density->getNumberOfTuples(), 24 * 24)
+      size_t numInside = 0;
+      for(double value : *density)
+      {
+        if(value != 0.0)
+        {
+          numInside++;
+          DREAM3D_REQUIRE(value > 0.75 && value < 1.25)
+        }
+      }
+      DREAM3D_REQUIRE(numInside > 24 * 24 / 4)
+
+      // Orientations with a weight of 0 do not contribute
+      config.kernelHalfWidth = 0.0f;
+      std::vector<float> weights(numOrientations, 0.0f);
+      std::fill(weights.begin(), weights.begin() + numOrientations / 2, 1.0f);
+      PoleFigureConfiguration_t halfConfig = config;
+      halfConfig.eulers = nullptr;
+      halfConfig.eulerView = EbsdArrayView<const float>(eulers->getPointer(0), numOrientations / 2, 3);
+      EbsdLib::DoubleArrayType::Pointer expected = ops->computeIPFDensity(halfConfig, refDir, false);
+      config.weights = EbsdArrayView<const float>(weights.data(), numOrientations, 1);
+      EbsdLib::DoubleArrayType::Pointer weighted = ops->computeIPFDensity(config, refDir, false);
+      for(size_t i = 0; i < expected->getNumberOfTuples(); i++)
+      {
+        DREAM3D_REQUIRE(std::fabs((*weighted)[i] - (*expected)[i]) < 1.0E-9 * std::max(1.0, (*expected)[i]))
+      }
+    }
+
+    // A single orientation puts all of its weight into the pixel of the [001] corner of the cubic triangle, which is
+    // the center of the stereographic projection
+    CubicOps ops;
+    std::vector<float> identity = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    PoleFigureConfiguration_t config;
+    config.eulerView = EbsdArrayView<const float>(identity.data(), 2, 3);
+    config.imageDim = 32;
+    config.numColors = 16;
+    config.discrete = false;
+    config.discreteHeatMap = false;
+    EbsdLib::DoubleArrayType::Pointer density = ops.computeIPFDensity(config, refDir, false);
+    size_t numNonZero = std::count_if(density->begin(), density->end(), [](double value) { return value != 0.0; });
+    DREAM3D_REQUIRE_EQUAL(numNonZero, 1)
+    size_t peak = static_cast<size_t>(std::max_element(density->begin(), density->end()) - density->begin());
+    DREAM3D_REQUIRE(peak / 32 < 2 && peak % 32 < 2)
+
+    EbsdLib::UInt8ArrayType::Pointer image = ops.generateIPFDensityImage(config, refDir, false);
+    DREAM3D_REQUIRE_EQUAL(image->getNumberOfTuples(), 32 * 32)
+    const uint32_t* rgba = reinterpret_cast<const uint32_t*>(image->getPointer(0));
+    DREAM3D_REQUIRE_EQUAL(rgba[32 * 32 - 1], 0xFFFFFFFF)
+    DREAM3D_REQUIRE(rgba[peak] != 0xFFFFFFFF)
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "<===== Start " << getNameOfClass() << std::endl;
+
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestSlipTransmissionMetrics())
+    DREAM3D_REGISTER_TEST(TestSchmidFactorMap())
+    DREAM3D_REGISTER_TEST(TestMisorientations())
+    DREAM3D_REGISTER_TEST(TestNearestQuats())
+    DREAM3D_REGISTER_TEST(TestAverageQuatsByGroup())
+    DREAM3D_REGISTER_TEST(TestFeatureOrientationStatistics())
+    DREAM3D_REGISTER_TEST(TestKernelAverageMisorientation())
+    DREAM3D_REGISTER_TEST(TestMisorientationSegmentation())
+    DREAM3D_REGISTER_TEST(TestIPFColors())
+    DREAM3D_REGISTER_TEST(TestLaueOpsRegistry())
+    DREAM3D_REGISTER_TEST(TestPhasePartition())
+    DREAM3D_REGISTER_TEST(TestPoleFigureColorImage())
+    DREAM3D_REGISTER_TEST(TestPoleFigurePyramid())
+    DREAM3D_REGISTER_TEST(TestPoleFigureAccumulator())
+    DREAM3D_REGISTER_TEST(TestWeightedPoleFigures())
+    DREAM3D_REGISTER_TEST(TestIPFDensity())
+  }
+};
@@ -33,10 +33,14 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <random>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <string>
@@ -44,6 +48,7 @@
 
 #include "EbsdLib/Core/EbsdDataArray.hpp"
 #include "EbsdLib/Core/EbsdLibConstants.h"
+#include "EbsdLib/Core/FusedOrientationTransformation.hpp"
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 #include "EbsdLib/OrientationMath/OrientationConverter.hpp"
 #include "EbsdLib/Utilities/EbsdStringUtils.hpp"
@@ -545,6 +550,139 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <OrientationRepresentation::Type From, OrientationRepresentation::Type To>
+  void CompareFusedConversion(const std::vector<double>& eulers)
+  {
+    using namespace OrientationTransformation;
+    const size_t numOrientations = eulers.size() / 3;
+    const size_t inStride = Fused::NumComponents(From);
+    const size_t outStride = Fused::NumComponents(To);
+
+    // Build the input representation from the Euler angles, then run the fused kernel over the whole array
+    std::vector<double> input(numOrientations * inStride);
+    Fused::GetConversionKernel<double>(OrientationRepresentation::Type::Euler, From)(eulers.data(), 3, input.data(), inStride, 0, numOrientations);
+    std::vector<double> output(numOrientations * outStride);
+    Fused::ConversionKernel<double> kernel = Fused::GetConversionKernel<double>(From, To);
+    DREAM3D_REQUIRE_VALID_POINTER(kernel)
+    kernel(input.data(), inStride, output.data(), outStride, 0, numOrientations);
+
+    // The reference goes through the heap allocated Orientation and Quaternion containers
+    using RefInputType = std::conditional_t<From == OrientationRepresentation::Type::Quaternion, QuatD, OrientationD>;
+    using RefOutputType = std::conditional_t<To == OrientationRepresentation::Type::Quaternion, QuatD, OrientationD>;
+    for(size_t i = 0; i < numOrientations; i++)
+    {
+      const double* values = input.data() + i * inStride;
+      RefInputType in;
+      if constexpr(From == OrientationRepresentation::Type::Quaternion)
+      {
+        in = QuatD(values[0], values[1], values[2], values[3]);
+      }
+      else
+      {
+        in = OrientationD(input.data() + i * inStride, inStride);
+      }
+      RefOutputType ref = Fused::Conversion<From, To>::template Apply<RefInputType, RefOutputType>(in);
+      for(size_t c = 0; c < outStride; c++)
+      {
+        DREAM3D_REQUIRE(std::abs(ref[c] - output[i * outStride + c]) < 1.0E-9)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <size_t... Indices>
+  void CompareAllFusedConversions(const std::vector<double>& eulers, std::index_sequence<Indices...> /*unused*/)
+  {
+    (CompareFusedConversion<static_cast<OrientationRepresentation::Type>(Indices / 7), static_cast<OrientationRepresentation::Type>(Indices % 7)>(eulers), ...);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestFusedConversions()
+  {
+    std::mt19937_64 generator(12345);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    const size_t numOrientations = 500;
+    std::vector<double> eulers(numOrientations * 3);
+    for(size_t i = 0; i < numOrientations; i++)
+    {
+      eulers[i * 3] = EbsdLib::Constants::k_2PiD * distribution(generator);
+      eulers[i * 3 + 1] = EbsdLib::Constants::k_PiD * distribution(generator);
+      eulers[i * 3 + 2] = EbsdLib::Constants::k_2PiD * distribution(generator);
+    }
+    CompareAllFusedConversions(eulers, std::make_index_sequence<49>());
+
+    DREAM3D_REQUIRE_NULL_POINTER(OrientationTransformation::Fused::GetConversionKernel<double>(OrientationRepresentation::Type::Unknown, OrientationRepresentation::Type::Euler))
+
+    // Single orientation entry point
+    const double eu[3] = {0.5, 1.0, 1.5};
+    double qu[4] = {0.0, 0.0, 0.0, 0.0};
+    OrientationTransformation::Fused::Convert<OrientationRepresentation::Type::Euler, OrientationRepresentation::Type::Quaternion>(eu, qu);
+    QuatD ref = OrientationTransformation::eu2qu<OrientationD, QuatD>(OrientationD(0.5, 1.0, 1.5));
+    DREAM3D_REQUIRE(std::abs(qu[0] - ref.x()) < 1.0E-12)
+    DREAM3D_REQUIRE(std::abs(qu[3] - ref.w()) < 1.0E-12)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestSinglePrecisionConversions()
+  {
+    using RepType = OrientationRepresentation::Type;
+    namespace Fused = OrientationTransformation::Fused;
+    std::mt19937_64 generator(54321);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    const size_t numOrientations = 2000;
+    std::vector<double> eulers(numOrientations * 3);
+    for(size_t i = 0; i < numOrientations; i++)
+    {
+      eulers[i * 3] = EbsdLib::Constants::k_2PiD * distribution(generator);
+      eulers[i * 3 + 1] = EbsdLib::Constants::k_PiD * distribution(generator);
+      eulers[i * 3 + 2] = EbsdLib::Constants::k_2PiD * distribution(generator);
+    }
+
+    // Rodrigues vectors and orientation matrix inputs are outside of the documented bound
+    for(size_t from = 0; from < 7; from++)
+    {
+      const auto fromType = static_cast<RepType>(from);
+      if(fromType == RepType::Rodrigues || fromType == RepType::OrientationMatrix)
+      {
+        continue;
+      }
+      const size_t inStride = Fused::NumComponents(fromType);
+      std::vector<double> inputD(numOrientations * inStride);
+      Fused::GetConversionKernel<double>(RepType::Euler, fromType)(eulers.data(), 3, inputD.data(), inStride, 0, numOrientations);
+      std::vector<float> inputF(inputD.begin(), inputD.end());
+      for(size_t to = 0; to < 7; to++)
+      {
+        const auto toType = static_cast<RepType>(to);
+        if(toType == RepType::Rodrigues)
+        {
+          continue;
+        }
+        const size_t outStride = Fused::NumComponents(toType);
+        std::vector<double> outputD(numOrientations * outStride);
+        std::vector<float> outputF(numOrientations * outStride);
+        // The double reference starts from the same float rounded input
+        std::vector<double> roundedD(inputF.begin(), inputF.end());
+        Fused::GetConversionKernel<double>(fromType, toType)(roundedD.data(), inStride, outputD.data(), outStride, 0, numOrientations);
+        Fused::GetConversionKernel<float>(fromType, toType)(inputF.data(), inStride, outputF.data(), outStride, 0, numOrientations);
+        double maxError = 0.0;
+        for(size_t i = 0; i < outputD.size(); i++)
+        {
+          maxError = std::max(maxError, std::abs(outputD[i] - static_cast<double>(outputF[i])));
+        }
+        DREAM3D_REQUIRE(maxError < EbsdLib::SinglePrecisionBounds::k_OrientationTransform)
+      }
+    }
+  }
+
   void operator()()
   {
     std::cout << "<===== Start " << getNameOfClass() << std::endl;
@@ -553,6 +691,8 @@ public:
 
     StartTest();
 
+    DREAM3D_REGISTER_TEST(TestFusedConversions());
+    DREAM3D_REGISTER_TEST(TestSinglePrecisionConversions());
     DREAM3D_REGISTER_TEST(RemoveTestFiles());
   }
 
@@ -33,7 +33,9 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <cmath>
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -49,6 +51,7 @@
 #include "EbsdLib/LaueOps/TriclinicOps.h"
 #include "EbsdLib/LaueOps/TrigonalLowOps.h"
 #include "EbsdLib/LaueOps/TrigonalOps.h"
+#include "EbsdLib/Math/DiscreteSampler.h"
 #include "EbsdLib/Texture/StatsGen.hpp"
 #include "EbsdLib/Texture/Texture.hpp"
 
@@ -186,6 +189,62 @@ public:
     TestTextureOdf<TrigonalOps>();
   }
 
+  void TestDiscreteSampler()
+  {
+    const std::vector<float> weights = {0.0f, 1.0f, 3.0f, 0.0f, 4.0f, -2.0f};
+    DiscreteSampler sampler(weights);
+    DREAM3D_REQUIRE_EQUAL(sampler.size(), 6)
+    DREAM3D_REQUIRE(std::fabs(sampler.getTotalWeight() - 8.0) < 1.0E-12)
+    DREAM3D_REQUIRE(std::fabs(sampler.getProbability(2) - 0.375) < 1.0E-12)
+    DREAM3D_REQUIRE_EQUAL(sampler.getProbability(5), 0.0)
+
+    std::mt19937_64 generator(1234);
+    std::vector<size_t> counts(weights.size(), 0);
+    const size_t numDraws = 200000;
+    for(size_t i = 0; i < numDraws; i++)
+    {
+      counts[sampler(generator)]++;
+    }
+    DREAM3D_REQUIRE_EQUAL(counts[0], 0)
+    DREAM3D_REQUIRE_EQUAL(counts[3], 0)
+    DREAM3D_REQUIRE_EQUAL(counts[5], 0)
+    for(size_t bin = 0; bin < weights.size(); bin++)
+    {
+      double frequency = static_cast<double>(counts[bin]) / static_cast<double>(numDraws);
+      DREAM3D_REQUIRE(std::fabs(frequency - sampler.getProbability(bin)) < 0.01)
+    }
+    DREAM3D_REQUIRE_EQUAL(sampler.sample(0.9999999999), 4)
+
+    // An empty distribution always gives the first bin
+    DiscreteSampler empty(std::vector<float>(4, 0.0f));
+    DREAM3D_REQUIRE_EQUAL(empty.sample(0.75), 0)
+  }
+
+  void TestGenODFPlotData()
+  {
+    CubicOps ops;
+    std::vector<float> odf(static_cast<size_t>(ops.getODFSize()), 0.0f);
+    odf[100] = 1.0f;
+    odf[2000] = 3.0f;
+    DiscreteSampler sampler(odf);
+
+    const size_t npoints = 10000;
+    std::vector<float> eulers(npoints * 3);
+    std::vector<float> repeat(npoints * 3);
+    StatsGen::GenODFPlotData<float, CubicOps>(sampler, eulers.data(), npoints, 42);
+    StatsGen::GenODFPlotData<float, CubicOps>(sampler, repeat.data(), npoints, 42);
+    DREAM3D_REQUIRE(eulers == repeat)
+    for(float angle : eulers)
+    {
+      DREAM3D_REQUIRE(std::isfinite(angle))
+    }
+    StatsGen::GenODFPlotData<float, CubicOps>(sampler, repeat.data(), npoints, 43);
+    DREAM3D_REQUIRE(eulers != repeat)
+
+    int err = StatsGen::GenODFPlotData<float, CubicOps, std::vector<float>>(odf, eulers.data(), npoints);
+    DREAM3D_REQUIRE_EQUAL(err, 0)
+  }
+
   void operator()()
   {
     std::cout << "<===== Start " << getNameOfClass() << std::endl;
@@ -193,6 +252,8 @@ public:
     int err = EXIT_SUCCESS;
     DREAM3D_REGISTER_TEST(TestOdfGeneration())
     DREAM3D_REGISTER_TEST(TestMdfGeneration())
+    DREAM3D_REGISTER_TEST(TestDiscreteSampler())
+    DREAM3D_REGISTER_TEST(TestGenODFPlotData())
   }
 
 public:
@@ -1,4 +1,5 @@
 from . import ang
 from . import ctf
+from ._native import native
 
-__all__ = ['ang', 'ctf']
+__all__ = ['ang', 'ctf', 'native']
@@ -0,0 +1,24 @@
+from typing import Any, Dict
+
+# The compiled bindings are optional. They are built by configuring EbsdLib with EbsdLib_BUILD_PYTHON=ON and are
+# found either inside this package or on the Python path.
+try:
+  from . import _ebsdlib as native
+except ImportError:
+  try:
+    import _ebsdlib as native
+  except ImportError:
+    native = None
+
+def require_native() -> Any:
+  if native is None:
+    raise RuntimeError('The EbsdLib Python bindings (_ebsdlib) were not found. Build EbsdLib with EbsdLib_BUILD_PYTHON=ON and put the module in the ebsd package or on the Python path.')
+  return native
+
+def read_data(reader: Any, filepath: str) -> Dict[str, Any]:
+  reader.file_name = filepath
+  err = reader.read_file()
+  if err < 0:
+    raise RuntimeError(f'{filepath}: {reader.error_message} ({err})')
+  # The columns are moved out of the reader, so the arrays outlive it
+  return reader.columns()
@@ -3,9 +3,10 @@ import os
 from dataclasses import dataclass
 from typing import Any, Dict, Final, Generator, List, Optional, Type
 
+from . import _native
 from ._utils import file_line_generator
 
-__all__ = ['HKLFamily', 'AngPhase', 'AngHeader', 'parse_header', 'parse_header_as_dict']
+__all__ = ['HKLFamily', 'AngPhase', 'AngHeader', 'parse_header', 'parse_header_as_dict', 'read_data']
 
 ANG_HEADER_CHAR: Final[str] = '#'
 ANG_PROPERTY_SEP: Final[str] = ':'
@@ -219,3 +220,7 @@ def _get_phases_as_dict(phases: Dict[int, AngPhase]) -> dict:
     phases_dict[f"Phase {x}"] = phase_dict
 
   return phases_dict
+
+def read_data(filepath: str) -> Dict[str, Any]:
+  """Parses the data columns with the C++ AngReader. Returns a dict of NumPy arrays."""
+  return _native.read_data(_native.require_native().AngReader(), filepath)
@@ -4,9 +4,10 @@ from dataclasses import dataclass
 from enum import IntEnum
 from typing import Any, Callable, Dict, Final, Generator, List, Tuple
 
+from . import _native
 from ._utils import file_line_generator
 
-__all__ = ['CtfPhase', 'CtfHeader', 'parse_header', 'parse_header_as_dict']
+__all__ = ['CtfPhase', 'CtfHeader', 'parse_header', 'parse_header_as_dict', 'read_data']
 
 CTF_DELIMITER: Final[str] = '\t'
 
@@ -196,3 +197,7 @@ def _get_phases_as_dict(phases: Dict[int, CtfPhase]) -> dict:
     phases_dict[f"Phase {phase_num}"] = phase_dict
 
   return phases_dict
+
+def read_data(filepath: str) -> Dict[str, Any]:
+  """Parses the data columns with the C++ CtfReader. Returns a dict of NumPy arrays."""
+  return _native.read_data(_native.require_native().CtfReader(), filepath)